@@ -43,3 +43,6 @@ SB_ERROR(PUBLIC_KEY_INVALID)
 
 // The signature is invalid
 SB_ERROR(SIGNATURE_INVALID)
+
+// The presignature pool has no presignatures left
+SB_ERROR(PRESIGNATURE_POOL_EMPTY)
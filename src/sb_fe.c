@@ -14,6 +14,8 @@
 #include "sb_test.h"
 #include "sb_fe.h"
 #include "sb_sw_curves.h"
+#include "sb_mont_lib.h"
+#include "sb_mont_curves.h"
 
 // ARM assembly is provided for Thumb-2 and 32-bit ARMv6 and later targets.
 // If you have DSP extensions, the UMAAL instruction is used, which provides
@@ -47,6 +49,90 @@
 #error "Conflicting options: SB_USE_ARM_DSP_ASM implies SB_USE_ARM_ASM"
 #endif
 
+// x86-64 assembly is provided for Montgomery multiplication when SB_MUL_SIZE
+// is 8 and the target supports the BMI2 and ADX extensions (Intel Broadwell,
+// AMD Zen, and later). MULX multiplies without affecting the flags, and ADCX
+// and ADOX propagate carries through CF and OF respectively, which allows
+// the low and high halves of each row of partial products to be accumulated
+// in two independent carry chains. The extensions are detected using the
+// compiler's target macros, so you will need to compile with -mbmi2 -madx or
+// an appropriate -march option to get the assembly; otherwise, the portable C
+// implementation is used. As above, you can define SB_USE_X86_64_ASM
+// explicitly if detection does not work for you.
+
+#ifndef SB_USE_X86_64_ASM
+#if defined(__x86_64__) && defined(__BMI2__) && defined(__ADX__) && \
+    SB_MUL_SIZE == 8
+#define SB_USE_X86_64_ASM 1
+#else
+#define SB_USE_X86_64_ASM 0
+#endif
+#endif
+
+#if SB_USE_X86_64_ASM && SB_MUL_SIZE != 8
+#error "Conflicting options: SB_USE_X86_64_ASM requires SB_MUL_SIZE == 8"
+#endif
+
+// If SB_FE_SPECIALIZE is 1, the field routines are instantiated for each of
+// the supported primes as described at sb_fe_field_value_t in sb_fe.h. This
+// costs a copy of the Montgomery multiplication and squaring routines for
+// each prime which uses Montgomery reduction, and pays off when Montgomery
+// multiplication is compiled from C: with 32-bit words, P-256 point
+// multiplication is about 14% faster on x86-64. Where Montgomery
+// multiplication is done in assembly, which loads the prime from memory, the
+// instances gain little, so they are disabled by default. If
+// SB_FE_SPECIALIZE is 0, the instances call the generic routines, which do
+// not dispatch.
+#ifndef SB_FE_SPECIALIZE
+#if SB_USE_ARM_DSP_ASM || SB_USE_X86_64_ASM
+#define SB_FE_SPECIALIZE 0
+#else
+#define SB_FE_SPECIALIZE 1
+#endif
+#endif
+
+// The routines which depend on the prime are written as SB_FE_INLINE
+// functions taking a field structure, from which both the generic routines
+// and the instances are made. In an instance, the field structure is a
+// constant, and the compiler folds its members into the inlined code;
+// inlining is forced, as the compiler's own heuristics will not inline
+// routines of this size into several callers. The prime-specific reduction
+// methods are already written for a single prime, and are not inlined.
+#if SB_FE_SPECIALIZE && (defined(__GNUC__) || defined(__clang__))
+#define SB_FE_INLINE inline __attribute__((always_inline))
+#else
+#define SB_FE_INLINE inline
+#endif
+
+// SB_FE_DISPATCH(p, f, ...) calls the instance of the routine f for the field
+// p, if there is one, and returns.
+#if SB_SW_P256_SUPPORT
+#define SB_FE_DISPATCH_P256(f, ...) \
+    case SB_FE_FIELD_P256: f##_p256(__VA_ARGS__); return;
+#else
+#define SB_FE_DISPATCH_P256(f, ...)
+#endif
+
+#if SB_SW_SECP256K1_SUPPORT
+#define SB_FE_DISPATCH_SECP256K1(f, ...) \
+    case SB_FE_FIELD_SECP256K1: f##_secp256k1(__VA_ARGS__); return;
+#else
+#define SB_FE_DISPATCH_SECP256K1(f, ...)
+#endif
+
+#if SB_FE_SPECIALIZE
+#define SB_FE_DISPATCH(p, f, ...) do { \
+    switch ((p)->field) { \
+        SB_FE_DISPATCH_P256(f, __VA_ARGS__) \
+        SB_FE_DISPATCH_SECP256K1(f, __VA_ARGS__) \
+        case SB_FE_FIELD_X25519: f##_x25519(__VA_ARGS__); return; \
+        default: break; \
+    } \
+} while (0)
+#else
+#define SB_FE_DISPATCH(p, f, ...) do { } while (0)
+#endif
+
 // Convert an appropriately-sized set of bytes (src) into a field element
 // using the given endianness.
 void sb_fe_from_bytes(sb_fe_t dest[static const restrict 1],
@@ -341,8 +427,8 @@ sb_word_t sb_fe_sub(sb_fe_t dest[static const 1],
     return sb_fe_sub_borrow(dest, left, right, 0);
 }
 
-sb_word_t sb_fe_lt(const sb_fe_t left[static 1],
-                   const sb_fe_t right[static 1])
+static SB_FE_INLINE sb_word_t sb_fe_lt_impl(const sb_fe_t left[static 1],
+                                            const sb_fe_t right[static 1])
 {
     sb_word_t borrow = 0;
 
@@ -382,6 +468,12 @@ sb_word_t sb_fe_lt(const sb_fe_t left[static 1],
     return borrow;
 }
 
+sb_word_t sb_fe_lt(const sb_fe_t left[static 1],
+                   const sb_fe_t right[static 1])
+{
+    return sb_fe_lt_impl(left, right);
+}
+
 // As a ZVA countermeasure, modular operations work with "quasi-reduced" inputs
 // and outputs:
 // Rather than reducing to [0, M - 1], they reduce to [1, M].
@@ -400,9 +492,10 @@ sb_word_t sb_fe_lt(const sb_fe_t left[static 1],
 
 // This helper routine subtracts p if c is 1; the subtraction is done
 // unconditionally, and the result is only written if c is 1
-static void sb_fe_cond_sub_p(sb_fe_t dest[static const restrict 1],
-                             sb_word_t c,
-                             const sb_fe_t p[static const restrict 1])
+static SB_FE_INLINE void
+sb_fe_cond_sub_p(sb_fe_t dest[static const restrict 1],
+                 sb_word_t c,
+                 const sb_fe_t p[static const restrict 1])
 {
 #if SB_USE_ARM_ASM
 
@@ -495,11 +588,12 @@ static void sb_fe_cond_sub_p(sb_fe_t dest[static const restrict 1],
 
 // Quasi-reduce dest (with extra carry bit) by subtracting p iff dest is
 // greater than p
-void sb_fe_qr(sb_fe_t dest[static const restrict 1],
+static SB_FE_INLINE void
+sb_fe_qr_impl(sb_fe_t dest[static const restrict 1],
               sb_word_t const carry,
               const sb_prime_field_t p[static const restrict 1])
 {
-    sb_word_t b = sb_fe_lt(&p->p, dest);
+    sb_word_t b = sb_fe_lt_impl(&p->p, dest);
     sb_fe_cond_sub_p(dest, carry | b, &p->p);
     SB_ASSERT(sb_fe_equal(dest, &p->p) || sb_fe_lt(dest, &p->p),
               "quasi-reduction must always produce quasi-reduced output");
@@ -507,12 +601,20 @@ void sb_fe_qr(sb_fe_t dest[static const restrict 1],
               "quasi-reduction must always produce quasi-reduced output");
 }
 
+void sb_fe_qr(sb_fe_t dest[static const restrict 1],
+              sb_word_t const carry,
+              const sb_prime_field_t p[static const restrict 1])
+{
+    sb_fe_qr_impl(dest, carry, p);
+}
+
 // This helper adds 1 or (p + 1), depending on c. On ARM, this is done by
 // adding p then choosing to store either the original value or the result of
 // the addition, followed by a second pass to add 1.
-static void sb_fe_cond_add_p_1(sb_fe_t dest[static const restrict 1],
-                               sb_word_t c,
-                               const sb_fe_t p[static const restrict 1])
+static SB_FE_INLINE void
+sb_fe_cond_add_p_1(sb_fe_t dest[static const restrict 1],
+                   sb_word_t c,
+                   const sb_fe_t p[static const restrict 1])
 {
 #if SB_USE_ARM_ASM
 
@@ -588,11 +690,11 @@ static void sb_fe_cond_add_p_1(sb_fe_t dest[static const restrict 1],
 // This is done as a subtraction of (right - 1) followed by addition of
 // 1 or (p + 1), which means that a result of all zeros is never written back
 // to memory.
-void
-sb_fe_mod_sub(sb_fe_t dest[static const 1],
-              const sb_fe_t left[static const 1],
-              const sb_fe_t right[static const 1],
-              const sb_prime_field_t p[static const 1])
+static SB_FE_INLINE void
+sb_fe_mod_sub_impl(sb_fe_t dest[static const 1],
+                   const sb_fe_t left[static const 1],
+                   const sb_fe_t right[static const 1],
+                   const sb_prime_field_t p[static const 1])
 {
     const sb_word_t b = sb_fe_sub_borrow(dest, left, right, 1);
     sb_fe_cond_add_p_1(dest, b, &p->p);
@@ -602,15 +704,35 @@ sb_fe_mod_sub(sb_fe_t dest[static const 1],
               "modular subtraction must always produce quasi-reduced output");
 }
 
+void
+sb_fe_mod_sub(sb_fe_t dest[static const 1],
+              const sb_fe_t left[static const 1],
+              const sb_fe_t right[static const 1],
+              const sb_prime_field_t p[static const 1])
+{
+    SB_FE_DISPATCH(p, sb_fe_mod_sub, dest, left, right);
+    sb_fe_mod_sub_impl(dest, left, right, p);
+}
+
 // Given quasi-reduced left and right, produce quasi-reduced left + right.
 
+static SB_FE_INLINE void
+sb_fe_mod_add_impl(sb_fe_t dest[static const 1],
+                   const sb_fe_t left[static const 1],
+                   const sb_fe_t right[static const 1],
+                   const sb_prime_field_t p[static const 1])
+{
+    sb_word_t carry = sb_fe_add(dest, left, right);
+    sb_fe_qr_impl(dest, carry, p);
+}
+
 void
 sb_fe_mod_add(sb_fe_t dest[static const 1], const sb_fe_t left[static const 1],
               const sb_fe_t right[static const 1],
               const sb_prime_field_t p[static const 1])
 {
-    sb_word_t carry = sb_fe_add(dest, left, right);
-    sb_fe_qr(dest, carry, p);
+    SB_FE_DISPATCH(p, sb_fe_mod_add, dest, left, right);
+    sb_fe_mod_add_impl(dest, left, right, p);
 }
 
 void sb_fe_mod_double(sb_fe_t dest[static const 1],
@@ -681,15 +803,418 @@ static inline void sb_add_carry_2(sb_word_t h[static const restrict 1],
     *l = (sb_word_t) r;
 }
 
+// Double-width multiplication: t = x * y, where t is 2 * SB_FE_WORDS words
+// long. This is used with the prime-specific reduction methods, which operate
+// on the full product, and by sb_fe_mult_shift_round.
+static void sb_fe_mult_wide(sb_word_t t[static const restrict 2 * SB_FE_WORDS],
+                            const sb_fe_t x[static const restrict 1],
+                            const sb_fe_t y[static const restrict 1])
+{
+#if SB_USE_X86_64_ASM
+
+    // See sb_fe_mont_mult for a description of the MULX/ADCX/ADOX technique.
+    // Each row adds x_i * y to a window of five words (a_0, ..., a_4) of t,
+    // where a_4 is zero on entry; afterwards, a_0 is final and is stored, and
+    // its register is cleared to become a_4 of the next row. The row's
+    // product fits in the window, so the final carries into a_4 do not
+    // overflow.
+
+    sb_word_t r0 = 0, r1 = 0, r2 = 0, r3 = 0, r4 = 0, lo, hi;
+
+#define MW_X86_MULADD(s, a_j, a_j1) \
+    "mulxq " s ", %[lo], %[hi]\n\t" \
+    "adcxq %[lo], " a_j "\n\t" \
+    "adoxq %[hi], " a_j1 "\n\t"
+
+#define MW_X86_ROW(i, a_0, a_1, a_2, a_3, a_4) \
+    "movq  " i "(%[x]), %%rdx\n\t" \
+    "xorl  %k[lo], %k[lo]\n\t" \
+    MW_X86_MULADD("0(%[y])", a_0, a_1) \
+    MW_X86_MULADD("8(%[y])", a_1, a_2) \
+    MW_X86_MULADD("16(%[y])", a_2, a_3) \
+    MW_X86_MULADD("24(%[y])", a_3, a_4) \
+    "movl  $0, %k[hi]\n\t" \
+    "adcxq %[hi], " a_4 "\n\t" \
+    "movq  " a_0 ", " i "(%[t])\n\t" \
+    "xorq  " a_0 ", " a_0 "\n\t"
+
+    __asm(MW_X86_ROW("0", "%[r0]", "%[r1]", "%[r2]", "%[r3]", "%[r4]")
+          MW_X86_ROW("8", "%[r1]", "%[r2]", "%[r3]", "%[r4]", "%[r0]")
+          MW_X86_ROW("16", "%[r2]", "%[r3]", "%[r4]", "%[r0]", "%[r1]")
+          MW_X86_ROW("24", "%[r3]", "%[r4]", "%[r0]", "%[r1]", "%[r2]")
+          : [r0] "+&r" (r0), [r1] "+&r" (r1), [r2] "+&r" (r2),
+            [r3] "+&r" (r3), [r4] "+&r" (r4),
+            [lo] "=&r" (lo), [hi] "=&r" (hi)
+          : [x] "r" (x), [y] "r" (y), [t] "r" (t)
+          : "rdx", "cc", "memory");
+
+#undef MW_X86_ROW
+#undef MW_X86_MULADD
+
+    // After four rotations, the high half of t is in (r2, r1, r0, r4)
+    t[4] = r4;
+    t[5] = r0;
+    t[6] = r1;
+    t[7] = r2;
+
+#else
+
+    // The first row is computed separately, as t is initially 0. As in
+    // sb_fe_square_wide, each product is stored through a local word.
+    sb_word_t c = 0;
+    SB_UNROLL_1(j, 0, {
+        sb_word_t l;
+        sb_mult_add_add(&c, &l, SB_FE_WORD(x, 0), SB_FE_WORD(y, j), 0, c);
+        t[j] = l;
+    });
+    t[SB_FE_WORDS] = c;
+    SB_UNROLL_2(i, 1, { // for i from 1 to (n - 1)
+        const sb_word_t x_i = SB_FE_WORD(x, i);
+        c = 0;
+        SB_UNROLL_1(j, 0, {
+            // t = t + x_i * y * b^i
+            sb_word_t l;
+            sb_mult_add_add(&c, &l, x_i, SB_FE_WORD(y, j), t[i + j], c);
+            t[i + j] = l;
+        });
+        t[i + SB_FE_WORDS] = c;
+    });
+
+#endif
+}
+
+void sb_fe_mult_shift_round(sb_fe_t dest[static const restrict 1],
+                            const sb_fe_t left[static const restrict 1],
+                            const sb_fe_t right[static const restrict 1],
+                            const sb_bitcount_t shift)
+{
+    SB_ASSERT(shift > SB_FE_BITS && shift < 2 * SB_FE_BITS,
+              "shift must be between SB_FE_BITS and 2 * SB_FE_BITS");
+
+    sb_word_t t[2 * SB_FE_WORDS];
+    sb_fe_mult_wide(t, left, right);
+
+    // Only the word and bit offsets of the shift, which is public, determine
+    // which words are read.
+    const sb_wordcount_t w = shift >> SB_WORD_BITS_SHIFT;
+    const sb_bitcount_t b = shift & SB_WORD_BITS_MASK;
+
+    // The result is rounded by adding the highest bit shifted out.
+    sb_word_t c = (sb_word_t) ((t[(shift - 1) >> SB_WORD_BITS_SHIFT] >>
+                                ((shift - 1) & SB_WORD_BITS_MASK)) & 1);
+
+    for (sb_wordcount_t i = 0; i < SB_FE_WORDS; i++) {
+        const sb_word_t lo = (w + i < 2 * SB_FE_WORDS) ? t[w + i] : 0;
+        const sb_word_t hi = (w + i + 1 < 2 * SB_FE_WORDS) ? t[w + i + 1] : 0;
+        const sb_word_t r = b ? (sb_word_t) ((lo >> b) |
+                                             (hi << (SB_WORD_BITS - b))) : lo;
+        sb_add_carry_2(&c, &SB_FE_WORD(dest, i), r, c, 0);
+    }
+}
+
+#if SB_FE_FAST_REDUCTION
+
+// The prime-specific reduction methods are defined in terms of 32-bit words,
+// regardless of the word size used for multiplication. These helpers load
+// and store 32-bit word i of a double-width value or a field element.
+
+#define SB_WORDS_PER_32 ((sb_wordcount_t) (4 / SB_MUL_SIZE))
+
+static inline uint32_t sb_wide_get_32(const sb_word_t t[static const 2 * SB_FE_WORDS],
+                                      const sb_wordcount_t i)
+{
+#if SB_MUL_SIZE == 8
+    return (uint32_t) (t[i >> 1] >> ((i & 1) * 32));
+#else
+    uint32_t r = 0;
+    for (sb_wordcount_t j = 0; j < SB_WORDS_PER_32; j++) {
+        r |= (uint32_t) t[i * SB_WORDS_PER_32 + j] << (j * SB_WORD_BITS);
+    }
+    return r;
+#endif
+}
+
+static inline void sb_fe_set_32(sb_fe_t dest[static const 1],
+                                const sb_wordcount_t i,
+                                const uint32_t v)
+{
+#if SB_MUL_SIZE == 8
+    // Words must be stored in ascending order
+    if (i & 1) {
+        SB_FE_WORD(dest, i >> 1) |= (sb_word_t) v << 32;
+    } else {
+        SB_FE_WORD(dest, i >> 1) = v;
+    }
+#else
+    for (sb_wordcount_t j = 0; j < SB_WORDS_PER_32; j++) {
+        SB_FE_WORD(dest, i * SB_WORDS_PER_32 + j) =
+            (sb_word_t) (v >> (j * SB_WORD_BITS));
+    }
+#endif
+}
+
+// The reduction methods accumulate signed sums of 32-bit words. These sums
+// are computed with unsigned 64-bit arithmetic, which is two's complement
+// arithmetic modulo 2^64; the carry into the next word is the accumulated sum
+// shifted right by 32 bits, with the sign bit extended.
+static inline uint64_t sb_carry_32(const uint64_t acc)
+{
+    return (acc >> 32) | ((uint64_t) -(acc >> 63) << 32);
+}
+
+#if SB_FE_P256_FAST_REDUCTION
+
+// Given a value d in [0, 2^256) with d congruent to the desired result,
+// produce the quasi-reduced result in [1, p]. As 2^256 < 2 * p for the primes
+// with fast reduction methods, the result is d - p if d > p, p if d is zero,
+// and d otherwise. d > p exactly when d - p does not borrow and is nonzero.
+static void sb_fe_fast_qr(sb_fe_t dest[static const restrict 1],
+                          const sb_prime_field_t p[static const restrict 1])
+{
+    sb_fe_t d_p;
+    const sb_word_t b = sb_fe_sub_borrow(&d_p, dest, &p->p, 0);
+    const sb_word_t gt = (b ^ (sb_word_t) 1) &
+                         (sb_fe_equal(&d_p, &SB_FE_ZERO) ^ (sb_word_t) 1);
+    const sb_word_t z = sb_fe_equal(dest, &SB_FE_ZERO);
+    SB_UNROLL_3(i, 0, {
+        SB_FE_WORD(dest, i) =
+            sb_ctc_word(gt, sb_ctc_word(z, SB_FE_WORD(dest, i),
+                                        SB_FE_WORD(&p->p, i)),
+                        SB_FE_WORD(&d_p, i));
+    });
+    SB_ASSERT(sb_fe_equal(dest, &p->p) || sb_fe_lt(dest, &p->p),
+              "fast reduction must always produce quasi-reduced output");
+    SB_ASSERT(!sb_fe_equal(dest, &SB_FE_ZERO),
+              "fast reduction must always produce quasi-reduced output");
+}
+
+// Fast reduction modulo the P-256 prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1,
+// as described in FIPS 186-4, section D.2.3. Given the 512-bit value t as
+// 32-bit words (c_15, ..., c_0), dest = T + 2 S1 + 2 S2 + S3 + S4 - D1 - D2
+// - D3 - D4 mod p, where:
+//  T = ( c_7,  c_6,  c_5,  c_4,  c_3,  c_2,  c_1,  c_0)
+// S1 = (c_15, c_14, c_13, c_12, c_11,    0,    0,    0)
+// S2 = (   0, c_15, c_14, c_13, c_12,    0,    0,    0)
+// S3 = (c_15, c_14,    0,    0,    0, c_10,  c_9,  c_8)
+// S4 = ( c_8, c_13, c_15, c_14, c_13, c_11, c_10,  c_9)
+// D1 = (c_10,  c_8,    0,    0,    0, c_13, c_12, c_11)
+// D2 = (c_11,  c_9,    0,    0, c_15, c_14, c_13, c_12)
+// D3 = (c_12,    0, c_10,  c_9,  c_8, c_15, c_14, c_13)
+// D4 = (c_13,    0, c_11, c_10,  c_9,    0, c_15, c_14)
+// Rather than computing each of these terms, the sum is computed one 32-bit
+// word at a time, which leaves a signed carry out of the top word in
+// [-4, 6]. The carry is folded back into the low words using
+// 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p; this is done a second time to fold
+// in the carry (-1, 0, or 1) out of the first fold. The result is then in
+// [0, 2^256) and a final conditional subtraction is performed.
+static void sb_fe_p256_reduce_wide(sb_fe_t dest[static const restrict 1],
+                                   const sb_word_t t[static const restrict 2 *
+                                                     SB_FE_WORDS],
+                                   const sb_prime_field_t p[static const restrict 1])
+{
+    uint64_t c[16];
+    for (sb_wordcount_t i = 0; i < 16; i++) {
+        c[i] = sb_wide_get_32(t, i);
+    }
+
+    uint64_t r[8], acc = 0;
+
+#define SB_P256_WORD(i, e) do { \
+    acc = sb_carry_32(acc) + (e); \
+    r[i] = (uint32_t) acc; \
+} while (0)
+
+    SB_P256_WORD(0, c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14]);
+    SB_P256_WORD(1, c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15]);
+    SB_P256_WORD(2, c[2] + c[10] + c[11] - c[13] - c[14] - c[15]);
+    SB_P256_WORD(3, c[3] + 2 * c[11] + 2 * c[12] + c[13] - c[15] - c[8] -
+                    c[9]);
+    SB_P256_WORD(4, c[4] + 2 * c[12] + 2 * c[13] + c[14] - c[9] - c[10]);
+    SB_P256_WORD(5, c[5] + 2 * c[13] + 2 * c[14] + c[15] - c[10] - c[11]);
+    SB_P256_WORD(6, c[6] + 3 * c[14] + 2 * c[15] + c[13] - c[8] - c[9]);
+    SB_P256_WORD(7, c[7] + 3 * c[15] + c[8] - c[10] - c[11] - c[12] - c[13]);
+
+    for (size_t f = 0; f < 2; f++) {
+        // k is the signed carry out of the top word
+        const uint64_t k = sb_carry_32(acc);
+        acc = 0;
+        SB_P256_WORD(0, r[0] + k);
+        SB_P256_WORD(1, r[1]);
+        SB_P256_WORD(2, r[2]);
+        SB_P256_WORD(3, r[3] - k);
+        SB_P256_WORD(4, r[4]);
+        SB_P256_WORD(5, r[5]);
+        SB_P256_WORD(6, r[6] - k);
+        SB_P256_WORD(7, r[7] + k);
+    }
+
+#undef SB_P256_WORD
+
+    SB_ASSERT(sb_carry_32(acc) == 0,
+              "two folds of the carry must produce a 256-bit value");
+
+    for (sb_wordcount_t i = 0; i < 8; i++) {
+        sb_fe_set_32(dest, i, (uint32_t) r[i]);
+    }
+
+    sb_fe_fast_qr(dest, p);
+}
+
+#endif
+
+#if SB_FE_SECP256K1_FAST_REDUCTION
+
+// Reduction modulo the secp256k1 prime p = 2^256 - 2^32 - 977 uses
+// 2^256 = c mod p, where c = 2^32 + 977 = 0x1000003D1. Given t = h * 2^256 + l,
+// t = l + h * c mod p; this fold is repeated until the result fits in 256
+// bits. c occupies the following number of words:
+#define SB_SECP256K1_C_WORDS \
+    ((sb_wordcount_t) ((33 + SB_MUL_SIZE * 8 - 1) / (SB_MUL_SIZE * 8)))
+
+static const sb_fe_t SB_SECP256K1_C = SB_FE_CONST(0, 0, 0, 0x1000003D1);
+static const sb_fe_t SB_SECP256K1_2C = SB_FE_CONST(0, 0, 0, 0x2000007A2);
+
+// Three folds are needed. After the first, the high part h of the result is
+// less than 2^34, so h * c is less than 2^67 and the second fold is a single
+// addition, whose carry is 0 or 1. If this carry is 1, the low part is less
+// than 2^67, and adding c in the third fold cannot carry out of 256 bits.
+// Because p = 2^256 - c, the third fold also computes y - p, where y is the
+// result of the fold: y - p = y + c mod 2^256, and y >= p exactly when this
+// addition carries out. The quasi-reduced result is y - p if y > p, p if y is
+// zero, and y otherwise.
+static void sb_fe_secp256k1_reduce_wide(sb_fe_t dest[static const restrict 1],
+                                        const sb_word_t t[static const restrict
+                                                          2 * SB_FE_WORDS],
+                                        const sb_prime_field_t p[static const
+                                                                 restrict 1])
+{
+    sb_word_t r[SB_FE_WORDS + SB_SECP256K1_C_WORDS];
+    sb_word_t s[2 * SB_SECP256K1_C_WORDS] = { 0 };
+    sb_fe_t e;
+
+    // r = l + h * c, computed one row for each word of c. As in
+    // sb_fe_mult_wide, each word is computed into a local and then stored.
+    for (sb_wordcount_t j = 0; j < SB_SECP256K1_C_WORDS; j++) {
+        const sb_word_t c_j = SB_FE_WORD(&SB_SECP256K1_C, j);
+        sb_word_t c = 0;
+        SB_UNROLL_1(i, 0, {
+            // The first row adds l; the top word of each row is written
+            // as the carry of that row
+            const sb_word_t r_ij = (j == 0) ? t[i] : r[i + j];
+            sb_word_t l;
+            sb_mult_add_add(&c, &l, t[SB_FE_WORDS + i], c_j, r_ij, c);
+            r[i + j] = l;
+        });
+        r[SB_FE_WORDS + j] = c;
+    }
+
+    // s = h * c, where h is the top SB_SECP256K1_C_WORDS words of r
+    for (sb_wordcount_t j = 0; j < SB_SECP256K1_C_WORDS; j++) {
+        const sb_word_t c_j = SB_FE_WORD(&SB_SECP256K1_C, j);
+        sb_word_t c = 0;
+        for (sb_wordcount_t i = 0; i < SB_SECP256K1_C_WORDS; i++) {
+            sb_word_t l;
+            sb_mult_add_add(&c, &l, r[SB_FE_WORDS + i], c_j, s[i + j], c);
+            s[i + j] = l;
+        }
+        s[SB_SECP256K1_C_WORDS + j] = c;
+    }
+
+    // r = l + s, with carry out h
+    sb_word_t h = 0;
+    SB_UNROLL_1(i, 0, {
+        const sb_word_t s_i = (i < 2 * SB_SECP256K1_C_WORDS) ? s[i] : 0;
+        sb_word_t l;
+        sb_add_carry_2(&h, &l, r[i], s_i, h);
+        r[i] = l;
+    });
+
+    // dest = y = r + h * c, and e = r + (h + 1) * c = y - p mod 2^256
+    sb_word_t cy = 0, ce = 0, y_nz = 0, e_nz = 0;
+    SB_UNROLL_1(i, 0, {
+        const sb_word_t hc_i = sb_ctc_word(h, 0, SB_FE_WORD(&SB_SECP256K1_C, i));
+        const sb_word_t h1c_i = sb_ctc_word(h, SB_FE_WORD(&SB_SECP256K1_C, i),
+                                            SB_FE_WORD(&SB_SECP256K1_2C, i));
+        sb_word_t y_i, e_i;
+        sb_add_carry_2(&cy, &y_i, r[i], hc_i, cy);
+        sb_add_carry_2(&ce, &e_i, r[i], h1c_i, ce);
+        SB_FE_WORD(dest, i) = y_i;
+        SB_FE_WORD(&e, i) = e_i;
+        y_nz |= y_i;
+        e_nz |= e_i;
+    });
+    SB_ASSERT(cy == 0, "three folds must produce a 256-bit value");
+
+    // gt is 1 if y > p: y - p does not borrow, and is nonzero
+    // z is 1 if y is zero
+    // See sb_fe_equal for the conversion of a nonzero word to 1
+    const sb_word_t gt =
+        ce & (sb_word_t) ((e_nz | (sb_word_t) -e_nz) >> (SB_WORD_BITS - 1));
+    const sb_word_t z =
+        (sb_word_t) ((y_nz | (sb_word_t) -y_nz) >> (SB_WORD_BITS - 1)) ^
+        (sb_word_t) 1;
+    SB_UNROLL_1(i, 0, {
+        SB_FE_WORD(dest, i) =
+            sb_ctc_word(gt, sb_ctc_word(z, SB_FE_WORD(dest, i),
+                                        SB_FE_WORD(&p->p, i)),
+                        SB_FE_WORD(&e, i));
+    });
+    SB_ASSERT(sb_fe_equal(dest, &p->p) || sb_fe_lt(dest, &p->p),
+              "fast reduction must always produce quasi-reduced output");
+    SB_ASSERT(!sb_fe_equal(dest, &SB_FE_ZERO),
+              "fast reduction must always produce quasi-reduced output");
+}
+
+#endif
+
+// Reduce t mod p using the field's prime-specific reduction method
+static SB_FE_INLINE void
+sb_fe_fast_reduce_wide(sb_fe_t dest[static const restrict 1],
+                       const sb_word_t t[static const restrict 2 * SB_FE_WORDS],
+                       const sb_prime_field_t p[static const restrict 1])
+{
+    switch (p->reduction) {
+#if SB_FE_P256_FAST_REDUCTION
+        case SB_FE_REDUCTION_P256:
+            sb_fe_p256_reduce_wide(dest, t, p);
+            break;
+#endif
+#if SB_FE_SECP256K1_FAST_REDUCTION
+        case SB_FE_REDUCTION_SECP256K1:
+            sb_fe_secp256k1_reduce_wide(dest, t, p);
+            break;
+#endif
+        default:
+            // dest is still written, so that every path defines it
+            SB_ASSERT(0, "unknown field reduction method");
+            *dest = p->p;
+            break;
+    }
+}
+
+#endif
+
 // Montgomery multiplication: given x, y, p produces x * y * R^-1 mod p where
 // R = 2^256 mod p. See the _Handbook of Applied Cryptography_ by Menezes,
 // van Oorschot, and Vanstone, chapter 14, section 14.3.2:
 // http://cacr.uwaterloo.ca/hac/about/chap14.pdf
-void sb_fe_mont_mult(sb_fe_t A[static const restrict 1],
+// If the field uses a prime-specific reduction method, R is 1, and this is
+// ordinary modular multiplication.
+static SB_FE_INLINE void
+sb_fe_mont_mult_impl(sb_fe_t A[static const restrict 1],
                      const sb_fe_t x[static const 1],
                      const sb_fe_t y[static const 1],
                      const sb_prime_field_t p[static const 1])
 {
+#if SB_FE_FAST_REDUCTION
+    if (p->reduction != SB_FE_REDUCTION_MONTGOMERY) {
+        sb_word_t t[SB_FE_WORDS * 2];
+        sb_fe_mult_wide(t, x, y);
+        sb_fe_fast_reduce_wide(A, t, p);
+        return;
+    }
+#endif
+
 #if SB_USE_ARM_DSP_ASM && SB_UNROLL > 0
 
     // If SB_UNROLL is 3, then the outer multiplication loop is fully unrolled.
@@ -822,6 +1347,79 @@ void sb_fe_mont_mult(sb_fe_t A[static const restrict 1],
       "m" (*x), "m" (*y), "m" (*p) :
     "r4", "r5", "r6", "r7", "cc");
 
+#elif SB_USE_X86_64_ASM
+
+    // The accumulator A is held in six registers; rather than moving A one
+    // word to the right on each iteration to divide by b, the roles of the
+    // registers are rotated from one iteration to the next. After the
+    // reduction step of each iteration, the low word of A is zero, and that
+    // register becomes the new high word.
+
+    sb_word_t r0 = 0, r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0, lo, hi;
+
+    // MM_X86_MULADD(s, a_j, a_j1) adds the double-word product of rdx and the
+    // memory operand s to (a_j1, a_j), with the low word accumulated through
+    // CF and the high word accumulated through OF:
+    // (hi, lo) = rdx * s
+    // (CF, a_j) = a_j + lo + CF
+    // (OF, a_j1) = a_j1 + hi + OF
+
+#define MM_X86_MULADD(s, a_j, a_j1) \
+    "mulxq " s ", %[lo], %[hi]\n\t" \
+    "adcxq %[lo], " a_j "\n\t" \
+    "adoxq %[hi], " a_j1 "\n\t"
+
+    // MM_X86_ROW(s, a_0, ..., a_5) adds rdx * s to A, where s is y or p. XOR
+    // is used to clear CF and OF before the row; MOV does not affect flags,
+    // so hi is used as a zero register to collect the final carries.
+    // Pseudocode:
+    // CF = OF = 0
+    // for j from 0 to 3: MM_X86_MULADD(s[j], a_j, a_(j + 1))
+    // (CF, a_4) = a_4 + CF
+    // a_5 = a_5 + OF + CF
+
+#define MM_X86_ROW(s, a_0, a_1, a_2, a_3, a_4, a_5) \
+    "xorl  %k[lo], %k[lo]\n\t" \
+    MM_X86_MULADD("0(" s ")", a_0, a_1) \
+    MM_X86_MULADD("8(" s ")", a_1, a_2) \
+    MM_X86_MULADD("16(" s ")", a_2, a_3) \
+    MM_X86_MULADD("24(" s ")", a_3, a_4) \
+    "movl  $0, %k[hi]\n\t" \
+    "adcxq %[hi], " a_4 "\n\t" \
+    "adoxq %[hi], " a_5 "\n\t" \
+    "adcxq %[hi], " a_5 "\n\t"
+
+    // Pseudocode for MM_X86_ITER(i, a_0, ..., a_5) where i is in bytes:
+    // rdx = x[i]
+    // A = A + x_i * y
+    // rdx = u_i = a_0 * p->mp
+    // A = A + u_i * p, after which a_0 is zero
+
+#define MM_X86_ITER(i, a_0, a_1, a_2, a_3, a_4, a_5) \
+    "movq  " i "(%[x]), %%rdx\n\t" \
+    MM_X86_ROW("%[y]", a_0, a_1, a_2, a_3, a_4, a_5) \
+    "movq  " a_0 ", %%rdx\n\t" \
+    "imulq %[mp], %%rdx\n\t" \
+    MM_X86_ROW("%[p]", a_0, a_1, a_2, a_3, a_4, a_5)
+
+    __asm(MM_X86_ITER("0", "%[r0]", "%[r1]", "%[r2]", "%[r3]", "%[r4]", "%[r5]")
+          MM_X86_ITER("8", "%[r1]", "%[r2]", "%[r3]", "%[r4]", "%[r5]", "%[r0]")
+          MM_X86_ITER("16", "%[r2]", "%[r3]", "%[r4]", "%[r5]", "%[r0]", "%[r1]")
+          MM_X86_ITER("24", "%[r3]", "%[r4]", "%[r5]", "%[r0]", "%[r1]", "%[r2]")
+          : [r0] "+&r" (r0), [r1] "+&r" (r1), [r2] "+&r" (r2),
+            [r3] "+&r" (r3), [r4] "+&r" (r4), [r5] "+&r" (r5),
+            [lo] "=&r" (lo), [hi] "=&r" (hi)
+          : [x] "r" (x), [y] "r" (y), [p] "r" (p), [mp] "m" (p->p_mp)
+          : "rdx", "cc", "memory");
+
+    // After four rotations, A is in (r1, r0, r5, r4) and the carry is in r2
+    SB_FE_WORD(A, 0) = r4;
+    SB_FE_WORD(A, 1) = r5;
+    SB_FE_WORD(A, 2) = r0;
+    SB_FE_WORD(A, 3) = r1;
+    const sb_word_t hw = r2;
+    SB_ASSERT(hw < 2, "W + W * W + W * W overflows at most once");
+
 #else
 
     sb_word_t hw = 0;
@@ -863,15 +1461,156 @@ void sb_fe_mont_mult(sb_fe_t A[static const restrict 1],
 
     // If A > p or hw is set, A = A - p
 
-    sb_fe_qr(A, hw, p);
+    sb_fe_qr_impl(A, hw, p);
+}
+
+void sb_fe_mont_mult(sb_fe_t A[static const restrict 1],
+                     const sb_fe_t x[static const 1],
+                     const sb_fe_t y[static const 1],
+                     const sb_prime_field_t p[static const 1])
+{
+    SB_FE_DISPATCH(p, sb_fe_mont_mult, A, x, y);
+    sb_fe_mont_mult_impl(A, x, y, p);
 }
 
+#if !SB_USE_X86_64_ASM || SB_FE_FAST_REDUCTION
+
+// Double-width squaring: t = x * x, where t is 2 * SB_FE_WORDS words long.
+// Each off-diagonal product x_i * x_j (i < j) appears twice in the square, so
+// these products are computed once, and their sum is doubled as the diagonal
+// products x_i * x_i are added in. This saves n * (n - 1) / 2 of the n^2 word
+// multiplications needed by sb_fe_mont_mult.
+static void
+sb_fe_square_wide(sb_word_t t[static const restrict 2 * SB_FE_WORDS],
+                  const sb_fe_t x[static const restrict 1])
+{
+    // t = sum of x_i * x_j * b^(i + j) for i < j
+    // The first row is computed separately, as t is initially 0. The top word
+    // is written by the last row, as the carry out of an empty row.
+    // Each product is accumulated into a local word and then stored, rather
+    // than written through a pointer into t, so that the compiler can see
+    // that the stores of the guarded unrolled copies stay within t.
+    sb_word_t c = 0;
+    t[0] = 0;
+    SB_UNROLL_1(j, 1, {
+        sb_word_t l;
+        sb_mult_add_add(&c, &l, SB_FE_WORD(x, 0), SB_FE_WORD(x, j), 0, c);
+        t[j] = l;
+    });
+    t[SB_FE_WORDS] = c;
+    SB_UNROLL_2(i, 1, {
+        const sb_word_t x_i = SB_FE_WORD(x, i);
+        c = 0;
+        SB_UNROLL_1(j, i + 1, {
+            sb_word_t l;
+            sb_mult_add_add(&c, &l, x_i, SB_FE_WORD(x, j), t[i + j], c);
+            t[i + j] = l;
+        });
+        t[i + SB_FE_WORDS] = c;
+    });
+
+    // t = 2 * t + sum of x_i * x_i * b^(2 * i)
+    // c is the carry out of the addition; s is the bit shifted out of t
+    sb_word_t s = 0;
+    c = 0;
+    SB_UNROLL_1(i, 0, {
+        const sb_word_t x_i = SB_FE_WORD(x, i);
+        const sb_word_t t_0 = t[i * 2], t_1 = t[i * 2 + 1];
+        sb_word_t h, l;
+
+        // (h, t_2i) = x_i * x_i + 2 * t_2i + c, where the shift of t_2i
+        // receives the bit shifted out of the previous word
+        sb_mult_add_add(&h, &l, x_i, x_i,
+                        (sb_word_t) ((sb_word_t) (t_0 << 1) | s), c);
+        t[i * 2] = l;
+        s = (sb_word_t) (t_0 >> (SB_WORD_BITS - 1));
+
+        // (c, t_2i+1) = 2 * t_2i+1 + h
+        sb_add_carry_2(&c, &l, (sb_word_t) ((sb_word_t) (t_1 << 1) | s), h, 0);
+        t[i * 2 + 1] = l;
+        s = (sb_word_t) (t_1 >> (SB_WORD_BITS - 1));
+    });
+    SB_ASSERT(c == 0 && s == 0,
+              "the square of an n-word value fits in 2n words");
+}
+
+#endif
+
+#if !SB_USE_X86_64_ASM
+
+// Montgomery reduction of a double-width value: dest = t * R^-1 mod p, where
+// t is 2 * SB_FE_WORDS words long and less than p * R. This is the reduction
+// step of HAC algorithm 14.32, which separates the multiplication and
+// reduction steps that are interleaved in sb_fe_mont_mult. t is destroyed.
+static SB_FE_INLINE void
+sb_fe_mont_reduce_wide(sb_fe_t dest[static const restrict 1],
+                       sb_word_t t[static const restrict 2 * SB_FE_WORDS],
+                       const sb_prime_field_t p[static const restrict 1])
+{
+    sb_word_t hw = 0;
+
+    SB_UNROLL_2(i, 0, { // for i from 0 to (n - 1)
+        // u_i = t_i m' mod b
+        const sb_word_t u_i = (sb_word_t) (t[i] * ((sb_dword_t) p->p_mp));
+        sb_word_t c = 0;
+
+        // t = t + u_i * m * b^i, stored through a local word as in
+        // sb_fe_square_wide
+        SB_UNROLL_1(j, 0, {
+            sb_word_t l;
+            sb_mult_add_add(&c, &l, u_i, SB_FE_WORD(&p->p, j), t[i + j], c);
+            t[i + j] = l;
+        });
+
+        // The carry out of the top word of this round is propagated into the
+        // next round's top word
+        sb_word_t l;
+        sb_add_carry_2(&hw, &l, t[i + SB_FE_WORDS], c, hw);
+        t[i + SB_FE_WORDS] = l;
+    });
+
+    // dest = t / R
+    SB_UNROLL_3(i, 0, { SB_FE_WORD(dest, i) = t[i + SB_FE_WORDS]; });
+    SB_ASSERT(hw < 2, "Montgomery reduction overflows at most once");
+
+    sb_fe_qr_impl(dest, hw, p);
+}
+
+#endif
+
 // Montgomery squaring: dest = left * left * R^-1 mod p
+static SB_FE_INLINE void
+sb_fe_mont_square_impl(sb_fe_t dest[static const restrict 1],
+                       const sb_fe_t left[static const 1],
+                       const sb_prime_field_t p[static const 1])
+{
+    sb_word_t t[SB_FE_WORDS * 2];
+
+#if SB_FE_FAST_REDUCTION
+    if (p->reduction != SB_FE_REDUCTION_MONTGOMERY) {
+        sb_fe_square_wide(t, left);
+        sb_fe_fast_reduce_wide(dest, t, p);
+        return;
+    }
+#endif
+
+#if SB_USE_X86_64_ASM
+    // The x86-64 multiplication routine is faster than the portable squaring
+    // routine, so it is used for squaring as well.
+    (void) t;
+    sb_fe_mont_mult_impl(dest, left, left, p);
+#else
+    sb_fe_square_wide(t, left);
+    sb_fe_mont_reduce_wide(dest, t, p);
+#endif
+}
+
 void sb_fe_mont_square(sb_fe_t dest[static const restrict 1],
                        const sb_fe_t left[static const 1],
                        const sb_prime_field_t p[static const 1])
 {
-    sb_fe_mont_mult(dest, left, left, p);
+    SB_FE_DISPATCH(p, sb_fe_mont_square, dest, left);
+    sb_fe_mont_square_impl(dest, left, p);
 }
 
 // Montgomery reduction: dest = left * R^-1 mod p, implemented by Montgomery
@@ -883,6 +1622,63 @@ void sb_fe_mont_reduce(sb_fe_t dest[static const restrict 1],
     sb_fe_mont_mult(dest, left, &SB_FE_ONE, p);
 }
 
+// SB_FE_DEFINE_FIELD(name, field) defines the instances of the field routines
+// for the field structure field, which must be a constant. If
+// SB_FE_SPECIALIZE is 0, the instances call the generic routines instead.
+#if SB_FE_SPECIALIZE
+#define SB_FE_INSTANCE(f) f##_impl
+#else
+#define SB_FE_INSTANCE(f) f
+#endif
+
+#define SB_FE_DEFINE_FIELD(name, field) \
+void sb_fe_mod_sub_##name(sb_fe_t dest[static const 1], \
+                          const sb_fe_t left[static const 1], \
+                          const sb_fe_t right[static const 1]) \
+{ \
+    SB_FE_INSTANCE(sb_fe_mod_sub)(dest, left, right, &(field)); \
+} \
+void sb_fe_mod_add_##name(sb_fe_t dest[static const 1], \
+                          const sb_fe_t left[static const 1], \
+                          const sb_fe_t right[static const 1]) \
+{ \
+    SB_FE_INSTANCE(sb_fe_mod_add)(dest, left, right, &(field)); \
+} \
+void sb_fe_mod_double_##name(sb_fe_t dest[static const 1], \
+                             const sb_fe_t left[static const 1]) \
+{ \
+    SB_FE_INSTANCE(sb_fe_mod_add)(dest, left, left, &(field)); \
+} \
+void sb_fe_mont_mult_##name(sb_fe_t dest[static const restrict 1], \
+                            const sb_fe_t left[static const 1], \
+                            const sb_fe_t right[static const 1]) \
+{ \
+    SB_FE_INSTANCE(sb_fe_mont_mult)(dest, left, right, &(field)); \
+} \
+void sb_fe_mont_square_##name(sb_fe_t dest[static const restrict 1], \
+                              const sb_fe_t left[static const 1]) \
+{ \
+    SB_FE_INSTANCE(sb_fe_mont_square)(dest, left, &(field)); \
+}
+
+#if SB_SW_P256_SUPPORT
+#if SB_FE_P256_FAST_REDUCTION
+SB_FE_DEFINE_FIELD(p256, SB_CURVE_P256_P_FAST)
+#else
+SB_FE_DEFINE_FIELD(p256, SB_CURVE_P256_P)
+#endif
+#endif
+
+#if SB_SW_SECP256K1_SUPPORT
+#if SB_FE_SECP256K1_FAST_REDUCTION
+SB_FE_DEFINE_FIELD(secp256k1, SB_CURVE_SECP256K1_P_FAST)
+#else
+SB_FE_DEFINE_FIELD(secp256k1, SB_CURVE_SECP256K1_P)
+#endif
+#endif
+
+SB_FE_DEFINE_FIELD(x25519, SB_CURVE_X25519_P)
+
 #ifdef SB_TEST
 
 _Bool sb_test_mont_mult(void)
@@ -935,6 +1731,31 @@ _Bool sb_test_mont_mult(void)
     sb_fe_mont_mult(&t, &SB_CURVE_P256_P.p, &a5,
                     &SB_CURVE_P256_P);
     SB_TEST_ASSERT(sb_fe_equal(&t, &SB_CURVE_P256_P.p));
+
+    // Squaring must produce the same results as multiplication, including
+    // for p itself (that is, zero) and the largest reduced value p - 1
+    sb_fe_mont_square(&t, &SB_CURVE_P256_P.p, &SB_CURVE_P256_P);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &SB_CURVE_P256_P.p));
+
+    const sb_prime_field_t* const fields[2] = { &SB_CURVE_P256_P,
+                                                &SB_CURVE_P256_N };
+    for (size_t f = 0; f < 2; f++) {
+        const sb_prime_field_t* const p = fields[f];
+        sb_fe_t s = p->p;
+        sb_fe_sub(&s, &s, &SB_FE_ONE);
+        for (size_t i = 0; i < 256; i++) {
+            sb_fe_mont_square(&t, &s, p);
+            sb_fe_mont_mult(&t2, &s, &s, p);
+            SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+            // alternate between squaring the previous result and a value
+            // with most bits set
+            if (i & 1) {
+                s = t;
+            } else {
+                sb_fe_mod_sub(&s, &a5, &t, p);
+            }
+        }
+    }
     return 1;
 }
 
@@ -952,11 +1773,13 @@ void sb_fe_ctswap(const sb_word_t a,
     }
 }
 
+#if !SB_FE_SAFEGCD_INVERSION || defined(SB_TEST)
+
 // x = x^e mod m
 
 // Modular exponentation is NOT constant time with respect to the exponent;
-// this procedure is used ONLY for inversion (and possibly square roots in
-// the future) and the exponents are determined by the prime in this case.
+// this procedure is used ONLY for inversion and the exponents are determined
+// by the prime in this case.
 // It is assumed that performance may differ with respect to the curve, but
 // not with respect to the inputs.
 
@@ -988,14 +1811,505 @@ sb_fe_mod_expt_r(sb_fe_t x[static const restrict 1],
     *x = *t2;
 }
 
-// See sb_prime_field_t in sb_fe.h for more comments on modular inversion.
+#endif
+
+// a = a^(2^n) * m, using t as a temporary
+static void
+sb_fe_mod_expt_step_r(sb_fe_t a[static const restrict 1],
+                      sb_fe_t t[static const restrict 1],
+                      const sb_bitcount_t n,
+                      const sb_fe_t m[static const restrict 1],
+                      const sb_prime_field_t p[static const restrict 1])
+{
+    for (sb_bitcount_t i = 1; i < n; i += 2) {
+        sb_fe_mont_square(t, a, p);
+        sb_fe_mont_square(a, t, p);
+    }
+    if (n & 1) {
+        sb_fe_mont_square(t, a, p);
+        sb_fe_mont_mult(a, t, m, p);
+    } else {
+        sb_fe_mont_mult(t, a, m, p);
+        *a = *t;
+    }
+}
+
+// Exponentiation using an addition chain, raising x to the power e >> shift,
+// where e has the same number of bits as p. This is used for inversion, with
+// e = p - 2, and for square roots, with e = p + 1 and a shift of 2; in both
+// cases, the exponent must begin with at least inv_run one bits. x holds the
+// base and is left unmodified; the result is placed in a. w holds
+// x^(2^inv_run - 1) and later x^3, and t is used for squaring. See
+// sb_prime_field_t in sb_fe.h for a description of the chain.
+static void
+sb_fe_mod_expt_chain_r(const sb_fe_t x[static const restrict 1],
+                       sb_fe_t w[static const restrict 1],
+                       sb_fe_t a[static const restrict 1],
+                       sb_fe_t t[static const restrict 1],
+                       const sb_fe_t e[static const restrict 1],
+                       const sb_bitcount_t shift,
+                       const sb_prime_field_t p[static const restrict 1])
+{
+    const sb_bitcount_t run = p->inv_run, window = p->inv_window;
+
+    // w = x^(2^run - 1), computed from the binary expansion of run: each
+    // step doubles the number of one bits and then optionally appends one
+    sb_bitcount_t top = 0;
+    while ((run >> top) > 1) {
+        top++;
+    }
+    *w = *x;
+    for (sb_bitcount_t j = top; j > 0; j--) {
+        *a = *w;
+        sb_fe_mod_expt_step_r(a, t, run >> j, w, p);
+        if ((run >> (j - 1)) & 1) {
+            sb_fe_mod_expt_step_r(a, t, 1, x, p);
+        }
+        *w = *a;
+    }
+
+    // The leading run of one bits in e is w itself.
+    *a = *w;
+    sb_bitcount_t i = p->bits - shift - run; // the number of bits left in e
+
+    while (i > window) {
+        sb_bitcount_t r = 0;
+        while (r < run && i - r > window &&
+               sb_fe_test_bit(e, shift + i - 1 - r)) {
+            r++;
+        }
+        if (r == run) {
+            sb_fe_mod_expt_step_r(a, t, run, w, p);
+            i -= run;
+        } else if (r) {
+            sb_fe_mod_expt_step_r(a, t, 1, x, p);
+            i--;
+        } else {
+            sb_fe_mont_square(t, a, p);
+            *a = *t;
+            i--;
+        }
+    }
+
+    if (window) {
+        // w = x^3
+        sb_fe_mont_square(t, x, p);
+        sb_fe_mont_mult(w, t, x, p);
+
+        while (i > 0) {
+            if (!sb_fe_test_bit(e, shift + i - 1)) {
+                sb_fe_mont_square(t, a, p);
+                *a = *t;
+                i--;
+            } else if (i > 1 && sb_fe_test_bit(e, shift + i - 2)) {
+                sb_fe_mod_expt_step_r(a, t, 2, w, p);
+                i -= 2;
+            } else {
+                sb_fe_mod_expt_step_r(a, t, 1, x, p);
+                i--;
+            }
+        }
+    }
+}
+
+// Square roots for primes p = 3 mod 4: if x is a square, x^((p + 1) / 4) is
+// a square root of x. As with inversion, this is computed in the Montgomery
+// domain with an addition chain that depends only on p, so it is constant
+// time with respect to its input.
+sb_word_t sb_fe_mod_sqrt_r(sb_fe_t dest[static const restrict 1],
+                           sb_fe_t t2[static const restrict 1],
+                           sb_fe_t t3[static const restrict 1],
+                           sb_fe_t t4[static const restrict 1],
+                           const sb_prime_field_t p[static const restrict 1])
+{
+    SB_ASSERT(p->inv_run != 0 && sb_fe_test_bit(&p->p, 0) &&
+              sb_fe_test_bit(&p->p, 1),
+              "Square roots require p = 3 mod 4 and an addition chain.");
+
+    // The exponent depends only on the prime and is not secret.
+    sb_fe_t e;
+    sb_fe_add(&e, &p->p, &SB_FE_ONE);
+
+    sb_fe_mod_expt_chain_r(dest, t2, t3, t4, &e, 2, p);
+
+    sb_fe_mont_square(t4, t3, p);
+    const sb_word_t square = sb_fe_equal(t4, dest);
+    *dest = *t3;
+    return square;
+}
+
+#if !SB_FE_SAFEGCD_INVERSION || defined(SB_TEST)
+
+// Inversion by exponentiation. See sb_prime_field_t in sb_fe.h for more
+// comments on modular inversion.
+static void
+sb_fe_mod_inv_expt_r(sb_fe_t dest[static const restrict 1],
+                     sb_fe_t t2[static const restrict 1],
+                     sb_fe_t t3[static const restrict 1],
+                     const sb_prime_field_t p[static const restrict 1])
+{
+    if (p->inv_run) {
+        static const sb_fe_t two = SB_FE_CONST(0, 0, 0, 2);
+
+        // The exponent depends only on the prime and is not secret. The chain
+        // needs a third temporary, which is taken from the stack so that
+        // callers continue to supply two.
+        sb_fe_t e, t4;
+        sb_fe_sub(&e, &p->p, &two);
+
+        sb_fe_mod_expt_chain_r(dest, t2, t3, &t4, &e, 0, p);
+        *dest = *t3;
+    } else {
+        sb_fe_mod_expt_r(dest, &p->p_minus_two_f1, t2, t3, p);
+        sb_fe_mod_expt_r(dest, &p->p_minus_two_f2, t2, t3, p);
+    }
+}
+
+#endif
+
+#if SB_FE_SAFEGCD_INVERSION || defined(SB_TEST)
+
+// Constant-time inversion using the "divstep" iteration of Bernstein and
+// Yang, "Fast constant-time gcd computation and modular inversion" (2019),
+// in the variant used by libsecp256k1 (see its doc/safegcd_implementation.md)
+// which tracks zeta = -(delta + 1/2) and needs at most 590 divsteps for
+// 256-bit inputs.
+
+// Values are held in signed limbs of SB_SGCD_LIMB_BITS bits, so that the
+// products of a limb and an entry of a transition matrix, plus a carry, fit
+// in sb_sgcd_wide_t. Each batch of divsteps is accumulated in a transition
+// matrix scaled by 2^SB_SGCD_LIMB_BITS, which is then applied to the full
+// values.
+#if SB_MUL_SIZE == 8
+typedef int64_t sb_sgcd_limb_t;
+typedef uint64_t sb_sgcd_ulimb_t;
+typedef __int128_t sb_sgcd_wide_t;
+#define SB_SGCD_LIMB_BITS 62
+#define SB_SGCD_LIMBS 5
+#define SB_SGCD_BATCH 59
+#else
+typedef int32_t sb_sgcd_limb_t;
+typedef uint32_t sb_sgcd_ulimb_t;
+typedef int64_t sb_sgcd_wide_t;
+#define SB_SGCD_LIMB_BITS 30
+#define SB_SGCD_LIMBS 9
+#define SB_SGCD_BATCH 30
+#endif
+
+#define SB_SGCD_BATCHES ((590 + SB_SGCD_BATCH - 1) / SB_SGCD_BATCH)
+#define SB_SGCD_SIGN_SHIFT (sizeof(sb_sgcd_limb_t) * 8 - 1)
+#define SB_SGCD_MASK \
+    ((sb_sgcd_limb_t) (((sb_sgcd_ulimb_t) 1 << SB_SGCD_LIMB_BITS) - 1))
+
+typedef struct sb_sgcd_t {
+    sb_sgcd_limb_t v[SB_SGCD_LIMBS];
+} sb_sgcd_t;
+
+typedef struct sb_sgcd_matrix_t {
+    sb_sgcd_limb_t u, v, q, r;
+} sb_sgcd_matrix_t;
+
+// Converts a field element to signed limbs. Limb and word indices depend only
+// on the (public) limb number, not on the value.
+static void sb_sgcd_from_fe(sb_sgcd_t dest[static const restrict 1],
+                            const sb_fe_t src[static const restrict 1])
+{
+    for (size_t i = 0; i < SB_SGCD_LIMBS; i++) {
+        sb_sgcd_ulimb_t l = 0;
+        for (size_t b = 0; b < SB_SGCD_LIMB_BITS;) {
+            const size_t bit = i * SB_SGCD_LIMB_BITS + b;
+            if (bit >= SB_FE_BITS) {
+                break;
+            }
+            const size_t w = bit / SB_WORD_BITS, off = bit % SB_WORD_BITS;
+            l |= (sb_sgcd_ulimb_t) (SB_FE_WORD(src, w) >> off) << b;
+            b += SB_WORD_BITS - off;
+        }
+        dest->v[i] = (sb_sgcd_limb_t) l & SB_SGCD_MASK;
+    }
+}
+
+// Converts normalized signed limbs (all in [0, 2^SB_SGCD_LIMB_BITS)) back to
+// a field element.
+static void sb_sgcd_to_fe(sb_fe_t dest[static const restrict 1],
+                          const sb_sgcd_t src[static const restrict 1])
+{
+    *dest = SB_FE_ZERO;
+    for (size_t i = 0; i < SB_SGCD_LIMBS; i++) {
+        const sb_sgcd_ulimb_t l = (sb_sgcd_ulimb_t) src->v[i];
+        for (size_t b = 0; b < SB_SGCD_LIMB_BITS;) {
+            const size_t bit = i * SB_SGCD_LIMB_BITS + b;
+            if (bit >= SB_FE_BITS) {
+                break;
+            }
+            const size_t w = bit / SB_WORD_BITS, off = bit % SB_WORD_BITS;
+            SB_FE_WORD(dest, w) |= (sb_word_t) ((sb_word_t) (l >> b) << off);
+            b += SB_WORD_BITS - off;
+        }
+    }
+}
+
+// Performs SB_SGCD_BATCH divsteps on the low limbs f0 and g0 of f and g,
+// returning the new zeta and the transition matrix (scaled by
+// 2^SB_SGCD_LIMB_BITS) in t. f is always odd. Every step is computed using
+// masks, so timing does not depend on f or g.
+static sb_sgcd_limb_t sb_sgcd_divsteps(sb_sgcd_limb_t zeta,
+                                       const sb_sgcd_ulimb_t f0,
+                                       const sb_sgcd_ulimb_t g0,
+                                       sb_sgcd_matrix_t t[static const 1])
+{
+    // The matrix starts as the identity, scaled so that it is scaled by
+    // 2^SB_SGCD_LIMB_BITS after SB_SGCD_BATCH steps.
+    const sb_sgcd_ulimb_t one =
+        (sb_sgcd_ulimb_t) 1 << (SB_SGCD_LIMB_BITS - SB_SGCD_BATCH);
+    sb_sgcd_ulimb_t u = one, v = 0, q = 0, r = one;
+    sb_sgcd_ulimb_t f = f0, g = g0;
+    for (size_t i = 0; i < SB_SGCD_BATCH; i++) {
+        // c1 is all ones if zeta < 0; c2 is all ones if g is odd
+        sb_sgcd_ulimb_t c1 = (sb_sgcd_ulimb_t) (zeta >> SB_SGCD_SIGN_SHIFT);
+        const sb_sgcd_ulimb_t c2 = -(g & 1);
+
+        // (x, y, z) = -(f, u, v) if zeta < 0, (f, u, v) otherwise
+        const sb_sgcd_ulimb_t x = (f ^ c1) - c1;
+        const sb_sgcd_ulimb_t y = (u ^ c1) - c1;
+        const sb_sgcd_ulimb_t z = (v ^ c1) - c1;
+
+        // if g is odd, (g, q, r) += (x, y, z)
+        g += x & c2;
+        q += y & c2;
+        r += z & c2;
+
+        // if zeta < 0 and g was odd, (f, u, v) = the old (g, q, r) and
+        // zeta = -zeta - 1; otherwise, zeta = zeta - 1
+        c1 &= c2;
+        zeta = (sb_sgcd_limb_t) ((sb_sgcd_ulimb_t) zeta ^ c1) - 1;
+        f += g & c1;
+        u += q & c1;
+        v += r & c1;
+
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t->u = (sb_sgcd_limb_t) u;
+    t->v = (sb_sgcd_limb_t) v;
+    t->q = (sb_sgcd_limb_t) q;
+    t->r = (sb_sgcd_limb_t) r;
+    return zeta;
+}
+
+// (f, g) = t * (f, g) / 2^SB_SGCD_LIMB_BITS; the division is exact
+static void sb_sgcd_update_fg(sb_sgcd_t f[static const restrict 1],
+                              sb_sgcd_t g[static const restrict 1],
+                              const sb_sgcd_matrix_t t[static const 1])
+{
+    sb_sgcd_wide_t cf = (sb_sgcd_wide_t) t->u * f->v[0] +
+                        (sb_sgcd_wide_t) t->v * g->v[0];
+    sb_sgcd_wide_t cg = (sb_sgcd_wide_t) t->q * f->v[0] +
+                        (sb_sgcd_wide_t) t->r * g->v[0];
+    cf >>= SB_SGCD_LIMB_BITS;
+    cg >>= SB_SGCD_LIMB_BITS;
+    for (size_t i = 1; i < SB_SGCD_LIMBS; i++) {
+        cf += (sb_sgcd_wide_t) t->u * f->v[i] +
+              (sb_sgcd_wide_t) t->v * g->v[i];
+        cg += (sb_sgcd_wide_t) t->q * f->v[i] +
+              (sb_sgcd_wide_t) t->r * g->v[i];
+        f->v[i - 1] = (sb_sgcd_limb_t) cf & SB_SGCD_MASK;
+        g->v[i - 1] = (sb_sgcd_limb_t) cg & SB_SGCD_MASK;
+        cf >>= SB_SGCD_LIMB_BITS;
+        cg >>= SB_SGCD_LIMB_BITS;
+    }
+    f->v[SB_SGCD_LIMBS - 1] = (sb_sgcd_limb_t) cf;
+    g->v[SB_SGCD_LIMBS - 1] = (sb_sgcd_limb_t) cg;
+}
+
+// (d, e) = (t * (d, e) + m * (md, me)) / 2^SB_SGCD_LIMB_BITS, where md and me
+// are chosen to make the division exact and to keep d and e in (-2m, m).
+// m_inv is m^-1 mod 2^SB_SGCD_LIMB_BITS.
+static void sb_sgcd_update_de(sb_sgcd_t d[static const restrict 1],
+                              sb_sgcd_t e[static const restrict 1],
+                              const sb_sgcd_matrix_t t[static const 1],
+                              const sb_sgcd_t m[static const restrict 1],
+                              const sb_sgcd_ulimb_t m_inv)
+{
+    // Start with md, me = 0; add (u, q) if d is negative and (v, r) if e is
+    // negative.
+    const sb_sgcd_limb_t sd = d->v[SB_SGCD_LIMBS - 1] >> SB_SGCD_SIGN_SHIFT;
+    const sb_sgcd_limb_t se = e->v[SB_SGCD_LIMBS - 1] >> SB_SGCD_SIGN_SHIFT;
+    sb_sgcd_limb_t md = (t->u & sd) + (t->v & se);
+    sb_sgcd_limb_t me = (t->q & sd) + (t->r & se);
+
+    sb_sgcd_wide_t cd = (sb_sgcd_wide_t) t->u * d->v[0] +
+                        (sb_sgcd_wide_t) t->v * e->v[0];
+    sb_sgcd_wide_t ce = (sb_sgcd_wide_t) t->q * d->v[0] +
+                        (sb_sgcd_wide_t) t->r * e->v[0];
+
+    // Adjust md and me so that the low limb of the result is zero.
+    md -= (sb_sgcd_limb_t) ((m_inv * (sb_sgcd_ulimb_t) cd +
+                             (sb_sgcd_ulimb_t) md) &
+                            (sb_sgcd_ulimb_t) SB_SGCD_MASK);
+    me -= (sb_sgcd_limb_t) ((m_inv * (sb_sgcd_ulimb_t) ce +
+                             (sb_sgcd_ulimb_t) me) &
+                            (sb_sgcd_ulimb_t) SB_SGCD_MASK);
+
+    cd += (sb_sgcd_wide_t) m->v[0] * md;
+    ce += (sb_sgcd_wide_t) m->v[0] * me;
+    cd >>= SB_SGCD_LIMB_BITS;
+    ce >>= SB_SGCD_LIMB_BITS;
+
+    for (size_t i = 1; i < SB_SGCD_LIMBS; i++) {
+        cd += (sb_sgcd_wide_t) t->u * d->v[i] +
+              (sb_sgcd_wide_t) t->v * e->v[i];
+        ce += (sb_sgcd_wide_t) t->q * d->v[i] +
+              (sb_sgcd_wide_t) t->r * e->v[i];
+        cd += (sb_sgcd_wide_t) m->v[i] * md;
+        ce += (sb_sgcd_wide_t) m->v[i] * me;
+        d->v[i - 1] = (sb_sgcd_limb_t) cd & SB_SGCD_MASK;
+        e->v[i - 1] = (sb_sgcd_limb_t) ce & SB_SGCD_MASK;
+        cd >>= SB_SGCD_LIMB_BITS;
+        ce >>= SB_SGCD_LIMB_BITS;
+    }
+    d->v[SB_SGCD_LIMBS - 1] = (sb_sgcd_limb_t) cd;
+    e->v[SB_SGCD_LIMBS - 1] = (sb_sgcd_limb_t) ce;
+}
+
+// Propagates carries so that all limbs but the top one are in
+// [0, 2^SB_SGCD_LIMB_BITS).
+static void sb_sgcd_carry(sb_sgcd_t r[static const 1])
+{
+    for (size_t i = 0; i < SB_SGCD_LIMBS - 1; i++) {
+        r->v[i + 1] += r->v[i] >> SB_SGCD_LIMB_BITS;
+        r->v[i] &= SB_SGCD_MASK;
+    }
+}
+
+// r = r * sign(s) mod m, in [0, m), given r in (-2m, m)
+static void sb_sgcd_normalize(sb_sgcd_t r[static const restrict 1],
+                              const sb_sgcd_limb_t s,
+                              const sb_sgcd_t m[static const restrict 1])
+{
+    // Add m if r is negative, then negate if s is negative, bringing r into
+    // (-m, m).
+    sb_sgcd_limb_t c_add = r->v[SB_SGCD_LIMBS - 1] >> SB_SGCD_SIGN_SHIFT;
+    const sb_sgcd_limb_t c_neg = s >> SB_SGCD_SIGN_SHIFT;
+    for (size_t i = 0; i < SB_SGCD_LIMBS; i++) {
+        r->v[i] = ((r->v[i] + (m->v[i] & c_add)) ^ c_neg) - c_neg;
+    }
+    sb_sgcd_carry(r);
+
+    // Add m again if r is still negative.
+    c_add = r->v[SB_SGCD_LIMBS - 1] >> SB_SGCD_SIGN_SHIFT;
+    for (size_t i = 0; i < SB_SGCD_LIMBS; i++) {
+        r->v[i] += m->v[i] & c_add;
+    }
+    sb_sgcd_carry(r);
+}
+
+// dest = dest^-1 mod p, for dest in [1, p]. p (which is quasi-reduced zero)
+// produces p. Montgomery domain values are not converted.
+void sb_fe_mod_inv_safegcd(sb_fe_t dest[static const restrict 1],
+                           const sb_prime_field_t p[static const restrict 1])
+{
+    sb_sgcd_t m, f, g, d = { .v = { 0 } }, e = { .v = { 1 } };
+
+    sb_sgcd_from_fe(&m, &p->p);
+    sb_sgcd_from_fe(&g, dest);
+
+    // g = 0 if dest is p
+    const sb_word_t z = sb_fe_equal(dest, &p->p);
+    for (size_t i = 0; i < SB_SGCD_LIMBS; i++) {
+        g.v[i] &= (sb_sgcd_limb_t) z - 1;
+    }
+
+    // m_inv = p^-1 mod 2^SB_SGCD_LIMB_BITS, by Newton's method: each step
+    // doubles the number of correct low bits, starting with three.
+    const sb_sgcd_ulimb_t m0 = (sb_sgcd_ulimb_t) m.v[0];
+    sb_sgcd_ulimb_t m_inv = m0;
+    for (size_t i = 0; i < 5; i++) {
+        m_inv *= 2 - m0 * m_inv;
+    }
+
+    f = m;
+    sb_sgcd_limb_t zeta = -1;
+    for (size_t i = 0; i < SB_SGCD_BATCHES; i++) {
+        sb_sgcd_matrix_t t;
+        zeta = sb_sgcd_divsteps(zeta, (sb_sgcd_ulimb_t) f.v[0],
+                                (sb_sgcd_ulimb_t) g.v[0], &t);
+        sb_sgcd_update_de(&d, &e, &t, &m, m_inv);
+        sb_sgcd_update_fg(&f, &g, &t);
+    }
+
+    // g is now zero and f is +/- 1, as p is prime; d is +/- the inverse.
+    sb_sgcd_normalize(&d, f.v[SB_SGCD_LIMBS - 1], &m);
+    sb_sgcd_to_fe(dest, &d);
+
+    // If dest was p, d is zero; quasi-reduce it to p.
+    for (size_t i = 0; i < SB_FE_WORDS; i++) {
+        SB_FE_WORD(dest, i) = sb_ctc_word(z, SB_FE_WORD(dest, i),
+                                          SB_FE_WORD(&p->p, i));
+    }
+}
+
+// Inversion using safegcd, returning the inverse in the Montgomery domain:
+// given x * R, the plain inverse is x^-1 * R^-1, and two Montgomery
+// multiplications by R^2 produce x^-1 * R.
+static void
+sb_fe_mod_inv_safegcd_r(sb_fe_t dest[static const restrict 1],
+                        sb_fe_t t2[static const restrict 1],
+                        sb_fe_t t3[static const restrict 1],
+                        const sb_prime_field_t p[static const restrict 1])
+{
+    (void) t3;
+    sb_fe_mod_inv_safegcd(dest, p);
+    sb_fe_mont_mult(t2, dest, &p->r2_mod_p, p);
+    sb_fe_mont_mult(dest, t2, &p->r2_mod_p, p);
+}
+
+#endif
+
 void sb_fe_mod_inv_r(sb_fe_t dest[static const restrict 1],
                      sb_fe_t t2[static const restrict 1],
                      sb_fe_t t3[static const restrict 1],
                      const sb_prime_field_t p[static const restrict 1])
 {
-    sb_fe_mod_expt_r(dest, &p->p_minus_two_f1, t2, t3, p);
-    sb_fe_mod_expt_r(dest, &p->p_minus_two_f2, t2, t3, p);
+#if SB_FE_SAFEGCD_INVERSION
+    sb_fe_mod_inv_safegcd_r(dest, t2, t3, p);
+#else
+    sb_fe_mod_inv_expt_r(dest, t2, t3, p);
+#endif
+}
+
+// Montgomery's trick: with prefix products a_i = src[0] * ... * src[i],
+// src[i]^-1 = a_i^-1 * a_(i-1), and a_(i-1)^-1 = a_i^-1 * src[i].
+void sb_fe_batch_inv_r(sb_fe_t dest[static const restrict 1],
+                       const sb_fe_t src[static const restrict 1],
+                       const size_t count,
+                       sb_fe_t scratch[static const restrict 3],
+                       const sb_prime_field_t p[static const restrict 1])
+{
+    if (count == 0) {
+        return;
+    }
+
+    // dest[i] = a_i
+    dest[0] = src[0];
+    for (size_t i = 1; i < count; i++) {
+        sb_fe_mont_mult(&dest[i], &dest[i - 1], &src[i], p);
+    }
+
+    // scratch[0] = a_(count - 1)^-1
+    scratch[0] = dest[count - 1];
+    sb_fe_mod_inv_r(&scratch[0], &scratch[1], &scratch[2], p);
+
+    for (size_t i = count - 1; i > 0; i--) {
+        // dest[i] = a_i^-1 * a_(i-1) = src[i]^-1
+        sb_fe_mont_mult(&dest[i], &scratch[0], &dest[i - 1], p);
+
+        // scratch[0] = a_i^-1 * src[i] = a_(i-1)^-1
+        sb_fe_mont_mult(&scratch[1], &scratch[0], &src[i], p);
+        scratch[0] = scratch[1];
+    }
+    dest[0] = scratch[0];
 }
 
 #ifdef SB_TEST
@@ -1067,4 +2381,365 @@ _Bool sb_test_mod_expt_p(void)
     return 1;
 }
 
+static const sb_prime_field_t* const sb_test_inv_fields[] = {
+    &SB_CURVE_P256_P, &SB_CURVE_P256_N,
+    &SB_CURVE_SECP256K1_P, &SB_CURVE_SECP256K1_N,
+    &SB_CURVE_X25519_P,
+#if SB_FE_P256_FAST_REDUCTION
+    &SB_CURVE_P256_P_FAST,
+#endif
+#if SB_FE_SECP256K1_FAST_REDUCTION
+    &SB_CURVE_SECP256K1_P_FAST,
+#endif
+};
+
+#define SB_TEST_INV_FIELDS \
+    (sizeof(sb_test_inv_fields) / sizeof(sb_test_inv_fields[0]))
+
+// Checks chain-based inversion against factor-based inversion, and safegcd
+// against both, in the field p
+static _Bool sb_test_mod_inv_field(const sb_prime_field_t* const p)
+{
+    static const sb_fe_t a5 = SB_FE_CONST(0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA);
+    sb_fe_t x, y, t, t2, t3;
+
+    SB_TEST_ASSERT(p->inv_run != 0);
+
+    // Start with p - 1 and continue with a sequence of products involving
+    // both large and small values
+    x = p->p;
+    sb_fe_sub(&x, &x, &SB_FE_ONE);
+    for (size_t i = 0; i < 16; i++) {
+        t = x;
+        sb_fe_mod_inv_expt_r(&t, &t2, &t3, p);
+
+        y = x;
+        sb_fe_mod_expt_r(&y, &p->p_minus_two_f1, &t2, &t3, p);
+        sb_fe_mod_expt_r(&y, &p->p_minus_two_f2, &t2, &t3, p);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &y));
+
+        y = x;
+        sb_fe_mod_inv_safegcd_r(&y, &t2, &t3, p);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &y));
+
+        // (x * R) * (x^-1 * R) * R^-1 = R
+        sb_fe_mont_mult(&y, &x, &t, p);
+        SB_TEST_ASSERT(sb_fe_equal(&y, &p->r_mod_p));
+
+        sb_fe_mont_mult(&y, &x, (i & 1) ? &a5 : &x, p);
+        x = y;
+    }
+
+    // 1^-1 == 1 in the Montgomery domain
+    t = p->r_mod_p;
+    sb_fe_mod_inv_r(&t, &t2, &t3, p);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &p->r_mod_p));
+
+    // Zero has no inverse; both methods produce p (quasi-reduced zero)
+    t = p->p;
+    sb_fe_mod_inv_expt_r(&t, &t2, &t3, p);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &p->p));
+    t = p->p;
+    sb_fe_mod_inv_safegcd_r(&t, &t2, &t3, p);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &p->p));
+    return 1;
+}
+
+_Bool sb_test_mod_inv(void)
+{
+    for (size_t f = 0; f < SB_TEST_INV_FIELDS; f++) {
+        SB_TEST_ASSERT(sb_test_mod_inv_field(sb_test_inv_fields[f]));
+    }
+    return 1;
+}
+
+static const sb_prime_field_t* const sb_test_sqrt_fields[] = {
+    &SB_CURVE_P256_P, &SB_CURVE_SECP256K1_P,
+#if SB_FE_P256_FAST_REDUCTION
+    &SB_CURVE_P256_P_FAST,
+#endif
+#if SB_FE_SECP256K1_FAST_REDUCTION
+    &SB_CURVE_SECP256K1_P_FAST,
+#endif
+};
+
+_Bool sb_test_mod_sqrt(void)
+{
+    static const sb_fe_t a5 = SB_FE_CONST(0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA);
+    sb_fe_t x, y, z, t, t2, t3, t4;
+
+    for (size_t f = 0;
+         f < sizeof(sb_test_sqrt_fields) / sizeof(sb_test_sqrt_fields[0]);
+         f++) {
+        const sb_prime_field_t* const p = sb_test_sqrt_fields[f];
+
+        x = p->p;
+        sb_fe_sub(&x, &x, &SB_FE_ONE);
+        for (size_t i = 0; i < 16; i++) {
+            // The square root of x^2 is x or -x
+            sb_fe_mont_square(&y, &x, p);
+            t = y;
+            SB_TEST_ASSERT(sb_fe_mod_sqrt_r(&t, &t2, &t3, &t4, p));
+            sb_fe_mod_sub(&z, &p->p, &x, p);
+            SB_TEST_ASSERT(sb_fe_equal(&t, &x) || sb_fe_equal(&t, &z));
+
+            // -1 is not a square when p = 3 mod 4, so neither is -x^2; the
+            // result is then a square root of x^2
+            sb_fe_mod_sub(&t, &p->p, &y, p);
+            SB_TEST_ASSERT(!sb_fe_mod_sqrt_r(&t, &t2, &t3, &t4, p));
+            sb_fe_mont_square(&z, &t, p);
+            SB_TEST_ASSERT(sb_fe_equal(&z, &y));
+
+            sb_fe_mont_mult(&y, &x, (i & 1) ? &a5 : &x, p);
+            x = y;
+        }
+
+        // The square root of zero is zero
+        t = p->p;
+        SB_TEST_ASSERT(sb_fe_mod_sqrt_r(&t, &t2, &t3, &t4, p));
+        SB_TEST_ASSERT(sb_fe_equal(&t, &p->p));
+    }
+    return 1;
+}
+
+// Inverts a sequence of 64 values in each field using the given method.
+// Run these tests with -t and -c to compare the speed of the two methods.
+static _Bool sb_test_mod_inv_speed(void (* const inv)(sb_fe_t*, sb_fe_t*,
+                                                      sb_fe_t*,
+                                                      const sb_prime_field_t*))
+{
+    sb_fe_t x, t, t2, t3;
+    for (size_t f = 0; f < SB_TEST_INV_FIELDS; f++) {
+        const sb_prime_field_t* const p = sb_test_inv_fields[f];
+        x = p->r2_mod_p;
+        for (size_t i = 0; i < 64; i++) {
+            t = x;
+            inv(&t, &t2, &t3, p);
+            sb_fe_mont_mult(&t2, &x, &t, p);
+            SB_TEST_ASSERT(sb_fe_equal(&t2, &p->r_mod_p));
+            sb_fe_mod_add(&x, &x, &t, p);
+        }
+    }
+    return 1;
+}
+
+_Bool sb_test_mod_inv_expt(void)
+{
+    return sb_test_mod_inv_speed(sb_fe_mod_inv_expt_r);
+}
+
+_Bool sb_test_mod_inv_safegcd(void)
+{
+    return sb_test_mod_inv_speed(sb_fe_mod_inv_safegcd_r);
+}
+
+_Bool sb_test_batch_inv(void)
+{
+    sb_fe_t src[9], dest[9], scratch[3], t, t2, t3;
+    for (size_t f = 0; f < SB_TEST_INV_FIELDS; f++) {
+        const sb_prime_field_t* const p = sb_test_inv_fields[f];
+
+        // src = p - 1, r2_mod_p, and their products
+        src[0] = p->p;
+        sb_fe_sub(&src[0], &src[0], &SB_FE_ONE);
+        src[1] = p->r2_mod_p;
+        for (size_t i = 2; i < 9; i++) {
+            sb_fe_mont_mult(&src[i], &src[i - 1], &src[i - 2], p);
+        }
+
+        // Every prefix of src, including a single element
+        for (size_t n = 1; n <= 9; n++) {
+            sb_fe_batch_inv_r(dest, src, n, scratch, p);
+            for (size_t i = 0; i < n; i++) {
+                t = src[i];
+                sb_fe_mod_inv_r(&t, &t2, &t3, p);
+                SB_TEST_ASSERT(sb_fe_equal(&dest[i], &t));
+            }
+        }
+
+        // A zero element zeroes every output
+        src[4] = p->p;
+        sb_fe_batch_inv_r(dest, src, 9, scratch, p);
+        for (size_t i = 0; i < 9; i++) {
+            SB_TEST_ASSERT(sb_fe_equal(&dest[i], &p->p));
+        }
+    }
+    return 1;
+}
+
+_Bool sb_test_mult_shift_round(void)
+{
+    static const sb_fe_t a5 = SB_FE_CONST(0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA);
+    static const sb_fe_t ones = SB_FE_CONST(0xFFFFFFFFFFFFFFFF,
+                                            0xFFFFFFFFFFFFFFFF,
+                                            0xFFFFFFFFFFFFFFFF,
+                                            0xFFFFFFFFFFFFFFFF);
+    static const struct {
+        sb_bitcount_t shift;
+        sb_fe_t r;
+    } a5_squared[] = {
+        // The first bit shifted out is 0
+        { 257, SB_FE_CONST(0x38AAF1722A396300, 0x6371B91C0EC66471,
+                           0x00719C55B839D41D, 0x9BAB0E3880C5F353) },
+        { 384, SB_FE_CONST(0x0000000000000000, 0x0000000000000000,
+                           0x7155E2E45472C600, 0xC6E372381D8CC8E2) },
+        // The first bit shifted out is 1
+        { 300, SB_FE_CONST(0x000000000007155E, 0x2E45472C600C6E37,
+                           0x2381D8CC8E200E33, 0x8AB7073A83B37562) },
+        { 447, SB_FE_CONST(0x0000000000000000, 0x0000000000000000,
+                           0x0000000000000000, 0xE2ABC5C8A8E58C02) },
+        { 511, SB_FE_CONST(0, 0, 0, 1) }
+    };
+    sb_fe_t t;
+
+    for (size_t i = 0; i < sizeof(a5_squared) / sizeof(a5_squared[0]); i++) {
+        sb_fe_mult_shift_round(&t, &a5, &a5, a5_squared[i].shift);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &a5_squared[i].r));
+    }
+
+    // (2^256 - 1)^2 = 2^512 - 2^257 + 1, which rounds up to 2^128 with a
+    // carry through the low words of the result
+    static const sb_fe_t two_128 = SB_FE_CONST(0, 1, 0, 0);
+    sb_fe_mult_shift_round(&t, &ones, &ones, 384);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &two_128));
+    sb_fe_mult_shift_round(&t, &ones, &ones, 511);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &(sb_fe_t) SB_FE_CONST(0, 0, 0, 2)));
+
+    sb_fe_mult_shift_round(&t, &SB_FE_ZERO, &ones, 384);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &SB_FE_ZERO));
+    return 1;
+}
+
+#if SB_FE_FAST_REDUCTION
+
+// Checks multiplication and squaring in the field fast against Montgomery
+// multiplication in the field mont, which must have the same prime.
+static _Bool sb_test_fast_field(const sb_prime_field_t* const fast,
+                                const sb_prime_field_t* const mont)
+{
+    static const sb_fe_t a5 = SB_FE_CONST(0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA);
+    sb_fe_t x, y, t, t2, t3;
+
+    SB_TEST_ASSERT(sb_fe_equal(&fast->p, &mont->p));
+
+    // p * y = 0, which is quasi-reduced to p
+    sb_fe_mont_mult(&t, &fast->p, &a5, fast);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &fast->p));
+    sb_fe_mont_square(&t, &fast->p, fast);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &fast->p));
+
+    // (p - 1)^2 = 1
+    x = fast->p;
+    sb_fe_sub(&x, &x, &SB_FE_ONE);
+    sb_fe_mont_square(&t, &x, fast);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &SB_FE_ONE));
+
+    // Compare against x * y * R^-1 * R^2 * R^-1 = x * y in the Montgomery
+    // field, for a sequence of products with both large and small values
+    y = a5;
+    for (size_t i = 0; i < 1024; i++) {
+        sb_fe_mont_mult(&t, &x, &y, fast);
+        sb_fe_mont_mult(&t2, &x, &y, mont);
+        sb_fe_mont_mult(&t3, &t2, &mont->r2_mod_p, mont);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t3));
+
+        sb_fe_mont_square(&t2, &x, fast);
+        sb_fe_mont_mult(&t3, &x, &x, fast);
+        SB_TEST_ASSERT(sb_fe_equal(&t2, &t3));
+
+        y = x;
+        if (i & 1) {
+            x = t;
+        } else {
+            sb_fe_mod_sub(&x, &fast->p, &t, fast); // x = -t
+        }
+    }
+    return 1;
+}
+
+#endif
+
+_Bool sb_test_fast_reduction(void)
+{
+#if SB_FE_P256_FAST_REDUCTION
+    SB_TEST_ASSERT(sb_test_fast_field(&SB_CURVE_P256_P_FAST, &SB_CURVE_P256_P));
+#endif
+#if SB_FE_SECP256K1_FAST_REDUCTION
+    SB_TEST_ASSERT(sb_test_fast_field(&SB_CURVE_SECP256K1_P_FAST,
+                                      &SB_CURVE_SECP256K1_P));
+#endif
+    return 1;
+}
+
+// Checks the instance of the field routines for the field p against the
+// generic routines, which are used for a copy of p with the generic id.
+static _Bool sb_test_field_instance(const sb_prime_field_t* const p)
+{
+    static const sb_fe_t a5 = SB_FE_CONST(0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA);
+    sb_prime_field_t g = *p;
+    g.field = SB_FE_FIELD_GENERIC;
+    sb_fe_t x, y, t, t2;
+
+    SB_TEST_ASSERT(p->field != SB_FE_FIELD_GENERIC);
+
+    // x = p - 1, y = p
+    x = p->p;
+    sb_fe_sub(&x, &x, &SB_FE_ONE);
+    y = p->p;
+    for (size_t i = 0; i < 512; i++) {
+        sb_fe_mont_mult(&t, &x, &y, p);
+        sb_fe_mont_mult(&t2, &x, &y, &g);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        sb_fe_mont_square(&t, &x, p);
+        sb_fe_mont_square(&t2, &x, &g);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        sb_fe_mod_add(&t, &x, &y, p);
+        sb_fe_mod_add(&t2, &x, &y, &g);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        sb_fe_mod_double(&t, &x, p);
+        sb_fe_mod_double(&t2, &x, &g);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        sb_fe_mod_sub(&t, &x, &y, p);
+        sb_fe_mod_sub(&t2, &x, &y, &g);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        // Continue with a sequence of large and small values
+        sb_fe_mont_mult(&t, &x, (i & 1) ? &y : &a5, p);
+        y = x;
+        if (i & 2) {
+            x = t;
+        } else {
+            sb_fe_mod_sub(&x, &p->p, &t, p); // x = -t
+        }
+    }
+    return 1;
+}
+
+_Bool sb_test_fe_specialize(void)
+{
+    SB_TEST_ASSERT(sb_test_field_instance(SB_CURVE_P256.p));
+    SB_TEST_ASSERT(sb_test_field_instance(SB_CURVE_SECP256K1.p));
+    SB_TEST_ASSERT(sb_test_field_instance(&SB_CURVE_X25519_P));
+    return 1;
+}
+
 #endif
@@ -174,6 +174,85 @@ typedef struct sb_fe_t {
 static const sb_fe_t SB_FE_ONE = SB_FE_CONST(0, 0, 0, 1);
 static const sb_fe_t SB_FE_ZERO = SB_FE_CONST(0, 0, 0, 0);
 
+// Multiplication in a prime field (sb_fe_mont_mult and sb_fe_mont_square) is
+// performed using one of the following reduction methods. Montgomery
+// reduction works with any odd prime; the other methods are specific to a
+// single prime of a special form. When a prime-specific method is used, R is
+// 1 rather than 2^SB_FE_BITS: the "Montgomery domain" of the field is just the
+// ordinary representation of field elements, and r_mod_p and r2_mod_p are
+// both 1. Code which converts values using r_mod_p and r2_mod_p and operates
+// on them with the sb_fe_mont_ routines works with either kind of field.
+typedef enum sb_fe_reduction_value_t {
+    SB_FE_REDUCTION_MONTGOMERY = 0,
+    SB_FE_REDUCTION_P256, // FIPS 186-4 D.2.3 fast reduction for P-256's prime
+    SB_FE_REDUCTION_SECP256K1 // folding reduction for secp256k1's prime
+} sb_fe_reduction_value_t;
+
+typedef uint32_t sb_fe_reduction_t;
+
+// If SB_FE_P256_FAST_REDUCTION is 1, P-256 uses a field with fast reduction
+// instead of Montgomery reduction. Fast reduction replaces half of the word
+// multiplications of Montgomery multiplication with a fixed sequence of
+// 32-bit additions and subtractions, which is a win when multiplications are
+// narrow; with 32- or 64-bit multiplication, Montgomery multiplication of a
+// few wide words is faster. By default, fast reduction is used only when
+// SB_MUL_SIZE is 1 or 2.
+#ifndef SB_FE_P256_FAST_REDUCTION
+#if SB_MUL_SIZE <= 2
+#define SB_FE_P256_FAST_REDUCTION 1
+#else
+#define SB_FE_P256_FAST_REDUCTION 0
+#endif
+#endif
+
+// If SB_FE_SECP256K1_FAST_REDUCTION is 1, secp256k1 uses a field which
+// reduces products by folding the high half back into the low half: since
+// p = 2^256 - 0x1000003D1, 2^256 = 0x1000003D1 mod p. Each fold multiplies by
+// a constant of at most 33 bits, which is faster than Montgomery reduction for
+// all supported word sizes, so this is the default.
+#ifndef SB_FE_SECP256K1_FAST_REDUCTION
+#define SB_FE_SECP256K1_FAST_REDUCTION 1
+#endif
+
+// If SB_FE_SAFEGCD_INVERSION is 1, sb_fe_mod_inv_r uses the constant-time
+// divstep-based algorithm of Bernstein and Yang (safegcd) instead of
+// exponentiation; see sb_fe.c. safegcd works with any odd modulus and needs
+// about 600 divsteps on single words plus 20 updates of the full values,
+// which is much less work than exponentiation for every SB_MUL_SIZE. It does
+// use 32x32->64-bit signed multiplication (64x64->128-bit when SB_MUL_SIZE is
+// 8) regardless of SB_MUL_SIZE. Set this to 0 to use exponentiation if that
+// multiplication is unavailable or must be avoided, or to save code space.
+#ifndef SB_FE_SAFEGCD_INVERSION
+#define SB_FE_SAFEGCD_INVERSION 1
+#endif
+
+// Internal: 1 if any field uses a prime-specific reduction method
+#define SB_FE_FAST_REDUCTION \
+    (SB_FE_P256_FAST_REDUCTION || SB_FE_SECP256K1_FAST_REDUCTION)
+
+// The routines sb_fe_mont_mult, sb_fe_mont_square, sb_fe_mod_add,
+// sb_fe_mod_sub, and sb_fe_mod_double are written once in terms of a field
+// structure, and are also instantiated for each of the following primes with
+// that prime's field structure known at compile time. In an instance, the
+// words of the prime, p_mp, and the reduction method are constants: the
+// compiler can fold P-256's zero and all-ones words and p_mp of 1 into the
+// arithmetic instead of loading them from memory, and the branches on the
+// reduction method disappear. A field's id selects its instance; the generic
+// routines dispatch on it, so that code which works with a field chosen at
+// run time (such as the short Weierstrass curve routines) still uses the
+// instances, and code which works with a single field (such as X25519) can
+// call its instance directly. Other fields, such as the scalar fields, have
+// the generic id and use the generic routines. Whether the instances are
+// specialised depends on SB_FE_SPECIALIZE; see sb_fe.c.
+typedef enum sb_fe_field_value_t {
+    SB_FE_FIELD_GENERIC = 0,
+    SB_FE_FIELD_P256, // the field of P-256's prime used by the curve
+    SB_FE_FIELD_SECP256K1, // the field of secp256k1's prime used by the curve
+    SB_FE_FIELD_X25519 // the field of curve25519's prime
+} sb_fe_field_value_t;
+
+typedef uint32_t sb_fe_field_t;
+
 typedef struct sb_prime_field_t {
     sb_fe_t p;
 
@@ -184,13 +263,29 @@ typedef struct sb_prime_field_t {
     // prime, and as such it's best to use exponents with a minimum Hamming
     // weight. Thus, we compute (n^f_1)^f_2 where (f_1 * f_2) = p - 2.
     // You can optimize inversion routines with more intermediate products
-    // than this approach, but this works "well enough" for our purposes.
+    // than this approach, and the primes used by the supplied curves do so:
+    // see inv_run and inv_window below.
     sb_fe_t p_minus_two_f1; // used for Fermat's little theorem based inversion
     sb_fe_t p_minus_two_f2; // second factor of p - 2
 
     sb_fe_t r2_mod_p; // 2^(SB_FE_BITS * 2) mod p
     sb_fe_t r_mod_p; // 2^SB_FE_BITS mod p
     sb_bitcount_t bits; // the number of bits in the prime
+    sb_fe_reduction_t reduction; // the reduction method; see above
+
+    // If inv_run is nonzero, inversion instead uses an addition chain derived
+    // from p - 2, which must begin with at least inv_run one bits. The chain
+    // first computes n^(2^inv_run - 1) and uses it as the leading bits of the
+    // result and for every later run of inv_run one bits. Other bits cost a
+    // multiplication by n each, except for the low inv_window bits, which are
+    // processed in two-bit windows using n^3. Each of the supplied primes has
+    // long runs of one bits, so this needs 14 to 59 multiplications instead
+    // of the 108 to 134 needed by the factors above. The chain depends only
+    // on p, so inversion is still constant time with respect to its input.
+    sb_bitcount_t inv_run;
+    sb_bitcount_t inv_window;
+
+    sb_fe_field_t field; // the id of the field's instance; see above
 } sb_prime_field_t;
 
 extern void sb_fe_from_bytes(sb_fe_t dest[static restrict 1],
@@ -253,9 +348,67 @@ extern void sb_fe_mont_reduce(sb_fe_t dest[static restrict 1],
                               const sb_fe_t left[static 1],
                               const sb_prime_field_t p[static 1]);
 
+// Declares the instances of the field routines for the named prime; see
+// sb_fe_field_value_t above. These take the same arguments as the generic
+// routines, without the field.
+#define SB_FE_DECLARE_FIELD(name) \
+extern void sb_fe_mod_sub_##name(sb_fe_t dest[static 1], \
+                                 const sb_fe_t left[static 1], \
+                                 const sb_fe_t right[static 1]); \
+extern void sb_fe_mod_add_##name(sb_fe_t dest[static 1], \
+                                 const sb_fe_t left[static 1], \
+                                 const sb_fe_t right[static 1]); \
+extern void sb_fe_mod_double_##name(sb_fe_t dest[static 1], \
+                                    const sb_fe_t left[static 1]); \
+extern void sb_fe_mont_mult_##name(sb_fe_t dest[static restrict 1], \
+                                   const sb_fe_t left[static 1], \
+                                   const sb_fe_t right[static 1]); \
+extern void sb_fe_mont_square_##name(sb_fe_t dest[static restrict 1], \
+                                     const sb_fe_t left[static 1])
+
+SB_FE_DECLARE_FIELD(p256);
+SB_FE_DECLARE_FIELD(secp256k1);
+SB_FE_DECLARE_FIELD(x25519);
+
+// dest = round(left * right / 2^shift), where SB_FE_BITS < shift <
+// 2 * SB_FE_BITS, so that the result cannot overflow. Timing depends only on
+// shift. This is used to split scalars for the secp256k1 endomorphism.
+extern void sb_fe_mult_shift_round(sb_fe_t dest[static restrict 1],
+                                   const sb_fe_t left[static restrict 1],
+                                   const sb_fe_t right[static restrict 1],
+                                   sb_bitcount_t shift);
+
+#if SB_FE_SAFEGCD_INVERSION
+// dest = dest^-1 mod p, without regard to the Montgomery domain
+extern void sb_fe_mod_inv_safegcd(sb_fe_t dest[static restrict 1],
+                                  const sb_prime_field_t p[static restrict 1]);
+#endif
+
 extern void sb_fe_mod_inv_r(sb_fe_t dest[static restrict 1],
                             sb_fe_t t2[static restrict  1],
                             sb_fe_t t3[static restrict  1],
                             const sb_prime_field_t p[static restrict 1]);
 
+// Given dest = x * R, computes dest = sqrt(x) * R and returns whether x is a
+// square; if it is not, dest is a square root of -x instead. Only fields with
+// p = 3 mod 4 and an inversion addition chain (inv_run) are supported, which
+// includes those of the supported short Weierstrass curves. The input must be
+// quasi-reduced (zero is represented as p), as Montgomery products are.
+extern sb_word_t sb_fe_mod_sqrt_r(sb_fe_t dest[static restrict 1],
+                                  sb_fe_t t2[static restrict 1],
+                                  sb_fe_t t3[static restrict 1],
+                                  sb_fe_t t4[static restrict 1],
+                                  const sb_prime_field_t p[static restrict 1]);
+
+// Inverts count elements at once using Montgomery's trick: as with
+// sb_fe_mod_inv_r, given src[i] = x_i * R, dest[i] = x_i^-1 * R. This costs
+// one inversion and 3 * (count - 1) multiplications. scratch must hold four
+// elements, and dest must not overlap src. Timing depends only on count. If
+// any element of src is zero (p), every element of dest is p.
+extern void sb_fe_batch_inv_r(sb_fe_t dest[static restrict 1],
+                              const sb_fe_t src[static restrict 1],
+                              size_t count,
+                              sb_fe_t scratch[static restrict 3],
+                              const sb_prime_field_t p[static restrict 1]);
+
 #endif
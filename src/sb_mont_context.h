@@ -17,13 +17,51 @@
 #include "sb_fe.h"
 #include "sb_hmac_drbg.h"
 
+// If SB_MONT_X25519_RADIX_51 is 1, the Montgomery ladder on curve25519
+// represents field elements as five 51-bit limbs in 64-bit words rather than
+// using the generic Montgomery multiplication routines. Reduction modulo
+// 2^255 - 19 is then a multiplication by 19, and additions and subtractions
+// do not need to propagate carries. This requires 64x64->128-bit
+// multiplication, so it is the default only when SB_MUL_SIZE is 8.
+#ifndef SB_MONT_X25519_RADIX_51
+#if SB_MUL_SIZE == 8
+#define SB_MONT_X25519_RADIX_51 1
+#else
+#define SB_MONT_X25519_RADIX_51 0
+#endif
+#endif
+
+#if SB_MONT_X25519_RADIX_51 && SB_MUL_SIZE != 8
+#error "SB_MONT_X25519_RADIX_51 requires SB_MUL_SIZE == 8"
+#endif
+
+#if SB_MONT_X25519_RADIX_51
+
+// An element of the field of curve25519: v[0] + v[1] * 2^51 + ... +
+// v[4] * 2^204, where limbs may exceed 2^51 between carry propagations.
+typedef struct sb_fe25519_t {
+    sb_word_t v[5];
+} sb_fe25519_t;
+
+// The state of the Montgomery ladder on curve25519; see sb_mont_lib.c
+typedef struct sb_mont_x25519_ladder_t {
+    sb_fe25519_t x_p, z_p, x_0, z_0, x_1, z_1, t5, t6, t7, t8;
+} sb_mont_x25519_ladder_t;
+
+#endif
+
 // Context used for point operations on Montgomery curves:
 
 typedef struct sb_mont_context_t {
     sb_fe_t z_p;
     union {
         struct {
-            sb_fe_t x_p, x_0, z_0, x_1, z_1, t5, t6, t7, t8, k;
+            sb_fe_t x_p, k;
+#if SB_MONT_X25519_RADIX_51
+            sb_mont_x25519_ladder_t l;
+#else
+            sb_fe_t x_0, z_0, x_1, z_1, t5, t6, t7, t8;
+#endif
         };
         struct {
             sb_hmac_drbg_state_t drbg;
@@ -44,7 +44,10 @@ static const sb_prime_field_t SB_CURVE_X25519_P = {
     .r2_mod_p = SB_FE_CONST(0, 0, 0, 0x000005A4),
     .r_mod_p = SB_FE_CONST(0, 0, 0, 0x26),
 
-    .bits = 255
+    .bits = 255,
+    // p - 2 is 250 ones followed by 01011
+    .inv_run = 50,
+    .field = SB_FE_FIELD_X25519
 };
 
 static const sb_mont_curve_t SB_CURVE_X25519 = {
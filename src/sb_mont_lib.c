@@ -17,6 +17,384 @@
 #include "sb_test.h"
 #include <string.h>
 
+#if SB_MONT_X25519_RADIX_51
+
+// Field arithmetic for curve25519 in radix 2^51. See Bernstein et al. 2012,
+// "High-speed high-security signatures", section 3.
+//
+// Limbs are kept within the following bounds, which are sufficient for all
+// of the 128-bit column sums in multiplication to be exact:
+// * the output of multiplication, squaring, and sb_fe25519_from_fe has limbs
+//   less than 2^51 + 2^13;
+// * the output of addition or subtraction of two such values has limbs less
+//   than 2^53;
+// * multiplication and squaring accept inputs with limbs less than 2^53.
+// The ladder below only adds and subtracts outputs of multiplication, so
+// carries are only propagated after multiplication.
+
+#define SB_FE25519_MASK ((UINT64_C(1) << 51) - 1)
+
+static const sb_fe25519_t SB_FE25519_ONE = { .v = { 1 } };
+
+// (A + 2) / 4 for curve25519
+#define SB_FE25519_A24 UINT64_C(121666)
+
+// Propagate carries out of the five 128-bit column sums t0 ... t4. The carry
+// out of t4 is multiplied by 19, since 2^255 = 19 mod p, and added to t0.
+static inline void sb_fe25519_carry_wide(sb_fe25519_t r[static const 1],
+                                         sb_dword_t t0, sb_dword_t t1,
+                                         sb_dword_t t2, sb_dword_t t3,
+                                         sb_dword_t t4)
+{
+    t1 += (sb_word_t) (t0 >> 51);
+    t2 += (sb_word_t) (t1 >> 51);
+    t3 += (sb_word_t) (t2 >> 51);
+    t4 += (sb_word_t) (t3 >> 51);
+
+    // t4 < 2^110, so the carry out of t4 times 19 fits in a word
+    const sb_word_t r0 = ((sb_word_t) t0 & SB_FE25519_MASK) +
+                         (sb_word_t) (t4 >> 51) * 19;
+
+    r->v[0] = r0 & SB_FE25519_MASK;
+    r->v[1] = ((sb_word_t) t1 & SB_FE25519_MASK) + (r0 >> 51);
+    r->v[2] = (sb_word_t) t2 & SB_FE25519_MASK;
+    r->v[3] = (sb_word_t) t3 & SB_FE25519_MASK;
+    r->v[4] = (sb_word_t) t4 & SB_FE25519_MASK;
+}
+
+// r = a * b. Terms of the product at or above 2^255 are folded into the low
+// columns by multiplying by 19. r may alias a or b.
+static void sb_fe25519_mult(sb_fe25519_t r[static const 1],
+                            const sb_fe25519_t a[static const 1],
+                            const sb_fe25519_t b[static const 1])
+{
+    const sb_word_t a0 = a->v[0], a1 = a->v[1], a2 = a->v[2], a3 = a->v[3],
+        a4 = a->v[4];
+    const sb_word_t b0 = b->v[0], b1 = b->v[1], b2 = b->v[2], b3 = b->v[3],
+        b4 = b->v[4];
+    const sb_word_t b1_19 = b1 * 19, b2_19 = b2 * 19, b3_19 = b3 * 19,
+        b4_19 = b4 * 19;
+
+    const sb_dword_t t0 = (sb_dword_t) a0 * b0 + (sb_dword_t) a1 * b4_19 +
+                          (sb_dword_t) a2 * b3_19 + (sb_dword_t) a3 * b2_19 +
+                          (sb_dword_t) a4 * b1_19;
+    const sb_dword_t t1 = (sb_dword_t) a0 * b1 + (sb_dword_t) a1 * b0 +
+                          (sb_dword_t) a2 * b4_19 + (sb_dword_t) a3 * b3_19 +
+                          (sb_dword_t) a4 * b2_19;
+    const sb_dword_t t2 = (sb_dword_t) a0 * b2 + (sb_dword_t) a1 * b1 +
+                          (sb_dword_t) a2 * b0 + (sb_dword_t) a3 * b4_19 +
+                          (sb_dword_t) a4 * b3_19;
+    const sb_dword_t t3 = (sb_dword_t) a0 * b3 + (sb_dword_t) a1 * b2 +
+                          (sb_dword_t) a2 * b1 + (sb_dword_t) a3 * b0 +
+                          (sb_dword_t) a4 * b4_19;
+    const sb_dword_t t4 = (sb_dword_t) a0 * b4 + (sb_dword_t) a1 * b3 +
+                          (sb_dword_t) a2 * b2 + (sb_dword_t) a3 * b1 +
+                          (sb_dword_t) a4 * b0;
+
+    sb_fe25519_carry_wide(r, t0, t1, t2, t3, t4);
+}
+
+// r = a^2, which needs 15 word multiplications instead of 25. r may alias a.
+static void sb_fe25519_square(sb_fe25519_t r[static const 1],
+                              const sb_fe25519_t a[static const 1])
+{
+    const sb_word_t a0 = a->v[0], a1 = a->v[1], a2 = a->v[2], a3 = a->v[3],
+        a4 = a->v[4];
+    const sb_word_t d0 = a0 * 2, d1 = a1 * 2, d2 = a2 * 2, d3 = a3 * 2;
+    const sb_word_t a3_19 = a3 * 19, a4_19 = a4 * 19;
+
+    const sb_dword_t t0 = (sb_dword_t) a0 * a0 + (sb_dword_t) d1 * a4_19 +
+                          (sb_dword_t) d2 * a3_19;
+    const sb_dword_t t1 = (sb_dword_t) d0 * a1 + (sb_dword_t) d2 * a4_19 +
+                          (sb_dword_t) a3 * a3_19;
+    const sb_dword_t t2 = (sb_dword_t) d0 * a2 + (sb_dword_t) a1 * a1 +
+                          (sb_dword_t) d3 * a4_19;
+    const sb_dword_t t3 = (sb_dword_t) d0 * a3 + (sb_dword_t) d1 * a2 +
+                          (sb_dword_t) a4 * a4_19;
+    const sb_dword_t t4 = (sb_dword_t) d0 * a4 + (sb_dword_t) d1 * a3 +
+                          (sb_dword_t) a2 * a2;
+
+    sb_fe25519_carry_wide(r, t0, t1, t2, t3, t4);
+}
+
+#if !SB_FE_SAFEGCD_INVERSION || defined(SB_TEST)
+
+// r = a^(2^n)
+static void sb_fe25519_square_n(sb_fe25519_t r[static const 1],
+                                const sb_fe25519_t a[static const 1],
+                                size_t n)
+{
+    sb_fe25519_square(r, a);
+    while (--n) {
+        sb_fe25519_square(r, r);
+    }
+}
+
+#endif
+
+// r = a * ((A + 2) / 4)
+static void sb_fe25519_mult_a24(sb_fe25519_t r[static const 1],
+                                const sb_fe25519_t a[static const 1])
+{
+    sb_fe25519_carry_wide(r,
+                          (sb_dword_t) a->v[0] * SB_FE25519_A24,
+                          (sb_dword_t) a->v[1] * SB_FE25519_A24,
+                          (sb_dword_t) a->v[2] * SB_FE25519_A24,
+                          (sb_dword_t) a->v[3] * SB_FE25519_A24,
+                          (sb_dword_t) a->v[4] * SB_FE25519_A24);
+}
+
+// r = a + b, without carry propagation
+static void sb_fe25519_add(sb_fe25519_t r[static const 1],
+                           const sb_fe25519_t a[static const 1],
+                           const sb_fe25519_t b[static const 1])
+{
+    for (size_t i = 0; i < 5; i++) {
+        r->v[i] = a->v[i] + b->v[i];
+    }
+}
+
+// r = a + 2p - b, without carry propagation. The limbs of 2p are at least
+// 2^52 - 38, so no limb underflows if b is the output of a multiplication.
+static void sb_fe25519_sub(sb_fe25519_t r[static const 1],
+                           const sb_fe25519_t a[static const 1],
+                           const sb_fe25519_t b[static const 1])
+{
+    static const sb_fe25519_t p2 = {
+        .v = {
+            (SB_FE25519_MASK - 18) * 2, SB_FE25519_MASK * 2,
+            SB_FE25519_MASK * 2, SB_FE25519_MASK * 2, SB_FE25519_MASK * 2
+        }
+    };
+    for (size_t i = 0; i < 5; i++) {
+        r->v[i] = a->v[i] + p2.v[i] - b->v[i];
+    }
+}
+
+// Swap a and b if s is 1, in constant time
+static void sb_fe25519_ctswap(const sb_word_t s,
+                              sb_fe25519_t a[static const restrict 1],
+                              sb_fe25519_t b[static const restrict 1])
+{
+    const sb_word_t mask = (sb_word_t) -s;
+    for (size_t i = 0; i < 5; i++) {
+        const sb_word_t t = mask & (a->v[i] ^ b->v[i]);
+        a->v[i] ^= t;
+        b->v[i] ^= t;
+    }
+}
+
+// Split a field element in [0, 2^255) into limbs
+static void sb_fe25519_from_fe(sb_fe25519_t r[static const restrict 1],
+                               const sb_fe_t a[static const restrict 1])
+{
+    const sb_word_t w0 = SB_FE_WORD(a, 0), w1 = SB_FE_WORD(a, 1),
+        w2 = SB_FE_WORD(a, 2), w3 = SB_FE_WORD(a, 3);
+    r->v[0] = w0 & SB_FE25519_MASK;
+    r->v[1] = ((w0 >> 51) | (w1 << 13)) & SB_FE25519_MASK;
+    r->v[2] = ((w1 >> 38) | (w2 << 26)) & SB_FE25519_MASK;
+    r->v[3] = ((w2 >> 25) | (w3 << 39)) & SB_FE25519_MASK;
+    r->v[4] = (w3 >> 12) & SB_FE25519_MASK;
+}
+
+// Produce the quasi-reduced field element in [1, p] congruent to a. This is
+// computed as ((a + p - 1) mod p) + 1, where the reduction mod p produces
+// a value in [0, p) as follows: after one pass of carry propagation, the
+// value is less than 2 * p, and p is subtracted if a + 19 >= 2^255.
+static void sb_fe25519_to_fe(sb_fe_t r[static const restrict 1],
+                             const sb_fe25519_t a[static const restrict 1])
+{
+    sb_word_t v[5] = {
+        a->v[0] + SB_FE25519_MASK - 19, a->v[1] + SB_FE25519_MASK,
+        a->v[2] + SB_FE25519_MASK, a->v[3] + SB_FE25519_MASK,
+        a->v[4] + SB_FE25519_MASK
+    };
+
+    for (size_t i = 0; i < 4; i++) {
+        v[i + 1] += v[i] >> 51;
+        v[i] &= SB_FE25519_MASK;
+    }
+    v[0] += (v[4] >> 51) * 19;
+    v[4] &= SB_FE25519_MASK;
+
+    // q is 1 if v >= p, and 0 otherwise
+    sb_word_t q = (v[0] + 19) >> 51;
+    for (size_t i = 1; i < 5; i++) {
+        q = (v[i] + q) >> 51;
+    }
+
+    // Subtract p by adding 19 and discarding bit 255
+    v[0] += q * 19;
+    for (size_t i = 0; i < 4; i++) {
+        v[i + 1] += v[i] >> 51;
+        v[i] &= SB_FE25519_MASK;
+    }
+    v[4] &= SB_FE25519_MASK;
+
+    SB_FE_WORD(r, 0) = v[0] | (v[1] << 51);
+    SB_FE_WORD(r, 1) = (v[1] >> 13) | (v[2] << 38);
+    SB_FE_WORD(r, 2) = (v[2] >> 26) | (v[3] << 25);
+    SB_FE_WORD(r, 3) = (v[3] >> 39) | (v[4] << 12);
+    sb_fe_add(r, r, &SB_FE_ONE);
+}
+
+#if !SB_FE_SAFEGCD_INVERSION || defined(SB_TEST)
+
+// r = a^-1 = a^(p - 2) = a^(2^255 - 21), using the addition chain from
+// Bernstein's curve25519 reference implementation: 254 squarings and 11
+// multiplications. t5 through t8 of the ladder state are used as temporaries.
+static void sb_fe25519_inv(sb_fe25519_t r[static const 1],
+                           const sb_fe25519_t a[static const 1],
+                           sb_mont_x25519_ladder_t l[static const 1])
+{
+    sb_fe25519_square(&l->t5, a); // 2
+    sb_fe25519_square_n(&l->t6, &l->t5, 2); // 8
+    sb_fe25519_mult(&l->t6, a, &l->t6); // 9
+    sb_fe25519_mult(&l->t5, &l->t5, &l->t6); // 11
+    sb_fe25519_square(&l->t7, &l->t5); // 22
+    sb_fe25519_mult(&l->t6, &l->t6, &l->t7); // 2^5 - 1
+    sb_fe25519_square_n(&l->t7, &l->t6, 5); // 2^10 - 2^5
+    sb_fe25519_mult(&l->t6, &l->t7, &l->t6); // 2^10 - 1
+    sb_fe25519_square_n(&l->t7, &l->t6, 10); // 2^20 - 2^10
+    sb_fe25519_mult(&l->t7, &l->t7, &l->t6); // 2^20 - 1
+    sb_fe25519_square_n(&l->t8, &l->t7, 20); // 2^40 - 2^20
+    sb_fe25519_mult(&l->t7, &l->t8, &l->t7); // 2^40 - 1
+    sb_fe25519_square_n(&l->t7, &l->t7, 10); // 2^50 - 2^10
+    sb_fe25519_mult(&l->t6, &l->t7, &l->t6); // 2^50 - 1
+    sb_fe25519_square_n(&l->t7, &l->t6, 50); // 2^100 - 2^50
+    sb_fe25519_mult(&l->t7, &l->t7, &l->t6); // 2^100 - 1
+    sb_fe25519_square_n(&l->t8, &l->t7, 100); // 2^200 - 2^100
+    sb_fe25519_mult(&l->t7, &l->t8, &l->t7); // 2^200 - 1
+    sb_fe25519_square_n(&l->t7, &l->t7, 50); // 2^250 - 2^50
+    sb_fe25519_mult(&l->t6, &l->t7, &l->t6); // 2^250 - 1
+    sb_fe25519_square_n(&l->t6, &l->t6, 5); // 2^255 - 2^5
+    sb_fe25519_mult(r, &l->t6, &l->t5); // 2^255 - 21
+}
+
+#endif
+
+// The following are the same as the generic ladder routines below, operating
+// on the radix 2^51 ladder state.
+
+// 5M + 4A; see sb_mont_point_double
+static void sb_mont_x25519_point_double(sb_mont_x25519_ladder_t l[static const 1])
+{
+    sb_fe25519_add(&l->t5, &l->x_0, &l->z_0); // t5 = x_0 + z_0 = v_1
+    sb_fe25519_square(&l->t6, &l->t5); // t6 = v_1^2 = v_1
+
+    sb_fe25519_sub(&l->z_0, &l->x_0, &l->z_0); // t2 = x_0 - z_0 = v_2
+    sb_fe25519_square(&l->t7, &l->z_0); // t7 = v_2^2 = v_2
+
+    sb_fe25519_mult(&l->x_0, &l->t6, &l->t7); // x_0 = v_1 * v_2 = X_2Q
+
+    sb_fe25519_sub(&l->t6, &l->t6, &l->t7); // t6 = v_1 - v_2 = v_1
+    sb_fe25519_mult_a24(&l->t8, &l->t6); // t8 = ((A + 2) / 4) * v_1 = v_3
+    sb_fe25519_add(&l->t8, &l->t8, &l->t7); // t8 = v_3 + v_2 = v_3
+
+    l->t7 = l->z_0; // t7 = (x_Q - z_Q)
+
+    sb_fe25519_mult(&l->z_0, &l->t6, &l->t8); // z_0 = v_1 * v_3 = Z_2Q
+}
+
+// 6M + 4A; see sb_mont_point_diff_add
+static void sb_mont_x25519_point_diff_add(sb_mont_x25519_ladder_t l[static const 1])
+{
+    sb_fe25519_add(&l->t6, &l->x_1, &l->z_1); // t6 = x_1 + z_1 = v_0
+    sb_fe25519_mult(&l->t8, &l->t7, &l->t6); // t8 = v_1 * v_0 = v_1
+
+    sb_fe25519_sub(&l->x_1, &l->x_1, &l->z_1); // t3 = x_1 - z_1 = v_0
+    sb_fe25519_mult(&l->t6, &l->t5, &l->x_1); // t6 = v_2 * v_0 = v_2
+
+    sb_fe25519_add(&l->t5, &l->t8, &l->t6); // t5 = v_1 + v_2 = v_3
+    sb_fe25519_square(&l->t7, &l->t5); // t7 = v_3^2 = v_3
+
+    sb_fe25519_sub(&l->t5, &l->t8, &l->t6); // t5 = v_1 - v_2 = v_4
+    sb_fe25519_square(&l->t6, &l->t5); // t6 = v_4^2 = v_4
+
+    sb_fe25519_mult(&l->x_1, &l->z_p, &l->t7); // x_1 = z_p * v_3
+    sb_fe25519_mult(&l->z_1, &l->x_p, &l->t6); // z_1 = x_p * v_4
+}
+
+// See sb_mont_point_mult below for a description of the method.
+static sb_error_t
+sb_mont_point_mult(sb_mont_context_t c[static const 1],
+                   const sb_mont_curve_t m[static const 1])
+{
+    sb_mont_x25519_ladder_t* const l = &c->l;
+    sb_word_t swap = 0;
+    sb_bitcount_t t;
+
+    SB_ASSERT(m == &SB_CURVE_X25519, "radix 2^51 arithmetic is specific to "
+        "curve25519");
+
+    sb_fe25519_from_fe(&l->x_0, &c->x_p);
+
+    // Temporarily store the initial Z in z_1
+    sb_fe25519_from_fe(&l->z_1, &c->z_p);
+
+    l->z_0 = SB_FE25519_ONE;
+
+    // Multiply the input point by the cofactor:
+    for (t = 0; t < 3; t++) {
+        sb_mont_x25519_point_double(l);
+    }
+
+    // If z_0 == 0 then this was a small-order point! x_p is no longer needed
+    // and is used to hold the quasi-reduced z_0.
+    sb_fe25519_to_fe(&c->x_p, &l->z_0);
+    if (sb_fe_equal(&c->x_p, &m->p->p)) {
+        return SB_ERROR_PUBLIC_KEY_INVALID;
+    }
+
+    // Apply the initial Z
+    sb_fe25519_mult(&l->x_p, &l->x_0, &l->z_1);
+    sb_fe25519_mult(&l->z_p, &l->z_0, &l->z_1);
+
+    l->x_0 = l->x_p;
+    l->z_0 = l->z_p;
+
+    // bit 254 is always set, so the ladder starts at h * P, 2 * h * P
+    sb_mont_x25519_point_double(l);
+    l->x_1 = l->x_p;
+    l->z_1 = l->z_p;
+    swap = 1; // equivalent to swapping (x_0, z_0) and (x_1, z_1)
+
+    for (t = SB_FE_BITS - 3; t > 2; t--) {
+        // 11M + 8A per bit
+        const sb_word_t k_t = sb_fe_test_bit(&c->k, t);
+
+        swap ^= k_t;
+        sb_fe25519_ctswap(swap, &l->x_0, &l->x_1);
+        sb_fe25519_ctswap(swap, &l->z_0, &l->z_1);
+        swap = k_t;
+
+        sb_mont_x25519_point_double(l);
+        sb_mont_x25519_point_diff_add(l);
+    }
+
+    sb_fe25519_ctswap(swap, &l->x_0, &l->x_1);
+    sb_fe25519_ctswap(swap, &l->z_0, &l->z_1);
+
+#if SB_FE_SAFEGCD_INVERSION
+    // safegcd is much faster than the addition chain; x_p is no longer needed
+    sb_fe25519_to_fe(&c->x_p, &l->z_0);
+    sb_fe_mod_inv_safegcd(&c->x_p, m->p);
+    sb_fe25519_from_fe(&l->z_1, &c->x_p); // z_1 = z_0 ^ -1
+#else
+    sb_fe25519_inv(&l->z_1, &l->z_0, l); // z_1 = z_0 ^ -1
+#endif
+    sb_fe25519_mult(&l->x_1, &l->x_0, &l->z_1); // x_1 = x_0 * z_0 ^ -1
+    sb_fe25519_to_fe(&c->x_p, &l->x_1);
+
+    return 0;
+}
+
+#else
+
+// X25519 is the only supported Montgomery curve, so the ladder calls the
+// instances of the field routines for its prime directly; see
+// sb_fe_field_value_t in sb_fe.h.
+
 // 5MM + 4A
 // See Costello and Smith 2017, Algorithm 2 (xDBL)
 // Input: Q = (x_0, z_0)
@@ -25,25 +403,27 @@
 static void sb_mont_point_double(sb_mont_context_t c[static const 1],
                                  sb_mont_curve_t const m[static const 1])
 {
+    SB_ASSERT(m->p == &SB_CURVE_X25519_P, "only X25519 is supported");
+
     // t1 = x_0, t2 = z_0, t3 = x_1, t4 = z_1
-    sb_fe_mod_add(&c->t5, &c->x_0, &c->z_0, m->p); // t5 = x_0 + z_0 = v_1
-    sb_fe_mont_square(&c->t6, &c->t5, m->p); // t6 = v_1^2 = v_1
+    sb_fe_mod_add_x25519(&c->t5, &c->x_0, &c->z_0); // t5 = x_0 + z_0 = v_1
+    sb_fe_mont_square_x25519(&c->t6, &c->t5); // t6 = v_1^2 = v_1
 
-    sb_fe_mod_sub(&c->z_0, &c->x_0, &c->z_0, m->p); // t2 = x_0 - z_0 = v_2
-    sb_fe_mont_square(&c->t7, &c->z_0, m->p); // t7 = v_2^2 = v_2
+    sb_fe_mod_sub_x25519(&c->z_0, &c->x_0, &c->z_0); // t2 = x_0 - z_0 = v_2
+    sb_fe_mont_square_x25519(&c->t7, &c->z_0); // t7 = v_2^2 = v_2
 
-    sb_fe_mont_mult(&c->x_0, &c->t6, &c->t7, m->p); // x_0 = v_1 * v_2 = X_2Q
+    sb_fe_mont_mult_x25519(&c->x_0, &c->t6, &c->t7); // x_0 = v_1 * v_2 = X_2Q
 
-    sb_fe_mod_sub(&c->t6, &c->t6, &c->t7, m->p); // t6 = v_1 - v_2 = v_1
-    sb_fe_mont_mult(&c->t8, &m->a24_r, &c->t6, m->p);
+    sb_fe_mod_sub_x25519(&c->t6, &c->t6, &c->t7); // t6 = v_1 - v_2 = v_1
+    sb_fe_mont_mult_x25519(&c->t8, &m->a24_r, &c->t6);
     // t8 = ((A + 2) / 4) * v_1 = v_3
-    sb_fe_mod_add(&c->t8, &c->t8, &c->t7, m->p); // t8 = v_3 + v_2 = v_3
+    sb_fe_mod_add_x25519(&c->t8, &c->t8, &c->t7); // t8 = v_3 + v_2 = v_3
 
     c->t7 = c->z_0;
     // t7 = (x_Q - z_Q), saved for use in the differential addition portion of
     // the ladder
 
-    sb_fe_mont_mult(&c->z_0, &c->t6, &c->t8, m->p); // z_0 = v_1 * v_3 = Z_2Q
+    sb_fe_mont_mult_x25519(&c->z_0, &c->t6, &c->t8); // z_0 = v_1 * v_3 = Z_2Q
 }
 
 // 6MM + 4A
@@ -51,27 +431,26 @@ static void sb_mont_point_double(sb_mont_context_t c[static const 1],
 // values already computed in xDBL
 // Input: P = (x_1, z_1); x_Q + z_Q = t5; x_Q - z_Q = t7, P - Q = (x_p, z_p)
 // Output: P + Q = (x_1, z_1)
-static void sb_mont_point_diff_add(sb_mont_context_t c[static const 1],
-                                   sb_mont_curve_t const m[static const 1])
+static void sb_mont_point_diff_add(sb_mont_context_t c[static const 1])
 {
     // t1 = x_0, t2 = z_0, t3 = x_1, t4 = z_1
-    sb_fe_mod_add(&c->t6, &c->x_1, &c->z_1, m->p); // t6 = x_1 + z_1 = v_0
+    sb_fe_mod_add_x25519(&c->t6, &c->x_1, &c->z_1); // t6 = x_1 + z_1 = v_0
     // v_1 = x_Q - z_Q = t7
-    sb_fe_mont_mult(&c->t8, &c->t7, &c->t6, m->p); // t8 = v_1 * v_0 = v_1
+    sb_fe_mont_mult_x25519(&c->t8, &c->t7, &c->t6); // t8 = v_1 * v_0 = v_1
 
-    sb_fe_mod_sub(&c->x_1, &c->x_1, &c->z_1, m->p); // t3 = x_1 - z_1 = v_0
+    sb_fe_mod_sub_x25519(&c->x_1, &c->x_1, &c->z_1); // t3 = x_1 - z_1 = v_0
     // v_2 = x_Q + z_Q = t5
-    sb_fe_mont_mult(&c->t6, &c->t5, &c->x_1, m->p); // t6 = v_2 * v_0 = v_2
+    sb_fe_mont_mult_x25519(&c->t6, &c->t5, &c->x_1); // t6 = v_2 * v_0 = v_2
 
-    sb_fe_mod_add(&c->t5, &c->t8, &c->t6, m->p); // t5 = v_1 + v_2 = v_3
+    sb_fe_mod_add_x25519(&c->t5, &c->t8, &c->t6); // t5 = v_1 + v_2 = v_3
 
-    sb_fe_mont_square(&c->t7, &c->t5, m->p); // t7 = v_3^2 = v_3
+    sb_fe_mont_square_x25519(&c->t7, &c->t5); // t7 = v_3^2 = v_3
 
-    sb_fe_mod_sub(&c->t5, &c->t8, &c->t6, m->p); // t5 = v_1 - v_2 = v_4
-    sb_fe_mont_square(&c->t6, &c->t5, m->p); // t6 = v_4^2 = v_4
+    sb_fe_mod_sub_x25519(&c->t5, &c->t8, &c->t6); // t5 = v_1 - v_2 = v_4
+    sb_fe_mont_square_x25519(&c->t6, &c->t5); // t6 = v_4^2 = v_4
 
-    sb_fe_mont_mult(&c->x_1, &c->z_p, &c->t7, m->p); // x_1 = z_p * v_3
-    sb_fe_mont_mult(&c->z_1, &c->x_p, &c->t6, m->p); // z_1 = x_p * v_4
+    sb_fe_mont_mult_x25519(&c->x_1, &c->z_p, &c->t7); // x_1 = z_p * v_3
+    sb_fe_mont_mult_x25519(&c->z_1, &c->x_p, &c->t6); // z_1 = x_p * v_4
 
 }
 
@@ -146,7 +525,7 @@ sb_mont_point_mult(sb_mont_context_t c[static const 1],
         swap = k_t;
 
         sb_mont_point_double(c, m);
-        sb_mont_point_diff_add(c, m);
+        sb_mont_point_diff_add(c);
     }
 
     sb_fe_ctswap(swap, &c->x_0, &c->x_1);
@@ -160,6 +539,8 @@ sb_mont_point_mult(sb_mont_context_t c[static const 1],
     return 0;
 }
 
+#endif
+
 #ifdef SB_TEST
 
 static _Bool test_mont_point_mult(const sb_fe_t* const g,
@@ -229,6 +610,85 @@ _Bool sb_test_mont_point_mult(void)
     return res;
 }
 
+// Checks the radix 2^51 field arithmetic against the generic field routines
+_Bool sb_test_mont_radix_51(void)
+{
+#if SB_MONT_X25519_RADIX_51
+    const sb_prime_field_t* const p = &SB_CURVE_X25519_P;
+    static const sb_fe_t two = SB_FE_CONST(0, 0, 0, 2);
+    static const sb_fe_t a24 = SB_FE_CONST(0, 0, 0, 121666);
+    static const sb_fe_t a5 = SB_FE_CONST(0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55,
+                                          0x55AA55AA55AA55AA,
+                                          0xAA55AA55AA55AA55);
+    sb_mont_context_t c;
+    sb_mont_x25519_ladder_t* const l = &c.l;
+    sb_fe_t x, y, t, t2, t3;
+
+    // (p - 1) * (p - 2) = 2, and p itself is zero
+    x = p->p;
+    sb_fe_sub(&x, &x, &SB_FE_ONE);
+    y = x;
+    sb_fe_sub(&y, &y, &SB_FE_ONE);
+    sb_fe25519_from_fe(&l->x_0, &x);
+    sb_fe25519_from_fe(&l->z_0, &y);
+    sb_fe25519_mult(&l->x_1, &l->x_0, &l->z_0);
+    sb_fe25519_to_fe(&t, &l->x_1);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &two));
+    sb_fe25519_from_fe(&l->x_0, &p->p);
+    sb_fe25519_to_fe(&t, &l->x_0);
+    SB_TEST_ASSERT(sb_fe_equal(&t, &p->p));
+
+    y = a5;
+    for (size_t i = 0; i < 256; i++) {
+        sb_fe25519_from_fe(&l->x_0, &x);
+        sb_fe25519_from_fe(&l->z_0, &y);
+
+        // x * y, computed as x * y * R^-1 * R^2 * R^-1 in the generic field
+        sb_fe_mont_mult(&t2, &x, &y, p);
+        sb_fe_mont_mult(&t, &t2, &p->r2_mod_p, p);
+        sb_fe25519_mult(&l->x_1, &l->x_0, &l->z_0);
+        sb_fe25519_to_fe(&t2, &l->x_1);
+        SB_TEST_ASSERT(sb_fe_equal(&t, &t2));
+
+        // x^2
+        sb_fe25519_mult(&l->t5, &l->x_0, &l->x_0);
+        sb_fe25519_square(&l->t6, &l->x_0);
+        SB_TEST_ASSERT_EQUAL(l->t5, l->t6);
+
+        // (x * y + x) * (x * y - x) with unreduced limbs; x_1 = t = x * y
+        sb_fe25519_add(&l->t5, &l->x_1, &l->x_0);
+        sb_fe25519_sub(&l->t6, &l->x_1, &l->x_0);
+        sb_fe25519_mult(&l->t7, &l->t5, &l->t6);
+        sb_fe_mod_add(&t2, &t, &x, p);
+        sb_fe_mod_sub(&t3, &t, &x, p);
+        sb_fe_mont_mult(&y, &t2, &t3, p);
+        sb_fe_mont_mult(&t3, &y, &p->r2_mod_p, p);
+        sb_fe25519_to_fe(&t2, &l->t7);
+        SB_TEST_ASSERT(sb_fe_equal(&t2, &t3));
+
+        // x * ((A + 2) / 4)
+        sb_fe25519_mult_a24(&l->t5, &l->x_0);
+        sb_fe25519_to_fe(&t2, &l->t5);
+        sb_fe_mont_mult(&y, &x, &a24, p);
+        sb_fe_mont_mult(&t3, &y, &p->r2_mod_p, p);
+        SB_TEST_ASSERT(sb_fe_equal(&t2, &t3));
+
+        // x * x^-1 = 1
+        if (i % 32 == 0) {
+            sb_fe25519_inv(&l->x_p, &l->x_0, l);
+            sb_fe25519_mult(&l->z_p, &l->x_p, &l->x_0);
+            sb_fe25519_to_fe(&t2, &l->z_p);
+            SB_TEST_ASSERT(sb_fe_equal(&t2, &SB_FE_ONE));
+        }
+
+        y = x;
+        x = t;
+    }
+#endif
+    return 1;
+}
+
 #endif
 
 // curve25519 private keys are 251 bits; the lowest three bits are zeroed to
@@ -18,6 +18,7 @@
 #include "sb_fe.h"
 #include "sb_hmac_drbg.h"
 #include "sb_sw_lib.h"
+#include "sb_sw_fixed_base.h"
 
 #if defined(SB_TEST) && !(SB_SW_P256_SUPPORT && SB_SW_SECP256K1_SUPPORT)
 #error "Both SB_SW_P256_SUPPORT and SB_SW_SECP256K1_SUPPORT must be enabled for tests!"
@@ -30,17 +31,74 @@
 // is -a * R * 3^-1. For P256, this is just R. For secp256k1,
 // this is p.
 
+// Here R is the Montgomery constant of the field p; see sb_prime_field_t in
+// sb_fe.h. If the field uses a prime-specific reduction method, R is 1.
+
+#if SB_SW_GLV_WINDOW || SB_SW_VARTIME_SUPPORT
+
+// Constants for multiplication using an endomorphism phi(x, y) = (beta * x, y)
+// which acts on the group as multiplication by lambda. The lattice vectors
+// (a1, b1) and (a2, b2) satisfy a + b * lambda = 0 mod N; see
+// sb_sw_point_mult_glv in sb_sw_lib.c. None of these values is multiplied by
+// R, so that the same constants serve fields with any reduction method.
+typedef struct sb_sw_glv_t {
+    sb_fe_t beta; // A cube root of unity mod P
+    sb_fe_t lambda; // The corresponding cube root of unity mod N
+    sb_fe_t g1; // round(2^384 * b2 / N)
+    sb_fe_t g2; // round(2^384 * -b1 / N)
+    sb_fe_t minus_b1; // -b1 mod N
+    sb_fe_t minus_b2; // -b2 mod N
+    sb_fe_t v1[2]; // (a1, b1) mod N, both odd as integers
+    sb_fe_t v2[2]; // (a2, b2) mod N, with a2 even and b2 odd
+#if SB_SW_VARTIME_SUPPORT
+    // Odd multiples of lambda * G for variable-time verification
+    const sb_fe_t (*lambda_g_odd)[2];
+#endif
+} sb_sw_glv_t;
+
+#endif
+
 typedef struct sb_sw_curve_t {
     const sb_prime_field_t* p; // The prime field which the curve is defined over
     const sb_prime_field_t* n; // The prime order of the group, used for scalar computations
     sb_fe_t minus_a; // -a (3 for P256, 0 for secp256k1)
     const sb_fe_t* minus_a_r_over_three; // R for P256, 0 for secp256k1
     sb_fe_t b; // b ("random" for P256, 7 for secp256k1)
+    _Bool a_zero; // Whether a is 0 rather than -3; see SB_SW_CURVE_A_ZERO
     sb_fe_t g_r[2]; // The generator for the group, with X and Y multiplied by R
     sb_fe_t h_r[2]; // H = (2^257 - 1)^-1 * G, with X and Y multiplied by R
     sb_fe_t g_h_r[2]; // G + H, with X and Y multiplied by R
+#if SB_SW_FIXED_BASE_WINDOW
+    // Comb table for fixed-base multiplication of G; see sb_sw_fixed_base.h
+    const sb_fe_t (*g_comb)[2];
+#endif
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    // b * R (P256) or 3 * b * R (secp256k1), for the complete formulas
+    sb_fe_t complete_b_r;
+#endif
+#if SB_SW_VARTIME_SUPPORT
+    // Odd multiples of G for variable-time verification
+    const sb_fe_t (*g_odd)[2];
+#endif
+#if SB_SW_GLV_WINDOW || SB_SW_VARTIME_SUPPORT
+    // Endomorphism constants, or NULL if the curve has no such endomorphism
+    const sb_sw_glv_t* glv;
+#endif
 } sb_sw_curve_t;
 
+// Point doubling is specialized for the shape of the curve: for a = -3,
+// 3 * X^2 + a * Z^4 = 3 * (X - Z^2) * (X + Z^2), and for a = 0, the a * Z^4
+// term vanishes. If only one curve is supported, the shape is known at
+// compile time, and the formulas for the other shape are omitted.
+#if SB_SW_P256_SUPPORT && SB_SW_SECP256K1_SUPPORT
+#define SB_SW_CURVE_A_ZERO(s) ((s)->a_zero)
+#elif SB_SW_SECP256K1_SUPPORT
+#define SB_SW_CURVE_A_ZERO(s) 1
+#else
+#define SB_SW_CURVE_A_ZERO(s) 0
+#endif
+
 #if SB_SW_P256_SUPPORT
 
 // P256 is defined over F(p) where p is the Solinas prime
@@ -63,9 +121,35 @@ static const sb_prime_field_t SB_CURVE_P256_P = {
                             0xFFFFFFFBFFFFFFFF, 0x0000000000000003),
     .r_mod_p = SB_FE_CONST(0x00000000FFFFFFFE, 0xFFFFFFFFFFFFFFFF,
                            0xFFFFFFFF00000000, 0x0000000000000001),
-    .bits = 256
+    .bits = 256,
+    // p - 2 is 32 ones, 31 zeros, 1, 96 zeros, 94 ones, 0, 1
+    .inv_run = 31,
+#if !SB_FE_P256_FAST_REDUCTION
+    .field = SB_FE_FIELD_P256
+#endif
+};
+
+#if SB_FE_P256_FAST_REDUCTION
+
+// The same field, using FIPS 186-4 fast reduction instead of Montgomery
+// reduction. In this field, R is 1, and p_mp is not used.
+static const sb_prime_field_t SB_CURVE_P256_P_FAST = {
+    .p = SB_FE_CONST(0xFFFFFFFF00000001, 0x0000000000000000,
+                     0x00000000FFFFFFFF, 0xFFFFFFFFFFFFFFFF),
+    .p_minus_two_f1 =
+        SB_FE_CONST(0x00000000F04D3168, 0xCA47D4443B0552EC,
+                    0x999CB770B4B62944, 0x6571423119245693),
+    .p_minus_two_f2 = SB_FE_CONST(0, 0, 0, 0x110B9592F),
+    .r2_mod_p = SB_FE_CONST(0, 0, 0, 1),
+    .r_mod_p = SB_FE_CONST(0, 0, 0, 1),
+    .bits = 256,
+    .reduction = SB_FE_REDUCTION_P256,
+    .inv_run = 31,
+    .field = SB_FE_FIELD_P256
 };
 
+#endif
+
 // The prime order of the P256 group
 static const sb_prime_field_t SB_CURVE_P256_N = {
     .p = SB_FE_CONST(0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFF,
@@ -88,16 +172,58 @@ static const sb_prime_field_t SB_CURVE_P256_N = {
     .r_mod_p =
         SB_FE_CONST(0x00000000FFFFFFFF, 0x0000000000000000,
                     0x4319055258E8617B, 0x0C46353D039CDAAF),
-    .bits = 256
+    .bits = 256,
+    // p - 2 is 32 ones, 32 zeros, 64 ones, and 128 irregular bits
+    .inv_run = 32,
+    .inv_window = 128
 };
 
 static const sb_sw_curve_t SB_CURVE_P256 = {
-    .p = &SB_CURVE_P256_P,
     .n = &SB_CURVE_P256_N,
     .minus_a = SB_FE_CONST(0, 0, 0, 3),
-    .minus_a_r_over_three = &SB_CURVE_P256_P.r_mod_p,
     .b = SB_FE_CONST(0x5AC635D8AA3A93E7, 0xB3EBBD55769886BC,
                      0x651D06B0CC53B0F6, 0x3BCE3C3E27D2604B),
+#if SB_SW_FIXED_BASE_WINDOW
+    .g_comb = SB_CURVE_P256_G_COMB,
+#endif
+#if SB_SW_VARTIME_SUPPORT
+    .g_odd = SB_CURVE_P256_G_ODD,
+#endif
+    // The remaining members depend on the field's reduction method
+#if SB_FE_P256_FAST_REDUCTION
+    .p = &SB_CURVE_P256_P_FAST,
+    .minus_a_r_over_three = &SB_CURVE_P256_P_FAST.r_mod_p,
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    .complete_b_r = SB_FE_CONST(0x5AC635D8AA3A93E7, 0xB3EBBD55769886BC,
+                                0x651D06B0CC53B0F6, 0x3BCE3C3E27D2604B),
+#endif
+    .g_r = {
+        SB_FE_CONST(0x6B17D1F2E12C4247, 0xF8BCE6E563A440F2,
+                    0x77037D812DEB33A0, 0xF4A13945D898C296),
+        SB_FE_CONST(0x4FE342E2FE1A7F9B, 0x8EE7EB4A7C0F9E16,
+                    0x2BCE33576B315ECE, 0xCBB6406837BF51F5)
+    },
+    .h_r = {
+        SB_FE_CONST(0x4BE78E44A0F8A725, 0x15A7416F808D1AF3,
+                    0x603DD49482861E63, 0x5A2C5823D2ED5B69),
+        SB_FE_CONST(0x0CC11EE751E0CA96, 0x624C54E2F80D364C,
+                    0x285036D7D207E0DA, 0x25E4BE09F8B342D5)
+    },
+    .g_h_r = {
+        SB_FE_CONST(0xE3F1C66E48D1FB9A, 0x97CE63B502CB241C,
+                    0xFD8007C079D2DB2D, 0x79D2EC98A812D18B),
+        SB_FE_CONST(0xA014AE5931F7223A, 0xE89B71B06CFF7F45,
+                    0x4AEB4262BCCCA407, 0xA4F156DA4D56BA6F)
+    }
+#else
+    .p = &SB_CURVE_P256_P,
+    .minus_a_r_over_three = &SB_CURVE_P256_P.r_mod_p,
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    .complete_b_r = SB_FE_CONST(0xDC30061D04874834, 0xE5A220ABF7212ED6,
+                                0xACF005CD78843090, 0xD89CDF6229C4BDDF),
+#endif
     .g_r = {
         SB_FE_CONST(0x18905F76A53755C6, 0x79FB732B77622510,
                     0x75BA95FC5FEDB601, 0x79E730D418A9143C),
@@ -116,6 +242,7 @@ static const sb_sw_curve_t SB_CURVE_P256 = {
         SB_FE_CONST(0xD041EE1CCC6223C9, 0xCD81EFC57B6F0943,
                     0xC614355C4D10A425, 0x3A1739581FCABBB7)
     }
+#endif
 };
 
 #endif
@@ -144,9 +271,35 @@ static const sb_prime_field_t SB_CURVE_SECP256K1_P = {
     .r_mod_p =
         SB_FE_CONST(0, 0, 0, 0x1000003D1),
 
-    .bits = 256
+    .bits = 256,
+    // p - 2 is 223 ones, 0, 22 ones, 0000101101
+    .inv_run = 22,
+#if !SB_FE_SECP256K1_FAST_REDUCTION
+    .field = SB_FE_FIELD_SECP256K1
+#endif
+};
+
+#if SB_FE_SECP256K1_FAST_REDUCTION
+
+// The same field, reduced by folding with 2^256 = 0x1000003D1 mod p instead
+// of Montgomery reduction. In this field, R is 1, and p_mp is not used.
+static const sb_prime_field_t SB_CURVE_SECP256K1_P_FAST = {
+    .p = SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
+                     0xFFFFFFFFFFFFFFFF, 0xFFFFFFFEFFFFFC2F),
+    .p_minus_two_f1 =
+        SB_FE_CONST(0, 0, 0x037F6FF774E142D5, 0xC004A68677B5D811),
+    .p_minus_two_f2 = SB_FE_CONST(0, 0x49,
+                                  0x30562E37A2A6A014, 0x99B40D0074369E5D),
+    .r2_mod_p = SB_FE_CONST(0, 0, 0, 1),
+    .r_mod_p = SB_FE_CONST(0, 0, 0, 1),
+    .bits = 256,
+    .reduction = SB_FE_REDUCTION_SECP256K1,
+    .inv_run = 22,
+    .field = SB_FE_FIELD_SECP256K1
 };
 
+#endif
+
 // The prime order of the secp256k1 group:
 static const sb_prime_field_t SB_CURVE_SECP256K1_N = {
     .p = SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFE,
@@ -166,16 +319,92 @@ static const sb_prime_field_t SB_CURVE_SECP256K1_N = {
                             0x741496C20E7CF878, 0x896CF21467D7D140),
     .r_mod_p = SB_FE_CONST(0x0000000000000000, 0x0000000000000001,
                            0x4551231950B75FC4, 0x402DA1732FC9BEBF),
-    .bits = 256
+    .bits = 256,
+    // p - 2 is 127 ones, 0, and 128 irregular bits
+    .inv_run = 127,
+    .inv_window = 129
+};
+
+#if SB_SW_GLV_WINDOW || SB_SW_VARTIME_SUPPORT
+
+// The constants of Gallant, Lambert, and Vanstone (2001) for secp256k1, as
+// used by libsecp256k1.
+static const sb_sw_glv_t SB_CURVE_SECP256K1_GLV = {
+    .beta = SB_FE_CONST(0x7AE96A2B657C0710, 0x6E64479EAC3434E9,
+                        0x9CF0497512F58995, 0xC1396C28719501EE),
+    .lambda = SB_FE_CONST(0x5363AD4CC05C30E0, 0xA5261C028812645A,
+                          0x122E22EA20816678, 0xDF02967C1B23BD72),
+    .g1 = SB_FE_CONST(0x3086D221A7D46BCD, 0xE86C90E49284EB15,
+                      0x3DAA8A1471E8CA7F, 0xE893209A45DBB031),
+    .g2 = SB_FE_CONST(0xE4437ED6010E8828, 0x6F547FA90ABFE4C4,
+                      0x221208AC9DF506C6, 0x1571B4AE8AC47F71),
+    .minus_b1 = SB_FE_CONST(0, 0, 0xE4437ED6010E8828, 0x6F547FA90ABFE4C3),
+    .minus_b2 = SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFE,
+                            0x8A280AC50774346D, 0xD765CDA83DB1562C),
+    .v1 = {
+        SB_FE_CONST(0, 0, 0x3086D221A7D46BCD, 0xE86C90E49284EB15),
+        SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFD,
+                    0xD66B5E10AE3A1813, 0x507DDEE3C5765C7E)
+    },
+    .v2 = {
+        SB_FE_CONST(0, 0x1, 0x14CA50F7A8E2F3F6, 0x57C1108D9D44CFD8),
+        SB_FE_CONST(0, 0, 0x3086D221A7D46BCD, 0xE86C90E49284EB15)
+    },
+#if SB_SW_VARTIME_SUPPORT
+    .lambda_g_odd = SB_CURVE_SECP256K1_LAMBDA_G_ODD,
+#endif
 };
 
+#endif
+
 static const sb_sw_curve_t SB_CURVE_SECP256K1 = {
-    .p = &SB_CURVE_SECP256K1_P,
     .n = &SB_CURVE_SECP256K1_N,
     .minus_a = SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
                            0xFFFFFFFFFFFFFFFF, 0xFFFFFFFEFFFFFC2F),
-    .minus_a_r_over_three = &SB_CURVE_SECP256K1_P.p,
     .b = SB_FE_CONST(0, 0, 0, 7),
+    .a_zero = 1,
+#if SB_SW_FIXED_BASE_WINDOW
+    .g_comb = SB_CURVE_SECP256K1_G_COMB,
+#endif
+#if SB_SW_VARTIME_SUPPORT
+    .g_odd = SB_CURVE_SECP256K1_G_ODD,
+#endif
+#if SB_SW_GLV_WINDOW || SB_SW_VARTIME_SUPPORT
+    .glv = &SB_CURVE_SECP256K1_GLV,
+#endif
+    // The remaining members depend on the field's reduction method
+#if SB_FE_SECP256K1_FAST_REDUCTION
+    .p = &SB_CURVE_SECP256K1_P_FAST,
+    .minus_a_r_over_three = &SB_CURVE_SECP256K1_P_FAST.p,
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    .complete_b_r = SB_FE_CONST(0, 0, 0, 21),
+#endif
+    .g_r = {
+        SB_FE_CONST(0x79BE667EF9DCBBAC, 0x55A06295CE870B07,
+                    0x029BFCDB2DCE28D9, 0x59F2815B16F81798),
+        SB_FE_CONST(0x483ADA7726A3C465, 0x5DA4FBFC0E1108A8,
+                    0xFD17B448A6855419, 0x9C47D08FFB10D4B8)
+    },
+    .h_r = {
+        SB_FE_CONST(0x69E4CDDE0E6BEC69, 0xB1EDBD4E4720DC2F,
+                    0x7FB0690D88827FA7, 0x94BD9FA591EEABEA),
+        SB_FE_CONST(0xC82694A9E65B7D47, 0x9A119983A81E7A93,
+                    0x265E015089AED2CA, 0x2F3101B6623C0723)
+    },
+    .g_h_r = {
+        SB_FE_CONST(0x8082E4960843AE5D, 0x37B504BD526BFE0B,
+                    0x39A4E57D179F83CC, 0x362B4A8091EE9AD8),
+        SB_FE_CONST(0xDECE2F00EED81789, 0x979C11CF210220AA,
+                    0xBED140628B22BFB7, 0x3343107E41B493AC)
+    }
+#else
+    .p = &SB_CURVE_SECP256K1_P,
+    .minus_a_r_over_three = &SB_CURVE_SECP256K1_P.p,
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    .complete_b_r = SB_FE_CONST(0, 0, 0, 0x1500005025),
+#endif
     .g_r = {
         SB_FE_CONST(0x9981E643E9089F48, 0x979F48C033FD129C,
                     0x231E295329BC66DB, 0xD7362E5A487E2097),
@@ -194,6 +423,7 @@ static const sb_sw_curve_t SB_CURVE_SECP256K1 = {
         SB_FE_CONST(0x3FB97A191E4DE5EA, 0xBBA21827B7EFEC04,
                     0xC7B977CC32E0BAA9, 0xC374BB2A1315A22F)
     }
+#endif
 };
 
 #endif
@@ -0,0 +1,1061 @@
+/*
+ * sb_sw_fixed_base.h: private precomputed tables for fixed-base scalar
+ * multiplication of the generators of the supported short Weierstrass curves
+ *
+ * This file is part of Sweet B, a safe, compact, embeddable elliptic curve
+ * cryptography library.
+ *
+ * Sweet B is provided under the terms of the included LICENSE file. All
+ * other rights are reserved.
+ *
+ * Copyright 2017 Wearable Inc.
+ *
+ */
+
+#ifndef SB_SW_FIXED_BASE_H
+#define SB_SW_FIXED_BASE_H
+
+#include "sb_fe.h"
+#include "sb_sw_lib.h"
+
+#if SB_SW_FIXED_BASE_WINDOW
+
+// Multiplication of the generator G uses a signed comb with
+// SB_SW_FIXED_BASE_WINDOW teeth spaced SB_SW_FIXED_BASE_SPACING bits apart;
+// see sb_sw_point_mult_base in sb_sw_lib.c. The spacing is the smallest such
+// that the comb covers 256 bits.
+
+#if SB_SW_FIXED_BASE_WINDOW == 4
+#define SB_SW_FIXED_BASE_SPACING 64
+#elif SB_SW_FIXED_BASE_WINDOW == 5
+#define SB_SW_FIXED_BASE_SPACING 52
+#elif SB_SW_FIXED_BASE_WINDOW == 6
+#define SB_SW_FIXED_BASE_SPACING 43
+#else
+#error "SB_SW_FIXED_BASE_WINDOW must be 0, 4, 5, or 6"
+#endif
+
+// Let w be SB_SW_FIXED_BASE_WINDOW and d be SB_SW_FIXED_BASE_SPACING. Entry j
+// of a comb table is the affine point
+//   (2^((w - 1) * d) + sum_{l < w - 1} (2 * j_l - 1) * 2^(l * d)) * G
+// where j_l is bit l of j. Coordinates are NOT multiplied by R, so that the
+// same table serves fields with Montgomery reduction and with fast reduction.
+
+#if SB_SW_P256_SUPPORT
+
+static const sb_fe_t SB_CURVE_P256_G_COMB[SB_SW_FIXED_BASE_ENTRIES][2] = {
+#if SB_SW_FIXED_BASE_WINDOW == 4
+    {
+        SB_FE_CONST(0xDCA746348411AFB5, 0x7A941B3100C7462E,
+                    0xC7DD307902D88340, 0x2C147BD3023E0A99),
+        SB_FE_CONST(0xA378F49C3C6073E0, 0xEFA230D38E2875B6,
+                    0xD170FE410060632C, 0x47B0D520235F3FB0)
+    },
+    {
+        SB_FE_CONST(0x47B8C15B59312390, 0x87F51BCFA6C75133,
+                    0x24FC081AD4E6E5C5, 0xF7447E16E0B9010A),
+        SB_FE_CONST(0xEAB69CFCB27BCED9, 0x1DE9C2EAD61AA5C0,
+                    0xC8CB9D1BC2FAA827, 0x5D8A5A16D7B4B792)
+    },
+    {
+        SB_FE_CONST(0x39F2E126E7A90157, 0xAFF955E975A52979,
+                    0x4FCFDE2A0FCB47E3, 0x8DB221505B370B39),
+        SB_FE_CONST(0x2FE3918B81BAC5C2, 0x034CFC1D65141B26,
+                    0x6FDAB9FB481DE5AC, 0xC13C7A63865122BA)
+    },
+    {
+        SB_FE_CONST(0xB98668C64A1D889B, 0x37B0901718355237,
+                    0x43726C12F9021BC1, 0xDBD40B537699E898),
+        SB_FE_CONST(0x04EF5FA9A113F297, 0xC8DAA7515DA9F656,
+                    0x4EC8476537C48F4E, 0xC894A7323A913C3D)
+    },
+    {
+        SB_FE_CONST(0x8399D76DF70660CB, 0x574AF433F51B14F0,
+                    0xACCBD9E5A6C902A9, 0x7342E89B4C02FAA6),
+        SB_FE_CONST(0xA08F6B5156ECB1CC, 0x58EF27C62016D4C8,
+                    0x7A47E013C6875872, 0x74C93F9BE68BA2BA)
+    },
+    {
+        SB_FE_CONST(0x61302D5D508FDC2E, 0x7F8ED508A43B83B7,
+                    0x0BA6D2F4E0103C59, 0xD14F8EAD7DB8CAB2),
+        SB_FE_CONST(0x6C584E7F2CC4A029, 0x0410B88323E6DE42,
+                    0x70750B1D46B0F759, 0xEBD1782FB01280C1)
+    },
+    {
+        SB_FE_CONST(0x8781FBDAFC931410, 0xB414F9CEE81FF10C,
+                    0x45E388A81FD9D03D, 0xE47C247D3CE742EB),
+        SB_FE_CONST(0x3EB35234FA6ADA4C, 0xBFE61EE20C945128,
+                    0xCADA9AD59713E7CA, 0xA87B2111082CA20D)
+    },
+    {
+        SB_FE_CONST(0xB48E26B484F7A21C, 0x0A4A46FB6AAF363A,
+                    0x66B0DE3225C4744B, 0x9615B5110D1D78E5),
+        SB_FE_CONST(0xFAC015404D4D3DAB, 0x64131BCDFED6F668,
+                    0xC004E4048B7B0F98, 0x06EBB0F621A01B2D)
+    }
+#elif SB_SW_FIXED_BASE_WINDOW == 5
+    {
+        SB_FE_CONST(0x8429DFDD7FD081C5, 0xC70C60AD4ACDA0CB,
+                    0xF88C60C83A22AAD4, 0xF95276D2C7E54BEE),
+        SB_FE_CONST(0xC056E544851897E6, 0x8BAE071E20F9FF59,
+                    0x26D82C6B13138832, 0xB6E0094953873020)
+    },
+    {
+        SB_FE_CONST(0x2E8F84BADF5AD6E9, 0x74A95E7292D81B88,
+                    0xBD5692742A566FC8, 0xAA44314CEA4B564A),
+        SB_FE_CONST(0xD44AC55D5438FBAD, 0x45DA9165CD482ECA,
+                    0x411F1CCDB15843F8, 0xD3F6BBE9935C5DAD)
+    },
+    {
+        SB_FE_CONST(0x572D607B2AC9CE9F, 0xEB662CF07DA81DCA,
+                    0x3B086F1F36E65EB5, 0x0E645AC31674DCAB),
+        SB_FE_CONST(0x125EB4AA1BCC9455, 0x1528EB2DDD40CE47,
+                    0x5F6020D9E1451F4E, 0xDAC5F4C125DDA560)
+    },
+    {
+        SB_FE_CONST(0xA4F9F3672C06E4EA, 0xBE4FA309250A6932,
+                    0x7B6D234EC3DA30BB, 0x41618305BCB70552),
+        SB_FE_CONST(0xF76F534825C442E4, 0x5AF9501FA5D98E06,
+                    0x90097CB6052A14AE, 0xB8EBEA26F68D981B)
+    },
+    {
+        SB_FE_CONST(0x3F0C96E6CFEF2213, 0x4CFB0E28646DB607,
+                    0x89AE788C22BD6911, 0xBA9314D9338E58DA),
+        SB_FE_CONST(0xDBFB719192CCC35C, 0x15F3F02B21876FC4,
+                    0xDE2E237AFD6657FA, 0xF966D2B0F3501083)
+    },
+    {
+        SB_FE_CONST(0x7918B03BDE55C5ED, 0xD9FD0DA1643966B8,
+                    0x1065AE57CC8EA358, 0x3E955641B258FBBA),
+        SB_FE_CONST(0x614AF45351EA048B, 0xFB2B863ECDDB9309,
+                    0x543B7DD08E46E993, 0xBC3BAEE5B6870E88)
+    },
+    {
+        SB_FE_CONST(0xAF21E49C72B22479, 0x41FBA49E8E9E8BF3,
+                    0xC5D15A999B4AD9FD, 0x0A3E349410326611),
+        SB_FE_CONST(0xB0110FE5FCAE536C, 0xD200D6FFCF1D4105,
+                    0xD143D59D3EA1116A, 0xF941496213A4B52A)
+    },
+    {
+        SB_FE_CONST(0xD5588A0DC948561B, 0x98465DD3F47BF8EA,
+                    0x0F091A2F86FB8797, 0xCF042714994A5B6E),
+        SB_FE_CONST(0xDAA94E8FA35C551A, 0xE9F649DAC7F7A92F,
+                    0x47F5CB7D42DDC496, 0xDE5B9A419BC74903)
+    },
+    {
+        SB_FE_CONST(0x01E0DE74D86D9BC0, 0x5924F7F090E7F7F9,
+                    0xA8EA75894D6E1737, 0x0968AAA09C6DE2F0),
+        SB_FE_CONST(0xDBBD891F488B2F0A, 0xDBB4CA960AA44E5D,
+                    0x512267AD4A0A4AEF, 0x9B06BF9268AF552B)
+    },
+    {
+        SB_FE_CONST(0x2B51F09A3BD73679, 0xDB3CD8F079C1A3AB,
+                    0xA07EDEC998056827, 0xE7DA7A303EF6F4C1),
+        SB_FE_CONST(0xAD9CE7AB332AB912, 0x966B6BD409315057,
+                    0x61A524F3DFD9FE28, 0x6B4BA19FA45F02E8)
+    },
+    {
+        SB_FE_CONST(0xEB34F08024373A17, 0xD331BCDCC3F5ECEC,
+                    0xAE1600ABC00157B9, 0x0ABB926B8545438A),
+        SB_FE_CONST(0x758FE259A8F93055, 0x5FE24BA3AADB792E,
+                    0xF02CA10ACF0D91CD, 0x57100075B1EF8E14)
+    },
+    {
+        SB_FE_CONST(0xDAB8DDDC24DA6438, 0x1AEBF43CDD9EBE66,
+                    0x0C0BF6138B3843D5, 0x3B9E5A25320304D1),
+        SB_FE_CONST(0x9EB0EFBF9E4E370C, 0x7650EC558D315EF7,
+                    0x647797C648CA9837, 0xF6541C5608BA5B92)
+    },
+    {
+        SB_FE_CONST(0x5278844096C4FF9C, 0x89616CB1E79E07DD,
+                    0xDC8F13BFCAEDDB83, 0x8C3D5202798F316D),
+        SB_FE_CONST(0x4D3D5923A61AE1B4, 0xDED0D15BBF2DD834,
+                    0x80B866FE6C50A1EF, 0xA20999F6A934B669)
+    },
+    {
+        SB_FE_CONST(0x792F29F8676984A9, 0x4F5239D9791551AB,
+                    0xC29520B8BF0AB911, 0xF317D32C9BF174BF),
+        SB_FE_CONST(0xF0D8CE8B3B28E94A, 0x356FDD6DC9D4B1C1,
+                    0x9AB2FAF239B96D8B, 0x08F267F2A6FB036B)
+    },
+    {
+        SB_FE_CONST(0xAD7F1B10B6323654, 0xAB7D900769DDABE5,
+                    0x1C28A636D0746191, 0xF1B2FB602C2603D7),
+        SB_FE_CONST(0x127F9B5D07BDE255, 0x3FACBE89FDE4783F,
+                    0x4A7765A1BE181BEA, 0x09B9D19616BCEB7D)
+    },
+    {
+        SB_FE_CONST(0x825F01948E831D5B, 0x76C4C1804286FB42,
+                    0x1A2530B05A00169C, 0x2E75A2665B696527),
+        SB_FE_CONST(0x435872FEBC723A17, 0x61794C4F24111150,
+                    0x106F9BC4CE5B106A, 0xDBF0A11FEF703739)
+    }
+#elif SB_SW_FIXED_BASE_WINDOW == 6
+    {
+        SB_FE_CONST(0x16E4ABE60C4B18A4, 0x76FDAB0DB59C1AC3,
+                    0x767855B4118BE011, 0x3BD04BB679F1952D),
+        SB_FE_CONST(0x2CB99CFC850675E8, 0xFB8DB58EC8C2C216,
+                    0xC1FB57740FB8F754, 0xC4716379D3A5AF5D)
+    },
+    {
+        SB_FE_CONST(0xF00E4339634A1D28, 0xA5D141BFC264423C,
+                    0xF25F7CBC1554C3D0, 0xC803D606090D092A),
+        SB_FE_CONST(0x5013E1E07DB3427F, 0xA6E84F048A559DFB,
+                    0x899C7CBE14DA4163, 0x040F0752CC47C9BA)
+    },
+    {
+        SB_FE_CONST(0x79E3EB1041712315, 0x34B5642EC651C52A,
+                    0xCC67D205B16B5A47, 0x6FBD84F43E930576),
+        SB_FE_CONST(0xC6F8990C1523534A, 0x1122F0918FA9A873,
+                    0x0966C53D41597386, 0x2DA56B7309F87A59)
+    },
+    {
+        SB_FE_CONST(0x708BB8F851FE7B8E, 0x6F854B3D9A689EF4,
+                    0xF3C4B3B00604881C, 0xDC52945C4B2C7CB5),
+        SB_FE_CONST(0x06DA7AEE3BCC6C4F, 0xA7CB53B19B53386C,
+                    0x6B05EFD1D73C1896, 0x1CF468FFE87C90BC)
+    },
+    {
+        SB_FE_CONST(0x6B9B3919B29C56EF, 0xE49DA18C794B5572,
+                    0x34E6EA5553A1CABC, 0x1530C239CF725D71),
+        SB_FE_CONST(0x87E1F0EEC3E2DDFA, 0x6455CE06903A14AE,
+                    0x0F878D875350C88D, 0x9CD28B3F218E740A)
+    },
+    {
+        SB_FE_CONST(0xA18ADA01B459F28E, 0x93B364AAAF7BC52D,
+                    0x6E03D1305D7AFA38, 0x747E9845007264FE),
+        SB_FE_CONST(0x159A4CCC8D26DBEC, 0xAAA8ABB028CE1EE1,
+                    0x47BE449A768F2811, 0x2465AD5446B59886)
+    },
+    {
+        SB_FE_CONST(0x4BAF4DF8EA79377B, 0xA235A26109E3787C,
+                    0xC84449F23E5760DC, 0xE3AC0EB90118E54B),
+        SB_FE_CONST(0x721D664A908C70B9, 0xACFE90EC44DC9AE3,
+                    0x076B245D49F0E8F0, 0x8D9D8DC4787BA563)
+    },
+    {
+        SB_FE_CONST(0x6F08B1861FFF9E25, 0xF969CE2BC64D7F36,
+                    0x65E56120DAEA05AC, 0x23445D3FC2E859FB),
+        SB_FE_CONST(0xA9401BB33CD3DB1A, 0xC1E31A2F05CFA50B,
+                    0x1D0A0D9F833CDDB0, 0xCF51E928AE30362F)
+    },
+    {
+        SB_FE_CONST(0xBFB342FDCA18B07D, 0x325408E05D530247,
+                    0x5A9A32A5124F22D5, 0x6D7C3FA77F82440C),
+        SB_FE_CONST(0x31975005FB8CA3D7, 0xFB0C06375B559968,
+                    0x0B50392D0E7B947C, 0x9FC58F2430DC8CCC)
+    },
+    {
+        SB_FE_CONST(0x70B6C627A25BD699, 0xD8AEF3EFB030547A,
+                    0x8D2056CA61DC37F2, 0xAEE513E18A93CE62),
+        SB_FE_CONST(0x81AF1BA404D1AD9D, 0xD4F92CA42847382D,
+                    0x2ED738C960FFF409, 0x5FEE3D436C3392EE)
+    },
+    {
+        SB_FE_CONST(0x5E654FC5B099BED7, 0x0A385130AF2C1F88,
+                    0x28795FF0DD62EA40, 0x82334B03F9F48DF1),
+        SB_FE_CONST(0x54DBDA6EA227182A, 0x376C2915576BCB6E,
+                    0xF2B75B5509FCB1B4, 0x47593AE58A1C8B72)
+    },
+    {
+        SB_FE_CONST(0x3B411C8B64B1F103, 0x0C24F4F30527B7DE,
+                    0xF5D26DD457896E0F, 0x6AFCF2A7E2A337E1),
+        SB_FE_CONST(0x3E93F88E302CABBE, 0xDFF8533C4C6BCD96,
+                    0x92E499346D98F164, 0xC960A25DC91FB8E3)
+    },
+    {
+        SB_FE_CONST(0xC5F3A1C3396457E8, 0x41D320B78A98D39A,
+                    0x1E96954E2757E079, 0x268A5234FAE300DA),
+        SB_FE_CONST(0x69BA87B8681A2304, 0x7EC45AB35C03DF0F,
+                    0xD41699784393B5F6, 0x38EDA1F12F78A0A6)
+    },
+    {
+        SB_FE_CONST(0x01078AC1D1CFCC5D, 0xEA20BBB64E572CE8,
+                    0x8522F4C8C6B4161A, 0x216B0E512C6E57CB),
+        SB_FE_CONST(0xEFF624C7D0FB0A10, 0x78183AEC74FA21AC,
+                    0xF12B2E60D0C6FDD3, 0x5022D094BED01D25)
+    },
+    {
+        SB_FE_CONST(0x451404EC77071104, 0x37F0270C5C3ADECC,
+                    0xB4A67537D9E75B09, 0xF3060FEF4C3B39F7),
+        SB_FE_CONST(0xF8D4CC826E2F229D, 0x9E6CB67D19205542,
+                    0xE5A19B768F4538B8, 0x0334154A46D65448)
+    },
+    {
+        SB_FE_CONST(0x6939A5E4FD9E966B, 0x9C8B3D262AFAB3D5,
+                    0xAC0DED40938D674C, 0x4093A8C3375A54B7),
+        SB_FE_CONST(0x0E419D291AC3E744, 0x87FDE95CA1F400D9,
+                    0x3B12335E3E04D4A7, 0x8FBBB8436252EBAA)
+    },
+    {
+        SB_FE_CONST(0x81B0578AE622E0ED, 0xEE4949FCCF800026,
+                    0x99B64DFFC5863618, 0xC3AF0F38D4469BF3),
+        SB_FE_CONST(0x2847687B1DC8E6AC, 0xA16CEED7CF3D90AC,
+                    0x8526823C0CDBE1C6, 0x16872A5EA4D6BBAC)
+    },
+    {
+        SB_FE_CONST(0xE000BB7FA11FB4C1, 0x63EB69AD4F6A0575,
+                    0xD48D9981517FA7C4, 0x0828C3E6FADADA30),
+        SB_FE_CONST(0x1E2B4202503114F6, 0x7612C6DC371A45C9,
+                    0x13EA935910E9EF5D, 0xEC53F28AD61FF297)
+    },
+    {
+        SB_FE_CONST(0x3E13E433593E8AD7, 0x20BF8225502A175D,
+                    0x945D7C226910B073, 0xD1239E0B1A7DB624),
+        SB_FE_CONST(0x42D5DCB991F915A2, 0x503055A496329A64,
+                    0x9CDE5707BF816623, 0x686AB327D780F253)
+    },
+    {
+        SB_FE_CONST(0x391CFD558DE81F4A, 0x70288953819F9606,
+                    0xF951C64977F60379, 0xB90D2042F1F79EF8),
+        SB_FE_CONST(0x3BB2C5BCABD9C54D, 0x33FB6E66B41CE386,
+                    0xBF171620C18ED6B7, 0xB2FD1E0C2F8DA33E)
+    },
+    {
+        SB_FE_CONST(0xEFA51EBA21326C8B, 0x6E689B1E6338A496,
+                    0x6A20AD982E539339, 0x16C90DC2131FC711),
+        SB_FE_CONST(0xA9BB5340181431F4, 0x1054084BBC79B4AD,
+                    0xD5E03BCFA27C0098, 0x5073FE6712142137)
+    },
+    {
+        SB_FE_CONST(0xE80CB386AC2EF483, 0x73CAD5B56A3EE90B,
+                    0x12737892EC00AD80, 0xA7AB395DA0285A0C),
+        SB_FE_CONST(0x505C3B531AF78EE9, 0xD2A0B7FDD20D4E04,
+                    0x778AD7D788F8E0CF, 0x9571A01E252799F7)
+    },
+    {
+        SB_FE_CONST(0x7FE2602B94D17C8F, 0xC0F727DF8531F855,
+                    0x9724B53050345B7A, 0x0E47B714AEC193D7),
+        SB_FE_CONST(0x454091A68C2C753C, 0xA9C07D7AEBA6623F,
+                    0xF4AE3293D8A94FFC, 0xB59AECF0F3A67F01)
+    },
+    {
+        SB_FE_CONST(0x94356E3B4B6F7157, 0x26815A04A62EB032,
+                    0x1F171B124F9FA00F, 0xBE32211D37F42A75),
+        SB_FE_CONST(0x6298E2753C563375, 0x48F4ACCF9C170991,
+                    0x80BF3ECBBEFDEA00, 0x02D26F97AB655A27)
+    },
+    {
+        SB_FE_CONST(0x7D02BFC953A5597F, 0x814FCD93A33F021A,
+                    0x7AC36B60F2544946, 0xCBFED9C9FCBEB801),
+        SB_FE_CONST(0x72027379EAC5A27A, 0xDF14622D64692FF4,
+                    0x5F60C03913DA5BFD, 0x26BFA782C4FD70D7)
+    },
+    {
+        SB_FE_CONST(0xD2FF073FA48206B5, 0x7AA78326BDE70338,
+                    0x0445CFAF3F05E104, 0x34540DB13A77DC93),
+        SB_FE_CONST(0xEA9700060F4A3C34, 0xAD96D0DA581DC3C1,
+                    0x08C3484AD2ECB9A0, 0xFBC5DCDC2E0F2D1D)
+    },
+    {
+        SB_FE_CONST(0x9DF63780398B5031, 0x639DAF5A8351F08B,
+                    0x7DD4F86B722487F1, 0x20B4234706CF3753),
+        SB_FE_CONST(0xCF43DF1AE365A953, 0xBA03501864D0B637,
+                    0x813069445AE027A5, 0x264CB81D9CA3C491)
+    },
+    {
+        SB_FE_CONST(0x2E754EED6484D513, 0x3B8537D3892C3F6C,
+                    0x597CD01B98786F01, 0x5F42470744A01E3B),
+        SB_FE_CONST(0x1FF30B962C3C6704, 0xA91343BD3A29C81F,
+                    0x21EA9E3A0D366D41, 0x4E685D4983D91024)
+    },
+    {
+        SB_FE_CONST(0x5308051B5CBF5B11, 0xA590A5BD3BFD8B59,
+                    0xD6072C6AEA33D2EC, 0xBF5109C9EF3D0CA4),
+        SB_FE_CONST(0xE4A4760842723907, 0xA655BCB46094E9F4,
+                    0x135F6B27A882071B, 0x7FA490A332D51985)
+    },
+    {
+        SB_FE_CONST(0xFEB2ACA234B96EBD, 0x35D6F530CDBF9C05,
+                    0xADD41F38B56B868C, 0x7002DCA554540E99),
+        SB_FE_CONST(0xFB362C236B303E85, 0x0A166874F2C6738D,
+                    0xE6D8E6D603A4C0EE, 0xD2EFA742BC22AE1B)
+    },
+    {
+        SB_FE_CONST(0xACB41A544D70BC76, 0xD64B821A90C9E34D,
+                    0x601BD3CC28BF4E8E, 0xD22E1B909C4025FD),
+        SB_FE_CONST(0x573599237B2E62D5, 0x86BA70E614B273D1,
+                    0x4843171E44004CA8, 0x8F7F8A8692C11C81)
+    },
+    {
+        SB_FE_CONST(0x2518373433C7546D, 0xE6C0E12DBB580C9A,
+                    0x4F1FB2D63ADA2B53, 0xB9E437F4AFCC2BEF),
+        SB_FE_CONST(0x531F307FB48F21F2, 0x2A0C7A7E9CE6F49F,
+                    0x2CB9B9B3A185AE46, 0xAB12D90FBFD92FB9)
+    }
+#endif
+};
+
+#endif
+
+#if SB_SW_SECP256K1_SUPPORT
+
+static const sb_fe_t SB_CURVE_SECP256K1_G_COMB[SB_SW_FIXED_BASE_ENTRIES][2] = {
+#if SB_SW_FIXED_BASE_WINDOW == 4
+    {
+        SB_FE_CONST(0xB931DB0743A8E7F4, 0x59F970261BCEE157,
+                    0x25ED1A5153E371C2, 0x16AF358A957F664E),
+        SB_FE_CONST(0x2DF5DF83332F42B4, 0xC36FAB363DAED493,
+                    0xF282DCC249F648C8, 0xCD9B179631D6E0AB)
+    },
+    {
+        SB_FE_CONST(0x258A2D079AB5DDF1, 0xC44D21AFF2F5FC15,
+                    0x41CF1BA5EDE221D0, 0x3782CB88CDF1AB56),
+        SB_FE_CONST(0x9DE60DE6373AEF09, 0xC7328C66F2B69233,
+                    0xA56C124827D4925A, 0x6029088216AD88CA)
+    },
+    {
+        SB_FE_CONST(0x82BEB48EFEA0416F, 0x44D93E02D6FF6319,
+                    0xD02444A40ABF0C7C, 0x517C920AED47A00E),
+        SB_FE_CONST(0x46F52DC11BDA4001, 0xD3D6EE03650C3111,
+                    0x3FDAA641E436CCF1, 0x4042823E941224B7)
+    },
+    {
+        SB_FE_CONST(0xD094D65B05CA76C2, 0x00FB32642D7609DF,
+                    0x71C1113EC4998D94, 0x6BE2DB15EB0920AA),
+        SB_FE_CONST(0x68E72512DA4BB363, 0xB9CDED48FB32D696,
+                    0x25709DD35544B39E, 0x4B4C8B0624C99ADC)
+    },
+    {
+        SB_FE_CONST(0xF438290E5F1ACD57, 0x3A30EBB3A82C7C3E,
+                    0x7C9340E01C8DC719, 0x9A5D634476DBE0B1),
+        SB_FE_CONST(0x39325EE391164C12, 0x836681D4416363D2,
+                    0x27D080457723F03D, 0x681DD2AE51559F08)
+    },
+    {
+        SB_FE_CONST(0x34ADBD2F21430545, 0xE722C7C5DEC6F76A,
+                    0xA60B1881FA8F8B94, 0x1F60A1EB3087DD92),
+        SB_FE_CONST(0xEBB73F71A83F1830, 0x7DE6EB589D3A7001,
+                    0x79CC980E143BDAE1, 0x85C825DD80146EBB)
+    },
+    {
+        SB_FE_CONST(0x6D2899563E61D225, 0xEF5ADD622A5E6345,
+                    0xC96B6E8B5EB5F5D9, 0x07A7F167EF65A40C),
+        SB_FE_CONST(0xD8696BD0FF608E24, 0xC02048EA44F97127,
+                    0x1F2F1814B7BA09A4, 0x3A2CF2E71797F3BD)
+    },
+    {
+        SB_FE_CONST(0x52DE253AFBB83870, 0xB6FFFFFCDDEB356B,
+                    0x0262B204EA0DDA76, 0x8808CA5FBEB8B1E2),
+        SB_FE_CONST(0x3A270D6FD36FB8DB, 0x0FF834D738E421EA,
+                    0x89686278002F03ED, 0x961F40C08F8D21EA)
+    }
+#elif SB_SW_FIXED_BASE_WINDOW == 5
+    {
+        SB_FE_CONST(0xFA794FA573EE8AB7, 0xB85B94CEA4792E89,
+                    0x2B419E403342A97B, 0x8C2D7B565AFC6849),
+        SB_FE_CONST(0xBDCCABCE568BF9D6, 0x78AEBE437424EC72,
+                    0x64730D7E5F6B8B5C, 0xA0D37008D7885AF8)
+    },
+    {
+        SB_FE_CONST(0xA2F3332E9AF58119, 0xBFBF05CFBF26DE01,
+                    0x9C61216F5EFE221D, 0x671CD2A013AC0A71),
+        SB_FE_CONST(0x487460A90C85FDC0, 0x004F1CBC75F059A5,
+                    0x68411DC1FB85E4E1, 0x1030D35917FB4155)
+    },
+    {
+        SB_FE_CONST(0x4EC2B23625CF66D0, 0x62E5E9C29AA887F4,
+                    0x97DAE364BA1696A7, 0xEAF0D8C07F62F55B),
+        SB_FE_CONST(0x7FD8811254D2B55F, 0xE333283301E3F42E,
+                    0xC70EFF67244CF050, 0x04EBDC7F1322D18E)
+    },
+    {
+        SB_FE_CONST(0x121C5F8D2048E224, 0x4AD3654E36167D5C,
+                    0x5E809655681142C1, 0xAACB8746BCAD8875),
+        SB_FE_CONST(0xDDDCDCFC23AF1A62, 0x44C57462E50A90FE,
+                    0x04D4D94CDCB2D826, 0x895FB41EF260CD35)
+    },
+    {
+        SB_FE_CONST(0x80388F3C5B362124, 0xC70AC327D6C41887,
+                    0xB3A30360F4EC0249, 0x928983F433A7F07F),
+        SB_FE_CONST(0xF9960655695BF9A7, 0xCEBA6715CDA5575E,
+                    0x3A2E28E8F283403D, 0xA02E0606DBDBD456)
+    },
+    {
+        SB_FE_CONST(0xF2583EAB6479D4E2, 0xBBF115AED5C86717,
+                    0x63B1B56931D4D1A8, 0xB7D30CBAC835CE36),
+        SB_FE_CONST(0xA1AA60963C77B320, 0xE95EC3886601717E,
+                    0xD396443D837D291B, 0x900760F495397327)
+    },
+    {
+        SB_FE_CONST(0x6AB63434EE2A785B, 0x94BA471D4CEE0EF0,
+                    0xE28175D56E16CD3A, 0x799CBB01684B7834),
+        SB_FE_CONST(0xCBAD56591AB9DDC0, 0xF687340C7B5CF606,
+                    0xAA6B7E00453D529B, 0x50885B6318D9D5F4)
+    },
+    {
+        SB_FE_CONST(0x20BD130442ACFDBC, 0xCD41982DBDDAAEBE,
+                    0x055F3B24038BBEA8, 0xFF20D28FD515E754),
+        SB_FE_CONST(0x5B95253B5B380642, 0x2F27D1651E09FC10,
+                    0x04797EEC85DDE2DF, 0xCA17F83768D3BAAD)
+    },
+    {
+        SB_FE_CONST(0x662FAADEB3E3D6D6, 0x195DB69A4C0E830A,
+                    0x927CA54071C07944, 0x689F4BF05164386A),
+        SB_FE_CONST(0x6E6F54854D9A2413, 0xD8E2BB829D524962,
+                    0xBBBD49760EA762D4, 0x4D69869C8A8BFC12)
+    },
+    {
+        SB_FE_CONST(0x11D802B7EDC81A15, 0xFE548D00CC0B2A80,
+                    0xC16DB8FDD8B2089D, 0x89953D5D8F478001),
+        SB_FE_CONST(0x25CF8D662D9F9370, 0x88681FBA797E4992,
+                    0xE849CCA1C73C2A1F, 0xC36DCC44DC194646)
+    },
+    {
+        SB_FE_CONST(0x16ED632EA0527359, 0x6111C23EC4676457,
+                    0x909354D266BF5D17, 0x09DB6E7FC26EAD14),
+        SB_FE_CONST(0x4F772677D14316B0, 0x75251879A8A334F3,
+                    0xF30CBCF698AD517C, 0x25C776F94BC8BC22)
+    },
+    {
+        SB_FE_CONST(0xF419A3B949CAA666, 0x28D528AE67932504,
+                    0xE5AEBD98FBBEEBA1, 0x7FE61079BBA98774),
+        SB_FE_CONST(0x8488BE5A7BB1E410, 0xDFD03CAF0708387F,
+                    0xD8D504A06B8651DC, 0x81C20C012B326353)
+    },
+    {
+        SB_FE_CONST(0x8413EF7205CD1880, 0xB133B8C2BF7EB9B6,
+                    0x0719C14F802FB121, 0xBDE81EB0321C4287),
+        SB_FE_CONST(0x93D3CC6F0164D8DA, 0xF89870BA56085C8A,
+                    0x43E3E34F64499BD1, 0xC9E2196ACD5BB22D)
+    },
+    {
+        SB_FE_CONST(0x94CBA2CF7AC2C581, 0x7C2CAED4B06D6CF9,
+                    0x8C188CBF8DBA6881, 0x7AB3822BA2512F02),
+        SB_FE_CONST(0x208ECB1D8A9F6E8B, 0xE803A9741BAD8DE1,
+                    0x9773D9882AAD4596, 0x18EF3ECCD569ECE5)
+    },
+    {
+        SB_FE_CONST(0x0392FEBF259E8DA7, 0xEBC9AC4AB1DC8EBD,
+                    0xD7547EBC043FBEFB, 0xAF15176EF6E0AE00),
+        SB_FE_CONST(0x48ABD5E026BD35B5, 0x4B851FE3E3F95342,
+                    0xC1C8FA53E2F85B3A, 0x0DED12D67F7EE8D2)
+    },
+    {
+        SB_FE_CONST(0x892A09EC30EF2135, 0x566B058B228AB159,
+                    0xCC0FC9191D4BF2CD, 0x11F8813EFD32E1CC),
+        SB_FE_CONST(0xAB3A52B18A7F8937, 0x95BDF49C0ACD8F4F,
+                    0xF2B2F5CCF43A18DD, 0x4C3C6C07464A8415)
+    }
+#elif SB_SW_FIXED_BASE_WINDOW == 6
+    {
+        SB_FE_CONST(0x850294C93956301D, 0x65E74C58FA7707ED,
+                    0xDE9775802F662BDE, 0xDB39C7A2D5D627C9),
+        SB_FE_CONST(0xCC21A802D21A5F7E, 0xA645A1F245EED99C,
+                    0x37A950E4DEA121C1, 0x8E9B3DB04E6525FC)
+    },
+    {
+        SB_FE_CONST(0xCBEDCCDC2EDFCDD4, 0x982E58E33BC3C1A7,
+                    0xE42A1659F14D99A9, 0x019101AEDF63D58B),
+        SB_FE_CONST(0xEB57FF91E6A4E818, 0x9E2D96036766494D,
+                    0x5910680F8C68282E, 0xC3D1BE70100D1D52)
+    },
+    {
+        SB_FE_CONST(0x1A991E847DD882F3, 0xF90D1603906387FE,
+                    0x0DDC6135946ADEB7, 0xAEB653010CBA4B52),
+        SB_FE_CONST(0xEF5507800735B981, 0x8CF16E363068A229,
+                    0xD3AA590FEC116F73, 0x4D67A0F6BEABC0CE)
+    },
+    {
+        SB_FE_CONST(0x4DBE2F2BF290BF83, 0xCA23BCF213CC7AE1,
+                    0x8B88D763BA34414A, 0x91DB46DE15874440),
+        SB_FE_CONST(0x8FBCE1347870108A, 0x93C047282C9CCD5F,
+                    0xDF372A4295EF8189, 0xD19892A9C7E84417)
+    },
+    {
+        SB_FE_CONST(0x35E9AA0047D425AA, 0x229CB2D29E1F2C24,
+                    0xD2D07842CA3F5D4F, 0xBE0F88EB78F2BFA8),
+        SB_FE_CONST(0x5EA4E02FC0C73A55, 0x682CEDACE4013370,
+                    0x51332C95EEBE8697, 0x01282C9B31157722)
+    },
+    {
+        SB_FE_CONST(0xC7EB264CFBE9651A, 0xC469660B6752C2C8,
+                    0xC243A958AFBB906F, 0x78D78DFC27EE69FF),
+        SB_FE_CONST(0x8D0325C872C81EDB, 0x8FA2DC8B13C95AC6,
+                    0x72A494CFE2F5C213, 0xA4EFDD3127DDF946)
+    },
+    {
+        SB_FE_CONST(0x6997ED185E0B540D, 0xD0DA990E60964CE8,
+                    0x3BE4DE2DC55FFA3B, 0xE27A55A0CFBA0411),
+        SB_FE_CONST(0x944236519C4A183F, 0x59E33176E26AD9D2,
+                    0xB923CF1941BE9A44, 0xE4424F7003DA3012)
+    },
+    {
+        SB_FE_CONST(0x79A185263EB2E841, 0xC8C7756A31BBA94A,
+                    0xBFFCDF4F91BC1F18, 0x6C8DF6EB6719A72F),
+        SB_FE_CONST(0xCF34115352F87034, 0xEFF10A9C54F808B6,
+                    0x0129E40C8FA41FCB, 0x559B54A3134A8278)
+    },
+    {
+        SB_FE_CONST(0xD785638D0521A05D, 0xFB4C3864509878D5,
+                    0x755DED0882326727, 0x8E8B8DDE8BE31A7E),
+        SB_FE_CONST(0xC5356F5D6480CE24, 0x6CA78D6982889427,
+                    0xF2BA32D9E7B0FC10, 0x84938755AC0812F3)
+    },
+    {
+        SB_FE_CONST(0xA3E09E81BFA00866, 0x620C0CCD06DB557E,
+                    0xE37152A5D3F9A395, 0xB8B9440496CBF991),
+        SB_FE_CONST(0x3DDCE942693096BD, 0x09A8C8F9041BF615,
+                    0xFCC1C7B2768C8823, 0x1BB73FB2C2442755)
+    },
+    {
+        SB_FE_CONST(0x628E97B7E6E07D24, 0xD3B4D52C06C995FD,
+                    0x62FC18A019D41ABC, 0x900C85C288CC3BD5),
+        SB_FE_CONST(0xFD0135BC5F5C191D, 0xFCEE3B25DE1A07A8,
+                    0xC31DF4FE63C8F4C7, 0x682A12E2BD4F53E0)
+    },
+    {
+        SB_FE_CONST(0x6C1DFF1DE7A6A813, 0x79A4488FF00BA876,
+                    0x00B728380F47FCE0, 0xEF46EB80028AAF16),
+        SB_FE_CONST(0xA73E7D1F57E3E8B7, 0x7CE99E623AC9506C,
+                    0xF7FE511C81090610, 0xE4604FBFF6E9BF89)
+    },
+    {
+        SB_FE_CONST(0xC4C84747F9925667, 0x5714DABB2D50F330,
+                    0x34C96AC7C7718725, 0x88303390F329C70B),
+        SB_FE_CONST(0x3613431E98393162, 0xFECE11671E00F368,
+                    0x60ADDC91EA37D33E, 0xB6563DB7A91D4C5F)
+    },
+    {
+        SB_FE_CONST(0x12D770DFDF59D540, 0x5E7FCC4F3B1DCC60,
+                    0x9CCFBA87B8A26616, 0x5EB4CABBB420FF7F),
+        SB_FE_CONST(0x902206951278CE29, 0xB822FF8BC9582440,
+                    0xE6CE7EA2E1901BC3, 0x7DA79B7B029BBBE2)
+    },
+    {
+        SB_FE_CONST(0x782FCBC2DF5BFEF1, 0xA2842A7668369B65,
+                    0x986E06F0F6613191, 0xF483FE017338844D),
+        SB_FE_CONST(0xC600FFE5E21EF8CA, 0x3AB1FC52AC810090,
+                    0x4FF46A176C1770D1, 0x7100718ECE1189E3)
+    },
+    {
+        SB_FE_CONST(0x81E32F3E66A18F84, 0xEEEE55F4BFD6FAC3,
+                    0x1EE2492780554252, 0x240BA21E888A3AD2),
+        SB_FE_CONST(0x6041DEAE112AB725, 0x2E6A0246B11B46FC,
+                    0x2B134DBFC8BCBA69, 0x6D026CA979F91BF7)
+    },
+    {
+        SB_FE_CONST(0xD911B7730C0EDC4B, 0x3253C45C430E4918,
+                    0xA49DCE3E172E3391, 0x8DB7CAD6190E11AA),
+        SB_FE_CONST(0x0B73D35D34D80A4D, 0x1D833DC1F997B059,
+                    0x77558F4143719BA5, 0xF18388E036393973)
+    },
+    {
+        SB_FE_CONST(0x6FCC4BD26FF8EDAC, 0x893B5855A9E9C837,
+                    0x5D2B1A406A439DF1, 0x30CD219696155AE8),
+        SB_FE_CONST(0xEE2599AEB6F1E8EB, 0xEABD0F798369B47E,
+                    0x597FF5793B8402C5, 0xA5F1A5E981551866)
+    },
+    {
+        SB_FE_CONST(0x86052E4402219BC6, 0x4AB36084BD27D6A6,
+                    0xA3AB83446B4B3BBF, 0x232B84A509E6F88F),
+        SB_FE_CONST(0x71C38CDA76653AED, 0x72AFB20700CC7703,
+                    0x4037C3A98B43BA18, 0xA68D53585F34C7C9)
+    },
+    {
+        SB_FE_CONST(0x34C043BB2BC4B3BD, 0xB7ECA2072712F528,
+                    0x998E5F72A8BEABD9, 0x48332C138F434CE1),
+        SB_FE_CONST(0x1336E5298E402EE5, 0xA067B1C90F72BB16,
+                    0xB4A6D35F7B6BE7B8, 0x1A0CEEB7F1E87A43)
+    },
+    {
+        SB_FE_CONST(0xD0048BF6605828C2, 0x0FE43BE73591D3EB,
+                    0x3398AB123237970A, 0xD6938105DB7933DA),
+        SB_FE_CONST(0x8DE9AD990B1E927C, 0xAEE1F3FB6AFCF3A2,
+                    0x3E88162F00AE55B3, 0xADED3B681E42677E)
+    },
+    {
+        SB_FE_CONST(0x437A09C1FC3FE71A, 0xD0DFA1B72884AF01,
+                    0xA7B9002B46B72778, 0x099D79AF6526D471),
+        SB_FE_CONST(0xD8ED8D5564DA4AAD, 0xBCEC9CA7C3C29CD1,
+                    0xE7161F2CA5118EE9, 0xE6E19F56E270EE5E)
+    },
+    {
+        SB_FE_CONST(0x5B53A380B5E18C5E, 0x5B80DF5D0BAE1831,
+                    0x16D98EE6910FDD94, 0xF42C9C56428B7FAC),
+        SB_FE_CONST(0xEEB0F40814AEAD37, 0xACB2EEBC14CDA2BC,
+                    0x7D101E9B0245BBE7, 0x41FE0CD9035ED5EE)
+    },
+    {
+        SB_FE_CONST(0xD71F59FF5C030961, 0x37137A8A75B9927B,
+                    0x218CF40541F15833, 0xEDA51C10A1849C40),
+        SB_FE_CONST(0x69B12BAE3D61A3F7, 0x1B1A8480E452DC04,
+                    0xD8BB242B2BFF6D9A, 0x08DC450B913923FC)
+    },
+    {
+        SB_FE_CONST(0x632A58542E360947, 0x76A5DBC0AE44F97D,
+                    0xB0C240643D7A0EA2, 0x4400B8B1EE562ABA),
+        SB_FE_CONST(0xA7CFCAE75A5B84E3, 0x3C81A0FFEFD0A136,
+                    0x1FD01D872F438EB8, 0x15C145297B9BAFDB)
+    },
+    {
+        SB_FE_CONST(0xA914609DA476E65B, 0xE3ED6A849F0F0C37,
+                    0x06B7F53CD19BC50C, 0x4CF2258967242808),
+        SB_FE_CONST(0xE302E7059A5B6A1B, 0xCD516889C4E860BE,
+                    0xE612510AFAC285D1, 0x7FE273983A776347)
+    },
+    {
+        SB_FE_CONST(0x1096B0923043AC90, 0x97541C3A690D3182,
+                    0xA52B11ABA25C3FC8, 0x7906FC8DF61355BE),
+        SB_FE_CONST(0x2739EF3FB4487918, 0x2FE154F9B0DC267C,
+                    0x40A95618FC48ED6C, 0xE0C007F1E816EE4F)
+    },
+    {
+        SB_FE_CONST(0xBBC1A6D3F2F8A953, 0x6179E097F2C51FAD,
+                    0x98158B27CA28F719, 0xB7844341C940FFFB),
+        SB_FE_CONST(0x749FFA5C6CE4640D, 0xB901CEE6199854EA,
+                    0xD1F50EA2EA9ACA0E, 0x7BFF7DF68D3B3654)
+    },
+    {
+        SB_FE_CONST(0xD4A390AB22AD92B1, 0xBF85B3DE1B768FCE,
+                    0xCC2B11DB4DE47592, 0x5DC1A7CA18E13489),
+        SB_FE_CONST(0x237A80460AE3C303, 0x41C8246F91851007,
+                    0xC1EA30BB615E3EE1, 0xD44F1DA689151134)
+    },
+    {
+        SB_FE_CONST(0x6AC25385213777F0, 0x45987CEF9E4E98DE,
+                    0x916E00F65467B429, 0x89C313AA6B9E6D5B),
+        SB_FE_CONST(0x665763C7F1C9B9C3, 0x56927949B2B636AF,
+                    0x25A450B32CD189A4, 0x5644DC876E1B0019)
+    },
+    {
+        SB_FE_CONST(0x002AE2996927D13F, 0x4EAF61E455C1EAE5,
+                    0xE40ECC44FD10C4AB, 0xB45A2B0D03DF301B),
+        SB_FE_CONST(0xB66E55FB31594AA5, 0xD0053B231B9B1971,
+                    0x7D6BE1C23C74B0C0, 0x6413501E44622227)
+    },
+    {
+        SB_FE_CONST(0x25898AD2570FBA39, 0x142893FDBA91BF45,
+                    0x5AE91D7FFB3B1B98, 0x93CCAD491F530FEE),
+        SB_FE_CONST(0x2188B6D4B0267681, 0xC9D4AAD1F28203DB,
+                    0x8A89E34CC7C54C52, 0x0BAA59821B7180E3)
+    }
+#endif
+};
+
+#endif
+
+#endif
+
+#if SB_SW_VARTIME_SUPPORT
+
+// Variable-time signature verification uses a width-6 NAF for the scalar
+// multiplying G, and thus needs the odd multiples G, 3G, ..., 31G. As above,
+// coordinates are NOT multiplied by R.
+
+#define SB_SW_VARTIME_G_WINDOW 6
+#define SB_SW_VARTIME_G_ENTRIES (1 << (SB_SW_VARTIME_G_WINDOW - 2))
+
+#if SB_SW_P256_SUPPORT
+
+static const sb_fe_t SB_CURVE_P256_G_ODD[SB_SW_VARTIME_G_ENTRIES][2] = {
+    {
+        SB_FE_CONST(0x6B17D1F2E12C4247, 0xF8BCE6E563A440F2,
+                    0x77037D812DEB33A0, 0xF4A13945D898C296),
+        SB_FE_CONST(0x4FE342E2FE1A7F9B, 0x8EE7EB4A7C0F9E16,
+                    0x2BCE33576B315ECE, 0xCBB6406837BF51F5)
+    },
+    {
+        SB_FE_CONST(0x5ECBE4D1A6330A44, 0xC8F7EF951D4BF165,
+                    0xE6C6B721EFADA985, 0xFB41661BC6E7FD6C),
+        SB_FE_CONST(0x8734640C4998FF7E, 0x374B06CE1A64A2EC,
+                    0xD82AB036384FB83D, 0x9A79B127A27D5032)
+    },
+    {
+        SB_FE_CONST(0x51590B7A515140D2, 0xD784C85608668FDF,
+                    0xEF8C82FD1F5BE524, 0x21554A0DC3D033ED),
+        SB_FE_CONST(0xE0C17DA8904A727D, 0x8AE1BF36BF8A7926,
+                    0x0D012F00D4D80888, 0xD1D0BB44FDA16DA4)
+    },
+    {
+        SB_FE_CONST(0x8E533B6FA0BF7B46, 0x25BB30667C01FB60,
+                    0x7EF9F8B8A80FEF5B, 0x300628703187B2A3),
+        SB_FE_CONST(0x73EB1DBDE0331836, 0x6D069F83A6F59000,
+                    0x53C73633CB041B21, 0xC55E1A86C1F400B4)
+    },
+    {
+        SB_FE_CONST(0xEA68D7B6FEDF0B71, 0x878938D51D71F872,
+                    0x9E0ACB8C2C6DF8B3, 0xD79E8A4B90949EE0),
+        SB_FE_CONST(0x2A2744C972C9FCE7, 0x87014A964A8EA0C8,
+                    0x4D714FEAA4DE823F, 0xE85A224A4DD048FA)
+    },
+    {
+        SB_FE_CONST(0x3ED113B7883B4C59, 0x0638379DB0C21CDA,
+                    0x16742ED0255048BF, 0x433391D374BC21D1),
+        SB_FE_CONST(0x9099209ACCC4C8A2, 0x24C843AFA4F4C68A,
+                    0x090D04DA5E9889DA, 0xE2F8EEFCE82A3740)
+    },
+    {
+        SB_FE_CONST(0x177C837AE0AC495A, 0x61805DF2D85EE2FC,
+                    0x792E284B65EAD58A, 0x98E15D9D46072C01),
+        SB_FE_CONST(0x63BB58CD4EBEA558, 0xA24091ADB40F4E72,
+                    0x26EE14C3A1FB4DF3, 0x9C43BBE2EFC7BFD8)
+    },
+    {
+        SB_FE_CONST(0xF0454DC6971ABAE7, 0xADFB378999888265,
+                    0xAE03AF92DE3A0EF1, 0x63668C63E59B9D5F),
+        SB_FE_CONST(0xB5B93EE3592E2D1F, 0x4E6594E51F9643E6,
+                    0x2A3B21CE75B5FA3F, 0x47E59CDE0D034F36)
+    },
+    {
+        SB_FE_CONST(0x47776904C0F1CC3A, 0x9C0984B66F75301A,
+                    0x5FA68678F0D64AF8, 0xBA1ABCE34738A73E),
+        SB_FE_CONST(0xAA005EE6B5B95728, 0x6231856577648E83,
+                    0x81B2804428D5733F, 0x32F787FF71F1FCDC)
+    },
+    {
+        SB_FE_CONST(0xCB6D2861102C0C25, 0xCE39B7C17108C507,
+                    0x782C452257884895, 0xC1FC7B74AB03ED83),
+        SB_FE_CONST(0x58D7614B24D9EF51, 0x5C35E7100D6D6CE4,
+                    0xA496716E30FA3E03, 0xE39150752BCECDAA)
+    },
+    {
+        SB_FE_CONST(0x3250FCF686637C7B, 0x2E4AC86EB473BCA5,
+                    0x3A582139F42B1523, 0xFD76364E67399E83),
+        SB_FE_CONST(0x42E7C342667D3593, 0x97B3090D1D7EB88C,
+                    0x897CD3C33B566A82, 0x15DE24A071D48C09)
+    },
+    {
+        SB_FE_CONST(0x0E91C7239C2640D7, 0xD28A3E39D4583FA6,
+                    0x3C0BC0A5DF64A4FE, 0x672E573045CA7896),
+        SB_FE_CONST(0x5DF65C3B550DBA22, 0x1A22733BB8E0BD6D,
+                    0x7E68833575E7A5AE, 0x138046543140AD55)
+    },
+    {
+        SB_FE_CONST(0x3A67E2554B0C0BB6, 0x85F4F52D8C07FA84,
+                    0x41652FC5B76F1B24, 0x84A4DC45F200D687),
+        SB_FE_CONST(0x27D0F1872F1FCF43, 0x26DAF267163AFB0D,
+                    0x8C188AF735A7618A, 0xA9ED16B302F79324)
+    },
+    {
+        SB_FE_CONST(0x184FFA5819D80D51, 0xDEBA2FAC4611F378,
+                    0x576355BD683E54AB, 0xF2E201173B0883D1),
+        SB_FE_CONST(0xC0A66E276688F359, 0xA4C6D90826CB9995,
+                    0x45BDECCC63F04916, 0x20D242C260906E6F)
+    },
+    {
+        SB_FE_CONST(0xD6D33ADEFA195B07, 0xA7C36DA090853B8C,
+                    0xFD8CD1C688B58A41, 0xDEDD693D1C784DEF),
+        SB_FE_CONST(0x84AABA16EE195D7E, 0x3F78245F558A5DCB,
+                    0x09A166AB4B95EDED, 0x550C124593D1BCA6)
+    },
+    {
+        SB_FE_CONST(0x301D9E502DC7E05D, 0xA85DA026A7AE9AA0,
+                    0xFAC9DB7D52A95B3E, 0x3E3F9AA0A1B45B8B),
+        SB_FE_CONST(0x6551B6F6B3061223, 0xE0D23C026B017D72,
+                    0x298D9AE46887CA61, 0xD58DB6AEA17EE267)
+    }
+};
+
+#endif
+
+#if SB_SW_SECP256K1_SUPPORT
+
+static const sb_fe_t SB_CURVE_SECP256K1_G_ODD[SB_SW_VARTIME_G_ENTRIES][2] = {
+    {
+        SB_FE_CONST(0x79BE667EF9DCBBAC, 0x55A06295CE870B07,
+                    0x029BFCDB2DCE28D9, 0x59F2815B16F81798),
+        SB_FE_CONST(0x483ADA7726A3C465, 0x5DA4FBFC0E1108A8,
+                    0xFD17B448A6855419, 0x9C47D08FFB10D4B8)
+    },
+    {
+        SB_FE_CONST(0xF9308A019258C310, 0x49344F85F89D5229,
+                    0xB531C845836F99B0, 0x8601F113BCE036F9),
+        SB_FE_CONST(0x388F7B0F632DE814, 0x0FE337E62A37F356,
+                    0x6500A99934C2231B, 0x6CB9FD7584B8E672)
+    },
+    {
+        SB_FE_CONST(0x2F8BDE4D1A072093, 0x55B4A7250A5C5128,
+                    0xE88B84BDDC619AB7, 0xCBA8D569B240EFE4),
+        SB_FE_CONST(0xD8AC222636E5E3D6, 0xD4DBA9DDA6C9C426,
+                    0xF788271BAB0D6840, 0xDCA87D3AA6AC62D6)
+    },
+    {
+        SB_FE_CONST(0x5CBDF0646E5DB4EA, 0xA398F365F2EA7A0E,
+                    0x3D419B7E0330E39C, 0xE92BDDEDCAC4F9BC),
+        SB_FE_CONST(0x6AEBCA40BA255960, 0xA3178D6D861A54DB,
+                    0xA813D0B813FDE7B5, 0xA5082628087264DA)
+    },
+    {
+        SB_FE_CONST(0xACD484E2F0C7F653, 0x09AD178A9F559ABD,
+                    0xE09796974C57E714, 0xC35F110DFC27CCBE),
+        SB_FE_CONST(0xCC338921B0A7D9FD, 0x64380971763B61E9,
+                    0xADD888A4375F8E0F, 0x05CC262AC64F9C37)
+    },
+    {
+        SB_FE_CONST(0x774AE7F858A9411E, 0x5EF4246B70C65AAC,
+                    0x5649980BE5C17891, 0xBBEC17895DA008CB),
+        SB_FE_CONST(0xD984A032EB6B5E19, 0x0243DD56D7B7B365,
+                    0x372DB1E2DFF9D6A8, 0x301D74C9C953C61B)
+    },
+    {
+        SB_FE_CONST(0xF28773C2D975288B, 0xC7D1D205C3748651,
+                    0xB075FBC6610E58CD, 0xDEEDDF8F19405AA8),
+        SB_FE_CONST(0x0AB0902E8D880A89, 0x758212EB65CDAF47,
+                    0x3A1A06DA521FA91F, 0x29B5CB52DB03ED81)
+    },
+    {
+        SB_FE_CONST(0xD7924D4F7D43EA96, 0x5A465AE3095FF411,
+                    0x31E5946F3C85F79E, 0x44ADBCF8E27E080E),
+        SB_FE_CONST(0x581E2872A86C72A6, 0x83842EC228CC6DEF,
+                    0xEA40AF2BD896D3A5, 0xC504DC9FF6A26B58)
+    },
+    {
+        SB_FE_CONST(0xDEFDEA4CDB677750, 0xA420FEE807EACF21,
+                    0xEB9898AE79B97687, 0x66E4FAA04A2D4A34),
+        SB_FE_CONST(0x4211AB0694635168, 0xE997B0EAD2A93DAE,
+                    0xCED1F4A04A95C0F6, 0xCFB199F69E56EB77)
+    },
+    {
+        SB_FE_CONST(0x2B4EA0A797A443D2, 0x93EF5CFF444F4979,
+                    0xF06ACFEBD7E86D27, 0x7475656138385B6C),
+        SB_FE_CONST(0x85E89BC037945D93, 0xB343083B5A1C8613,
+                    0x1A01F60C50269763, 0xB570C854E5C09B7A)
+    },
+    {
+        SB_FE_CONST(0x352BBF4A4CDD1256, 0x4F93FA332CE33330,
+                    0x1D9AD40271F81071, 0x81340AEF25BE59D5),
+        SB_FE_CONST(0x321EB4075348F534, 0xD59C18259DDA3E1F,
+                    0x4A1B3B2E71B1039C, 0x67BD3D8BCF81998C)
+    },
+    {
+        SB_FE_CONST(0x2FA2104D6B38D11B, 0x0230010559879124,
+                    0xE42AB8DFEFF5FF29, 0xDC9CDADD4ECACC3F),
+        SB_FE_CONST(0x02DE1068295DD865, 0xB64569335BD5DD80,
+                    0x181D70ECFC882648, 0x423BA76B532B7D67)
+    },
+    {
+        SB_FE_CONST(0x9248279B09B4D68D, 0xAB21A9B066EDDA83,
+                    0x263C3D84E09572E2, 0x69CA0CD7F5453714),
+        SB_FE_CONST(0x73016F7BF234AADE, 0x5D1AA71BDEA2B1FF,
+                    0x3FC0DE2A887912FF, 0xE54A32CE97CB3402)
+    },
+    {
+        SB_FE_CONST(0xDAED4F2BE3A8BF27, 0x8E70132FB0BEB752,
+                    0x2F570E144BF615C0, 0x7E996D443DEE8729),
+        SB_FE_CONST(0xA69DCE4A7D6C98E8, 0xD4A1ACA87EF8D700,
+                    0x3F83C230F3AFA726, 0xAB40E52290BE1C55)
+    },
+    {
+        SB_FE_CONST(0xC44D12C7065D812E, 0x8ACF28D7CBB19F90,
+                    0x11ECD9E9FDF281B0, 0xE6A3B5E87D22E7DB),
+        SB_FE_CONST(0x2119A460CE326CDC, 0x76C45926C982FDAC,
+                    0x0E106E861EDF61C5, 0xA039063F0E0E6482)
+    },
+    {
+        SB_FE_CONST(0x6A245BF6DC698504, 0xC89A20CFDED60853,
+                    0x152B695336C28063, 0xB61C65CBD269E6B4),
+        SB_FE_CONST(0xE022CF42C2BD4A70, 0x8B3F5126F16A24AD,
+                    0x8B33BA48D0423B6E, 0xFD5E6348100D8A82)
+    }
+};
+
+// Variable-time verification on secp256k1 splits both scalars using the
+// curve's endomorphism, and so also needs the odd multiples of lambda * G,
+// which are (beta * x, y) for each entry (x, y) above.
+
+static const sb_fe_t
+    SB_CURVE_SECP256K1_LAMBDA_G_ODD[SB_SW_VARTIME_G_ENTRIES][2] = {
+    {
+        SB_FE_CONST(0xBCACE2E99DA01887, 0xAB0102B696902325,
+                    0x872844067F15E98D, 0xA7BBA04400B88FCB),
+        SB_FE_CONST(0x483ADA7726A3C465, 0x5DA4FBFC0E1108A8,
+                    0xFD17B448A6855419, 0x9C47D08FFB10D4B8)
+    },
+    {
+        SB_FE_CONST(0xDF6EDF03731F9B4B, 0x8DCD8DCF2A28FA2F,
+                    0x8AF1E022C6DC8E1C, 0xF7F0728C77206B2F),
+        SB_FE_CONST(0x388F7B0F632DE814, 0x0FE337E62A37F356,
+                    0x6500A99934C2231B, 0x6CB9FD7584B8E672)
+    },
+    {
+        SB_FE_CONST(0x337B52E3ACDA49DF, 0xF79F54FBCCB94671,
+                    0xA045693EE0D097CC, 0x138C694695A83668),
+        SB_FE_CONST(0xD8AC222636E5E3D6, 0xD4DBA9DDA6C9C426,
+                    0xF788271BAB0D6840, 0xDCA87D3AA6AC62D6)
+    },
+    {
+        SB_FE_CONST(0x13F26E754BEA0B77, 0xA4FEC4D1C095C06E,
+                    0x0D3B20E20FAF7AAA, 0x3BC4686E4E53BC94),
+        SB_FE_CONST(0x6AEBCA40BA255960, 0xA3178D6D861A54DB,
+                    0xA813D0B813FDE7B5, 0xA5082628087264DA)
+    },
+    {
+        SB_FE_CONST(0x87B404037E44E819, 0x7B6558AFEC58AB20,
+                    0xB565CDF5EF6D44E1, 0x20CD912E65953A52),
+        SB_FE_CONST(0xCC338921B0A7D9FD, 0x64380971763B61E9,
+                    0xADD888A4375F8E0F, 0x05CC262AC64F9C37)
+    },
+    {
+        SB_FE_CONST(0x51F4D3D1171DAC1D, 0x8D897C41BEBF1A26,
+                    0x79859BB70B5FF620, 0xC5FF4334BB209CE7),
+        SB_FE_CONST(0xD984A032EB6B5E19, 0x0243DD56D7B7B365,
+                    0x372DB1E2DFF9D6A8, 0x301D74C9C953C61B)
+    },
+    {
+        SB_FE_CONST(0xF14D58374BB890A2, 0x07046C4578FC783B,
+                    0x32907ED74A3D0562, 0x60AAEE6A475FB678),
+        SB_FE_CONST(0x0AB0902E8D880A89, 0x758212EB65CDAF47,
+                    0x3A1A06DA521FA91F, 0x29B5CB52DB03ED81)
+    },
+    {
+        SB_FE_CONST(0x805F1105F5F9454A, 0x0E1B4825512B6948,
+                    0x05CC3BC9C1C0A639, 0x3AC0A40C71B1B3B4),
+        SB_FE_CONST(0x581E2872A86C72A6, 0x83842EC228CC6DEF,
+                    0xEA40AF2BD896D3A5, 0xC504DC9FF6A26B58)
+    },
+    {
+        SB_FE_CONST(0xC2E95843A1F110E2, 0xDD08754CC8986867,
+                    0x5CD58547A6754102, 0xC640B26AF6433CC9),
+        SB_FE_CONST(0x4211AB0694635168, 0xE997B0EAD2A93DAE,
+                    0xCED1F4A04A95C0F6, 0xCFB199F69E56EB77)
+    },
+    {
+        SB_FE_CONST(0x54F51A8F5A6BB0F6, 0x3272082DBFC45CC5,
+                    0x57BAFB25D78EEB1C, 0x5D2EB9142ED76769),
+        SB_FE_CONST(0x85E89BC037945D93, 0xB343083B5A1C8613,
+                    0x1A01F60C50269763, 0xB570C854E5C09B7A)
+    },
+    {
+        SB_FE_CONST(0x680EB70F9B7E452E, 0xA63D667A0A204325,
+                    0x592BC884809F2969, 0x2FDEAAB069CBBC35),
+        SB_FE_CONST(0x321EB4075348F534, 0xD59C18259DDA3E1F,
+                    0x4A1B3B2E71B1039C, 0x67BD3D8BCF81998C)
+    },
+    {
+        SB_FE_CONST(0xBAE0440B1659BC6E, 0xCFE162A03AED4DA4,
+                    0x47C5360F34A09B26, 0xB6704DCE788930FC),
+        SB_FE_CONST(0x02DE1068295DD865, 0xB64569335BD5DD80,
+                    0x181D70ECFC882648, 0x423BA76B532B7D67)
+    },
+    {
+        SB_FE_CONST(0xF7554ECE5468C831, 0x1F7497E0301D395F,
+                    0xE15B71F68400AA85, 0x8D758E87EF3195BE),
+        SB_FE_CONST(0x73016F7BF234AADE, 0x5D1AA71BDEA2B1FF,
+                    0x3FC0DE2A887912FF, 0xE54A32CE97CB3402)
+    },
+    {
+        SB_FE_CONST(0x8CA980CFE497BE98, 0x1D6D435F1AC76911,
+                    0x546322C61318A794, 0x837A2DFEF61B7229),
+        SB_FE_CONST(0xA69DCE4A7D6C98E8, 0xD4A1ACA87EF8D700,
+                    0x3F83C230F3AFA726, 0xAB40E52290BE1C55)
+    },
+    {
+        SB_FE_CONST(0xE48590B373B31775, 0x188C807E0658F9EB,
+                    0x1B9C0525119BD70C, 0xC5C56571D53BA020),
+        SB_FE_CONST(0x2119A460CE326CDC, 0x76C45926C982FDAC,
+                    0x0E106E861EDF61C5, 0xA039063F0E0E6482)
+    },
+    {
+        SB_FE_CONST(0xE6034C74DAE527C2, 0xE84D275183B19A3A,
+                    0x20BA50015945EB46, 0x8F8022A6AFAC1B9B),
+        SB_FE_CONST(0xE022CF42C2BD4A70, 0x8B3F5126F16A24AD,
+                    0x8B33BA48D0423B6E, 0xFD5E6348100D8A82)
+    }
+};
+
+#endif
+
+#endif
+
+#endif
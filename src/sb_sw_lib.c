@@ -30,6 +30,12 @@
 #define C_T7(ct) (&(ct)->c[6])
 #define C_T8(ct) (&(ct)->c[7])
 
+// The Z coordinate of (x1, y1) in Jacobian point arithmetic
+#define C_Z1(ct) (&(ct)->c[9])
+
+// The Z coordinate of (x2, y2) in Jacobian and projective point addition
+#define C_Z2(ct) (&(ct)->c[10])
+
 // The scalar used for point multiplication
 #define MULT_K(ct) (&(ct)->h[0])
 
@@ -59,6 +65,14 @@
 #define VERIFY_QS(ct) (&(ct)->c[10])
 #define VERIFY_QR(ct) (&(ct)->c[11])
 
+// The odd scalar in fixed-base multiplication
+#define MULT_BASE_K(ct) (&(ct)->c[8])
+
+// The odd scalars in comb multiplication-addition with a prepared public key,
+// overlapping MULT_POINT and VERIFY_QS
+#define MULT_ADD_COMB_KP(ct) (&(ct)->h[2])
+#define MULT_ADD_COMB_KG(ct) (&(ct)->c[10])
+
 // All multiplication in Sweet B takes place using Montgomery multiplication
 // MM(x, y) = x * y * R^-1 mod M where R = 2^SB_FE_BITS
 // This has the nice property that MM(x * R, y * R) = x * y * R
@@ -77,14 +91,16 @@
 
 // Input:  P = (x2, y2) in affine coordinates
 // Output: (x1, y1) = P', (x2, y2) = 2P in co-Z with t5 = Z = 2 * y2
-// Cost:   6MM + 11A
+// Cost:   6MM + 11A (10A if a = 0)
 static void sb_sw_point_initial_double(sb_sw_context_t c[static const 1],
                                        const sb_sw_curve_t s[static const 1])
 {
     sb_fe_mod_double(C_T5(c), C_Y2(c), s->p); // t5 = Z
     sb_fe_mont_square(C_Y1(c), C_X2(c), s->p); // t2 = x^2
-    sb_fe_mod_sub(C_Y1(c), C_Y1(c), s->minus_a_r_over_three,
-                  s->p); // t2 = x^2 + a / 3
+    if (!SB_SW_CURVE_A_ZERO(s)) {
+        sb_fe_mod_sub(C_Y1(c), C_Y1(c), s->minus_a_r_over_three,
+                      s->p); // t2 = x^2 + a / 3
+    }
     sb_fe_mod_double(C_X1(c), C_Y1(c), s->p); // t1 = 2 * (x^2 + a / 3)
     sb_fe_mod_add(C_Y1(c), C_Y1(c), C_X1(c),
                   s->p); // t2 = (3 * x^2 + a) = B
@@ -153,6 +169,8 @@ sb_sw_point_co_z_add_update(sb_sw_context_t c[static const 1],
     sb_sw_point_co_z_add_update_zup(c, s);
 }
 
+#if !SB_SW_VARIABLE_BASE_WINDOW || defined(SB_TEST)
+
 // Co-Z conjugate addition with update, with Z-update computation
 // Input:  P = (x1, y1), Q = (x2, y2) in co-Z, with x2 - x1 in t6
 // Output: P + Q = (x3, y3) in (x1, y1), P - Q = in (x2, y2), P' in (t6, t7)
@@ -180,6 +198,126 @@ static void sb_sw_point_co_z_conj_add(sb_sw_context_t c[static const 1],
                   s->p); // y3' = (y2 + y1) * (x3' - B) - E
 }
 
+#endif
+
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_VARTIME_SUPPORT || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+
+// Table-driven multiplication methods add precomputed affine points to a
+// running total in Jacobian coordinates, with Z stored in z1. The running
+// total is (x1, y1, z1) and the point to be added is (x2, y2).
+
+// Jacobian point doubling: (x1, y1, z1) = 2 * (x1, y1, z1)
+// Uses: t5, t6, t7, t8
+// Cost: 8MM + 12A (7MM + 10A if a = 0)
+static void sb_sw_point_double(sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+    if (SB_SW_CURVE_A_ZERO(s)) {
+        sb_fe_mont_square(C_T5(c), C_X1(c), s->p); // t5 = X^2
+    } else {
+        sb_fe_mont_square(C_T5(c), C_Z1(c), s->p); // t5 = Z^2
+        sb_fe_mod_sub(C_T6(c), C_X1(c), C_T5(c), s->p); // t6 = X - Z^2
+        sb_fe_mod_add(C_T7(c), C_X1(c), C_T5(c), s->p); // t7 = X + Z^2
+        sb_fe_mont_mult(C_T5(c), C_T6(c), C_T7(c),
+                        s->p); // t5 = X^2 - Z^4 = X^2 + a / 3 * Z^4
+    }
+    sb_fe_mod_double(C_T6(c), C_T5(c), s->p);
+    sb_fe_mod_add(C_T6(c), C_T6(c), C_T5(c), s->p); // t6 = 3 * X^2 + a * Z^4 = M
+
+    sb_fe_mont_mult(C_T5(c), C_Y1(c), C_Z1(c), s->p); // t5 = Y * Z
+    sb_fe_mod_double(C_Z1(c), C_T5(c), s->p); // z1 = 2 * Y * Z
+
+    sb_fe_mont_square(C_T7(c), C_Y1(c), s->p); // t7 = Y^2
+    sb_fe_mod_double(C_T7(c), C_T7(c), s->p); // t7 = 2 * Y^2
+    sb_fe_mont_mult(C_T5(c), C_X1(c), C_T7(c), s->p); // t5 = 2 * X * Y^2
+    sb_fe_mod_double(C_T5(c), C_T5(c), s->p); // t5 = 4 * X * Y^2 = S
+
+    sb_fe_mont_square(C_T8(c), C_T7(c), s->p); // t8 = 4 * Y^4
+    sb_fe_mod_double(C_T8(c), C_T8(c), s->p); // t8 = 8 * Y^4
+
+    sb_fe_mont_square(C_X1(c), C_T6(c), s->p); // x1 = M^2
+    sb_fe_mod_sub(C_X1(c), C_X1(c), C_T5(c), s->p);
+    sb_fe_mod_sub(C_X1(c), C_X1(c), C_T5(c), s->p); // x1 = M^2 - 2 * S
+
+    sb_fe_mod_sub(C_T5(c), C_T5(c), C_X1(c), s->p); // t5 = S - X'
+    sb_fe_mont_mult(C_Y1(c), C_T6(c), C_T5(c), s->p); // y1 = M * (S - X')
+    sb_fe_mod_sub(C_Y1(c), C_Y1(c), C_T8(c),
+                  s->p); // y1 = M * (S - X') - 8 * Y^4
+}
+
+// Mixed addition, first part: computes H = x2 * Z^2 - X and
+// r = y2 * Z^3 - Y. If H is zero (represented as p), the addition is
+// exceptional: the points are equal if r is also zero, and are negations of
+// each other otherwise.
+// Output: H in t6, r in t5
+// Cost:   4MM + 2A
+static void sb_sw_point_mixed_add_h_r(sb_sw_context_t c[static const 1],
+                                      const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_square(C_T5(c), C_Z1(c), s->p); // t5 = Z^2
+    sb_fe_mont_mult(C_T6(c), C_X2(c), C_T5(c), s->p); // t6 = x2 * Z^2
+    sb_fe_mont_mult(C_T7(c), C_T5(c), C_Z1(c), s->p); // t7 = Z^3
+    sb_fe_mont_mult(C_T5(c), C_Y2(c), C_T7(c), s->p); // t5 = y2 * Z^3
+
+    sb_fe_mod_sub(C_T6(c), C_T6(c), C_X1(c), s->p); // t6 = x2 * Z^2 - X = H
+    sb_fe_mod_sub(C_T5(c), C_T5(c), C_Y1(c), s->p); // t5 = y2 * Z^3 - Y = r
+}
+
+// Mixed addition, second part: (x1, y1, z1) = (x1, y1, z1) + (x2, y2), given
+// H in t6 and r in t5 from sb_sw_point_mixed_add_h_r. The result is incorrect
+// if the addition is exceptional.
+// Uses: t5, t6, t7, t8
+// Cost: 7MM + 5A
+static void sb_sw_point_mixed_add_finish(sb_sw_context_t c[static const 1],
+                                         const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_mult(C_T7(c), C_Z1(c), C_T6(c), s->p); // t7 = Z * H
+    *C_Z1(c) = *C_T7(c); // z1 = Z * H
+
+    sb_fe_mont_square(C_T7(c), C_T6(c), s->p); // t7 = H^2
+    sb_fe_mont_mult(C_T8(c), C_T7(c), C_T6(c), s->p); // t8 = H^3
+    sb_fe_mont_mult(C_T6(c), C_X1(c), C_T7(c), s->p); // t6 = X * H^2 = V
+
+    sb_fe_mont_square(C_X1(c), C_T5(c), s->p); // x1 = r^2
+    sb_fe_mod_sub(C_X1(c), C_X1(c), C_T8(c), s->p);
+    sb_fe_mod_sub(C_X1(c), C_X1(c), C_T6(c), s->p);
+    sb_fe_mod_sub(C_X1(c), C_X1(c), C_T6(c), s->p); // x1 = r^2 - H^3 - 2 * V
+
+    sb_fe_mont_mult(C_T7(c), C_Y1(c), C_T8(c), s->p); // t7 = Y * H^3
+    sb_fe_mod_sub(C_T6(c), C_T6(c), C_X1(c), s->p); // t6 = V - X'
+    sb_fe_mont_mult(C_Y1(c), C_T5(c), C_T6(c), s->p); // y1 = r * (V - X')
+    sb_fe_mod_sub(C_Y1(c), C_Y1(c), C_T7(c),
+                  s->p); // y1 = r * (V - X') - Y * H^3
+}
+
+#endif
+
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_VARTIME_SUPPORT || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+
+// Converts (x1, y1, z1) to affine coordinates, NOT multiplied by R, in
+// (x1, y1).
+// Uses: t5, t6, t7, t8
+static void sb_sw_point_affine(sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+    // Compute final Z^-1
+    *C_T8(c) = *C_Z1(c);
+    sb_fe_mod_inv_r(C_T8(c), C_T5(c), C_T6(c), s->p); // t8 = Z^-1 * R
+
+    sb_fe_mont_square(C_T5(c), C_T8(c), s->p); // t5 = Z^-2 * R
+    sb_fe_mont_mult(C_T6(c), C_T5(c), C_T8(c), s->p); // t6 = Z^-3 * R
+
+    sb_fe_mont_mult(C_T7(c), C_T5(c), C_X1(c), s->p); // t7 = X * Z^-2 * R
+    sb_fe_mont_reduce(C_X1(c), C_T7(c), s->p); // Montgomery reduce to x1
+
+    sb_fe_mont_mult(C_T7(c), C_T6(c), C_Y1(c), s->p); // t7 = Y * Z^-3 * R
+    sb_fe_mont_reduce(C_Y1(c), C_T7(c), s->p); // Montgomery reduce to y1
+}
+
+#endif
+
 // Regularize the bit count of the scalar by adding CURVE_N or 2 * CURVE_N
 // The resulting scalar will have P256_BITS + 1 bits, with the highest bit set
 // This enables the Montgomery ladder to start at (1P, 2P) instead of (0P, 1P).
@@ -202,11 +340,15 @@ static void sb_sw_regularize_scalar(sb_fe_t scalar[static const 1],
     sb_fe_ctswap(c_1, scalar, C_T5(c));
 }
 
+#if !SB_SW_VARIABLE_BASE_WINDOW || defined(SB_TEST)
 
+// Computes k * P for k in MULT_K and P = point, with X and Y multiplied by R,
+// using the Montgomery ladder. The result is left in (x1, y1) in affine
+// coordinates, NOT multiplied by R.
 static void
-sb_sw_point_mult(sb_sw_context_t m[static const 1],
-                 const sb_fe_t point[static const 2],
-                 const sb_sw_curve_t s[static const 1])
+sb_sw_point_mult_ladder(sb_sw_context_t m[static const 1],
+                        const sb_fe_t point[static const 2],
+                        const sb_sw_curve_t s[static const 1])
 {
     // Input scalars MUST always be checked for validity
     // (k is reduced and ∉ {-2, -1, 0, 1} mod N).
@@ -427,638 +569,4177 @@ sb_sw_point_mult(sb_sw_context_t m[static const 1],
                   s->n);  // reduce to restore original scalar
 }
 
-// Multiplication-addition using Shamir's trick to produce k_1 * P + k_2 * Q
+#endif
 
-// sb_sw_point_mult_add_z_update computes the new Z and then performs co-Z
-// point addition at a cost of 7MM + 7A
-static void sb_sw_point_mult_add_z_update(sb_sw_context_t q[static const 1],
-                                          const sb_sw_curve_t s[static const 1])
+#if SB_SW_VARTIME_SUPPORT || SB_SW_GLV_WINDOW || SB_SW_VARIABLE_BASE_WINDOW
+
+// Places the odd multiples P, 3 * P, ..., (2 * entries - 1) * P of the affine
+// point P = (x2, y2), multiplied by R, into table. The first entry is P
+// itself; the others are computed in co-Z with 2 * P and are left in Jacobian
+// coordinates, with ratio[i] = Z_i / Z_(i - 1), where Z_0 = ratio[0] is the Z
+// of P in co-Z with 2 * P, and Z_i for the last entry in z1.
+// sb_sw_point_odd_multiples_affine then converts them to affine coordinates
+// given Z_i^-1 for the last entry.
+// Uses: x1, y1, x2, y2, t5, t6, t7, z1
+static void sb_sw_point_odd_multiples_z(sb_fe_t table[static const 1][2],
+                                        sb_fe_t ratio[static const 1],
+                                        const size_t entries,
+                                        sb_sw_context_t c[static const 1],
+                                        const sb_sw_curve_t s[static const 1])
 {
-    sb_fe_mod_sub(C_T6(q), C_X2(q), C_X1(q), s->p); // t6 = x2 - x1 = Z' / Z
-    sb_fe_mont_mult(C_T5(q), C_T6(q), MULT_Z(q), s->p); // updated Z
-    *MULT_Z(q) = *C_T5(q);
-
-    sb_sw_point_co_z_add_update_zup(q, s);
+    table[0][0] = *C_X2(c);
+    table[0][1] = *C_Y2(c);
+
+    // (x1, y1) = P', (x2, y2) = 2 * P with Z_0 = t5
+    sb_sw_point_initial_double(c, s);
+    *C_Z1(c) = *C_T5(c);
+    ratio[0] = *C_T5(c);
+
+    for (size_t i = 1; i < entries; i++) {
+        // (x1, y1) = 2 * P, (x2, y2) = (2 * i - 1) * P
+        *C_T5(c) = *C_X1(c);
+        *C_X1(c) = *C_X2(c);
+        *C_X2(c) = *C_T5(c);
+        *C_T5(c) = *C_Y1(c);
+        *C_Y1(c) = *C_Y2(c);
+        *C_Y2(c) = *C_T5(c);
+
+        sb_fe_mod_sub(C_T6(c), C_X2(c), C_X1(c), s->p); // t6 = Z_i / Z_(i - 1)
+        ratio[i] = *C_T6(c);
+
+        sb_fe_mont_mult(C_T5(c), C_Z1(c), C_T6(c), s->p);
+        *C_Z1(c) = *C_T5(c);
+
+        // (x1, y1) = (2 * i + 1) * P, (x2, y2) = 2 * P
+        sb_sw_point_co_z_add_update_zup(c, s);
+        table[i][0] = *C_X1(c);
+        table[i][1] = *C_Y1(c);
+    }
 }
 
-// sb_sw_point_mult_add_apply_z applies a Z value to the selected point
-// (H, P + H, G + H, or P + G + H) at a cost of 4MM
-static void sb_sw_point_mult_add_apply_z(sb_sw_context_t q[static const 1],
-                                         const sb_sw_curve_t s[static const 1])
+// Given Z^-1 * R for the last entry of a table produced by
+// sb_sw_point_odd_multiples_z in t5, converts its entries to affine
+// coordinates multiplied by R.
+// Uses: x1, y1, t5, t6, t7
+static void
+sb_sw_point_odd_multiples_affine(sb_fe_t table[static const 1][2],
+                                 const sb_fe_t ratio[static const 1],
+                                 const size_t entries,
+                                 sb_sw_context_t c[static const 1],
+                                 const sb_sw_curve_t s[static const 1])
 {
-    sb_fe_mont_square(C_T6(q), MULT_Z(q), s->p); // Z^2
+    for (size_t i = entries - 1; i > 0; i--) {
+        sb_fe_mont_square(C_T6(c), C_T5(c), s->p); // t6 = Z_i^-2
+        sb_fe_mont_mult(C_T7(c), C_T6(c), C_T5(c), s->p); // t7 = Z_i^-3
 
-    sb_fe_mont_mult(C_T7(q), C_X2(q), C_T6(q), s->p);
-    *C_X2(q) = *C_T7(q);
+        sb_fe_mont_mult(C_X1(c), &table[i][0], C_T6(c), s->p);
+        sb_fe_mont_mult(C_Y1(c), &table[i][1], C_T7(c), s->p);
+        table[i][0] = *C_X1(c);
+        table[i][1] = *C_Y1(c);
 
-    sb_fe_mont_mult(C_T7(q), C_T6(q), MULT_Z(q), s->p); // Z^3
-    sb_fe_mont_mult(C_T6(q), C_Y2(q), C_T7(q), s->p);
-    *C_Y2(q) = *C_T6(q);
+        sb_fe_mont_mult(C_T6(c), C_T5(c), &ratio[i], s->p);
+        *C_T5(c) = *C_T6(c); // t5 = Z_(i - 1)^-1
+    }
 }
 
-// sb_sw_point_mult_add_select selects the point to conjugate-add to the
-// running total based on the bits of the given input scalars
-static void sb_sw_point_mult_add_select(const sb_word_t bp, const sb_word_t bg,
-                                        sb_sw_context_t q[static const 1],
-                                        const sb_sw_curve_t s[static const 1])
+#endif
+
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+
+// The complete formulas of Renes, Costello, and Batina 2016 ("Complete
+// addition formulas for prime order elliptic curves") have no exceptional
+// cases on curves of odd order: the same sequence of operations computes
+// P + Q for every P and Q, including P = Q, P = -Q, and the point at infinity.
+// They work in homogeneous projective coordinates, where (X, Y, Z) is the
+// affine point (X / Z, Y / Z) and (0, 1, 0) is the point at infinity, and are
+// specialized for a = -3 (Algorithms 4 through 6 of the paper) and a = 0
+// (Algorithms 7 through 9). The running total is (x1, y1, z1). The point to be
+// added is (x2, y2, z2) in full addition, and the affine point (x2, y2), which
+// cannot be the point at infinity, in mixed addition. b' below is
+// complete_b_r: b for a = -3 and 3 * b for a = 0.
+
+// Complete mixed addition for a = -3:
+// (x1, y1, z1) = (x1, y1, z1) + (x2, y2)
+// Cost: 13MM + 23A
+static void
+sb_sw_point_mixed_add_complete_a3(sb_sw_context_t c[static const 1],
+                                  const sb_sw_curve_t s[static const 1])
 {
-    // select a point S for conjugate addition with R
-    // if bp = 0 and bg = 0, select h
-    // if bp = 0 and bg = 1, select g + h
-    // if bp = 1 and bg = 0, select p + h
-    // if bp = 1 and bg = 1, select p + g + h
-    *C_X2(q) = s->h_r[0];
-    *C_Y2(q) = s->h_r[1];
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    sb_fe_mont_mult(&t0, C_X1(c), C_X2(c), p); // t0 = X1 * x2
+    sb_fe_mont_mult(&t1, C_Y1(c), C_Y2(c), p); // t1 = Y1 * y2
+    sb_fe_mod_add(&t3, C_X2(c), C_Y2(c), p); // t3 = x2 + y2
+    sb_fe_mod_add(&t4, C_X1(c), C_Y1(c), p); // t4 = X1 + Y1
+    sb_fe_mont_mult(&t2, &t3, &t4, p); // t2 = (x2 + y2) * (X1 + Y1)
+    sb_fe_mod_add(&t4, &t0, &t1, p);
+    sb_fe_mod_sub(&t3, &t2, &t4, p); // t3 = X1 * y2 + x2 * Y1
+    sb_fe_mont_mult(&t2, C_Y2(c), C_Z1(c), p);
+    sb_fe_mod_add(&t4, &t2, C_Y1(c), p); // t4 = y2 * Z1 + Y1
+    sb_fe_mont_mult(&y3, C_X2(c), C_Z1(c), p);
+    sb_fe_mod_add(&y3, &y3, C_X1(c), p); // y3 = x2 * Z1 + X1
+    sb_fe_mont_mult(&z3, &s->complete_b_r, C_Z1(c), p); // z3 = b * Z1
+    sb_fe_mod_sub(&x3, &y3, &z3, p);
+    sb_fe_mod_double(&z3, &x3, p);
+    sb_fe_mod_add(&x3, &x3, &z3, p); // x3 = 3 * (x2 * Z1 + X1 - b * Z1)
+    sb_fe_mod_sub(&z3, &t1, &x3, p); // z3 = Y1 * y2 - x3
+    sb_fe_mod_add(&x3, &t1, &x3, p); // x3 = Y1 * y2 + x3
+    sb_fe_mont_mult(&t5, &s->complete_b_r, &y3, p); // t5 = b * y3
+    sb_fe_mod_double(&t1, C_Z1(c), p);
+    sb_fe_mod_add(&t2, &t1, C_Z1(c), p); // t2 = 3 * Z1
+    sb_fe_mod_sub(&y3, &t5, &t2, p);
+    sb_fe_mod_sub(&y3, &y3, &t0, p);
+    sb_fe_mod_double(&t1, &y3, p);
+    sb_fe_mod_add(&y3, &t1, &y3, p); // y3 = 3 * (b * y3 - 3 * Z1 - X1 * x2)
+    sb_fe_mod_double(&t1, &t0, p);
+    sb_fe_mod_add(&t0, &t1, &t0, p);
+    sb_fe_mod_sub(&t0, &t0, &t2, p); // t0 = 3 * X1 * x2 - 3 * Z1
+    sb_fe_mont_mult(&t1, &t4, &y3, p);
+    sb_fe_mont_mult(&t2, &t0, &y3, p);
+    sb_fe_mont_mult(&y3, &x3, &z3, p);
+    sb_fe_mod_add(C_Y1(c), &y3, &t2, p); // Y3 = x3 * z3 + t0 * y3
+    sb_fe_mont_mult(&t5, &t3, &x3, p);
+    sb_fe_mod_sub(C_X1(c), &t5, &t1, p); // X3 = t3 * x3 - t4 * y3
+    sb_fe_mont_mult(&t5, &t4, &z3, p);
+    sb_fe_mont_mult(&t1, &t3, &t0, p);
+    sb_fe_mod_add(C_Z1(c), &t5, &t1, p); // Z3 = t4 * z3 + t3 * t0
+}
 
-    *C_T5(q) = s->g_h_r[0];
-    *C_T6(q) = s->g_h_r[1];
-    sb_fe_ctswap(bg, C_X2(q), C_T5(q));
-    sb_fe_ctswap(bg, C_Y2(q), C_T6(q));
+// Complete doubling for a = -3: (x1, y1, z1) = 2 * (x1, y1, z1)
+// Cost: 13MM + 21A
+static void
+sb_sw_point_double_complete_a3(sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    sb_fe_mont_square(&t0, C_X1(c), p); // t0 = X^2
+    sb_fe_mont_square(&t1, C_Y1(c), p); // t1 = Y^2
+    sb_fe_mont_square(&t2, C_Z1(c), p); // t2 = Z^2
+    sb_fe_mont_mult(&t4, C_X1(c), C_Y1(c), p);
+    sb_fe_mod_double(&t3, &t4, p); // t3 = 2 * X * Y
+    sb_fe_mont_mult(&t4, C_X1(c), C_Z1(c), p);
+    sb_fe_mod_double(&z3, &t4, p); // z3 = 2 * X * Z
+    sb_fe_mont_mult(&y3, &s->complete_b_r, &t2, p);
+    sb_fe_mod_sub(&y3, &y3, &z3, p);
+    sb_fe_mod_double(&x3, &y3, p);
+    sb_fe_mod_add(&y3, &x3, &y3, p); // y3 = 3 * (b * Z^2 - 2 * X * Z)
+    sb_fe_mod_sub(&x3, &t1, &y3, p); // x3 = Y^2 - y3
+    sb_fe_mod_add(&y3, &t1, &y3, p); // y3 = Y^2 + y3
+    sb_fe_mont_mult(&t4, &x3, &y3, p); // t4 = x3 * y3
+    sb_fe_mont_mult(&t5, &x3, &t3, p); // t5 = x3 * 2 * X * Y
+    sb_fe_mod_double(&t3, &t2, p);
+    sb_fe_mod_add(&t2, &t2, &t3, p); // t2 = 3 * Z^2
+    sb_fe_mont_mult(&t3, &s->complete_b_r, &z3, p);
+    sb_fe_mod_sub(&z3, &t3, &t2, p);
+    sb_fe_mod_sub(&z3, &z3, &t0, p);
+    sb_fe_mod_double(&t3, &z3, p);
+    sb_fe_mod_add(&z3, &z3, &t3, p); // z3 = 3 * (b * z3 - 3 * Z^2 - X^2)
+    sb_fe_mod_double(&t3, &t0, p);
+    sb_fe_mod_add(&t0, &t3, &t0, p);
+    sb_fe_mod_sub(&t0, &t0, &t2, p); // t0 = 3 * X^2 - 3 * Z^2
+    sb_fe_mont_mult(&t3, &t0, &z3, p);
+    sb_fe_mod_add(&y3, &t4, &t3, p); // y3 = t4 + t0 * z3
+    sb_fe_mont_mult(&t4, C_Y1(c), C_Z1(c), p);
+    sb_fe_mod_double(&t0, &t4, p); // t0 = 2 * Y * Z
+    sb_fe_mont_mult(&t2, &t0, &z3, p);
+    sb_fe_mod_sub(C_X1(c), &t5, &t2, p); // X3 = t5 - 2 * Y * Z * z3
+    *C_Y1(c) = y3;
+    sb_fe_mont_mult(&t2, &t0, &t1, p);
+    sb_fe_mod_double(&t2, &t2, p);
+    sb_fe_mod_double(C_Z1(c), &t2, p); // Z3 = 8 * Y^3 * Z
+}
 
-    *C_T5(q) = MULT_POINT(q)[0];
-    *C_T6(q) = MULT_POINT(q)[1];
-    sb_fe_ctswap(bp, C_X2(q), C_T5(q));
-    sb_fe_ctswap(bp, C_Y2(q), C_T6(q));
+// Complete mixed addition for a = 0:
+// (x1, y1, z1) = (x1, y1, z1) + (x2, y2)
+// Cost: 13MM + 13A
+static void
+sb_sw_point_mixed_add_complete_a0(sb_sw_context_t c[static const 1],
+                                  const sb_sw_curve_t s[static const 1])
+{
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    sb_fe_mont_mult(&t0, C_X1(c), C_X2(c), p); // t0 = X1 * x2
+    sb_fe_mont_mult(&t1, C_Y1(c), C_Y2(c), p); // t1 = Y1 * y2
+    sb_fe_mod_add(&t3, C_X2(c), C_Y2(c), p); // t3 = x2 + y2
+    sb_fe_mod_add(&t4, C_X1(c), C_Y1(c), p); // t4 = X1 + Y1
+    sb_fe_mont_mult(&t2, &t3, &t4, p); // t2 = (x2 + y2) * (X1 + Y1)
+    sb_fe_mod_add(&t4, &t0, &t1, p);
+    sb_fe_mod_sub(&t3, &t2, &t4, p); // t3 = X1 * y2 + x2 * Y1
+    sb_fe_mont_mult(&t2, C_Y2(c), C_Z1(c), p);
+    sb_fe_mod_add(&t4, &t2, C_Y1(c), p); // t4 = y2 * Z1 + Y1
+    sb_fe_mont_mult(&y3, C_X2(c), C_Z1(c), p);
+    sb_fe_mod_add(&y3, &y3, C_X1(c), p); // y3 = x2 * Z1 + X1
+    sb_fe_mod_double(&x3, &t0, p);
+    sb_fe_mod_add(&t0, &x3, &t0, p); // t0 = 3 * X1 * x2
+    sb_fe_mont_mult(&t2, &s->complete_b_r, C_Z1(c), p); // t2 = 3 * b * Z1
+    sb_fe_mod_add(&z3, &t1, &t2, p); // z3 = Y1 * y2 + 3 * b * Z1
+    sb_fe_mod_sub(&t1, &t1, &t2, p); // t1 = Y1 * y2 - 3 * b * Z1
+    sb_fe_mont_mult(&t5, &s->complete_b_r, &y3, p); // t5 = 3 * b * y3
+    sb_fe_mont_mult(&x3, &t4, &t5, p);
+    sb_fe_mont_mult(&t2, &t3, &t1, p);
+    sb_fe_mod_sub(C_X1(c), &t2, &x3, p); // X3 = t3 * t1 - t4 * t5
+    sb_fe_mont_mult(&y3, &t5, &t0, p);
+    sb_fe_mont_mult(&t2, &t1, &z3, p);
+    sb_fe_mod_add(C_Y1(c), &t2, &y3, p); // Y3 = t1 * z3 + t5 * t0
+    sb_fe_mont_mult(&t1, &t0, &t3, p);
+    sb_fe_mont_mult(&t5, &z3, &t4, p);
+    sb_fe_mod_add(C_Z1(c), &t5, &t1, p); // Z3 = z3 * t4 + t0 * t3
+}
 
-    *C_T5(q) = MULT_ADD_PG(q)[0];
-    *C_T6(q) = MULT_ADD_PG(q)[1];
-    sb_fe_ctswap(bp & bg, C_X2(q), C_T5(q));
-    sb_fe_ctswap(bp & bg, C_Y2(q), C_T6(q));
+// Complete doubling for a = 0: (x1, y1, z1) = 2 * (x1, y1, z1)
+// Cost: 9MM + 9A
+static void
+sb_sw_point_double_complete_a0(sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, z3;
+
+    sb_fe_mont_square(&t0, C_Y1(c), p); // t0 = Y^2
+    sb_fe_mod_double(&z3, &t0, p);
+    sb_fe_mod_double(&z3, &z3, p);
+    sb_fe_mod_double(&z3, &z3, p); // z3 = 8 * Y^2
+    sb_fe_mont_mult(&t1, C_Y1(c), C_Z1(c), p); // t1 = Y * Z
+    sb_fe_mont_square(&t2, C_Z1(c), p); // t2 = Z^2
+    sb_fe_mont_mult(&t3, &s->complete_b_r, &t2, p); // t3 = 3 * b * Z^2
+    sb_fe_mont_mult(&x3, &t3, &z3, p); // x3 = t3 * 8 * Y^2
+    sb_fe_mod_add(&t5, &t0, &t3, p); // t5 = Y^2 + t3
+    sb_fe_mont_mult(&t4, &t1, &z3, p); // t4 = 8 * Y^3 * Z
+    sb_fe_mod_double(&t1, &t3, p);
+    sb_fe_mod_add(&t2, &t1, &t3, p); // t2 = 9 * b * Z^2
+    sb_fe_mod_sub(&t0, &t0, &t2, p); // t0 = Y^2 - 9 * b * Z^2
+    sb_fe_mont_mult(&t2, &t0, &t5, p);
+    sb_fe_mod_add(&t5, &x3, &t2, p); // t5 = x3 + t0 * (Y^2 + t3)
+    sb_fe_mont_mult(&t1, C_X1(c), C_Y1(c), p); // t1 = X * Y
+    sb_fe_mont_mult(&x3, &t0, &t1, p);
+    sb_fe_mod_double(C_X1(c), &x3, p); // X3 = 2 * t0 * X * Y
+    *C_Y1(c) = t5;
+    *C_Z1(c) = t4;
+}
 
-    sb_sw_point_mult_add_apply_z(q, s);
+// Complete mixed addition: (x1, y1, z1) = (x1, y1, z1) + (x2, y2) in
+// projective coordinates
+static void
+sb_sw_point_mixed_add_complete(sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+    if (SB_SW_CURVE_A_ZERO(s)) {
+        sb_sw_point_mixed_add_complete_a0(c, s);
+    } else {
+        sb_sw_point_mixed_add_complete_a3(c, s);
+    }
 }
 
-// Signature verification uses a regular double-and-add algorithm with Shamir's
-// trick for dual scalar-basepoint multiplication. Because adding O (the
-// point at infinity) is an exceptional case in the standard formulae for
-// point addition on short Weierstrass curves, each iteration adds an
-// additional point H. Due to regularization of the input scalars,
-// the algorithm starts with bit 256 in both k_p and k_g set, so the initial
-// value is P + G + H, and at the end of the loop, (2^257 - 1) * H has been
-// added, producing k_p * P + k_g * G + (2^257 - 1) * H. To correct for this,
-// one could subtract the extra multiple of H at the end of the algorithm,
-// but instead H has been chosen so that we can easily adjust k_g before the
-// multiplication instead. Let H be (2^257 - 1)^-1 * G. Then compute:
-//   k_p * P + (k_g - 1) * G + (2^257 - 1) * H
-// = k_p * P + (k_g - 1) * G + (2^257 - 1) * (2^257 - 1)^-1 * G
-// = k_p * P + (k_g - 1) * G + G
-// = k_p * P + k_g * G
+// Complete doubling: (x1, y1, z1) = 2 * (x1, y1, z1) in projective coordinates
+static void sb_sw_point_double_complete(sb_sw_context_t c[static const 1],
+                                        const sb_sw_curve_t s[static const 1])
+{
+    if (SB_SW_CURVE_A_ZERO(s)) {
+        sb_sw_point_double_complete_a0(c, s);
+    } else {
+        sb_sw_point_double_complete_a3(c, s);
+    }
+}
 
-// The algorithm is as follows:
+#if SB_SW_VARIABLE_BASE_WINDOW
 
-// Given inputs k_p, P, k_g on some curve with base point G, and let H as
-// above, with G + H precomputed
+// Complete addition for a = -3:
+// (x1, y1, z1) = (x1, y1, z1) + (x2, y2, z2)
+// Cost: 14MM + 29A
+static void
+sb_sw_point_add_complete_a3(sb_sw_context_t c[static const 1],
+                            const sb_sw_curve_t s[static const 1])
+{
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    sb_fe_mont_mult(&t0, C_X1(c), C_X2(c), p); // t0 = X1 * X2
+    sb_fe_mont_mult(&t1, C_Y1(c), C_Y2(c), p); // t1 = Y1 * Y2
+    sb_fe_mont_mult(&t5, C_Z1(c), C_Z2(c), p); // t5 = Z1 * Z2
+    sb_fe_mod_add(&t3, C_X2(c), C_Y2(c), p); // t3 = X2 + Y2
+    sb_fe_mod_add(&t4, C_X1(c), C_Y1(c), p); // t4 = X1 + Y1
+    sb_fe_mont_mult(&t2, &t3, &t4, p); // t2 = (X2 + Y2) * (X1 + Y1)
+    sb_fe_mod_add(&t4, &t0, &t1, p);
+    sb_fe_mod_sub(&t3, &t2, &t4, p); // t3 = X1 * Y2 + X2 * Y1
+    sb_fe_mod_add(&t2, C_Y2(c), C_Z2(c), p); // t2 = Y2 + Z2
+    sb_fe_mod_add(&t4, C_Y1(c), C_Z1(c), p); // t4 = Y1 + Z1
+    sb_fe_mont_mult(&x3, &t2, &t4, p); // x3 = (Y2 + Z2) * (Y1 + Z1)
+    sb_fe_mod_add(&t4, &t1, &t5, p);
+    sb_fe_mod_sub(&t4, &x3, &t4, p); // t4 = Y1 * Z2 + Y2 * Z1
+    sb_fe_mod_add(&t2, C_X2(c), C_Z2(c), p); // t2 = X2 + Z2
+    sb_fe_mod_add(&x3, C_X1(c), C_Z1(c), p); // x3 = X1 + Z1
+    sb_fe_mont_mult(&y3, &t2, &x3, p); // y3 = (X2 + Z2) * (X1 + Z1)
+    sb_fe_mod_add(&x3, &t0, &t5, p);
+    sb_fe_mod_sub(&y3, &y3, &x3, p); // y3 = X1 * Z2 + X2 * Z1
+    sb_fe_mont_mult(&z3, &s->complete_b_r, &t5, p); // z3 = b * Z1 * Z2
+    sb_fe_mod_sub(&x3, &y3, &z3, p);
+    sb_fe_mod_double(&z3, &x3, p);
+    sb_fe_mod_add(&x3, &x3, &z3, p); // x3 = 3 * (y3 - b * Z1 * Z2)
+    sb_fe_mod_sub(&z3, &t1, &x3, p); // z3 = Y1 * Y2 - x3
+    sb_fe_mod_add(&x3, &t1, &x3, p); // x3 = Y1 * Y2 + x3
+    sb_fe_mod_double(&t1, &t5, p);
+    sb_fe_mod_add(&t2, &t1, &t5, p); // t2 = 3 * Z1 * Z2
+    sb_fe_mont_mult(&t5, &s->complete_b_r, &y3, p); // t5 = b * y3
+    sb_fe_mod_sub(&y3, &t5, &t2, p);
+    sb_fe_mod_sub(&y3, &y3, &t0, p);
+    sb_fe_mod_double(&t1, &y3, p);
+    sb_fe_mod_add(&y3, &t1, &y3, p); // y3 = 3 * (b * y3 - t2 - X1 * X2)
+    sb_fe_mod_double(&t1, &t0, p);
+    sb_fe_mod_add(&t0, &t1, &t0, p);
+    sb_fe_mod_sub(&t0, &t0, &t2, p); // t0 = 3 * X1 * X2 - 3 * Z1 * Z2
+    sb_fe_mont_mult(&t1, &t4, &y3, p);
+    sb_fe_mont_mult(&t2, &t0, &y3, p);
+    sb_fe_mont_mult(&y3, &x3, &z3, p);
+    sb_fe_mod_add(C_Y1(c), &y3, &t2, p); // Y3 = x3 * z3 + t0 * y3
+    sb_fe_mont_mult(&t5, &t3, &x3, p);
+    sb_fe_mod_sub(C_X1(c), &t5, &t1, p); // X3 = t3 * x3 - t4 * y3
+    sb_fe_mont_mult(&t5, &t4, &z3, p);
+    sb_fe_mont_mult(&t1, &t3, &t0, p);
+    sb_fe_mod_add(C_Z1(c), &t5, &t1, p); // Z3 = t4 * z3 + t3 * t0
+}
 
-// 1. Compute P + H and P + G + H
+// Complete addition for a = 0:
+// (x1, y1, z1) = (x1, y1, z1) + (x2, y2, z2)
+// Cost: 14MM + 19A
+static void
+sb_sw_point_add_complete_a0(sb_sw_context_t c[static const 1],
+                            const sb_sw_curve_t s[static const 1])
+{
+    const sb_prime_field_t* const p = s->p;
+    sb_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    sb_fe_mont_mult(&t0, C_X1(c), C_X2(c), p); // t0 = X1 * X2
+    sb_fe_mont_mult(&t1, C_Y1(c), C_Y2(c), p); // t1 = Y1 * Y2
+    sb_fe_mont_mult(&t5, C_Z1(c), C_Z2(c), p); // t5 = Z1 * Z2
+    sb_fe_mod_add(&t3, C_X2(c), C_Y2(c), p); // t3 = X2 + Y2
+    sb_fe_mod_add(&t4, C_X1(c), C_Y1(c), p); // t4 = X1 + Y1
+    sb_fe_mont_mult(&t2, &t3, &t4, p); // t2 = (X2 + Y2) * (X1 + Y1)
+    sb_fe_mod_add(&t4, &t0, &t1, p);
+    sb_fe_mod_sub(&t3, &t2, &t4, p); // t3 = X1 * Y2 + X2 * Y1
+    sb_fe_mod_add(&t2, C_Y2(c), C_Z2(c), p); // t2 = Y2 + Z2
+    sb_fe_mod_add(&t4, C_Y1(c), C_Z1(c), p); // t4 = Y1 + Z1
+    sb_fe_mont_mult(&x3, &t2, &t4, p); // x3 = (Y2 + Z2) * (Y1 + Z1)
+    sb_fe_mod_add(&t4, &t1, &t5, p);
+    sb_fe_mod_sub(&t4, &x3, &t4, p); // t4 = Y1 * Z2 + Y2 * Z1
+    sb_fe_mod_add(&t2, C_X2(c), C_Z2(c), p); // t2 = X2 + Z2
+    sb_fe_mod_add(&x3, C_X1(c), C_Z1(c), p); // x3 = X1 + Z1
+    sb_fe_mont_mult(&y3, &t2, &x3, p); // y3 = (X2 + Z2) * (X1 + Z1)
+    sb_fe_mod_add(&x3, &t0, &t5, p);
+    sb_fe_mod_sub(&y3, &y3, &x3, p); // y3 = X1 * Z2 + X2 * Z1
+    sb_fe_mod_double(&x3, &t0, p);
+    sb_fe_mod_add(&t0, &x3, &t0, p); // t0 = 3 * X1 * X2
+    sb_fe_mont_mult(&t2, &s->complete_b_r, &t5, p); // t2 = 3 * b * Z1 * Z2
+    sb_fe_mod_add(&z3, &t1, &t2, p); // z3 = Y1 * Y2 + t2
+    sb_fe_mod_sub(&t1, &t1, &t2, p); // t1 = Y1 * Y2 - t2
+    sb_fe_mont_mult(&t5, &s->complete_b_r, &y3, p); // t5 = 3 * b * y3
+    sb_fe_mont_mult(&x3, &t4, &t5, p);
+    sb_fe_mont_mult(&t2, &t3, &t1, p);
+    sb_fe_mod_sub(C_X1(c), &t2, &x3, p); // X3 = t3 * t1 - t4 * t5
+    sb_fe_mont_mult(&y3, &t5, &t0, p);
+    sb_fe_mont_mult(&t2, &t1, &z3, p);
+    sb_fe_mod_add(C_Y1(c), &t2, &y3, p); // Y3 = t1 * z3 + t5 * t0
+    sb_fe_mont_mult(&t1, &t0, &t3, p);
+    sb_fe_mont_mult(&t5, &z3, &t4, p);
+    sb_fe_mod_add(C_Z1(c), &t5, &t1, p); // Z3 = z3 * t4 + t0 * t3
+}
 
-// Let S(b_p, b_g) be:         H if b_p == 0 && b_g == 0
-//                         P + H if b_p == 1 && b_g == 0
-//                         G + H if b_p == 0 && b_g == 1
-//                     P + G + H if b_p == 1 && b_g == 1
+// Complete addition: (x1, y1, z1) = (x1, y1, z1) + (x2, y2, z2) in projective
+// coordinates
+static void sb_sw_point_add_complete(sb_sw_context_t c[static const 1],
+                                     const sb_sw_curve_t s[static const 1])
+{
+    if (SB_SW_CURVE_A_ZERO(s)) {
+        sb_sw_point_add_complete_a0(c, s);
+    } else {
+        sb_sw_point_add_complete_a3(c, s);
+    }
+}
 
-// 2. k_g := k_g - 1
-// 3. k_p := regularize(k_p)
-// 4. k_g := regularize(k_g)
-// 5. R := P + G + H
-// 6. R := 2 * R
-// 7. R := R + S(k_p_255, k_g_255)
-// 8. for i from 254 downto 0:
-//    8.1. R' := R + S(k_p_i, k_g_i)
-//    8.2. R  := R + R'
-// 9. return R
+#endif
 
-// Produces kp * P + kg * G in (x1, y1) with Z * R in t5
-static void sb_sw_point_mult_add_z(sb_sw_context_t q[static const 1],
+// Converts (x1, y1, z1) from Jacobian coordinates, where it is the affine
+// point (X / Z^2, Y / Z^3), to the projective point (X * Z, Y, Z^3).
+// Uses: t5, t6
+// Cost: 3MM
+static void
+sb_sw_point_jacobian_to_projective(sb_sw_context_t c[static const 1],
                                    const sb_sw_curve_t s[static const 1])
 {
-    sb_fe_t* const kp = MULT_K(q);
-    sb_fe_t* const kg = MULT_ADD_KG(q);
+    sb_fe_mont_square(C_T5(c), C_Z1(c), s->p); // t5 = Z^2
+    sb_fe_mont_mult(C_T6(c), C_X1(c), C_Z1(c), s->p);
+    *C_X1(c) = *C_T6(c); // x1 = X * Z
+    sb_fe_mont_mult(C_T6(c), C_T5(c), C_Z1(c), s->p);
+    *C_Z1(c) = *C_T6(c); // z1 = Z^3
+}
 
-    // Subtract one from kg to account for the addition of (2^257 - 1) * H = G
-    sb_fe_sub(kg, kg, &SB_FE_ONE);
+// Converts (x1, y1, z1) from projective coordinates, where it is the affine
+// point (X / Z, Y / Z), to the Jacobian point (X * Z, Y * Z^2, Z).
+// Uses: t5, t6
+// Cost: 3MM
+static void
+sb_sw_point_projective_to_jacobian(sb_sw_context_t c[static const 1],
+                                   const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_square(C_T5(c), C_Z1(c), s->p); // t5 = Z^2
+    sb_fe_mont_mult(C_T6(c), C_X1(c), C_Z1(c), s->p);
+    *C_X1(c) = *C_T6(c); // x1 = X * Z
+    sb_fe_mont_mult(C_T6(c), C_Y1(c), C_T5(c), s->p);
+    *C_Y1(c) = *C_T6(c); // y1 = Y * Z^2
+}
 
-    // Regularize the input scalars so the ladder starts at P + G + H
-    sb_sw_regularize_scalar(kp, q, s);
-    sb_sw_regularize_scalar(kg, q, s);
+#endif
 
-    // multiply (x, y) of P by R
-    sb_fe_mont_mult(C_X1(q), &MULT_POINT(q)[0], &s->p->r2_mod_p, s->p);
-    MULT_POINT(q)[0] = *C_X1(q);
-    sb_fe_mont_mult(C_Y1(q), &MULT_POINT(q)[1], &s->p->r2_mod_p, s->p);
-    MULT_POINT(q)[1] = *C_Y1(q);
+#if SB_SW_GLV_WINDOW || SB_SW_VARIABLE_BASE_WINDOW
+
+// Signed regular windows (Joye and Tunstall 2009, "Exponent recoding and
+// regular exponentiation algorithms") multiply a point by an odd scalar with
+// the same sequence of operations for every scalar. Let w be the window width
+// and d the number of windows. As in the comb, any odd k' < 2^(w * d) is a sum
+// of terms s_i * 2^i with each s_i in { -1, 1 }, where s_i = 2 * u_i - 1 and
+// u = (k' + 2^(w * d) - 1) / 2. Grouping the terms into d windows of w
+// consecutive bits gives odd digits: if the top bit of window m of u is set,
+// its digit is 2 * j + 1, where j is its low w - 1 bits; otherwise, its digit
+// is -(2 * ~j + 1). Each digit is plus or minus one of the 2^(w - 1) odd
+// multiples of the point, which are selected by reading the whole table.
+
+// Returns bit i of u = (k' - 1) / 2 + 2^(bits - 1) given odd k' < 2^bits.
+static sb_word_t sb_sw_window_bit(const sb_fe_t k[static const 1],
+                                  const size_t i, const size_t bits)
+{
+    if (i == bits - 1) {
+        return 1;
+    }
+    if (i + 1 >= SB_FE_BITS) {
+        return 0;
+    }
+    return sb_fe_test_bit(k, i + 1);
+}
 
-    *C_X2(q) = s->h_r[0];
-    *C_Y2(q) = s->h_r[1];
+// Places D_win * P, negated if neg is set, into (x2, y2), with X and Y
+// multiplied by R, where D_win is the digit of window win of width w of the
+// odd scalar k' < 2^bits and table holds the 2^(w - 1) odd multiples of P as
+// affine points multiplied by R. Every entry of the table is read in order to
+// select the correct one.
+// Uses: t5, t6, t7
+static void sb_sw_point_window_select(const size_t win, const size_t w,
+                                      const size_t bits, const sb_word_t neg,
+                                      const sb_fe_t k[static const 1],
+                                      sb_fe_t table[static const 1][2],
+                                      sb_sw_context_t m[static const 1],
+                                      const sb_sw_curve_t s[static const 1])
+{
+    const size_t entries = (size_t) 1 << (w - 1);
 
-    // Save initial Z in T8 until it can be applied
-    *C_T8(q) = *MULT_Z(q);
+    sb_word_t j = 0;
+    for (size_t l = 0; l < w - 1; l++) {
+        j |= (sb_word_t) (sb_sw_window_bit(k, win * w + l, bits) << l);
+    }
 
-    // P and H are in affine coordinates, so our current Z is one (R in
-    // Montgomery domain)
-    *MULT_Z(q) = s->p->r_mod_p;
+    // If the top bit is clear, use the complement of j and negate
+    const sb_word_t top = sb_sw_window_bit(k, win * w + w - 1, bits);
+    j ^= (sb_word_t) ((top ^ 1) * (entries - 1));
+
+    *C_X2(m) = table[0][0];
+    *C_T7(m) = table[0][1];
+    for (size_t e = 1; e < entries; e++) {
+        // sel is 1 iff e == j; both are less than 2^31
+        const sb_word_t sel =
+            (sb_word_t) (((uint32_t) (e ^ j) - UINT32_C(1)) >> 31);
+        *C_T5(m) = table[e][0];
+        *C_T6(m) = table[e][1];
+        sb_fe_ctswap(sel, C_X2(m), C_T5(m));
+        sb_fe_ctswap(sel, C_T7(m), C_T6(m));
+    }
 
-    // (x1, x2) = P + H; (x2, y2) = P'
-    sb_sw_point_mult_add_z_update(q, s);
+    sb_fe_mod_sub(C_Y2(m), &s->p->p, C_T7(m), s->p); // -y * R
+    sb_fe_ctswap(neg ^ top, C_Y2(m), C_T7(m));
+}
 
-    // Apply Z to G before co-Z addition of (P + H) and G
-    *C_X2(q) = s->g_r[0];
-    *C_Y2(q) = s->g_r[1];
-    sb_sw_point_mult_add_apply_z(q, s);
+#endif
 
-    // (x1, x2) = P + G + H; (x2, y2) = P + H
-    sb_sw_point_mult_add_z_update(q, s);
+#if SB_SW_GLV_WINDOW || SB_SW_VARTIME_SUPPORT
+
+// GLV multiplication (Gallant, Lambert, and Vanstone 2001, "Faster point
+// multiplication on elliptic curves with efficient endomorphisms") applies to
+// curves with an endomorphism phi(x, y) = (beta * x, y) which multiplies each
+// point by lambda. The scalar is split as k = k1 + k2 * lambda mod N, where k1
+// and k2 are about half as long as N, and k1 * P + k2 * phi(P) is computed
+// with half as many doublings as the Montgomery ladder.
+
+// The split follows libsecp256k1: with c1 = round(k * g1 / 2^384) and
+// c2 = round(k * g2 / 2^384), k2 = c1 * -b1 + c2 * -b2 and
+// k1 = k - k2 * lambda, both less than 2^128 in magnitude as signed values
+// mod N. The windows of sb_sw_point_mult_glv need odd multipliers, so the
+// lattice vector (a1, b1), (a2, b2), or their sum, each of which has
+// a + b * lambda = 0 mod N, is added as needed to make both k1 and k2 odd.
+// This leaves both less than 2^130 in magnitude; they are then replaced by
+// their absolute values, and P or phi(P) is negated in their place.
+
+#define SB_SW_GLV_BITS 130
+
+// Returns whether k, as a signed value in (-N / 2, N / 2], is negative, and
+// places N - k in t.
+static sb_word_t sb_sw_glv_negative(const sb_fe_t k[static const 1],
+                                    sb_fe_t t[static const 1],
+                                    const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_sub(t, &s->n->p, k);
+    return sb_fe_lt(t, k);
+}
 
-    // Invert Z and multiply so that P + H and P + G + H are in affine
-    // coordinates
-    *C_T5(q) = *MULT_Z(q); // t5 = Z * R
-    sb_fe_mod_inv_r(C_T5(q), C_T6(q), C_T7(q), s->p); // t5 = Z^-1 * R
-    sb_fe_mont_square(C_T6(q), C_T5(q), s->p); // t6 = Z^-2 * R
-    sb_fe_mont_mult(C_T7(q), C_T5(q), C_T6(q), s->p); // t7 = Z^-3 * R
+// Splits k into odd k1 and k2 less than 2^130 and signs neg1 and neg2 such
+// that k = (-1)^neg1 * k1 + (-1)^neg2 * k2 * lambda mod N, in constant time.
+// Uses: t5, t6, t7, t8
+static void sb_sw_glv_split(sb_fe_t k_half[static const 2],
+                            sb_word_t neg[static const 2],
+                            const sb_fe_t k[static const 1],
+                            sb_sw_context_t m[static const 1],
+                            const sb_sw_curve_t s[static const 1])
+{
+    const sb_sw_glv_t* const g = s->glv;
+
+    // c1 and c2 are less than 2^127, so adding N does not overflow, and
+    // quasi-reduction produces c1 and c2 with zero represented as N.
+    sb_fe_mult_shift_round(C_T5(m), k, &g->g1, 384);
+    sb_fe_mod_add(C_T5(m), C_T5(m), &s->n->p, s->n); // t5 = c1
+    sb_fe_mont_mult(C_T6(m), &g->minus_b1, &s->n->r2_mod_p,
+                    s->n); // t6 = -b1 * R
+    sb_fe_mont_mult(&k_half[1], C_T5(m), C_T6(m), s->n); // k2 = c1 * -b1
+
+    sb_fe_mult_shift_round(C_T5(m), k, &g->g2, 384);
+    sb_fe_mod_add(C_T5(m), C_T5(m), &s->n->p, s->n); // t5 = c2
+    sb_fe_mont_mult(C_T6(m), &g->minus_b2, &s->n->r2_mod_p,
+                    s->n); // t6 = -b2 * R
+    sb_fe_mont_mult(C_T7(m), C_T5(m), C_T6(m), s->n); // t7 = c2 * -b2
+    sb_fe_mod_add(&k_half[1], &k_half[1], C_T7(m),
+                  s->n); // k2 = c1 * -b1 + c2 * -b2
+
+    sb_fe_mont_mult(C_T6(m), &g->lambda, &s->n->r2_mod_p,
+                    s->n); // t6 = lambda * R
+    sb_fe_mont_mult(C_T7(m), &k_half[1], C_T6(m),
+                    s->n); // t7 = k2 * lambda
+    sb_fe_mod_sub(&k_half[0], k, C_T7(m), s->n); // k1 = k - k2 * lambda
+
+    // A signed value is even if it is even and nonnegative, or odd and
+    // negative, as N is odd
+    const sb_word_t even1 = sb_fe_test_bit(&k_half[0], 0) ^
+                            sb_sw_glv_negative(&k_half[0], C_T5(m), s) ^
+                            (sb_word_t) 1;
+    const sb_word_t even2 = sb_fe_test_bit(&k_half[1], 0) ^
+                            sb_sw_glv_negative(&k_half[1], C_T5(m), s) ^
+                            (sb_word_t) 1;
+
+    // (a1, b1) is (odd, odd); (a2, b2) is (even, odd); their sum is
+    // (odd, even). Add (a1, b1) if k1 is even, and (a2, b2) if exactly one of
+    // k1 and k2 is even.
+    for (size_t i = 0; i < 2; i++) {
+        sb_fe_mod_add(C_T5(m), &k_half[i], &g->v1[i], s->n);
+        sb_fe_ctswap(even1, &k_half[i], C_T5(m));
+        sb_fe_mod_add(C_T5(m), &k_half[i], &g->v2[i], s->n);
+        sb_fe_ctswap(even1 ^ even2, &k_half[i], C_T5(m));
+    }
 
-    // Apply Z to P + H
-    sb_fe_mont_mult(&MULT_POINT(q)[0], C_X2(q), C_T6(q), s->p);
-    sb_fe_mont_mult(&MULT_POINT(q)[1], C_Y2(q), C_T7(q), s->p);
+    for (size_t i = 0; i < 2; i++) {
+        neg[i] = sb_sw_glv_negative(&k_half[i], C_T5(m), s);
+        sb_fe_ctswap(neg[i], &k_half[i], C_T5(m));
+    }
+}
 
-    // Apply Z to P + G + H
-    sb_fe_mont_mult(&MULT_ADD_PG(q)[0], C_X1(q), C_T6(q), s->p);
-    sb_fe_mont_mult(&MULT_ADD_PG(q)[1], C_Y1(q), C_T7(q), s->p);
+#endif
 
-    // Computation begins with R = P + G + H due to regularization of the
-    // scalars. If bit 255 of kp and kpg are both 1, this would lead to a
-    // point doubling!
-    // Avoid the inadvertent doubling in the first bit, so that the regular
-    // ladder can start at 2 * (P + G + H) + S
+#if SB_SW_GLV_WINDOW
+
+// Both halves are recoded into SB_SW_GLV_DIGITS signed windows of
+// SB_SW_GLV_WINDOW bits, which covers 130 bits, and are processed together by
+// Horner's rule, with SB_SW_GLV_WINDOW doublings and two mixed additions of
+// odd multiples of P or phi(P) per window, taken from a table of
+// SB_SW_GLV_ENTRIES odd multiples of P.
+
+#define SB_SW_GLV_DIGITS \
+    ((SB_SW_GLV_BITS + SB_SW_GLV_WINDOW - 1) / SB_SW_GLV_WINDOW)
+
+// The last SB_SW_GLV_COMPLETE windows are processed with the complete
+// formulas; see sb_sw_point_mult_glv.
+#define SB_SW_GLV_COMPLETE (SB_SW_GLV_DIGITS - 127 / SB_SW_GLV_WINDOW)
+
+// Selects the digit of window win of a half k' of the split scalar as in
+// sb_sw_point_window_select.
+// Uses: t5, t6, t7
+static void sb_sw_point_glv_select(const size_t win,
+                                   const sb_word_t neg,
+                                   const sb_fe_t k[static const 1],
+                                   sb_fe_t
+                                   table[static const SB_SW_GLV_ENTRIES][2],
+                                   sb_sw_context_t m[static const 1],
+                                   const sb_sw_curve_t s[static const 1])
+{
+    sb_sw_point_window_select(win, SB_SW_GLV_WINDOW,
+                              SB_SW_GLV_WINDOW * SB_SW_GLV_DIGITS, neg, k,
+                              table, m, s);
+}
 
-    *C_X2(q) = MULT_ADD_PG(q)[0];
-    *C_Y2(q) = MULT_ADD_PG(q)[1];
+// Computes k * P for k in MULT_K and P = point, with X and Y multiplied by R,
+// using the endomorphism of the curve, which costs about 2300MM instead of the
+// ladder's 3600MM. The result is left in Jacobian coordinates (x1, y1, z1),
+// each multiplied by R.
+static void sb_sw_point_mult_glv(sb_sw_context_t m[static const 1],
+                                 const sb_fe_t point[static const 2],
+                                 const sb_sw_curve_t s[static const 1])
+{
+    // Input scalars MUST always be checked for validity
+    // (k is reduced and ∉ {-2, -1, 0, 1} mod N).
 
-    sb_sw_point_initial_double(q, s);
-    // 2 * (P + G + H) is now in (x2, y2); Z is in t5
+    sb_fe_t table[SB_SW_GLV_ENTRIES][2];
+    sb_fe_t ratio[SB_SW_GLV_ENTRIES];
+    sb_fe_t k[2], beta_r;
+    sb_word_t neg[2];
 
-    // apply initial Z
-    *MULT_Z(q) = *C_T8(q);
-    sb_sw_point_mult_add_apply_z(q, s);
+    // table = P, 3 * P, ..., with a single inversion
+    *C_X2(m) = point[0];
+    *C_Y2(m) = point[1];
+    sb_sw_point_odd_multiples_z(table, ratio, SB_SW_GLV_ENTRIES, m, s);
+    *C_T5(m) = *C_Z1(m);
+    sb_fe_mod_inv_r(C_T5(m), C_T6(m), C_T7(m),
+                    s->p); // t5 = Z_i^-1 for the last i
+    sb_sw_point_odd_multiples_affine(table, ratio, SB_SW_GLV_ENTRIES, m, s);
+
+    sb_sw_glv_split(k, neg, MULT_K(m), m, s);
+    sb_fe_mont_mult(&beta_r, &s->glv->beta, &s->p->r2_mod_p, s->p);
+
+    // Start with the top window of k1, with a Z update of iz * R^-1 as in
+    // sb_sw_point_mult_ladder.
+    sb_sw_point_glv_select(SB_SW_GLV_DIGITS - 1, neg[0], &k[0], table, m, s);
+
+    *C_Z1(m) = *MULT_Z(m);
+    sb_fe_mont_square(C_T5(m), MULT_Z(m), s->p); // t5 = z^2
+    sb_fe_mont_mult(C_T6(m), MULT_Z(m), C_T5(m), s->p); // t6 = z^3
+    sb_fe_mont_mult(C_X1(m), C_X2(m), C_T5(m), s->p); // x z^2
+    sb_fe_mont_mult(C_Y1(m), C_Y2(m), C_T6(m), s->p); // y z^3
+
+    // The doubling formula has no exceptional cases, and an addition is
+    // exceptional only if the running total is plus or minus the point being
+    // added. The running total is a1 * P + a2 * phi(P) = (a1 + a2 * lambda) * P
+    // for signed a1 and a2, and the added point is D * P or D * lambda * P for
+    // a small odd D, so an exceptional addition requires a nonzero solution of
+    // a + b * lambda = 0 mod N. After window m, a1 and a2 (with D included)
+    // are less than 2^(w * (d - m)) in magnitude, while every nonzero solution
+    // has |a| or |b| at least 2^127. The last SB_SW_GLV_COMPLETE windows, where
+    // the running total may be that long, are computed in projective
+    // coordinates with the complete formulas instead. No branch depends on
+    // the scalar.
+
+    for (size_t i = SB_SW_GLV_DIGITS; i > SB_SW_GLV_COMPLETE; i--) {
+        if (i < SB_SW_GLV_DIGITS) {
+            for (size_t b = 0; b < SB_SW_GLV_WINDOW; b++) {
+                sb_sw_point_double(m, s); // 7MM + 10A
+            }
+
+            sb_sw_point_glv_select(i - 1, neg[0], &k[0], table, m,
+                                   s); // 1A
+            sb_sw_point_mixed_add_h_r(m, s); // 4MM + 2A
+            sb_sw_point_mixed_add_finish(m, s); // 7MM + 5A
+        }
 
-    // z coordinate of (x2, y2) is now iz * t5
-    sb_fe_mont_mult(C_T6(q), MULT_Z(q), C_T5(q), s->p);
-    *MULT_Z(q) = *C_T6(q);
+        sb_sw_point_glv_select(i - 1, neg[1], &k[1], table, m, s); // 1A
+        sb_fe_mont_mult(C_T5(m), C_X2(m), &beta_r, s->p); // 1MM
+        *C_X2(m) = *C_T5(m); // (x2, y2) = phi(D * P)
+        sb_sw_point_mixed_add_h_r(m, s); // 4MM + 2A
+        sb_sw_point_mixed_add_finish(m, s); // 7MM + 5A
+    }
 
-    // move 2 * (P + G + H) to (x1, y1)
-    *C_X1(q) = *C_X2(q);
-    *C_Y1(q) = *C_Y2(q);
+    sb_sw_point_jacobian_to_projective(m, s); // 3MM
 
-    // 14MM + 14A + 4MM co-Z update = 18MM + 14A per bit
-    // Note that mixed Jacobian-affine doubling-addition can be done in 18MM.
-    // Assuming a Hamming weight of ~128 on both scalars and 8MM doubling, the
-    // expected performance of a conditional Jacobian double-and-add
-    // implementation would be (3/4 * 18MM) + (1/4 * 8MM) = 15.5MM/bit
+    for (size_t i = SB_SW_GLV_COMPLETE; i > 0; i--) {
+        for (size_t b = 0; b < SB_SW_GLV_WINDOW; b++) {
+            sb_sw_point_double_complete(m, s);
+        }
 
-    // The algorithm used here is regular and reuses the existing co-Z addition
-    // operation. Conventional wisdom says that signature verification does
-    // not need to be constant time; however, it's not clear to me that this
-    // holds in all cases. For instance, an embedded system might leak
-    // information about its firmware version by the amount of time that it
-    // takes to verify a signature on boot.
+        sb_sw_point_glv_select(i - 1, neg[0], &k[0], table, m, s); // 1A
+        sb_sw_point_mixed_add_complete(m, s);
 
-    // If you want a variable-time ladder, consider using Algorithms 14 and
-    // 17 from Rivain 2011 instead.
+        sb_sw_point_glv_select(i - 1, neg[1], &k[1], table, m, s); // 1A
+        sb_fe_mont_mult(C_T5(m), C_X2(m), &beta_r, s->p); // 1MM
+        *C_X2(m) = *C_T5(m); // (x2, y2) = phi(D * P)
+        sb_sw_point_mixed_add_complete(m, s);
+    }
 
-    // Note that this algorithm may also not be SPA- or DPA-resistant, as H,
-    // P + H, G + H, and P + G + H are stored and used in affine coordinates,
-    // so the co-Z update of these variables might be detectable even with
-    // Z blinding. If this matters for signature verification in your
-    // application, please contact the authors for commercial support.
+    sb_sw_point_projective_to_jacobian(m, s); // 3MM
 
-    for (size_t i = SB_FE_BITS - 1; i < SB_FE_BITS; i--) {
-        const sb_word_t bp = sb_fe_test_bit(kp, i);
-        const sb_word_t bg = sb_fe_test_bit(kg, i);
+    memset(k, 0, sizeof(k));
+    memset(neg, 0, sizeof(neg));
+}
 
-        sb_sw_point_mult_add_select(bp, bg, q, s);
+#endif
 
-        // (x1, y1) = (R + S), (x2, y2) = R'
-        sb_sw_point_mult_add_z_update(q, s);
+#if SB_SW_VARIABLE_BASE_WINDOW
+
+// Variable-base multiplication without an endomorphism recodes the whole
+// scalar into SB_SW_VARIABLE_BASE_DIGITS signed windows, and processes them by
+// Horner's rule with SB_SW_VARIABLE_BASE_WINDOW doublings and one mixed
+// addition per window. The table of odd multiples of P is not converted to
+// affine coordinates, which would cost an inversion; instead, its entries are
+// brought to a common Z_c. They are then affine points on the isomorphic curve
+// y^2 = x^3 + a * Z_c^4 * x + b * Z_c^6, where the product is computed, and a
+// point (X, Y, Z) on that curve is (X, Y, Z * Z_c) on the original curve.
+
+#define SB_SW_VARIABLE_BASE_DIGITS \
+    ((SB_FE_BITS + SB_SW_VARIABLE_BASE_WINDOW - 1) / \
+     SB_SW_VARIABLE_BASE_WINDOW)
+
+// Repeated Jacobian point doubling: (x1, y1, z1) = 2^n * (x1, y1, z1) on the
+// curve with a' * R = a_r. As in modified Jacobian coordinates (Cohen, Miyaji,
+// and Ono 1998), W = a' * Z^4 is carried from one doubling to the next, which
+// saves two multiplications per doubling after the first. If a = 0, then
+// a' = 0, and sb_sw_point_double is used instead.
+// Uses: t5, t6, t7, t8
+// Cost: 8MM * n + 2MM + 12A * n (7MM * n + 10A * n if a = 0)
+static void sb_sw_point_double_n(const size_t n,
+                                 const sb_fe_t a_r[static const 1],
+                                 sb_sw_context_t c[static const 1],
+                                 const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_t w;
 
-        // The initial point has already been doubled
-        if (i < SB_FE_BITS - 1) {
-            // R := (R + S) + R = 2 * R + S
-            sb_sw_point_mult_add_z_update(q, s);
+    if (SB_SW_CURVE_A_ZERO(s)) {
+        for (size_t i = 0; i < n; i++) {
+            sb_sw_point_double(c, s);
         }
+        return;
     }
 
-    *C_T6(q) = *C_X1(q);
-    sb_fe_mont_reduce(C_X1(q), C_T6(q), s->p);
-    *C_T6(q) = *C_Y1(q);
-    sb_fe_mont_reduce(C_Y1(q), C_T6(q), s->p);
-    *C_T5(q) = *MULT_Z(q);
-}
+    sb_fe_mont_square(C_T5(c), C_Z1(c), s->p); // t5 = Z^2
+    sb_fe_mont_square(C_T6(c), C_T5(c), s->p); // t6 = Z^4
+    sb_fe_mont_mult(&w, C_T6(c), a_r, s->p); // w = a' * Z^4
 
-#ifdef SB_TEST
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) {
+            sb_fe_mont_mult(C_T6(c), C_T8(c), &w, s->p); // t6 = 8 * Y^4 * W
+            sb_fe_mod_double(&w, C_T6(c), s->p); // w = 16 * Y^4 * W = W'
+        }
 
-// Test that A * (B * G) + C * G = (A * B + C) * G
-static _Bool test_sw_point_mult_add(const sb_fe_t* const ka,
-                                    const sb_fe_t* const kb,
-                                    const sb_fe_t* const kc,
-                                    const sb_sw_curve_t* const s)
+        sb_fe_mont_square(C_T5(c), C_X1(c), s->p); // t5 = X^2
+        sb_fe_mod_double(C_T6(c), C_T5(c), s->p);
+        sb_fe_mod_add(C_T5(c), C_T5(c), C_T6(c), s->p);
+        sb_fe_mod_add(C_T5(c), C_T5(c), &w, s->p); // t5 = 3 * X^2 + W = M
+
+        sb_fe_mont_mult(C_T6(c), C_Y1(c), C_Z1(c), s->p); // t6 = Y * Z
+        sb_fe_mod_double(C_Z1(c), C_T6(c), s->p); // z1 = 2 * Y * Z
+
+        sb_fe_mont_square(C_T6(c), C_Y1(c), s->p); // t6 = Y^2
+        sb_fe_mod_double(C_T6(c), C_T6(c), s->p); // t6 = 2 * Y^2
+        sb_fe_mont_mult(C_T7(c), C_X1(c), C_T6(c), s->p); // t7 = 2 * X * Y^2
+        sb_fe_mod_double(C_T7(c), C_T7(c), s->p); // t7 = 4 * X * Y^2 = S
+
+        sb_fe_mont_square(C_T8(c), C_T6(c), s->p); // t8 = 4 * Y^4
+        sb_fe_mod_double(C_T8(c), C_T8(c), s->p); // t8 = 8 * Y^4
+
+        sb_fe_mont_square(C_X1(c), C_T5(c), s->p); // x1 = M^2
+        sb_fe_mod_sub(C_X1(c), C_X1(c), C_T7(c), s->p);
+        sb_fe_mod_sub(C_X1(c), C_X1(c), C_T7(c), s->p); // x1 = M^2 - 2 * S
+
+        sb_fe_mod_sub(C_T7(c), C_T7(c), C_X1(c), s->p); // t7 = S - X'
+        sb_fe_mont_mult(C_Y1(c), C_T5(c), C_T7(c), s->p); // y1 = M * (S - X')
+        sb_fe_mod_sub(C_Y1(c), C_Y1(c), C_T8(c),
+                      s->p); // y1 = M * (S - X') - 8 * Y^4
+    }
+}
+
+// Brings the entries of a table produced by sb_sw_point_odd_multiples_z to
+// Z_c, the Z of its last entry, which is left in z1.
+// Uses: x1, y1, t5, t6, t7
+static void
+sb_sw_point_odd_multiples_co_z(sb_fe_t table[static const 1][2],
+                               const sb_fe_t ratio[static const 1],
+                               const size_t entries,
+                               sb_sw_context_t c[static const 1],
+                               const sb_sw_curve_t s[static const 1])
 {
-    sb_sw_context_t m;
-    memset(&m, 0, sizeof(m));
+    *C_T5(c) = ratio[entries - 1]; // t5 = Z_c / Z_i for i = entries - 2
 
-    sb_fe_t kabc;
+    for (size_t i = entries - 1; i > 0; i--) {
+        if (i == 1) {
+            // t5 = Z_c / Z_0 * Z_0 = Z_c, as entry 0 is affine
+            sb_fe_mont_mult(C_T6(c), C_T5(c), &ratio[0], s->p);
+            *C_T5(c) = *C_T6(c);
+        }
 
-    sb_fe_mont_mult(C_T5(&m), ka, kb, s->n);
-    sb_fe_mont_mult(&kabc, C_T5(&m), &s->n->r2_mod_p, s->n);
-    sb_fe_mod_add(&kabc, &kabc, kc, s->n);
+        sb_fe_mont_square(C_T6(c), C_T5(c), s->p); // t6 = (Z_c / Z_i)^2
+        sb_fe_mont_mult(C_T7(c), C_T6(c), C_T5(c),
+                        s->p); // t7 = (Z_c / Z_i)^3
 
-    *MULT_Z(&m) = SB_FE_ONE;
+        sb_fe_mont_mult(C_X1(c), &table[i - 1][0], C_T6(c), s->p);
+        sb_fe_mont_mult(C_Y1(c), &table[i - 1][1], C_T7(c), s->p);
+        table[i - 1][0] = *C_X1(c);
+        table[i - 1][1] = *C_Y1(c);
 
-    *MULT_K(&m) = *kb;
-    sb_sw_point_mult(&m, s->g_r, s);
+        if (i > 1) {
+            sb_fe_mont_mult(C_T6(c), C_T5(c), &ratio[i - 1], s->p);
+            *C_T5(c) = *C_T6(c); // t5 = Z_c / Z_(i - 2)
+        }
+    }
+}
 
-    sb_fe_t pb[] = { *C_X1(&m), *C_Y1(&m) };
+// Computes k * P for k in MULT_K and P = point, with X and Y multiplied by R,
+// using signed windows of SB_SW_VARIABLE_BASE_WINDOW bits, which costs about
+// 3000MM instead of the ladder's 3600MM. The result is left in Jacobian
+// coordinates (x1, y1, z1), each multiplied by R.
+static void sb_sw_point_mult_window(sb_sw_context_t m[static const 1],
+                                    const sb_fe_t point[static const 2],
+                                    const sb_sw_curve_t s[static const 1])
+{
+    // Input scalars MUST always be checked for validity
+    // (k is reduced and ∉ {-2, -1, 0, 1} mod N).
 
-    *MULT_K(&m) = kabc;
-    sb_sw_point_mult(&m, s->g_r, s);
+    sb_fe_t table[SB_SW_VARIABLE_BASE_ENTRIES][2];
+    sb_fe_t ratio[SB_SW_VARIABLE_BASE_ENTRIES];
+    sb_fe_t k, z_c, a_r;
 
-    sb_fe_t pabc[] = { *C_X1(&m), *C_Y1(&m) };
+    // table = P, 3 * P, ..., with common Z_c
+    *C_X2(m) = point[0];
+    *C_Y2(m) = point[1];
+    sb_sw_point_odd_multiples_z(table, ratio, SB_SW_VARIABLE_BASE_ENTRIES, m,
+                                s);
+    z_c = *C_Z1(m);
+    sb_sw_point_odd_multiples_co_z(table, ratio, SB_SW_VARIABLE_BASE_ENTRIES,
+                                   m, s);
+
+    // a_r = a * Z_c^4 * R = -3 * Z_c^4 * R, which is unused if a = 0
+    sb_fe_mont_square(C_T5(m), &z_c, s->p); // t5 = Z_c^2
+    sb_fe_mont_square(C_T6(m), C_T5(m), s->p); // t6 = Z_c^4
+    sb_fe_mod_double(C_T5(m), C_T6(m), s->p);
+    sb_fe_mod_add(C_T5(m), C_T5(m), C_T6(m), s->p); // t5 = 3 * Z_c^4
+    sb_fe_mod_sub(&a_r, &s->p->p, C_T5(m), s->p); // a_r = -3 * Z_c^4
+
+    // k' = k if k is odd, and N - k otherwise, in which case P is negated
+    sb_word_t neg = sb_fe_test_bit(MULT_K(m), 0) ^ (sb_word_t) 1;
+    *C_T5(m) = *MULT_K(m);
+    sb_fe_sub(&k, &s->n->p, C_T5(m));
+    sb_fe_ctswap(neg ^ 1, &k, C_T5(m));
+
+    // Start with the top window, with a Z update of iz * R^-1 as in
+    // sb_sw_point_mult_ladder.
+    sb_sw_point_window_select(SB_SW_VARIABLE_BASE_DIGITS - 1,
+                              SB_SW_VARIABLE_BASE_WINDOW,
+                              SB_SW_VARIABLE_BASE_WINDOW *
+                              SB_SW_VARIABLE_BASE_DIGITS, neg, &k, table, m,
+                              s);
+
+    *C_Z1(m) = *MULT_Z(m);
+    sb_fe_mont_square(C_T5(m), MULT_Z(m), s->p); // t5 = z^2
+    sb_fe_mont_mult(C_T6(m), MULT_Z(m), C_T5(m), s->p); // t6 = z^3
+    sb_fe_mont_mult(C_X1(m), C_X2(m), C_T5(m), s->p); // x z^2
+    sb_fe_mont_mult(C_Y1(m), C_Y2(m), C_T6(m), s->p); // y z^3
+
+    // Let w be the window width and D_i the digit of window i, and let
+    // A_i = sum_{j >= i} D_j * 2^(w * (j - i)), so that A_0 = k' and the
+    // running total before the doublings for window i is A_(i + 1) * P. A_i is
+    // odd, and since every digit is less than 2^w in magnitude,
+    // |A_(i + 1)| < k' / 2^(w * (i + 1)) + 1. For i > 0, the running total
+    // through the doublings is therefore a nonzero multiple of P smaller than
+    // N / 2 in magnitude, and the doubling formula has no exceptional cases
+    // for such points. The addition of D_i * P is exceptional only if
+    // 2^w * A_(i + 1) = +/- D_i mod N; both sides are less than N / 2 in
+    // magnitude, and the left side is even while the right side is odd, so
+    // this cannot happen either. Only the addition in the last window can be
+    // exceptional: 2^w * A_1 = k' - D_0, which is -D_0 mod N only if k' = 0,
+    // and D_0 mod N only if k' = N + 2 * D_0. For a given N and w, at most one
+    // negative digit D_0 satisfies this, so the exceptional case occurs for
+    // at most two scalars k, 2 * |D_0| and N - 2 * |D_0|. The last addition is
+    // therefore computed in projective coordinates with the complete formulas.
+    // These require the original curve, so the running total is returned to
+    // it, and D_0 * P is added as the projective point (x * Z_c, y, Z_c^3).
+    // No branch depends on the scalar.
+
+    for (size_t i = SB_SW_VARIABLE_BASE_DIGITS - 1; i > 1; i--) {
+        sb_sw_point_double_n(SB_SW_VARIABLE_BASE_WINDOW, &a_r, m, s);
+
+        sb_sw_point_window_select(i - 1, SB_SW_VARIABLE_BASE_WINDOW,
+                                  SB_SW_VARIABLE_BASE_WINDOW *
+                                  SB_SW_VARIABLE_BASE_DIGITS, neg, &k, table,
+                                  m, s); // 1A
+        sb_sw_point_mixed_add_h_r(m, s); // 4MM + 2A
+        sb_sw_point_mixed_add_finish(m, s); // 7MM + 5A
+    }
 
-    sb_sw_context_t q;
-    memset(&q, 0, sizeof(q));
-    *MULT_Z(&q) = SB_FE_ONE;
+    sb_sw_point_double_n(SB_SW_VARIABLE_BASE_WINDOW, &a_r, m, s);
 
-    MULT_POINT(&q)[0] = pb[0];
-    MULT_POINT(&q)[1] = pb[1];
-    *MULT_K(&q) = *ka;
-    *MULT_ADD_KG(&q) = *kc;
+    // Return to the original curve
+    sb_fe_mont_mult(C_T5(m), C_Z1(m), &z_c, s->p);
+    *C_Z1(m) = *C_T5(m);
+    sb_sw_point_jacobian_to_projective(m, s); // 3MM
 
-    // A * (B * G) + C * G = (A * B + C) * G
-    sb_sw_point_mult_add_z(&q, s);
+    // (x2, y2, z2) = D_0 * P in projective coordinates on the original curve
+    sb_sw_point_window_select(0, SB_SW_VARIABLE_BASE_WINDOW,
+                              SB_SW_VARIABLE_BASE_WINDOW *
+                              SB_SW_VARIABLE_BASE_DIGITS, neg, &k, table, m,
+                              s); // 1A
+    sb_fe_mont_mult(C_T5(m), C_X2(m), &z_c, s->p);
+    *C_X2(m) = *C_T5(m); // x2 = x * Z_c
+    sb_fe_mont_square(C_T5(m), &z_c, s->p);
+    sb_fe_mont_mult(C_Z2(m), C_T5(m), &z_c, s->p); // z2 = Z_c^3
 
-    // put pabc in co-Z with the result
-    sb_fe_mont_square(C_T6(&q), C_T5(&q), s->p); // t6 = Z^2 * R
-    sb_fe_mont_mult(C_T7(&q), C_T6(&q), C_T5(&q), s->p); // t7 = Z^3 * R
+    sb_sw_point_add_complete(m, s);
+    sb_sw_point_projective_to_jacobian(m, s); // 3MM
 
-    sb_fe_mont_mult(C_X2(&q), C_T6(&q), &pabc[0], s->p); // x2 = x * Z^2
-    sb_fe_mont_mult(C_Y2(&q), C_T7(&q), &pabc[1], s->p); // y2 = y * Z^3
-    SB_TEST_ASSERT(
-        sb_fe_equal(C_X1(&q), C_X2(&q)) && sb_fe_equal(C_Y1(&q), C_Y2(&q)));
-    return 1;
+    memset(&k, 0, sizeof(k));
+    memset(&neg, 0, sizeof(neg));
 }
 
-static _Bool generate_fe(sb_fe_t* const fe, sb_hmac_drbg_state_t* const drbg)
-{
-    sb_single_t s;
-    SB_TEST_ASSERT_SUCCESS(sb_hmac_drbg_generate(drbg, s.bytes, SB_ELEM_BYTES));
-    sb_fe_from_bytes(fe, s.bytes, SB_DATA_ENDIAN_BIG);
-    return 1;
-}
+#endif
 
-_Bool sb_test_sw_point_mult_add(void)
+// Computes k * P for k in MULT_K and P = point, with X and Y multiplied by R,
+// leaving the result in (x1, y1) in affine coordinates, NOT multiplied by R.
+// MULT_K is preserved. On a curve with an endomorphism, this uses
+// sb_sw_point_mult_glv unless SB_SW_GLV_WINDOW is 0; otherwise, it uses
+// sb_sw_point_mult_window unless SB_SW_VARIABLE_BASE_WINDOW is 0, and the
+// Montgomery ladder if neither applies.
+static void
+sb_sw_point_mult(sb_sw_context_t m[static const 1],
+                 const sb_fe_t point[static const 2],
+                 const sb_sw_curve_t s[static const 1])
 {
-    sb_fe_t ka = SB_FE_CONST(0, 0, 0, 3);
-    sb_fe_t kb = SB_FE_CONST(0, 0, 0, 4);
-    sb_fe_t kc = SB_FE_CONST(0, 0, 0, 6);
-    SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_P256));
-    SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_SECP256K1));
-    return 1;
+#if SB_SW_GLV_WINDOW
+    if (s->glv) {
+        sb_sw_point_mult_glv(m, point, s);
+        sb_sw_point_affine(m, s);
+        return;
+    }
+#endif
+#if SB_SW_VARIABLE_BASE_WINDOW
+    sb_sw_point_mult_window(m, point, s);
+    sb_sw_point_affine(m, s);
+#else
+    sb_sw_point_mult_ladder(m, point, s);
+#endif
 }
 
-_Bool sb_test_sw_point_mult_add_rand(void)
+#if SB_SW_FIXED_BASE_WINDOW
+
+// Fixed-base multiplication of the generator G uses the signed comb of
+// Hamburg 2012 ("Fast and compact elliptic-curve cryptography").
+// Let w be SB_SW_FIXED_BASE_WINDOW and d be SB_SW_FIXED_BASE_SPACING, with
+// w * d >= 256. Any odd k' < 2^(w * d) can be written as a sum of w * d terms
+// s_i * 2^i with each s_i in { -1, 1 }: let u = (k' + 2^(w * d) - 1) / 2,
+// then s_i = 2 * u_i - 1. Grouping the terms into d columns of w teeth gives
+//   k' = sum_{m < d} 2^m * C_m, where C_m = sum_{l < w} s_{l*d+m} * 2^(l*d)
+// Each column C_m is plus or minus an entry of the comb table (see
+// sb_sw_fixed_base.h): if the top tooth is positive, C_m is entry j, where
+// bit l of j is u_{l*d+m}; otherwise, C_m is the negation of entry ~j.
+// The product is computed by Horner's rule, with one doubling and one
+// mixed addition per column.
+
+// The same comb is also used for public keys prepared with
+// sb_sw_prepare_public_key, with a table computed by sb_sw_point_comb_table.
+
+// Returns bit i of u = (k' - 1) / 2 + 2^(w * d - 1) given odd k' < 2^256.
+static sb_word_t sb_sw_point_comb_bit(const sb_fe_t k[static const 1],
+                                      const size_t i)
 {
-    sb_fe_t ka, kb, kc;
-    sb_hmac_drbg_state_t drbg;
-    memset(&drbg, 0, sizeof(drbg));
-
-    for (size_t i = 0; i < 64; i++) {
-        SB_TEST_ASSERT(generate_fe(&ka, &drbg));
-        SB_TEST_ASSERT(generate_fe(&kb, &drbg));
-        SB_TEST_ASSERT(generate_fe(&kc, &drbg));
-        SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_P256));
-        SB_TEST_ASSERT(
-            test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_SECP256K1));
-        drbg.reseed_counter = 1;
+    if (i == SB_SW_FIXED_BASE_WINDOW * SB_SW_FIXED_BASE_SPACING - 1) {
+        return 1;
     }
-    return 1;
+    if (i + 1 >= SB_FE_BITS) {
+        return 0;
+    }
+    return sb_fe_test_bit(k, i + 1);
 }
 
-#endif
-
-// Given a point context with x in *C_X1(c), computes
-// y^2 = x^3 + a * x + b in *C_Y1(c)
-static void sb_sw_curve_y2(sb_sw_context_t c[static const 1],
-                           const sb_sw_curve_t s[static const 1])
+// Sets k' to k if k is odd or N - k if k is even, and returns whether k is
+// even. In the latter case, every column must be negated.
+// Uses: t5
+static sb_word_t sb_sw_point_comb_scalar(sb_fe_t k_odd[static const 1],
+                                         const sb_fe_t k[static const 1],
+                                         sb_sw_context_t m[static const 1],
+                                         const sb_sw_curve_t s[static const 1])
 {
-    sb_fe_mont_mult(C_T5(c), C_X1(c), &s->p->r2_mod_p, s->p); // t5 = x * R
-    sb_fe_mont_mult(C_T6(c), C_T5(c), C_X1(c), s->p); // t6 = x^2
-    sb_fe_mod_sub(C_T6(c), C_T6(c), &s->minus_a, s->p); // t6 = x^2 + a
-    sb_fe_mont_mult(C_Y1(c), C_T5(c), C_T6(c),
-                    s->p); // y1 = (x^2 + a) * x * R * R^-1 = x^3 + a * x
-    sb_fe_mod_add(C_Y1(c), C_Y1(c), &s->b, s->p); // y1 = y^2 = x^3 + a * x + b
+    const sb_word_t even = sb_fe_test_bit(k, 0) ^ (sb_word_t) 1;
+    *k_odd = *k;
+    sb_fe_sub(C_T5(m), &s->n->p, k);
+    sb_fe_ctswap(even, k_odd, C_T5(m));
+    return even;
 }
 
-// Note that this assumes reduced input, not quasi-reduced input!
-static _Bool
-sb_sw_point_valid(const sb_fe_t point[static const 2],
-                  sb_sw_context_t c[static const 1],
-                  const sb_sw_curve_t s[static const 1])
+// Places C_col * P, negated if neg is set, into (x2, y2), with X and Y
+// multiplied by R, where C_col is column col of the odd scalar k' and table
+// is the comb table of P. Every entry of the table is read in order to
+// select the correct one.
+// Uses: t5, t6, t7, t8
+static void sb_sw_point_comb_select(const size_t col,
+                                    const sb_word_t neg,
+                                    const sb_fe_t k[static const 1],
+                                    const sb_fe_t
+                                    table[static const SB_SW_FIXED_BASE_ENTRIES][2],
+                                    sb_sw_context_t m[static const 1],
+                                    const sb_sw_curve_t s[static const 1])
 {
-    // The point at infinity is not valid.
-    if (sb_fe_equal(&point[0], &SB_FE_ZERO) &&
-        sb_fe_equal(&point[1], &SB_FE_ZERO)) {
-        return 0;
+    sb_word_t j = 0;
+    for (size_t l = 0; l < SB_SW_FIXED_BASE_WINDOW - 1; l++) {
+        j |= (sb_word_t) (sb_sw_point_comb_bit(
+            k, l * SB_SW_FIXED_BASE_SPACING + col) << l);
     }
 
-    // Unreduced points are not valid.
-    if (!(sb_fe_lt(&point[0], &s->p->p) &&
-          sb_fe_lt(&point[1], &s->p->p))) {
-        return 0;
+    // If the top tooth is negative, use the complement of j and negate
+    const sb_word_t top = sb_sw_point_comb_bit(
+        k, (SB_SW_FIXED_BASE_WINDOW - 1) * SB_SW_FIXED_BASE_SPACING + col);
+    j ^= (sb_word_t) ((top ^ 1) * (SB_SW_FIXED_BASE_ENTRIES - 1));
+
+    *C_T5(m) = table[0][0];
+    *C_T6(m) = table[0][1];
+    for (size_t e = 1; e < SB_SW_FIXED_BASE_ENTRIES; e++) {
+        // sel is 1 iff e == j; both are less than 2^31
+        const sb_word_t sel =
+            (sb_word_t) (((uint32_t) (e ^ j) - UINT32_C(1)) >> 31);
+        *C_T7(m) = table[e][0];
+        *C_T8(m) = table[e][1];
+        sb_fe_ctswap(sel, C_T5(m), C_T7(m));
+        sb_fe_ctswap(sel, C_T6(m), C_T8(m));
     }
 
-    // Verify y^2 = x^3 + ax + b
-    sb_fe_mont_square(C_T5(c), &point[1], s->p); // t5 = y^2 * R^-1
-    sb_fe_mont_mult(C_Y2(c), C_T5(c), &s->p->r2_mod_p, s->p); // y2 = y^2
-    *C_X1(c) = point[0];
-    sb_sw_curve_y2(c, s);
-
-    // clang HATES cast to _Bool
-    return sb_fe_equal(C_Y1(c), C_Y2(c)) != 0;
+    sb_fe_mont_mult(C_X2(m), C_T5(m), &s->p->r2_mod_p, s->p); // x * R
+    sb_fe_mont_mult(C_T7(m), C_T6(m), &s->p->r2_mod_p, s->p); // y * R
+    sb_fe_mod_sub(C_Y2(m), &s->p->p, C_T7(m), s->p); // -y * R
+    sb_fe_ctswap(neg ^ top, C_Y2(m), C_T7(m));
 }
 
-// A scalar is valid if it is reduced and ∉ {-2, -1, 0, 1} mod N
-// Valid scalars are not modified, but invalid scalars may be reduced
-static _Bool
-sb_sw_scalar_valid(sb_fe_t* const k, const sb_sw_curve_t s[static const 1])
+// The last SB_SW_FIXED_BASE_COMPLETE columns of the comb are processed with
+// the complete formulas; see sb_sw_point_mult_base.
+#define SB_SW_FIXED_BASE_COMPLETE \
+    (SB_SW_FIXED_BASE_WINDOW * SB_SW_FIXED_BASE_SPACING - (SB_FE_BITS - 1))
+
+#endif
+
+#if SB_SW_FIXED_BASE_WINDOW
+
+// Computes k * G for the curve generator G using a comb, which costs about
+// 21MM per column instead of 14MM per bit. The result is left in Jacobian
+// coordinates (x1, y1, z1), each multiplied by R.
+static void
+sb_sw_point_mult_base_comb(sb_sw_context_t m[static const 1],
+                           const sb_sw_curve_t s[static const 1])
 {
-    _Bool r = 1;
+    // Input scalars MUST always be checked for validity
+    // (k is reduced and ∉ {-2, -1, 0, 1} mod N).
 
-    r &= sb_fe_lt(k, &s->n->p);
-    r &= !sb_fe_equal(k, &SB_FE_ONE); // 1
-    r &= !sb_fe_equal(k, &SB_FE_ZERO); // 0
+    // The comb requires an odd scalar k'. If k is even, use k' = N - k and
+    // negate every column, which produces -k' * G = k * G.
+    const sb_word_t even =
+        sb_sw_point_comb_scalar(MULT_BASE_K(m), MULT_K(m), m, s);
+
+    // Start with the top column, with a Z update of iz * R^-1 as in
+    // sb_sw_point_mult.
+    sb_sw_point_comb_select(SB_SW_FIXED_BASE_SPACING - 1, even,
+                            MULT_BASE_K(m), s->g_comb, m, s);
+
+    *C_Z1(m) = *MULT_Z(m);
+    sb_fe_mont_square(C_T5(m), MULT_Z(m), s->p); // t5 = z^2
+    sb_fe_mont_mult(C_T6(m), MULT_Z(m), C_T5(m), s->p); // t6 = z^3
+    sb_fe_mont_mult(C_X1(m), C_X2(m), C_T5(m), s->p); // x z^2
+    sb_fe_mont_mult(C_Y1(m), C_Y2(m), C_T6(m), s->p); // y z^3
+
+    // After processing columns d - 1 through m, the running total is a_m * G,
+    // where a_m = sum_{i >= m} 2^(i - m) * C_i. The doubling formula has no
+    // exceptional cases, and the addition of C_m * G is exceptional only if
+    // 2 * a_(m+1) ± C_m = 0 mod N. Both are sums of distinct powers of two
+    // with signs ±1, so neither is zero, and both are less than 2^(w*d - m)
+    // in magnitude. Since N > 2^255, this can only occur in the last
+    // w * d - 255 columns, which are computed in projective coordinates
+    // with the complete formulas instead. No branch depends on the scalar.
+
+    for (size_t i = SB_SW_FIXED_BASE_SPACING - 1;
+         i > SB_SW_FIXED_BASE_COMPLETE; i--) {
+        sb_sw_point_double(m, s); // 8MM + 12A
+        sb_sw_point_comb_select(i - 1, even, MULT_BASE_K(m), s->g_comb, m,
+                                s); // 2MM + 1A
+        sb_sw_point_mixed_add_h_r(m, s); // 4MM + 2A
+        sb_sw_point_mixed_add_finish(m, s); // 7MM + 5A
+    }
 
-    sb_fe_sub(k, &s->n->p, k); // -k
-    r &= !sb_fe_equal(k, &SB_FE_ONE); // -1
-    sb_fe_mod_sub(k, k, &SB_FE_ONE, s->n); // (-k) - 1
-    r &= !sb_fe_equal(k, &SB_FE_ONE); // -2
+    sb_sw_point_jacobian_to_projective(m, s); // 3MM
 
-    sb_fe_mod_add(k, k, &SB_FE_ONE, s->n); // -k
-    sb_fe_sub(k, &s->n->p, k); // k
+    for (size_t i = SB_SW_FIXED_BASE_COMPLETE; i > 0; i--) {
+        sb_sw_point_double_complete(m, s);
+        sb_sw_point_comb_select(i - 1, even, MULT_BASE_K(m), s->g_comb, m,
+                                s); // 2MM + 1A
+        sb_sw_point_mixed_add_complete(m, s);
+    }
 
-    return r;
+    sb_sw_point_projective_to_jacobian(m, s); // 3MM
 }
 
-#ifdef SB_TEST
+#endif
 
-static _Bool test_h(const sb_sw_curve_t* s)
+// Computes k * G for the curve generator G, with the same inputs and outputs
+// as sb_sw_point_mult. If SB_SW_FIXED_BASE_WINDOW is nonzero, this uses a
+// comb; see sb_sw_point_mult_base_comb.
+static void
+sb_sw_point_mult_base(sb_sw_context_t m[static const 1],
+                      const sb_sw_curve_t s[static const 1])
 {
-    sb_sw_context_t m;
-    memset(&m, 0, sizeof(m));
-    *MULT_Z(&m) = SB_FE_ONE;
-    *MULT_K(&m) = (sb_fe_t) SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
-                                        0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF);
-    sb_fe_sub(MULT_K(&m), MULT_K(&m), &s->n->p);
-    sb_fe_sub(MULT_K(&m), MULT_K(&m), &s->n->p);
-    const sb_fe_t h_inv = *MULT_K(&m);
-    sb_fe_mont_mult(C_T5(&m), MULT_K(&m), &s->n->r2_mod_p,
-                    s->n);
-    sb_fe_mod_inv_r(C_T5(&m), C_T6(&m), C_T7(&m), s->n);
-    sb_fe_mont_mult(MULT_K(&m), C_T5(&m), &SB_FE_ONE, s->n);
-    sb_sw_point_mult(&m, s->g_r, s);
-
-    sb_fe_mont_mult(&MULT_POINT(&m)[0], C_X1(&m), &s->p->r2_mod_p, s->p);
-    sb_fe_mont_mult(&MULT_POINT(&m)[1], C_Y1(&m), &s->p->r2_mod_p, s->p);
+#if SB_SW_FIXED_BASE_WINDOW
+    sb_sw_point_mult_base_comb(m, s);
+    sb_sw_point_affine(m, s);
+#else
+    sb_sw_point_mult(m, s->g_r, s);
+#endif
+}
 
-    SB_TEST_ASSERT(sb_fe_equal(&MULT_POINT(&m)[0], &s->h_r[0]));
-    SB_TEST_ASSERT(sb_fe_equal(&MULT_POINT(&m)[1], &s->h_r[1]));
+// Computes k * G as sb_sw_point_mult_base does, but leaves the result in
+// Jacobian coordinates (x1, y1, z1), each multiplied by R, so that the final
+// inversion can be shared among several points. If SB_SW_FIXED_BASE_WINDOW is
+// 0, the result of the Montgomery ladder is returned with Z = 1.
+static void
+sb_sw_point_mult_base_jacobian(sb_sw_context_t m[static const 1],
+                               const sb_sw_curve_t s[static const 1])
+{
+#if SB_SW_FIXED_BASE_WINDOW
+    sb_sw_point_mult_base_comb(m, s);
+#else
+    sb_sw_point_mult(m, s->g_r, s);
+    sb_fe_mont_mult(C_T5(m), C_X1(m), &s->p->r2_mod_p, s->p); // x * R
+    *C_X1(m) = *C_T5(m);
+    sb_fe_mont_mult(C_T5(m), C_Y1(m), &s->p->r2_mod_p, s->p); // y * R
+    *C_Y1(m) = *C_T5(m);
+    *C_Z1(m) = s->p->r_mod_p; // Z = 1
+#endif
+}
 
+// Multiplication-addition using Shamir's trick to produce k_1 * P + k_2 * Q
 
-    *MULT_K(&m) = h_inv;
-    sb_sw_point_mult(&m, MULT_POINT(&m), s);
-    sb_fe_mont_mult(C_X2(&m), &s->g_r[0], &SB_FE_ONE, s->p);
-    sb_fe_mont_mult(C_Y2(&m), &s->g_r[1], &SB_FE_ONE, s->p);
-    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), C_X2(&m)));
-    SB_TEST_ASSERT(sb_fe_equal(C_Y1(&m), C_Y2(&m)));
+// sb_sw_point_mult_add_z_update computes the new Z and then performs co-Z
+// point addition at a cost of 7MM + 7A
+static void sb_sw_point_mult_add_z_update(sb_sw_context_t q[static const 1],
+                                          const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mod_sub(C_T6(q), C_X2(q), C_X1(q), s->p); // t6 = x2 - x1 = Z' / Z
+    sb_fe_mont_mult(C_T5(q), C_T6(q), MULT_Z(q), s->p); // updated Z
+    *MULT_Z(q) = *C_T5(q);
 
-    return 1;
+    sb_sw_point_co_z_add_update_zup(q, s);
 }
 
-_Bool sb_test_sw_h(void)
+// sb_sw_point_mult_add_apply_z applies a Z value to the selected point
+// (H, P + H, G + H, or P + G + H) at a cost of 4MM
+static void sb_sw_point_mult_add_apply_z(sb_sw_context_t q[static const 1],
+                                         const sb_sw_curve_t s[static const 1])
 {
-    SB_TEST_ASSERT(test_h(&SB_CURVE_P256));
-    SB_TEST_ASSERT(test_h(&SB_CURVE_SECP256K1));
+    sb_fe_mont_square(C_T6(q), MULT_Z(q), s->p); // Z^2
 
-    return 1;
+    sb_fe_mont_mult(C_T7(q), C_X2(q), C_T6(q), s->p);
+    *C_X2(q) = *C_T7(q);
+
+    sb_fe_mont_mult(C_T7(q), C_T6(q), MULT_Z(q), s->p); // Z^3
+    sb_fe_mont_mult(C_T6(q), C_Y2(q), C_T7(q), s->p);
+    *C_Y2(q) = *C_T6(q);
 }
 
-// The following scalars cause exceptions in the ladder and are NOT valid.
-_Bool sb_test_exceptions(void)
+// sb_sw_point_mult_add_select selects the point to conjugate-add to the
+// running total based on the bits of the given input scalars
+static void sb_sw_point_mult_add_select(const sb_word_t bp, const sb_word_t bg,
+                                        sb_sw_context_t q[static const 1],
+                                        const sb_sw_curve_t s[static const 1])
 {
-    sb_sw_context_t m;
-    memset(&m, 0, sizeof(m));
-    *MULT_Z(&m) = SB_FE_ONE;
-
-    // Exceptions produce P, not zero, due to ZVA countermeasures
+    // select a point S for conjugate addition with R
+    // if bp = 0 and bg = 0, select h
+    // if bp = 0 and bg = 1, select g + h
+    // if bp = 1 and bg = 0, select p + h
+    // if bp = 1 and bg = 1, select p + g + h
+    *C_X2(q) = s->h_r[0];
+    *C_Y2(q) = s->h_r[1];
+
+    *C_T5(q) = s->g_h_r[0];
+    *C_T6(q) = s->g_h_r[1];
+    sb_fe_ctswap(bg, C_X2(q), C_T5(q));
+    sb_fe_ctswap(bg, C_Y2(q), C_T6(q));
+
+    *C_T5(q) = MULT_POINT(q)[0];
+    *C_T6(q) = MULT_POINT(q)[1];
+    sb_fe_ctswap(bp, C_X2(q), C_T5(q));
+    sb_fe_ctswap(bp, C_Y2(q), C_T6(q));
+
+    *C_T5(q) = MULT_ADD_PG(q)[0];
+    *C_T6(q) = MULT_ADD_PG(q)[1];
+    sb_fe_ctswap(bp & bg, C_X2(q), C_T5(q));
+    sb_fe_ctswap(bp & bg, C_Y2(q), C_T6(q));
+
+    sb_sw_point_mult_add_apply_z(q, s);
+}
+
+// Signature verification uses a regular double-and-add algorithm with Shamir's
+// trick for dual scalar-basepoint multiplication. Because adding O (the
+// point at infinity) is an exceptional case in the standard formulae for
+// point addition on short Weierstrass curves, each iteration adds an
+// additional point H. Due to regularization of the input scalars,
+// the algorithm starts with bit 256 in both k_p and k_g set, so the initial
+// value is P + G + H, and at the end of the loop, (2^257 - 1) * H has been
+// added, producing k_p * P + k_g * G + (2^257 - 1) * H. To correct for this,
+// one could subtract the extra multiple of H at the end of the algorithm,
+// but instead H has been chosen so that we can easily adjust k_g before the
+// multiplication instead. Let H be (2^257 - 1)^-1 * G. Then compute:
+//   k_p * P + (k_g - 1) * G + (2^257 - 1) * H
+// = k_p * P + (k_g - 1) * G + (2^257 - 1) * (2^257 - 1)^-1 * G
+// = k_p * P + (k_g - 1) * G + G
+// = k_p * P + k_g * G
+
+// The algorithm is as follows:
+
+// Given inputs k_p, P, k_g on some curve with base point G, and let H as
+// above, with G + H precomputed
+
+// 1. Compute P + H and P + G + H
+
+// Let S(b_p, b_g) be:         H if b_p == 0 && b_g == 0
+//                         P + H if b_p == 1 && b_g == 0
+//                         G + H if b_p == 0 && b_g == 1
+//                     P + G + H if b_p == 1 && b_g == 1
+
+// 2. k_g := k_g - 1
+// 3. k_p := regularize(k_p)
+// 4. k_g := regularize(k_g)
+// 5. R := P + G + H
+// 6. R := 2 * R
+// 7. R := R + S(k_p_255, k_g_255)
+// 8. for i from 254 downto 0:
+//    8.1. R' := R + S(k_p_i, k_g_i)
+//    8.2. R  := R + R'
+// 9. return R
+
+// The first part of step 1 of the algorithm: computes P + H and P + G + H in
+// Jacobian coordinates with a common Z, leaving P + G + H in (x1, y1), P + H
+// in (x2, y2), and Z * R in MULT_Z. P in MULT_POINT is multiplied by R.
+static void
+sb_sw_point_mult_add_prepare_jacobian(sb_sw_context_t q[static const 1],
+                                      const sb_sw_curve_t s[static const 1])
+{
+    // multiply (x, y) of P by R
+    sb_fe_mont_mult(C_X1(q), &MULT_POINT(q)[0], &s->p->r2_mod_p, s->p);
+    MULT_POINT(q)[0] = *C_X1(q);
+    sb_fe_mont_mult(C_Y1(q), &MULT_POINT(q)[1], &s->p->r2_mod_p, s->p);
+    MULT_POINT(q)[1] = *C_Y1(q);
+
+    *C_X2(q) = s->h_r[0];
+    *C_Y2(q) = s->h_r[1];
+
+    // P and H are in affine coordinates, so our current Z is one (R in
+    // Montgomery domain)
+    *MULT_Z(q) = s->p->r_mod_p;
+
+    // (x1, x2) = P + H; (x2, y2) = P'
+    sb_sw_point_mult_add_z_update(q, s);
+
+    // Apply Z to G before co-Z addition of (P + H) and G
+    *C_X2(q) = s->g_r[0];
+    *C_Y2(q) = s->g_r[1];
+    sb_sw_point_mult_add_apply_z(q, s);
+
+    // (x1, x2) = P + G + H; (x2, y2) = P + H
+    sb_sw_point_mult_add_z_update(q, s);
+}
+
+// The second part of step 1 of the algorithm: given Z^-1 * R in t5, places
+// P + H in MULT_POINT and P + G + H in MULT_ADD_PG, both in affine
+// coordinates multiplied by R.
+static void
+sb_sw_point_mult_add_prepare_affine(sb_sw_context_t q[static const 1],
+                                    const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_square(C_T6(q), C_T5(q), s->p); // t6 = Z^-2 * R
+    sb_fe_mont_mult(C_T7(q), C_T5(q), C_T6(q), s->p); // t7 = Z^-3 * R
+
+    // Apply Z to P + H
+    sb_fe_mont_mult(&MULT_POINT(q)[0], C_X2(q), C_T6(q), s->p);
+    sb_fe_mont_mult(&MULT_POINT(q)[1], C_Y2(q), C_T7(q), s->p);
+
+    // Apply Z to P + G + H
+    sb_fe_mont_mult(&MULT_ADD_PG(q)[0], C_X1(q), C_T6(q), s->p);
+    sb_fe_mont_mult(&MULT_ADD_PG(q)[1], C_Y1(q), C_T7(q), s->p);
+}
+
+// Step 1 of the algorithm: replaces P in MULT_POINT with P + H, and places
+// P + G + H in MULT_ADD_PG, both in affine coordinates multiplied by R. These
+// depend only on P, so they may be computed once per public key; see
+// sb_sw_prepare_public_key. MULT_Z is preserved.
+static void sb_sw_point_mult_add_prepare(sb_sw_context_t q[static const 1],
+                                         const sb_sw_curve_t s[static const 1])
+{
+    // Save initial Z in T8 until it can be restored
+    *C_T8(q) = *MULT_Z(q);
+
+    sb_sw_point_mult_add_prepare_jacobian(q, s);
+
+    // Invert Z and multiply so that P + H and P + G + H are in affine
+    // coordinates
+    *C_T5(q) = *MULT_Z(q); // t5 = Z * R
+    sb_fe_mod_inv_r(C_T5(q), C_T6(q), C_T7(q), s->p); // t5 = Z^-1 * R
+
+    sb_sw_point_mult_add_prepare_affine(q, s);
+
+    *MULT_Z(q) = *C_T8(q);
+}
+
+// Steps 2 through 9 of the algorithm: produces kp * P + kg * G in (x1, y1)
+// with Z * R in t5, given P + H in MULT_POINT and P + G + H in MULT_ADD_PG
+// from sb_sw_point_mult_add_prepare
+static void
+sb_sw_point_mult_add_z_prepared(sb_sw_context_t q[static const 1],
+                                const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_t* const kp = MULT_K(q);
+    sb_fe_t* const kg = MULT_ADD_KG(q);
+
+    // Subtract one from kg to account for the addition of (2^257 - 1) * H = G
+    sb_fe_sub(kg, kg, &SB_FE_ONE);
+
+    // Regularize the input scalars so the ladder starts at P + G + H
+    sb_sw_regularize_scalar(kp, q, s);
+    sb_sw_regularize_scalar(kg, q, s);
+
+    // Computation begins with R = P + G + H due to regularization of the
+    // scalars. If bit 255 of kp and kpg are both 1, this would lead to a
+    // point doubling!
+    // Avoid the inadvertent doubling in the first bit, so that the regular
+    // ladder can start at 2 * (P + G + H) + S
+
+    *C_X2(q) = MULT_ADD_PG(q)[0];
+    *C_Y2(q) = MULT_ADD_PG(q)[1];
+
+    sb_sw_point_initial_double(q, s);
+    // 2 * (P + G + H) is now in (x2, y2); Z is in t5
+
+    // apply initial Z
+    sb_sw_point_mult_add_apply_z(q, s);
+
+    // z coordinate of (x2, y2) is now iz * t5
+    sb_fe_mont_mult(C_T6(q), MULT_Z(q), C_T5(q), s->p);
+    *MULT_Z(q) = *C_T6(q);
+
+    // move 2 * (P + G + H) to (x1, y1)
+    *C_X1(q) = *C_X2(q);
+    *C_Y1(q) = *C_Y2(q);
+
+    // 14MM + 14A + 4MM co-Z update = 18MM + 14A per bit
+    // Note that mixed Jacobian-affine doubling-addition can be done in 18MM.
+    // Assuming a Hamming weight of ~128 on both scalars and 8MM doubling, the
+    // expected performance of a conditional Jacobian double-and-add
+    // implementation would be (3/4 * 18MM) + (1/4 * 8MM) = 15.5MM/bit
+
+    // The algorithm used here is regular and reuses the existing co-Z addition
+    // operation. Conventional wisdom says that signature verification does
+    // not need to be constant time; however, it's not clear to me that this
+    // holds in all cases. For instance, an embedded system might leak
+    // information about its firmware version by the amount of time that it
+    // takes to verify a signature on boot.
+
+    // If you want a variable-time algorithm, see
+    // sb_sw_point_mult_add_vartime below.
+
+    // Note that this algorithm may also not be SPA- or DPA-resistant, as H,
+    // P + H, G + H, and P + G + H are stored and used in affine coordinates,
+    // so the co-Z update of these variables might be detectable even with
+    // Z blinding. If this matters for signature verification in your
+    // application, please contact the authors for commercial support.
+
+    for (size_t i = SB_FE_BITS - 1; i < SB_FE_BITS; i--) {
+        const sb_word_t bp = sb_fe_test_bit(kp, i);
+        const sb_word_t bg = sb_fe_test_bit(kg, i);
+
+        sb_sw_point_mult_add_select(bp, bg, q, s);
+
+        // (x1, y1) = (R + S), (x2, y2) = R'
+        sb_sw_point_mult_add_z_update(q, s);
+
+        // The initial point has already been doubled
+        if (i < SB_FE_BITS - 1) {
+            // R := (R + S) + R = 2 * R + S
+            sb_sw_point_mult_add_z_update(q, s);
+        }
+    }
+
+    *C_T6(q) = *C_X1(q);
+    sb_fe_mont_reduce(C_X1(q), C_T6(q), s->p);
+    *C_T6(q) = *C_Y1(q);
+    sb_fe_mont_reduce(C_Y1(q), C_T6(q), s->p);
+    *C_T5(q) = *MULT_Z(q);
+}
+
+// Produces kp * P + kg * G in (x1, y1) with Z * R in t5
+static void sb_sw_point_mult_add_z(sb_sw_context_t q[static const 1],
+                                   const sb_sw_curve_t s[static const 1])
+{
+    sb_sw_point_mult_add_prepare(q, s);
+    sb_sw_point_mult_add_z_prepared(q, s);
+}
+
+#if SB_SW_FIXED_BASE_WINDOW
+
+// Computes the comb table of P = MULT_POINT for sb_sw_prepare_public_key, in
+// the same form as the comb table of G; see sb_sw_fixed_base.h. This costs
+// (w - 1) * d doublings, 2^(w - 1) * (w - 1) additions, and 2^(w - 1) + w - 1
+// inversions, and need not run in constant time, as P is public.
+static void
+sb_sw_point_comb_table(sb_fe_t table[static const SB_SW_FIXED_BASE_ENTRIES][2],
+                       sb_sw_context_t c[static const 1],
+                       const sb_sw_curve_t s[static const 1])
+{
+    // b[l] = 2^(l * d) * P in affine coordinates multiplied by R
+    sb_fe_t b[SB_SW_FIXED_BASE_WINDOW][2];
+
+    sb_fe_mont_mult(&b[0][0], &MULT_POINT(c)[0], &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(&b[0][1], &MULT_POINT(c)[1], &s->p->r2_mod_p, s->p);
+
+    for (size_t l = 1; l < SB_SW_FIXED_BASE_WINDOW; l++) {
+        *C_X1(c) = b[l - 1][0];
+        *C_Y1(c) = b[l - 1][1];
+        *C_Z1(c) = s->p->r_mod_p;
+        for (size_t i = 0; i < SB_SW_FIXED_BASE_SPACING; i++) {
+            sb_sw_point_double(c, s);
+        }
+        sb_sw_point_affine(c, s);
+        sb_fe_mont_mult(&b[l][0], C_X1(c), &s->p->r2_mod_p, s->p);
+        sb_fe_mont_mult(&b[l][1], C_Y1(c), &s->p->r2_mod_p, s->p);
+    }
+
+    // None of these additions is exceptional: the running total is a signed
+    // sum of distinct powers of two, each greater than the one being added,
+    // and the sum is less than N in magnitude.
+    for (size_t j = 0; j < SB_SW_FIXED_BASE_ENTRIES; j++) {
+        *C_X1(c) = b[SB_SW_FIXED_BASE_WINDOW - 1][0];
+        *C_Y1(c) = b[SB_SW_FIXED_BASE_WINDOW - 1][1];
+        *C_Z1(c) = s->p->r_mod_p;
+        for (size_t l = SB_SW_FIXED_BASE_WINDOW - 1; l > 0; l--) {
+            *C_X2(c) = b[l - 1][0];
+            if ((j >> (l - 1)) & 1) {
+                *C_Y2(c) = b[l - 1][1];
+            } else {
+                sb_fe_mod_sub(C_Y2(c), &s->p->p, &b[l - 1][1], s->p);
+            }
+            sb_sw_point_mixed_add_h_r(c, s);
+            sb_sw_point_mixed_add_finish(c, s);
+        }
+        sb_sw_point_affine(c, s);
+        table[j][0] = *C_X1(c);
+        table[j][1] = *C_Y1(c);
+    }
+}
+
+// Produces kp * P + kg * G with the same outputs as sb_sw_point_mult_add_z,
+// using the comb table of G and the given comb table of P with one doubling
+// and two additions per column. Returns nonzero if any addition was
+// exceptional, in which case the output is incorrect; as in
+// sb_sw_point_mult_base, this happens only for specially constructed inputs.
+static sb_word_t
+sb_sw_point_mult_add_comb(sb_sw_context_t q[static const 1],
+                          const sb_fe_t
+                          table[static const SB_SW_FIXED_BASE_ENTRIES][2],
+                          const sb_sw_curve_t s[static const 1])
+{
+    const sb_word_t even_g =
+        sb_sw_point_comb_scalar(MULT_ADD_COMB_KG(q), MULT_ADD_KG(q), q, s);
+    const sb_word_t even_p =
+        sb_sw_point_comb_scalar(MULT_ADD_COMB_KP(q), MULT_K(q), q, s);
+
+    // Start with the top column of kg, with a Z update of iz * R^-1 as in
+    // sb_sw_point_mult_base.
+    sb_sw_point_comb_select(SB_SW_FIXED_BASE_SPACING - 1, even_g,
+                            MULT_ADD_COMB_KG(q), s->g_comb, q, s);
+
+    *C_Z1(q) = *MULT_Z(q);
+    sb_fe_mont_square(C_T5(q), MULT_Z(q), s->p); // t5 = z^2
+    sb_fe_mont_mult(C_T6(q), MULT_Z(q), C_T5(q), s->p); // t6 = z^3
+    sb_fe_mont_mult(C_X1(q), C_X2(q), C_T5(q), s->p); // x z^2
+    sb_fe_mont_mult(C_Y1(q), C_Y2(q), C_T6(q), s->p); // y z^3
+
+    sb_word_t exceptional = 0;
+
+    for (size_t i = SB_SW_FIXED_BASE_SPACING; i > 0; i--) {
+        if (i < SB_SW_FIXED_BASE_SPACING) {
+            sb_sw_point_double(q, s); // 8MM + 12A
+            sb_sw_point_comb_select(i - 1, even_g, MULT_ADD_COMB_KG(q),
+                                    s->g_comb, q, s); // 2MM + 1A
+            sb_sw_point_mixed_add_h_r(q, s); // 4MM + 2A
+            exceptional |= sb_fe_equal(C_T6(q), &s->p->p);
+            sb_sw_point_mixed_add_finish(q, s); // 7MM + 5A
+        }
+
+        sb_sw_point_comb_select(i - 1, even_p, MULT_ADD_COMB_KP(q), table, q,
+                                s); // 2MM + 1A
+        sb_sw_point_mixed_add_h_r(q, s); // 4MM + 2A
+        exceptional |= sb_fe_equal(C_T6(q), &s->p->p);
+        sb_sw_point_mixed_add_finish(q, s); // 7MM + 5A
+    }
+
+    *C_T6(q) = *C_X1(q);
+    sb_fe_mont_reduce(C_X1(q), C_T6(q), s->p);
+    *C_T6(q) = *C_Y1(q);
+    sb_fe_mont_reduce(C_Y1(q), C_T6(q), s->p);
+    *C_T5(q) = *C_Z1(q);
+
+    return exceptional;
+}
+
+#endif
+
+#if SB_SW_VARTIME_SUPPORT
+
+// Variable-time multiplication-addition for sb_sw_verify_signature_vartime,
+// using the interleaved width-w NAF method (Algorithm 3.51 of Hankerson,
+// Menezes, and Vanstone, "Guide to Elliptic Curve Cryptography"). Odd
+// multiples of G come from a precomputed table; odd multiples of P are
+// computed for each call.
+
+#define SB_SW_VARTIME_P_WINDOW 5
+#define SB_SW_VARTIME_P_ENTRIES (1 << (SB_SW_VARTIME_P_WINDOW - 2))
+
+// Computes the width-w NAF of k: each nonzero digit is odd and less than
+// 2^(w - 1) in absolute value, and any w consecutive digits contain at most
+// one nonzero digit. One digit beyond SB_FE_BITS is needed for the final
+// carry.
+static void sb_sw_wnaf(int8_t naf[static const SB_FE_BITS + 1],
+                       const sb_fe_t k[static const 1],
+                       const size_t w)
+{
+    memset(naf, 0, SB_FE_BITS + 1);
+
+    sb_word_t carry = 0;
+    size_t i = 0;
+    while (i < SB_FE_BITS) {
+        if (sb_fe_test_bit(k, i) == carry) {
+            i++;
+            continue;
+        }
+
+        size_t n = w;
+        if (n > SB_FE_BITS - i) {
+            n = SB_FE_BITS - i;
+        }
+
+        // The low bit of the window differs from carry, so digit is odd
+        int32_t digit = (int32_t) carry;
+        for (size_t j = 0; j < n; j++) {
+            digit += (int32_t) sb_fe_test_bit(k, i + j) << j;
+        }
+
+        carry = (sb_word_t) ((digit >> (w - 1)) & 1);
+        digit -= (int32_t) carry << w;
+        naf[i] = (int8_t) digit;
+        i += n;
+    }
+    naf[SB_FE_BITS] = (int8_t) carry;
+}
+
+// Adds (x2, y2) to the running total (x1, y1, z1), which is the point at
+// infinity if *inf is set.
+// Uses: t5, t6, t7, t8
+static void sb_sw_point_add_vartime(_Bool inf[static const 1],
+                                    sb_sw_context_t c[static const 1],
+                                    const sb_sw_curve_t s[static const 1])
+{
+    if (*inf) {
+        *C_X1(c) = *C_X2(c);
+        *C_Y1(c) = *C_Y2(c);
+        *C_Z1(c) = s->p->r_mod_p;
+        *inf = 0;
+        return;
+    }
+
+    sb_sw_point_mixed_add_h_r(c, s);
+    if (sb_fe_equal(C_T6(c), &s->p->p)) {
+        if (sb_fe_equal(C_T5(c), &s->p->p)) {
+            // The points are equal
+            sb_sw_point_double(c, s);
+        } else {
+            // The points are negations of each other
+            *inf = 1;
+        }
+        return;
+    }
+    sb_sw_point_mixed_add_finish(c, s);
+}
+
+// Jacobian point addition: (x1, y1, z1) = (x1, y1, z1) + (x2, y2, z2), where
+// a Z coordinate of zero (represented as p) denotes the point at infinity.
+// With u = z2, the isomorphism (x, y) -> (u^2 * x, u^3 * y) takes the second
+// point to the affine point (x2, y2) and the first to (u^2 * x1, u^3 * y1, z1)
+// on a curve with a different a. Mixed addition does not depend on a, so it
+// is used to add the images, and the Z coordinate of the sum is multiplied by
+// u to take it back to the original curve.
+// Uses: t5, t6, t7, t8
+// Cost: 16MM + 7A
+static void
+sb_sw_point_add_jacobian_vartime(sb_sw_context_t c[static const 1],
+                                 const sb_sw_curve_t s[static const 1])
+{
+    if (sb_fe_equal(C_Z2(c), &s->p->p)) {
+        return;
+    }
+
+    if (sb_fe_equal(C_Z1(c), &s->p->p)) {
+        *C_X1(c) = *C_X2(c);
+        *C_Y1(c) = *C_Y2(c);
+        *C_Z1(c) = *C_Z2(c);
+        return;
+    }
+
+    sb_fe_mont_square(C_T5(c), C_Z2(c), s->p); // t5 = u^2
+    sb_fe_mont_mult(C_T6(c), C_T5(c), C_Z2(c), s->p); // t6 = u^3
+    sb_fe_mont_mult(C_T7(c), C_X1(c), C_T5(c), s->p);
+    *C_X1(c) = *C_T7(c); // x1 = u^2 * x1
+    sb_fe_mont_mult(C_T7(c), C_Y1(c), C_T6(c), s->p);
+    *C_Y1(c) = *C_T7(c); // y1 = u^3 * y1
+
+    sb_sw_point_mixed_add_h_r(c, s);
+    if (sb_fe_equal(C_T6(c), &s->p->p)) {
+        if (sb_fe_equal(C_T5(c), &s->p->p)) {
+            // The points are equal, and (x1, y1, u * z1) is the first point
+            // on the original curve
+            sb_fe_mont_mult(C_T5(c), C_Z1(c), C_Z2(c), s->p);
+            *C_Z1(c) = *C_T5(c);
+            sb_sw_point_double(c, s);
+        } else {
+            // The points are negations of each other
+            *C_Z1(c) = s->p->p;
+        }
+        return;
+    }
+    sb_sw_point_mixed_add_finish(c, s);
+
+    sb_fe_mont_mult(C_T5(c), C_Z1(c), C_Z2(c), s->p);
+    *C_Z1(c) = *C_T5(c); // z1 = u * z1
+}
+
+// Places the odd multiples P, 3 * P, ..., (2 * SB_SW_VARTIME_P_ENTRIES - 1) * P
+// of P = MULT_POINT into table as affine points multiplied by R, with a single
+// inversion.
+// Uses: x1, y1, x2, y2, t5, t6, t7, t8, z1
+static void sb_sw_point_odd_multiples(sb_fe_t table[static const
+                                                    SB_SW_VARTIME_P_ENTRIES][2],
+                                      sb_sw_context_t c[static const 1],
+                                      const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_t ratio[SB_SW_VARTIME_P_ENTRIES];
+
+    sb_fe_mont_mult(C_X2(c), &MULT_POINT(c)[0], &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(C_Y2(c), &MULT_POINT(c)[1], &s->p->r2_mod_p, s->p);
+    sb_sw_point_odd_multiples_z(table, ratio, SB_SW_VARTIME_P_ENTRIES, c, s);
+
+    *C_T5(c) = *C_Z1(c);
+    sb_fe_mod_inv_r(C_T5(c), C_T6(c), C_T7(c),
+                    s->p); // t5 = Z_i^-1 for the last i
+    sb_sw_point_odd_multiples_affine(table, ratio, SB_SW_VARTIME_P_ENTRIES, c,
+                                     s);
+}
+
+// Adds d * P to the running total (x1, y1, z1), which is the point at
+// infinity if *inf is set, where d is a nonzero NAF digit and table holds the
+// odd multiples of P as affine points multiplied by R.
+// Uses: x2, y2, t5, t6, t7, t8
+static void sb_sw_point_add_naf_vartime(_Bool inf[static const 1],
+                                        const int8_t d,
+                                        sb_fe_t table[static const 1][2],
+                                        sb_sw_context_t c[static const 1],
+                                        const sb_sw_curve_t s[static const 1])
+{
+    const size_t j = (size_t) ((d < 0 ? -d : d) >> 1);
+    *C_X2(c) = table[j][0];
+    if (d < 0) {
+        sb_fe_mod_sub(C_Y2(c), &s->p->p, &table[j][1], s->p);
+    } else {
+        *C_Y2(c) = table[j][1];
+    }
+    sb_sw_point_add_vartime(inf, c, s); // 11MM + 7A
+}
+
+// Adds d * G to the running total as sb_sw_point_add_naf_vartime does, where
+// d is a nonzero digit of a width-SB_SW_VARTIME_G_WINDOW NAF and g holds the
+// odd multiples of G (or of lambda * G) without R.
+// Uses: x2, y2, t5, t6, t7, t8
+static void sb_sw_point_add_naf_g_vartime(_Bool inf[static const 1],
+                                          const int8_t d,
+                                          const sb_fe_t g[static const 1][2],
+                                          sb_sw_context_t c[static const 1],
+                                          const sb_sw_curve_t s[static const 1])
+{
+    const size_t j = (size_t) ((d < 0 ? -d : d) >> 1);
+    sb_fe_mont_mult(C_X2(c), &g[j][0], &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(C_T5(c), &g[j][1], &s->p->r2_mod_p, s->p);
+    if (d < 0) {
+        sb_fe_mod_sub(C_Y2(c), &s->p->p, C_T5(c), s->p);
+    } else {
+        *C_Y2(c) = *C_T5(c);
+    }
+    sb_sw_point_add_vartime(inf, c, s); // 13MM + 7A
+}
+
+// Computes kp * P + kg * G into (x1, y1, z1) by the interleaved NAF method,
+// returning whether the result is the point at infinity.
+static _Bool
+sb_sw_point_mult_add_wnaf_vartime(sb_sw_context_t q[static const 1],
+                                  const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_t table[SB_SW_VARTIME_P_ENTRIES][2];
+    int8_t naf_p[SB_FE_BITS + 1], naf_g[SB_FE_BITS + 1];
+
+    sb_sw_wnaf(naf_p, MULT_K(q), SB_SW_VARTIME_P_WINDOW);
+    sb_sw_wnaf(naf_g, MULT_ADD_KG(q), SB_SW_VARTIME_G_WINDOW);
+
+    sb_sw_point_odd_multiples(table, q, s);
+
+    _Bool inf = 1;
+    for (size_t i = SB_FE_BITS; i <= SB_FE_BITS; i--) {
+        if (!inf) {
+            sb_sw_point_double(q, s); // 8MM + 12A
+        }
+
+        if (naf_p[i]) {
+            sb_sw_point_add_naf_vartime(&inf, naf_p[i], table, q, s);
+        }
+
+        if (naf_g[i]) {
+            sb_sw_point_add_naf_g_vartime(&inf, naf_g[i], s->g_odd, q, s);
+        }
+    }
+
+    return inf;
+}
+
+// On a curve with an endomorphism, each scalar is split with sb_sw_glv_split
+// into halves less than 2^130, so that kp * P + kg * G is computed as a sum of
+// four products with half as many doublings:
+//   kp1 * P + kp2 * phi(P) + kg1 * G + kg2 * (lambda * G)
+// The odd multiples of phi(P) are those of P with x multiplied by beta, and
+// those of lambda * G are precomputed. The signs of the halves are applied
+// to their NAF digits.
+
+// Computes the NAF of the half k of a split scalar, negating its digits if neg
+// is set. Since k < 2^130, every digit beyond digit SB_SW_GLV_BITS is zero.
+static void sb_sw_glv_wnaf(int8_t naf[static const SB_FE_BITS + 1],
+                           const sb_fe_t k[static const 1],
+                           const sb_word_t neg,
+                           const size_t w)
+{
+    sb_sw_wnaf(naf, k, w);
+    if (neg) {
+        for (size_t i = 0; i <= SB_SW_GLV_BITS; i++) {
+            naf[i] = (int8_t) -naf[i];
+        }
+    }
+}
+
+// Computes kp * P + kg * G into (x1, y1, z1) as above, returning whether the
+// result is the point at infinity.
+static _Bool
+sb_sw_point_mult_add_glv_vartime(sb_sw_context_t q[static const 1],
+                                 const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_t table[SB_SW_VARTIME_P_ENTRIES][2];
+    sb_fe_t table_phi[SB_SW_VARTIME_P_ENTRIES][2];
+    int8_t naf_p[2][SB_FE_BITS + 1], naf_g[2][SB_FE_BITS + 1];
+    sb_fe_t k[2];
+    sb_word_t neg[2];
+
+    sb_sw_glv_split(k, neg, MULT_K(q), q, s);
+    sb_sw_glv_wnaf(naf_p[0], &k[0], neg[0], SB_SW_VARTIME_P_WINDOW);
+    sb_sw_glv_wnaf(naf_p[1], &k[1], neg[1], SB_SW_VARTIME_P_WINDOW);
+
+    sb_sw_glv_split(k, neg, MULT_ADD_KG(q), q, s);
+    sb_sw_glv_wnaf(naf_g[0], &k[0], neg[0], SB_SW_VARTIME_G_WINDOW);
+    sb_sw_glv_wnaf(naf_g[1], &k[1], neg[1], SB_SW_VARTIME_G_WINDOW);
+
+    sb_sw_point_odd_multiples(table, q, s);
+
+    sb_fe_mont_mult(C_T5(q), &s->glv->beta, &s->p->r2_mod_p,
+                    s->p); // t5 = beta * R
+    for (size_t j = 0; j < SB_SW_VARTIME_P_ENTRIES; j++) {
+        sb_fe_mont_mult(&table_phi[j][0], &table[j][0], C_T5(q), s->p);
+        table_phi[j][1] = table[j][1];
+    }
+
+    _Bool inf = 1;
+    for (size_t i = SB_SW_GLV_BITS; i <= SB_SW_GLV_BITS; i--) {
+        if (!inf) {
+            sb_sw_point_double(q, s); // 7MM + 10A
+        }
+
+        if (naf_p[0][i]) {
+            sb_sw_point_add_naf_vartime(&inf, naf_p[0][i], table, q, s);
+        }
+
+        if (naf_p[1][i]) {
+            sb_sw_point_add_naf_vartime(&inf, naf_p[1][i], table_phi, q, s);
+        }
+
+        if (naf_g[0][i]) {
+            sb_sw_point_add_naf_g_vartime(&inf, naf_g[0][i], s->g_odd, q, s);
+        }
+
+        if (naf_g[1][i]) {
+            sb_sw_point_add_naf_g_vartime(&inf, naf_g[1][i],
+                                          s->glv->lambda_g_odd, q, s);
+        }
+    }
+
+    return inf;
+}
+
+// Produces kp * P + kg * G in (x1, y1) with Z * R in t5, with the same
+// inputs and outputs as sb_sw_point_mult_add_z. If the result is the point at
+// infinity, (x1, y1) is (p, p). Neither the running time nor the memory access
+// pattern of this routine is constant.
+static void sb_sw_point_mult_add_vartime(sb_sw_context_t q[static const 1],
+                                         const sb_sw_curve_t s[static const 1])
+{
+    _Bool inf;
+
+    if (s->glv) {
+        inf = sb_sw_point_mult_add_glv_vartime(q, s);
+    } else {
+        inf = sb_sw_point_mult_add_wnaf_vartime(q, s);
+    }
+
+    if (inf) {
+        *C_X1(q) = s->p->p;
+        *C_Y1(q) = s->p->p;
+        *C_T5(q) = s->p->r_mod_p;
+        return;
+    }
+
+    *C_T6(q) = *C_X1(q);
+    sb_fe_mont_reduce(C_X1(q), C_T6(q), s->p);
+    *C_T6(q) = *C_Y1(q);
+    sb_fe_mont_reduce(C_Y1(q), C_T6(q), s->p);
+    *C_T5(q) = *C_Z1(q);
+}
+
+// Randomized batch verification (see sb_sw_verify_signature_batch_vartime)
+// checks that the sum of a * (m * s^-1 * G + r * s^-1 * Q - R) over the
+// signatures in a batch is the point at infinity, where a is a random
+// coefficient of SB_SW_VARTIME_BATCH_BITS bits chosen for each signature.
+// Since a is shorter than the other scalars, -R is multiplied using a
+// width-SB_SW_VARTIME_R_WINDOW NAF and a smaller table.
+
+#define SB_SW_VARTIME_BATCH_BITS 128
+#define SB_SW_VARTIME_BATCH_BYTES (SB_SW_VARTIME_BATCH_BITS / 8)
+#define SB_SW_VARTIME_R_WINDOW 4
+#define SB_SW_VARTIME_R_ENTRIES (1 << (SB_SW_VARTIME_R_WINDOW - 2))
+
+// Coefficients are generated 128 bytes at a time, which every configuration
+// of SB_HMAC_DRBG_MAX_BYTES_PER_REQUEST allows
+#define SB_SW_VARTIME_BATCH_PER_REQUEST (128 / SB_SW_VARTIME_BATCH_BYTES)
+
+// The terms of the batch equation for the signatures in a chunk. Tables hold
+// odd multiples as affine points multiplied by R.
+typedef struct sb_sw_batch_vartime_t {
+    sb_fe_t q[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_P_ENTRIES][2];
+    sb_fe_t r[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_R_ENTRIES][2]; // -R
+    int8_t naf_q[SB_SW_VARTIME_BATCH_CHUNK][SB_FE_BITS + 1]; // a * r * s^-1
+    int8_t naf_r[SB_SW_VARTIME_BATCH_CHUNK][SB_FE_BITS + 1]; // a
+    sb_fe_t k_g[SB_SW_VARTIME_BATCH_CHUNK]; // a * m * s^-1
+    size_t index[SB_SW_VARTIME_BATCH_CHUNK]; // the index of the signature
+} sb_sw_batch_vartime_t;
+
+// Returns whether the batch equation holds for entries [lo, hi) of the batch,
+// computing the sum with the same interleaved NAF method as
+// sb_sw_point_mult_add_vartime. The doublings are shared among all of the
+// entries, which is where most of the savings of batch verification are had.
+static _Bool sb_sw_batch_vartime_check(sb_sw_batch_vartime_t b[static const 1],
+                                       const size_t lo, const size_t hi,
+                                       sb_sw_context_t q[static const 1],
+                                       const sb_sw_curve_t s[static const 1])
+{
+    int8_t naf_g[SB_FE_BITS + 1];
+
+    *MULT_ADD_KG(q) = b->k_g[lo];
+    for (size_t k = lo + 1; k < hi; k++) {
+        sb_fe_mod_add(MULT_ADD_KG(q), MULT_ADD_KG(q), &b->k_g[k], s->n);
+    }
+    sb_sw_wnaf(naf_g, MULT_ADD_KG(q), SB_SW_VARTIME_G_WINDOW);
+
+    _Bool inf = 1;
+    for (size_t i = SB_FE_BITS; i <= SB_FE_BITS; i--) {
+        if (!inf) {
+            sb_sw_point_double(q, s);
+        }
+
+        for (size_t k = lo; k < hi; k++) {
+            if (b->naf_q[k][i]) {
+                sb_sw_point_add_naf_vartime(&inf, b->naf_q[k][i], b->q[k], q,
+                                            s);
+            }
+            if (b->naf_r[k][i]) {
+                sb_sw_point_add_naf_vartime(&inf, b->naf_r[k][i], b->r[k], q,
+                                            s);
+            }
+        }
+
+        if (naf_g[i]) {
+            sb_sw_point_add_naf_g_vartime(&inf, naf_g[i], s->g_odd, q, s);
+        }
+    }
+
+    return inf;
+}
+
+// Multi-scalar multiplication (see sb_sw_multi_mult_vartime) computes the sum
+// of k_i * P_i over many points. With few points, or without space for
+// buckets, it uses the interleaved NAF method of sb_sw_point_mult_add_vartime
+// (Straus's method) on chunks of up to SB_SW_VARTIME_BATCH_CHUNK points. With
+// many points, it uses Pippenger's bucket method: for each w-bit digit
+// position of the scalars, starting from the top, each point is added to the
+// bucket for its digit, and the buckets are summed, weighted by their digits,
+// into the total. Jacobian points held outside of the context are stored as
+// three coordinates multiplied by R, and a Z coordinate of zero (represented
+// as p) denotes the point at infinity.
+
+// Windows wider than this would need more buckets than are ever useful
+#define SB_SW_MULTI_MULT_MAX_WINDOW 16
+
+// Places the point P, which must be valid, into (x2, y2) multiplied by R
+static void sb_sw_multi_mult_point(sb_sw_context_t c[static const 1],
+                                   const sb_sw_public_t point[static const 1],
+                                   const sb_sw_curve_t s[static const 1],
+                                   const sb_data_endian_t e)
+{
+    sb_fe_from_bytes(&MULT_POINT(c)[0], point->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(c)[1], point->bytes + SB_ELEM_BYTES, e);
+    sb_fe_mont_mult(C_X2(c), &MULT_POINT(c)[0], &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(C_Y2(c), &MULT_POINT(c)[1], &s->p->r2_mod_p, s->p);
+}
+
+// dst = dst + src for Jacobian points held outside of the context
+// Uses: x1, y1, x2, y2, t5, t6, t7, t8, z1, z2
+static void sb_sw_multi_mult_add(sb_fe_t dst[static const 3],
+                                 const sb_fe_t src[static const 3],
+                                 sb_sw_context_t c[static const 1],
+                                 const sb_sw_curve_t s[static const 1])
+{
+    *C_X1(c) = dst[0];
+    *C_Y1(c) = dst[1];
+    *C_Z1(c) = dst[2];
+    *C_X2(c) = src[0];
+    *C_Y2(c) = src[1];
+    *C_Z2(c) = src[2];
+    sb_sw_point_add_jacobian_vartime(c, s);
+    dst[0] = *C_X1(c);
+    dst[1] = *C_Y1(c);
+    dst[2] = *C_Z1(c);
+}
+
+// Returns the window for Pippenger's method with count points and up to the
+// given number of buckets, or 0 if Straus's method is expected to be faster.
+// Costs are estimated in field multiplications. Straus's method takes about
+// 43 mixed additions (11MM) per point with a width-5 NAF and about 150MM for
+// the point's table and its share of the inversion, and shares about 256
+// doublings (8MM) among each chunk. With a window of w bits, Pippenger's
+// method takes one mixed addition per point and two Jacobian additions
+// (16MM) per bucket for each of the (SB_FE_BITS + w) / w digit positions,
+// and w doublings between them.
+static size_t sb_sw_multi_mult_window(const size_t count, const size_t buckets)
+{
+    const uint64_t chunks = (count + SB_SW_VARTIME_BATCH_CHUNK - 1) /
+                            SB_SW_VARTIME_BATCH_CHUNK;
+    uint64_t best = (uint64_t) count * (43 * 11 + 150) +
+                    chunks * SB_FE_BITS * 8;
+    size_t window = 0;
+
+    for (size_t w = 2; w <= SB_SW_MULTI_MULT_MAX_WINDOW &&
+                       ((size_t) 1 << (w - 1)) <= buckets; w++) {
+        const uint64_t digits = (SB_FE_BITS + w) / w;
+        const uint64_t cost =
+            digits * ((uint64_t) count * 11 + ((uint64_t) 1 << (w - 1)) * 32 +
+                      w * 8);
+        if (cost < best) {
+            best = cost;
+            window = w;
+        }
+    }
+
+    return window;
+}
+
+// Computes sum = sum of k_i * P_i with Straus's method. The points must be
+// valid.
+// Uses: the entire context
+static void
+sb_sw_multi_mult_straus(sb_fe_t sum[static const 3],
+                        const sb_sw_scalar_t scalars[static const 1],
+                        const sb_sw_public_t points[static const 1],
+                        const size_t count,
+                        sb_sw_context_t c[static const 1],
+                        const sb_sw_curve_t s[static const 1],
+                        const sb_data_endian_t e)
+{
+    sb_fe_t table[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_P_ENTRIES][2];
+    sb_fe_t ratio[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_P_ENTRIES];
+    sb_fe_t z[SB_SW_VARTIME_BATCH_CHUNK], inv[SB_SW_VARTIME_BATCH_CHUNK];
+    int8_t naf[SB_SW_VARTIME_BATCH_CHUNK][SB_FE_BITS + 1];
+
+    sum[0] = s->p->p;
+    sum[1] = s->p->p;
+    sum[2] = s->p->p;
+
+    for (size_t base = 0; base < count; base += SB_SW_VARTIME_BATCH_CHUNK) {
+        const size_t n = (count - base < SB_SW_VARTIME_BATCH_CHUNK ?
+                          count - base : SB_SW_VARTIME_BATCH_CHUNK);
+
+        // The tables of odd multiples for the chunk are converted to affine
+        // coordinates with a single inversion
+        for (size_t k = 0; k < n; k++) {
+            sb_fe_from_bytes(MULT_K(c), scalars[base + k].bytes, e);
+            sb_sw_wnaf(naf[k], MULT_K(c), SB_SW_VARTIME_P_WINDOW);
+
+            sb_sw_multi_mult_point(c, &points[base + k], s, e);
+            sb_sw_point_odd_multiples_z(table[k], ratio[k],
+                                        SB_SW_VARTIME_P_ENTRIES, c, s);
+            z[k] = *C_Z1(c);
+        }
+
+        sb_fe_batch_inv_r(inv, z, n, C_T5(c), s->p);
+
+        for (size_t k = 0; k < n; k++) {
+            *C_T5(c) = inv[k];
+            sb_sw_point_odd_multiples_affine(table[k], ratio[k],
+                                             SB_SW_VARTIME_P_ENTRIES, c, s);
+        }
+
+        _Bool inf = 1;
+        for (size_t i = SB_FE_BITS; i <= SB_FE_BITS; i--) {
+            if (!inf) {
+                sb_sw_point_double(c, s);
+            }
+
+            for (size_t k = 0; k < n; k++) {
+                if (naf[k][i]) {
+                    sb_sw_point_add_naf_vartime(&inf, naf[k][i], table[k], c,
+                                                s);
+                }
+            }
+        }
+
+        if (inf) {
+            *C_Z1(c) = s->p->p;
+        }
+
+        *C_X2(c) = sum[0];
+        *C_Y2(c) = sum[1];
+        *C_Z2(c) = sum[2];
+        sb_sw_point_add_jacobian_vartime(c, s);
+        sum[0] = *C_X1(c);
+        sum[1] = *C_Y1(c);
+        sum[2] = *C_Z1(c);
+    }
+}
+
+// Returns digit j of the signed width-w recoding of k used by Pippenger's
+// method, which is in [-2^(w - 1), 2^(w - 1)]: the w bits of k starting at
+// bit j * w, plus the bit below them, less 2^w if the highest of the w bits
+// is set. The digits, weighted by 2^(j * w), sum to k so long as the highest
+// bit of the highest digit position is clear.
+static int32_t sb_sw_multi_mult_digit(const sb_fe_t k[static const 1],
+                                      const size_t j, const size_t w)
+{
+    const size_t lo = j * w;
+    int32_t digit = 0;
+
+    for (size_t i = 0; i < w && lo + i < SB_FE_BITS; i++) {
+        digit += (int32_t) sb_fe_test_bit(k, lo + i) << i;
+    }
+
+    if (lo > 0) {
+        digit += (int32_t) sb_fe_test_bit(k, lo - 1);
+    }
+
+    if (lo + w - 1 < SB_FE_BITS && sb_fe_test_bit(k, lo + w - 1)) {
+        digit -= (int32_t) 1 << w;
+    }
+
+    return digit;
+}
+
+// Computes sum = sum of k_i * P_i with Pippenger's method, using a window of
+// w bits and 2^(w - 1) buckets. The points must be valid.
+// Uses: the entire context
+static void
+sb_sw_multi_mult_pippenger(sb_fe_t sum[static const 3],
+                           const sb_sw_scalar_t scalars[static const 1],
+                           const sb_sw_public_t points[static const 1],
+                           const size_t count,
+                           sb_sw_multi_mult_bucket_t buckets[static const 1],
+                           const size_t w,
+                           sb_sw_context_t c[static const 1],
+                           const sb_sw_curve_t s[static const 1],
+                           const sb_data_endian_t e)
+{
+    const size_t digits = (SB_FE_BITS + w) / w;
+    const size_t entries = (size_t) 1 << (w - 1);
+    sb_fe_t running[3], total[3];
+
+    sum[0] = s->p->p;
+    sum[1] = s->p->p;
+    sum[2] = s->p->p;
+
+    for (size_t j = digits - 1; j < digits; j--) {
+        // sum = 2^w * sum
+        if (!sb_fe_equal(&sum[2], &s->p->p)) {
+            *C_X1(c) = sum[0];
+            *C_Y1(c) = sum[1];
+            *C_Z1(c) = sum[2];
+            for (size_t i = 0; i < w; i++) {
+                sb_sw_point_double(c, s);
+            }
+            sum[0] = *C_X1(c);
+            sum[1] = *C_Y1(c);
+            sum[2] = *C_Z1(c);
+        }
+
+        for (size_t b = 0; b < entries; b++) {
+            buckets[b].p[0] = s->p->p;
+            buckets[b].p[1] = s->p->p;
+            buckets[b].p[2] = s->p->p;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            sb_fe_from_bytes(MULT_K(c), scalars[i].bytes, e);
+            const int32_t d = sb_sw_multi_mult_digit(MULT_K(c), j, w);
+            if (!d) {
+                continue;
+            }
+
+            sb_sw_multi_mult_point(c, &points[i], s, e);
+            if (d < 0) {
+                sb_fe_mod_sub(C_Y2(c), &s->p->p, C_Y2(c), s->p);
+            }
+
+            sb_fe_t* const bucket = buckets[(d < 0 ? -d : d) - 1].p;
+            _Bool inf = sb_fe_equal(&bucket[2], &s->p->p);
+            *C_X1(c) = bucket[0];
+            *C_Y1(c) = bucket[1];
+            *C_Z1(c) = bucket[2];
+            sb_sw_point_add_vartime(&inf, c, s);
+            bucket[0] = *C_X1(c);
+            bucket[1] = *C_Y1(c);
+            bucket[2] = (inf ? s->p->p : *C_Z1(c));
+        }
+
+        // total = sum of (b + 1) * bucket b, as the sum over b of the sum of
+        // the buckets from b up
+        for (size_t i = 0; i < 3; i++) {
+            running[i] = s->p->p;
+            total[i] = s->p->p;
+        }
+        for (size_t b = entries - 1; b < entries; b--) {
+            sb_sw_multi_mult_add(running, buckets[b].p, c, s);
+            sb_sw_multi_mult_add(total, running, c, s);
+        }
+
+        sb_sw_multi_mult_add(sum, total, c, s);
+    }
+}
+
+#endif
+
+#ifdef SB_TEST
+
+// Test that the output of multiplication-addition, (x1, y1) with Z * R in t5,
+// is the given affine point
+static _Bool test_sw_point_mult_add_result(sb_sw_context_t q[static const 1],
+                                           const sb_fe_t p[static const 2],
+                                           const sb_sw_curve_t s[static const 1])
+{
+    // put p in co-Z with the result
+    sb_fe_mont_square(C_T6(q), C_T5(q), s->p); // t6 = Z^2 * R
+    sb_fe_mont_mult(C_T7(q), C_T6(q), C_T5(q), s->p); // t7 = Z^3 * R
+
+    sb_fe_mont_mult(C_X2(q), C_T6(q), &p[0], s->p); // x2 = x * Z^2
+    sb_fe_mont_mult(C_Y2(q), C_T7(q), &p[1], s->p); // y2 = y * Z^3
+    SB_TEST_ASSERT(
+        sb_fe_equal(C_X1(q), C_X2(q)) && sb_fe_equal(C_Y1(q), C_Y2(q)));
+    return 1;
+}
+
+// Test that A * (B * G) + C * G = (A * B + C) * G
+static _Bool test_sw_point_mult_add(const sb_fe_t* const ka,
+                                    const sb_fe_t* const kb,
+                                    const sb_fe_t* const kc,
+                                    const sb_sw_curve_t* const s)
+{
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+
+    sb_fe_t kabc;
+
+    sb_fe_mont_mult(C_T5(&m), ka, kb, s->n);
+    sb_fe_mont_mult(&kabc, C_T5(&m), &s->n->r2_mod_p, s->n);
+    sb_fe_mod_add(&kabc, &kabc, kc, s->n);
+
+    *MULT_Z(&m) = SB_FE_ONE;
+
+    *MULT_K(&m) = *kb;
+    sb_sw_point_mult(&m, s->g_r, s);
+
+    sb_fe_t pb[] = { *C_X1(&m), *C_Y1(&m) };
+
+    *MULT_K(&m) = kabc;
+    sb_sw_point_mult(&m, s->g_r, s);
+
+    sb_fe_t pabc[] = { *C_X1(&m), *C_Y1(&m) };
+
+    sb_sw_context_t q;
+    memset(&q, 0, sizeof(q));
+    *MULT_Z(&q) = SB_FE_ONE;
+
+    MULT_POINT(&q)[0] = pb[0];
+    MULT_POINT(&q)[1] = pb[1];
+    *MULT_K(&q) = *ka;
+    *MULT_ADD_KG(&q) = *kc;
+
+    // A * (B * G) + C * G = (A * B + C) * G
+    sb_sw_point_mult_add_z(&q, s);
+    SB_TEST_ASSERT(test_sw_point_mult_add_result(&q, pabc, s));
+
+#if SB_SW_VARTIME_SUPPORT
+    memset(&q, 0, sizeof(q));
+    MULT_POINT(&q)[0] = pb[0];
+    MULT_POINT(&q)[1] = pb[1];
+    *MULT_K(&q) = *ka;
+    *MULT_ADD_KG(&q) = *kc;
+
+    sb_sw_point_mult_add_vartime(&q, s);
+    SB_TEST_ASSERT(test_sw_point_mult_add_result(&q, pabc, s));
+#endif
+    return 1;
+}
+
+static _Bool generate_fe(sb_fe_t* const fe, sb_hmac_drbg_state_t* const drbg)
+{
+    sb_single_t s;
+    SB_TEST_ASSERT_SUCCESS(sb_hmac_drbg_generate(drbg, s.bytes, SB_ELEM_BYTES));
+    sb_fe_from_bytes(fe, s.bytes, SB_DATA_ENDIAN_BIG);
+    return 1;
+}
+
+_Bool sb_test_sw_point_mult_add(void)
+{
+    sb_fe_t ka = SB_FE_CONST(0, 0, 0, 3);
+    sb_fe_t kb = SB_FE_CONST(0, 0, 0, 4);
+    sb_fe_t kc = SB_FE_CONST(0, 0, 0, 6);
+    SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_P256));
+    SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_SECP256K1));
+    return 1;
+}
+
+_Bool sb_test_sw_point_mult_add_rand(void)
+{
+    sb_fe_t ka, kb, kc;
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    for (size_t i = 0; i < 64; i++) {
+        SB_TEST_ASSERT(generate_fe(&ka, &drbg));
+        SB_TEST_ASSERT(generate_fe(&kb, &drbg));
+        SB_TEST_ASSERT(generate_fe(&kc, &drbg));
+        SB_TEST_ASSERT(test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_P256));
+        SB_TEST_ASSERT(
+            test_sw_point_mult_add(&ka, &kb, &kc, &SB_CURVE_SECP256K1));
+        drbg.reseed_counter = 1;
+    }
+    return 1;
+}
+
+// Test the exceptional cases of variable-time multiplication-addition with
+// P = G: A * G + A * G = 2 * A * G, where the running total and the added
+// point are equal, and A * G + (-A) * G = O, where they are negations.
+_Bool sb_test_sw_point_mult_add_vartime(void)
+{
+#if SB_SW_VARTIME_SUPPORT
+    static const sb_sw_curve_t* const curves[] = {
+        &SB_CURVE_P256, &SB_CURVE_SECP256K1
+    };
+
+    sb_fe_t k;
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); c++) {
+        const sb_sw_curve_t* const s = curves[c];
+
+        for (size_t i = 0; i < 8; i++) {
+            if (i == 0) {
+                k = (sb_fe_t) SB_FE_CONST(0, 0, 0, 3);
+            } else {
+                SB_TEST_ASSERT(generate_fe(&k, &drbg));
+                drbg.reseed_counter = 1;
+            }
+
+            sb_sw_context_t m;
+            memset(&m, 0, sizeof(m));
+            *MULT_Z(&m) = SB_FE_ONE;
+
+            // 2 * k * G
+            sb_fe_mod_add(MULT_K(&m), &k, &k, s->n);
+            sb_sw_point_mult(&m, s->g_r, s);
+            const sb_fe_t p2k[] = { *C_X1(&m), *C_Y1(&m) };
+
+            sb_sw_context_t q;
+            memset(&q, 0, sizeof(q));
+            sb_fe_mont_mult(&MULT_POINT(&q)[0], &s->g_r[0], &SB_FE_ONE, s->p);
+            sb_fe_mont_mult(&MULT_POINT(&q)[1], &s->g_r[1], &SB_FE_ONE, s->p);
+            *MULT_K(&q) = k;
+            *MULT_ADD_KG(&q) = k;
+            sb_sw_point_mult_add_vartime(&q, s);
+            SB_TEST_ASSERT(test_sw_point_mult_add_result(&q, p2k, s));
+
+            memset(&q, 0, sizeof(q));
+            sb_fe_mont_mult(&MULT_POINT(&q)[0], &s->g_r[0], &SB_FE_ONE, s->p);
+            sb_fe_mont_mult(&MULT_POINT(&q)[1], &s->g_r[1], &SB_FE_ONE, s->p);
+            *MULT_K(&q) = k;
+            sb_fe_sub(MULT_ADD_KG(&q), &s->n->p, &k);
+            sb_sw_point_mult_add_vartime(&q, s);
+            SB_TEST_ASSERT(sb_fe_equal(C_X1(&q), &s->p->p) &&
+                           sb_fe_equal(C_Y1(&q), &s->p->p));
+        }
+    }
+#endif
+    return 1;
+}
+
+#if SB_SW_VARTIME_SUPPORT
+
+// Test that kp * H + kg * G computed with the endomorphism matches the
+// regular interleaved NAF method
+static _Bool test_sw_point_mult_add_glv_vartime(const sb_fe_t* const kp,
+                                                const sb_fe_t* const kg,
+                                                const sb_sw_curve_t* const s)
+{
+    sb_sw_context_t a, b;
+    memset(&a, 0, sizeof(a));
+    sb_fe_mont_mult(&MULT_POINT(&a)[0], &s->h_r[0], &SB_FE_ONE, s->p);
+    sb_fe_mont_mult(&MULT_POINT(&a)[1], &s->h_r[1], &SB_FE_ONE, s->p);
+    *MULT_K(&a) = *kp;
+    *MULT_ADD_KG(&a) = *kg;
+    b = a;
+
+    const _Bool inf = sb_sw_point_mult_add_glv_vartime(&a, s);
+    SB_TEST_ASSERT(inf == sb_sw_point_mult_add_wnaf_vartime(&b, s));
+    if (inf) {
+        return 1;
+    }
+
+    // Compare x * Z'^2 and y * Z'^3, where Z' is the other result's Z
+    sb_fe_mont_square(C_T5(&a), C_Z1(&b), s->p);
+    sb_fe_mont_mult(C_T6(&a), C_T5(&a), C_Z1(&b), s->p);
+    sb_fe_mont_mult(C_T7(&a), C_X1(&a), C_T5(&a), s->p);
+    sb_fe_mont_mult(C_T8(&a), C_Y1(&a), C_T6(&a), s->p);
+
+    sb_fe_mont_square(C_T5(&b), C_Z1(&a), s->p);
+    sb_fe_mont_mult(C_T6(&b), C_T5(&b), C_Z1(&a), s->p);
+    sb_fe_mont_mult(C_T7(&b), C_X1(&b), C_T5(&b), s->p);
+    sb_fe_mont_mult(C_T8(&b), C_Y1(&b), C_T6(&b), s->p);
+
+    SB_TEST_ASSERT(sb_fe_equal(C_T7(&a), C_T7(&b)) &&
+                   sb_fe_equal(C_T8(&a), C_T8(&b)));
+    return 1;
+}
+
+#endif
+
+_Bool sb_test_sw_point_mult_add_glv_vartime(void)
+{
+#if SB_SW_VARTIME_SUPPORT
+    const sb_sw_curve_t* const s = &SB_CURVE_SECP256K1;
+    sb_fe_t kp, kg;
+
+    kp = (sb_fe_t) SB_FE_CONST(0, 0, 0, 3);
+    kg = (sb_fe_t) SB_FE_CONST(0, 0, 0, 4);
+    SB_TEST_ASSERT(test_sw_point_mult_add_glv_vartime(&kp, &kg, s));
+
+    // Scalars of zero (represented as N), lambda, and -1
+    SB_TEST_ASSERT(
+        test_sw_point_mult_add_glv_vartime(&s->glv->lambda, &s->n->p, s));
+    SB_TEST_ASSERT(
+        test_sw_point_mult_add_glv_vartime(&s->n->p, &s->glv->lambda, s));
+    sb_fe_sub(&kp, &s->n->p, &SB_FE_ONE);
+    SB_TEST_ASSERT(test_sw_point_mult_add_glv_vartime(&kp, &SB_FE_ONE, s));
+    SB_TEST_ASSERT(test_sw_point_mult_add_glv_vartime(&s->n->p, &s->n->p, s));
+
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+    for (size_t i = 0; i < 16; i++) {
+        SB_TEST_ASSERT(generate_fe(&kp, &drbg));
+        SB_TEST_ASSERT(generate_fe(&kg, &drbg));
+        drbg.reseed_counter = 1;
+        SB_TEST_ASSERT(test_sw_point_mult_add_glv_vartime(&kp, &kg, s));
+    }
+#endif
+    return 1;
+}
+
+// Test that the fixed-base multiplication of G matches the Montgomery ladder
+static _Bool test_sw_point_mult_base(const sb_fe_t* const k,
+                                     const sb_fe_t* const z,
+                                     const sb_sw_curve_t* const s)
+{
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+
+    *MULT_K(&m) = *k;
+    *MULT_Z(&m) = *z;
+    sb_sw_point_mult_base(&m, s);
+    SB_TEST_ASSERT(sb_fe_equal(MULT_K(&m), k));
+
+    const sb_fe_t pk[] = { *C_X1(&m), *C_Y1(&m) };
+
+    sb_sw_point_mult(&m, s->g_r, s);
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &pk[0]) &&
+                   sb_fe_equal(C_Y1(&m), &pk[1]));
+    return 1;
+}
+
+_Bool sb_test_sw_point_mult_base(void)
+{
+    static const sb_sw_curve_t* const curves[] = {
+        &SB_CURVE_P256, &SB_CURVE_SECP256K1
+    };
+
+    sb_fe_t k, z;
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); c++) {
+        const sb_sw_curve_t* const s = curves[c];
+
+        // The smallest and largest valid scalars, both odd and even:
+        // 2 through 5 and -3 through -6
+        for (sb_word_t i = 2; i <= 5; i++) {
+            k = SB_FE_ZERO;
+            SB_FE_WORD(&k, 0) = i;
+            SB_TEST_ASSERT(test_sw_point_mult_base(&k, &SB_FE_ONE, s));
+            sb_fe_sub(&k, &s->n->p, &k);
+            sb_fe_sub(&k, &k, &SB_FE_ONE);
+            SB_TEST_ASSERT(test_sw_point_mult_base(&k, &SB_FE_ONE, s));
+        }
+
+        for (size_t i = 0; i < 16; i++) {
+            SB_TEST_ASSERT(generate_fe(&k, &drbg));
+            SB_TEST_ASSERT(generate_fe(&z, &drbg));
+            SB_TEST_ASSERT(test_sw_point_mult_base(&k, &z, s));
+            drbg.reseed_counter = 1;
+        }
+    }
+
+#if SB_SW_FIXED_BASE_WINDOW
+    // This scalar causes an exceptional addition in the last column of the
+    // comb on secp256k1, which the complete formulas must handle.
+#if SB_SW_FIXED_BASE_WINDOW == 4
+    k = (sb_fe_t) SB_FE_CONST(0xFFFFFFFFFFFFFFFD, 0xFFFFFFFFFFFFFFFC,
+                              0xBAAEDCE6AF48A039, 0xBFD25E8CD0364143);
+#elif SB_SW_FIXED_BASE_WINDOW == 5
+    k = (sb_fe_t) SB_FE_CONST(0xFFFFFFFFFFFDFFFF, 0xFFFFFFFFDFFFFFFE,
+                              0xBAAEDEE6AF48A03B, 0xBFF25E8CD0364143);
+#else
+    k = (sb_fe_t) SB_FE_CONST(0xFFFFFFFFFEFFFFFF, 0xFFFFDFFFFFFFFFFA,
+                              0xBAAEDCE6AFC8A03B, 0xBFD24E8CD0364143);
+#endif
+    SB_TEST_ASSERT(test_sw_point_mult_base(&k, &SB_FE_ONE,
+                                           &SB_CURVE_SECP256K1));
+#endif
+    return 1;
+}
+
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+
+// Test that the projective point (x1, y1, z1) is the projective point p, by
+// comparing X * Z_p to X_p * Z and Y * Z_p to Y_p * Z
+static _Bool test_sw_point_complete_equal(sb_sw_context_t c[static const 1],
+                                          const sb_fe_t p[static const 3],
+                                          const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_mult(C_T5(c), C_X1(c), &p[2], s->p);
+    sb_fe_mont_mult(C_T6(c), &p[0], C_Z1(c), s->p);
+    sb_fe_mont_mult(C_T7(c), C_Y1(c), &p[2], s->p);
+    sb_fe_mont_mult(C_T8(c), &p[1], C_Z1(c), s->p);
+    SB_TEST_ASSERT(sb_fe_equal(C_T5(c), C_T6(c)) &&
+                   sb_fe_equal(C_T7(c), C_T8(c)));
+    return 1;
+}
+
+// Places the affine point (x, y), multiplied by R, into (x1, y1, z1) as a
+// projective point with Z = z
+static void test_sw_point_complete_set(sb_sw_context_t c[static const 1],
+                                       const sb_fe_t point[static const 2],
+                                       const sb_fe_t z[static const 1],
+                                       const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_mult(C_X1(c), &point[0], z, s->p);
+    sb_fe_mont_mult(C_Y1(c), &point[1], z, s->p);
+    *C_Z1(c) = *z;
+}
+
+#endif
+
+// Test the complete formulas against Jacobian arithmetic, including the cases
+// that are exceptional for the latter
+_Bool sb_test_sw_point_complete(void)
+{
+#if SB_SW_FIXED_BASE_WINDOW || SB_SW_GLV_WINDOW || \
+    SB_SW_VARIABLE_BASE_WINDOW
+    static const sb_sw_curve_t* const curves[] = {
+        &SB_CURVE_P256, &SB_CURVE_SECP256K1
+    };
+
+    sb_sw_context_t c;
+    memset(&c, 0, sizeof(c));
+
+    sb_fe_t z, expected[3];
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    for (size_t i = 0; i < sizeof(curves) / sizeof(curves[0]); i++) {
+        const sb_sw_curve_t* const s = curves[i];
+
+        // A random Z, multiplied by R
+        SB_TEST_ASSERT(generate_fe(&z, &drbg));
+        sb_fe_mod_add(&z, &z, &s->p->p, s->p);
+        drbg.reseed_counter = 1;
+
+        // 2 * G, from the Montgomery ladder
+        *MULT_K(&c) = (sb_fe_t) SB_FE_CONST(0, 0, 0, 2);
+        *MULT_Z(&c) = SB_FE_ONE;
+        sb_sw_point_mult(&c, s->g_r, s);
+        sb_fe_mont_mult(&expected[0], C_X1(&c), &s->p->r2_mod_p, s->p);
+        sb_fe_mont_mult(&expected[1], C_Y1(&c), &s->p->r2_mod_p, s->p);
+        expected[2] = s->p->r_mod_p;
+
+        test_sw_point_complete_set(&c, s->g_r, &z, s);
+        sb_sw_point_double_complete(&c, s);
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // G + G, which is exceptional for mixed addition
+        test_sw_point_complete_set(&c, s->g_r, &z, s);
+        *C_X2(&c) = s->g_r[0];
+        *C_Y2(&c) = s->g_r[1];
+        sb_sw_point_mixed_add_complete(&c, s);
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // H + G
+        test_sw_point_complete_set(&c, s->h_r, &z, s);
+        sb_sw_point_mixed_add_complete(&c, s);
+        expected[0] = s->g_h_r[0];
+        expected[1] = s->g_h_r[1];
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // G + -G is the point at infinity, which doubles to itself
+        test_sw_point_complete_set(&c, s->g_r, &z, s);
+        sb_fe_mod_sub(C_Y2(&c), &s->p->p, &s->g_r[1], s->p);
+        sb_sw_point_mixed_add_complete(&c, s);
+        SB_TEST_ASSERT(sb_fe_equal(C_Z1(&c), &s->p->p));
+        SB_TEST_ASSERT(!sb_fe_equal(C_Y1(&c), &s->p->p));
+        sb_sw_point_double_complete(&c, s);
+        SB_TEST_ASSERT(sb_fe_equal(C_Z1(&c), &s->p->p));
+        SB_TEST_ASSERT(!sb_fe_equal(C_Y1(&c), &s->p->p));
+
+        // The point at infinity plus G is G
+        *C_Y2(&c) = s->g_r[1];
+        sb_sw_point_mixed_add_complete(&c, s);
+        expected[0] = s->g_r[0];
+        expected[1] = s->g_r[1];
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // 2 * (2 * H) + G, computed with the complete formulas after a
+        // conversion from Jacobian coordinates and with Jacobian arithmetic
+        *C_X1(&c) = s->h_r[0];
+        *C_Y1(&c) = s->h_r[1];
+        *C_Z1(&c) = s->p->r_mod_p;
+        sb_sw_point_double(&c, s);
+        sb_sw_point_double(&c, s);
+        sb_sw_point_mixed_add_h_r(&c, s);
+        sb_sw_point_mixed_add_finish(&c, s);
+        sb_sw_point_jacobian_to_projective(&c, s);
+        expected[0] = *C_X1(&c);
+        expected[1] = *C_Y1(&c);
+        expected[2] = *C_Z1(&c);
+
+        *C_X1(&c) = s->h_r[0];
+        *C_Y1(&c) = s->h_r[1];
+        *C_Z1(&c) = s->p->r_mod_p;
+        sb_sw_point_double(&c, s);
+        sb_sw_point_jacobian_to_projective(&c, s);
+        sb_sw_point_double_complete(&c, s);
+        sb_sw_point_mixed_add_complete(&c, s);
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+#if SB_SW_VARIABLE_BASE_WINDOW
+        // G + -G, the point at infinity plus G, G + G, and H + G with full
+        // addition, where the added point has Z = z^2
+        sb_fe_mont_square(C_Z2(&c), &z, s->p);
+        sb_fe_mont_mult(C_X2(&c), &s->g_r[0], C_Z2(&c), s->p);
+        sb_fe_mont_mult(C_Y2(&c), &s->g_r[1], C_Z2(&c), s->p);
+        sb_fe_mod_sub(C_Y2(&c), &s->p->p, C_Y2(&c), s->p);
+        test_sw_point_complete_set(&c, s->g_r, &z, s);
+        sb_sw_point_add_complete(&c, s);
+        SB_TEST_ASSERT(sb_fe_equal(C_Z1(&c), &s->p->p));
+        SB_TEST_ASSERT(!sb_fe_equal(C_Y1(&c), &s->p->p));
+        sb_fe_mod_sub(C_Y2(&c), &s->p->p, C_Y2(&c), s->p);
+        sb_sw_point_add_complete(&c, s);
+        expected[0] = s->g_r[0];
+        expected[1] = s->g_r[1];
+        expected[2] = s->p->r_mod_p;
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // G + G
+        sb_sw_point_double_complete(&c, s);
+        expected[0] = *C_X1(&c);
+        expected[1] = *C_Y1(&c);
+        expected[2] = *C_Z1(&c);
+        test_sw_point_complete_set(&c, s->g_r, &z, s);
+        sb_sw_point_add_complete(&c, s);
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+
+        // H + G
+        test_sw_point_complete_set(&c, s->h_r, &z, s);
+        sb_sw_point_add_complete(&c, s);
+        expected[0] = s->g_h_r[0];
+        expected[1] = s->g_h_r[1];
+        expected[2] = s->p->r_mod_p;
+        SB_TEST_ASSERT(test_sw_point_complete_equal(&c, expected, s));
+#endif
+    }
+#endif
+    return 1;
+}
+
+#if SB_SW_GLV_WINDOW
+
+// Test that GLV multiplication of the given point on secp256k1 matches the
+// Montgomery ladder, and that the scalar is split into odd halves less than
+// 2^130
+static _Bool test_sw_point_mult_glv(const sb_fe_t* const k,
+                                    const sb_fe_t* const z,
+                                    const sb_fe_t point[static const 2])
+{
+    const sb_sw_curve_t* const s = &SB_CURVE_SECP256K1;
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+
+    sb_fe_t k_half[2];
+    sb_word_t neg[2];
+    sb_sw_glv_split(k_half, neg, k, &m, s);
+    for (size_t i = 0; i < 2; i++) {
+        SB_TEST_ASSERT(sb_fe_test_bit(&k_half[i], 0));
+        for (size_t b = SB_SW_GLV_BITS; b < SB_FE_BITS; b++) {
+            SB_TEST_ASSERT(!sb_fe_test_bit(&k_half[i], b));
+        }
+        if (neg[i]) {
+            sb_fe_sub(&k_half[i], &s->n->p, &k_half[i]);
+        }
+    }
+
+    // k = k1 + k2 * lambda
+    sb_fe_mont_mult(C_T5(&m), &s->glv->lambda, &s->n->r2_mod_p, s->n);
+    sb_fe_mont_mult(C_T6(&m), &k_half[1], C_T5(&m), s->n);
+    sb_fe_mod_add(C_T5(&m), &k_half[0], C_T6(&m), s->n);
+    SB_TEST_ASSERT(sb_fe_equal(C_T5(&m), k));
+
+    *MULT_K(&m) = *k;
+    *MULT_Z(&m) = *z;
+    sb_sw_point_mult(&m, point, s);
+    SB_TEST_ASSERT(sb_fe_equal(MULT_K(&m), k));
+
+    const sb_fe_t pk[] = { *C_X1(&m), *C_Y1(&m) };
+
+    sb_sw_point_mult_ladder(&m, point, s);
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &pk[0]) &&
+                   sb_fe_equal(C_Y1(&m), &pk[1]));
+    return 1;
+}
+
+#endif
+
+_Bool sb_test_sw_point_mult_glv(void)
+{
+#if SB_SW_GLV_WINDOW
+    const sb_sw_curve_t* const s = &SB_CURVE_SECP256K1;
+    const sb_sw_glv_t* const g = s->glv;
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+
+    // lambda * G = (beta * x, y)
+    *MULT_K(&m) = g->lambda;
+    *MULT_Z(&m) = SB_FE_ONE;
+    sb_sw_point_mult_ladder(&m, s->g_r, s);
+    sb_fe_mont_mult(C_T5(&m), &s->g_r[0], &g->beta, s->p);
+    sb_fe_mont_mult(C_T6(&m), &s->g_r[1], &SB_FE_ONE, s->p);
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), C_T5(&m)) &&
+                   sb_fe_equal(C_Y1(&m), C_T6(&m)));
+
+    // a + b * lambda = 0 for both lattice vectors
+    sb_fe_mont_mult(C_T5(&m), &g->lambda, &s->n->r2_mod_p, s->n);
+    sb_fe_mont_mult(C_T6(&m), &g->v1[1], C_T5(&m), s->n);
+    sb_fe_mod_add(C_T7(&m), &g->v1[0], C_T6(&m), s->n);
+    SB_TEST_ASSERT(sb_fe_equal(C_T7(&m), &s->n->p));
+    sb_fe_mont_mult(C_T6(&m), &g->v2[1], C_T5(&m), s->n);
+    sb_fe_mod_add(C_T7(&m), &g->v2[0], C_T6(&m), s->n);
+    SB_TEST_ASSERT(sb_fe_equal(C_T7(&m), &s->n->p));
+
+    sb_fe_t k, z;
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    // The smallest and largest valid scalars, both odd and even:
+    // 2 through 5 and -3 through -6
+    for (sb_word_t i = 2; i <= 5; i++) {
+        k = SB_FE_ZERO;
+        SB_FE_WORD(&k, 0) = i;
+        SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &SB_FE_ONE, s->g_r));
+        sb_fe_sub(&k, &s->n->p, &k);
+        sb_fe_sub(&k, &k, &SB_FE_ONE);
+        SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &SB_FE_ONE, s->h_r));
+    }
+
+    // lambda, -lambda, and lambda + 1, which split into halves of 0 and 1
+    // before the lattice vectors are added
+    SB_TEST_ASSERT(test_sw_point_mult_glv(&g->lambda, &SB_FE_ONE, s->g_r));
+    sb_fe_sub(&k, &s->n->p, &g->lambda);
+    SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &SB_FE_ONE, s->g_r));
+    sb_fe_add(&k, &g->lambda, &SB_FE_ONE);
+    SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &SB_FE_ONE, s->h_r));
+
+    for (size_t i = 0; i < 16; i++) {
+        SB_TEST_ASSERT(generate_fe(&k, &drbg));
+        SB_TEST_ASSERT(generate_fe(&z, &drbg));
+        SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &z,
+                                              (i & 1) ? s->h_r : s->g_r));
+        drbg.reseed_counter = 1;
+    }
+
+    // This scalar causes an exceptional addition of phi(G) in the last
+    // window, which the complete formulas must handle.
+#if SB_SW_GLV_WINDOW == 3
+    k = (sb_fe_t) SB_FE_CONST(0xBE1B3B007C661739, 0x8C82E7E6AF481476,
+                              0x34EE167578148036, 0x492F995A31739E90);
+#elif SB_SW_GLV_WINDOW == 4
+    k = (sb_fe_t) SB_FE_CONST(0x87E0663476A3092F, 0x3A2127BE2E21CECE,
+                              0xB7763854DC6939D3, 0x18220A5890470DB5);
+#elif SB_SW_GLV_WINDOW == 5
+    k = (sb_fe_t) SB_FE_CONST(0x1B6ABC9C6B1CED1A, 0x955DA76D2BD5437F,
+                              0xBC867C13A512AD0C, 0xB606EC554DEDEBFF);
+#else
+    k = (sb_fe_t) SB_FE_CONST(0xF4560FCC82292543, 0xDEE4A80F306E5A1D,
+                              0xB265F49613BFC699, 0x7A3D285BD2A02F6B);
+#endif
+    SB_TEST_ASSERT(test_sw_point_mult_glv(&k, &SB_FE_ONE, s->g_r));
+#endif
+    return 1;
+}
+
+#if SB_SW_VARIABLE_BASE_WINDOW
+
+// Test that windowed multiplication of the given point on P-256 matches the
+// Montgomery ladder
+static _Bool test_sw_point_mult_window(const sb_fe_t* const k,
+                                       const sb_fe_t* const z,
+                                       const sb_fe_t point[static const 2])
+{
+    const sb_sw_curve_t* const s = &SB_CURVE_P256;
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+
+    *MULT_K(&m) = *k;
+    *MULT_Z(&m) = *z;
+    sb_sw_point_mult_window(&m, point, s);
+    SB_TEST_ASSERT(sb_fe_equal(MULT_K(&m), k));
+    sb_sw_point_affine(&m, s);
+
+    const sb_fe_t pk[] = { *C_X1(&m), *C_Y1(&m) };
+
+    sb_sw_point_mult_ladder(&m, point, s);
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &pk[0]) &&
+                   sb_fe_equal(C_Y1(&m), &pk[1]));
+
+    sb_sw_point_mult(&m, point, s);
+    SB_TEST_ASSERT(sb_fe_equal(MULT_K(&m), k));
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &pk[0]) &&
+                   sb_fe_equal(C_Y1(&m), &pk[1]));
+    return 1;
+}
+
+#endif
+
+_Bool sb_test_sw_point_mult_window(void)
+{
+#if SB_SW_VARIABLE_BASE_WINDOW
+    const sb_sw_curve_t* const s = &SB_CURVE_P256;
+    sb_fe_t k, z;
+    sb_hmac_drbg_state_t drbg;
+    memset(&drbg, 0, sizeof(drbg));
+
+    // The smallest and largest valid scalars, both odd and even:
+    // 2 through 5 and -3 through -6
+    for (sb_word_t i = 2; i <= 5; i++) {
+        k = SB_FE_ZERO;
+        SB_FE_WORD(&k, 0) = i;
+        SB_TEST_ASSERT(test_sw_point_mult_window(&k, &SB_FE_ONE, s->g_r));
+        sb_fe_sub(&k, &s->n->p, &k);
+        sb_fe_sub(&k, &k, &SB_FE_ONE);
+        SB_TEST_ASSERT(test_sw_point_mult_window(&k, &SB_FE_ONE, s->h_r));
+    }
+
+    for (size_t i = 0; i < 16; i++) {
+        SB_TEST_ASSERT(generate_fe(&k, &drbg));
+        SB_TEST_ASSERT(generate_fe(&z, &drbg));
+        SB_TEST_ASSERT(test_sw_point_mult_window(&k, &z,
+                                                 (i & 1) ? s->h_r : s->g_r));
+        drbg.reseed_counter = 1;
+    }
+
+    // These scalars, 2 * |D_0| and N - 2 * |D_0|, cause an exceptional
+    // addition in the last window, which the complete formulas must handle.
+    // There are none for windows of 3 or 5 bits, and N - 2 is not a valid
+    // scalar.
+#if SB_SW_VARIABLE_BASE_WINDOW == 4 || SB_SW_VARIABLE_BASE_WINDOW == 6
+    k = SB_FE_ZERO;
+    SB_FE_WORD(&k, 0) = (SB_SW_VARIABLE_BASE_WINDOW == 4) ? 2 : 34;
+    SB_TEST_ASSERT(test_sw_point_mult_window(&k, &SB_FE_ONE, s->g_r));
+#if SB_SW_VARIABLE_BASE_WINDOW == 6
+    sb_fe_sub(&k, &s->n->p, &k);
+    SB_TEST_ASSERT(test_sw_point_mult_window(&k, &SB_FE_ONE, s->g_r));
+#endif
+#endif
+#endif
+    return 1;
+}
+
+#endif
+
+// Given a point context with x in *C_X1(c), computes
+// y^2 = x^3 + a * x + b in *C_Y1(c), leaving x quasi-reduced in t7
+// Uses: t5, t6, t7
+static void sb_sw_curve_y2(sb_sw_context_t c[static const 1],
+                           const sb_sw_curve_t s[static const 1])
+{
+    // Montgomery multiplication requires quasi-reduced input, so x = 0 (which
+    // is on P256) is represented as p
+    sb_fe_mod_add(C_T7(c), C_X1(c), &s->p->p, s->p); // t7 = x
+    sb_fe_mont_mult(C_T5(c), C_T7(c), &s->p->r2_mod_p, s->p); // t5 = x * R
+    sb_fe_mont_mult(C_T6(c), C_T5(c), C_T7(c), s->p); // t6 = x^2
+    sb_fe_mod_sub(C_T6(c), C_T6(c), &s->minus_a, s->p); // t6 = x^2 + a
+    sb_fe_mont_mult(C_Y1(c), C_T5(c), C_T6(c),
+                    s->p); // y1 = (x^2 + a) * x * R * R^-1 = x^3 + a * x
+    sb_fe_mod_add(C_Y1(c), C_Y1(c), &s->b, s->p); // y1 = y^2 = x^3 + a * x + b
+}
+
+// Note that this assumes reduced input, not quasi-reduced input!
+static _Bool
+sb_sw_point_valid(const sb_fe_t point[static const 2],
+                  sb_sw_context_t c[static const 1],
+                  const sb_sw_curve_t s[static const 1])
+{
+    // The point at infinity is not valid.
+    if (sb_fe_equal(&point[0], &SB_FE_ZERO) &&
+        sb_fe_equal(&point[1], &SB_FE_ZERO)) {
+        return 0;
+    }
+
+    // Unreduced points are not valid.
+    if (!(sb_fe_lt(&point[0], &s->p->p) &&
+          sb_fe_lt(&point[1], &s->p->p))) {
+        return 0;
+    }
+
+    // Verify y^2 = x^3 + ax + b
+    sb_fe_mont_square(C_T5(c), &point[1], s->p); // t5 = y^2 * R^-1
+    sb_fe_mont_mult(C_Y2(c), C_T5(c), &s->p->r2_mod_p, s->p); // y2 = y^2
+    *C_X1(c) = point[0];
+    sb_sw_curve_y2(c, s);
+
+    // clang HATES cast to _Bool
+    return sb_fe_equal(C_Y1(c), C_Y2(c)) != 0;
+}
+
+// A scalar is valid if it is reduced and ∉ {-2, -1, 0, 1} mod N
+// Valid scalars are not modified, but invalid scalars may be reduced
+static _Bool
+sb_sw_scalar_valid(sb_fe_t* const k, const sb_sw_curve_t s[static const 1])
+{
+    _Bool r = 1;
+
+    r &= sb_fe_lt(k, &s->n->p);
+    r &= !sb_fe_equal(k, &SB_FE_ONE); // 1
+    r &= !sb_fe_equal(k, &SB_FE_ZERO); // 0
+
+    sb_fe_sub(k, &s->n->p, k); // -k
+    r &= !sb_fe_equal(k, &SB_FE_ONE); // -1
+    sb_fe_mod_sub(k, k, &SB_FE_ONE, s->n); // (-k) - 1
+    r &= !sb_fe_equal(k, &SB_FE_ONE); // -2
+
+    sb_fe_mod_add(k, k, &SB_FE_ONE, s->n); // -k
+    sb_fe_sub(k, &s->n->p, k); // k
+
+    return r;
+}
+
+#ifdef SB_TEST
+
+static _Bool test_h(const sb_sw_curve_t* s)
+{
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+    *MULT_Z(&m) = SB_FE_ONE;
+    *MULT_K(&m) = (sb_fe_t) SB_FE_CONST(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
+                                        0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF);
+    sb_fe_sub(MULT_K(&m), MULT_K(&m), &s->n->p);
+    sb_fe_sub(MULT_K(&m), MULT_K(&m), &s->n->p);
+    const sb_fe_t h_inv = *MULT_K(&m);
+    sb_fe_mont_mult(C_T5(&m), MULT_K(&m), &s->n->r2_mod_p,
+                    s->n);
+    sb_fe_mod_inv_r(C_T5(&m), C_T6(&m), C_T7(&m), s->n);
+    sb_fe_mont_mult(MULT_K(&m), C_T5(&m), &SB_FE_ONE, s->n);
+    sb_sw_point_mult(&m, s->g_r, s);
+
+    sb_fe_mont_mult(&MULT_POINT(&m)[0], C_X1(&m), &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(&MULT_POINT(&m)[1], C_Y1(&m), &s->p->r2_mod_p, s->p);
+
+    SB_TEST_ASSERT(sb_fe_equal(&MULT_POINT(&m)[0], &s->h_r[0]));
+    SB_TEST_ASSERT(sb_fe_equal(&MULT_POINT(&m)[1], &s->h_r[1]));
+
+
+    *MULT_K(&m) = h_inv;
+    sb_sw_point_mult(&m, MULT_POINT(&m), s);
+    sb_fe_mont_mult(C_X2(&m), &s->g_r[0], &SB_FE_ONE, s->p);
+    sb_fe_mont_mult(C_Y2(&m), &s->g_r[1], &SB_FE_ONE, s->p);
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), C_X2(&m)));
+    SB_TEST_ASSERT(sb_fe_equal(C_Y1(&m), C_Y2(&m)));
+
+    return 1;
+}
+
+_Bool sb_test_sw_h(void)
+{
+    SB_TEST_ASSERT(test_h(&SB_CURVE_P256));
+    SB_TEST_ASSERT(test_h(&SB_CURVE_SECP256K1));
+
+    return 1;
+}
+
+// The following scalars cause exceptions in the ladder and are NOT valid.
+_Bool sb_test_exceptions(void)
+{
+    sb_sw_context_t m;
+    memset(&m, 0, sizeof(m));
+    *MULT_Z(&m) = SB_FE_ONE;
+
+    // Exceptions produce P, not zero, due to ZVA countermeasures
 #define EX_ZERO(c) ((c).p->p)
 
-#define TEST_EX() do { \
-    SB_TEST_ASSERT(!sb_sw_scalar_valid(MULT_K(&m), &SB_CURVE_P256)); \
-    sb_sw_point_mult(&m, SB_CURVE_P256.g_r, &SB_CURVE_P256); \
-    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &EX_ZERO(SB_CURVE_P256)) && \
-           sb_fe_equal(C_Y1(&m), &EX_ZERO(SB_CURVE_P256))); \
-} while (0)
+#define TEST_EX() do { \
+    SB_TEST_ASSERT(!sb_sw_scalar_valid(MULT_K(&m), &SB_CURVE_P256)); \
+    sb_sw_point_mult_ladder(&m, SB_CURVE_P256.g_r, &SB_CURVE_P256); \
+    SB_TEST_ASSERT(sb_fe_equal(C_X1(&m), &EX_ZERO(SB_CURVE_P256)) && \
+           sb_fe_equal(C_Y1(&m), &EX_ZERO(SB_CURVE_P256))); \
+} while (0)
+
+    // k = 1
+    *MULT_K(&m) = SB_FE_ONE;
+    TEST_EX();
+
+    // k = 0
+    *MULT_K(&m) = SB_CURVE_P256.n->p;
+    TEST_EX();
+
+    // k = -1
+    *MULT_K(&m) = SB_CURVE_P256.n->p;
+    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
+    TEST_EX();
+
+    // k = -2
+    *MULT_K(&m) = SB_CURVE_P256.n->p;
+    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
+    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
+    TEST_EX();
+    return 1;
+}
+
+#endif
+
+// Computes the message-independent part of a signature: places r into x2 and
+// k^-1 * R into t7. Returns whether r is nonzero.
+static _Bool
+sb_sw_sign_presign(sb_sw_context_t g[static const 1],
+                   const sb_sw_curve_t s[static const 1])
+{
+    _Bool res = 1;
+
+    sb_sw_point_mult_base(g, s);
+
+    // This is used to quasi-reduce x1 modulo the curve N:
+    *C_X2(g) = *C_X1(g);
+    sb_fe_qr(C_X2(g), 0, s->n);
+
+    res &= !sb_fe_equal(C_X2(g), &s->n->p);
+
+    sb_fe_mont_mult(C_T7(g), MULT_K(g), &s->n->r2_mod_p, s->n); // t7 = k * R
+    sb_fe_mod_inv_r(C_T7(g), C_T5(g), C_T6(g), s->n); // t7 = k^-1 * R
+
+    return res;
+}
+
+// Given r in x2, k^-1 * R in t7, and d_A * R in SIGN_PRIVATE, places s into
+// y2. Returns whether s is nonzero.
+static _Bool
+sb_sw_sign_finish(sb_sw_context_t g[static const 1],
+                  const sb_sw_curve_t s[static const 1])
+{
+    sb_fe_mont_mult(C_T5(g), C_X2(g), SIGN_PRIVATE(g), s->n); // t5 = r * d_A
+    sb_fe_mod_add(C_T5(g), C_T5(g), SIGN_MESSAGE(g), s->n); // t5 = z + r * d_A
+    sb_fe_mont_mult(C_Y2(g), C_T5(g), C_T7(g),
+                    s->n); // y2 = k^-1 * R * (z + r * d_A) * R^-1 mod N
+
+    // mont_mul produces quasi-reduced output
+    return !sb_fe_equal(C_Y2(g), &s->n->p);
+}
+
+// Given d_A * R in SIGN_PRIVATE, places (r, s) into (x2, y2)
+static _Bool
+sb_sw_sign(sb_sw_context_t g[static const 1],
+           const sb_sw_curve_t s[static const 1])
+{
+    _Bool res = 1;
+
+    res &= sb_sw_sign_presign(g, s);
+    res &= sb_sw_sign_finish(g, s);
+
+    return res;
+}
+
+// Computes the scalars k_G and k_P for signature verification. Returns
+// whether the signature components are valid scalars.
+static _Bool sb_sw_verify_scalars(sb_sw_context_t v[static const 1],
+                                  const sb_sw_curve_t s[static const 1])
+{
+    _Bool res = 1;
+
+    res &= sb_sw_scalar_valid(VERIFY_QR(v), s);
+    res &= sb_sw_scalar_valid(VERIFY_QS(v), s);
+
+    sb_fe_mont_mult(C_T5(v), VERIFY_QS(v), &s->n->r2_mod_p, s->n); // t5 = s * R
+    sb_fe_mod_inv_r(C_T5(v), C_T6(v), C_T7(v), s->n); // t5 = s^-1 * R
+
+    sb_fe_mont_mult(MULT_ADD_KG(v), VERIFY_MESSAGE(v), C_T5(v),
+                    s->n); // k_G = m * s^-1
+    sb_fe_mont_mult(MULT_K(v), VERIFY_QR(v), C_T5(v), s->n); // k_P = r * s^-1
+
+    return res;
+}
+
+// Given k_P * P + k_G * G in (x1, y1) with Z * R in t5, returns whether
+// its X coordinate matches the signature.
+static _Bool sb_sw_verify_point(sb_sw_context_t v[static const 1],
+                                const sb_sw_curve_t s[static const 1])
+{
+    _Bool res = 1;
+
+    // This happens when p is some multiple of g that occurs within
+    // the ladder, such that additions inadvertently produce a point
+    // doubling. When that occurs, the private scalar that generated p is
+    // also obvious, so this is bad news. Don't do this.
+    res &= !(sb_fe_equal(C_X1(v), &s->p->p) & sb_fe_equal(C_Y1(v), &s->p->p));
+
+    _Bool ver = 0;
+
+    // qr ==? x mod N, but we don't have x, just x * z^2
+    // Given that qr is reduced, if it is >= P - N, then it can be used directly
+    // if it is < P - N, then we need to try to see if the original value was
+    // qr or qr + N
+    // Try directly first:
+    sb_fe_mont_square(C_T6(v), C_T5(v), s->p); // t6 = Z^2 * R
+    sb_fe_mont_mult(C_T7(v), VERIFY_QR(v), C_T6(v), s->p);
+    ver |= sb_fe_equal(C_T7(v), C_X1(v));
+
+    // If that didn't work, and qr < P - N, then we need to compare
+    // (qr + N) * z^2 against x * z^2
+
+    // Note that this code is probably never used because this situation occurs
+    // with very low probability (<2^-128)
+
+    sb_fe_mod_add(C_T5(v), VERIFY_QR(v), &s->n->p, s->p);
+    sb_fe_mont_mult(C_T7(v), VERIFY_QR(v), C_T6(v), s->p);
+    sb_fe_sub(C_T5(v), &s->p->p, &s->n->p); // t5 = P - N
+    ver |= (sb_fe_lt(VERIFY_QR(v), C_T5(v)) &
+            sb_fe_equal(C_T7(v), C_X1(v)));
+
+    return res & ver;
+}
+
+// If vartime is set, the multiplication-addition is performed in variable
+// time; see sb_sw_verify_signature_vartime.
+static _Bool sb_sw_verify(sb_sw_context_t v[static const 1],
+                          const sb_sw_curve_t s[static const 1],
+                          const _Bool vartime)
+{
+    _Bool res = sb_sw_verify_scalars(v, s);
+
+#if SB_SW_VARTIME_SUPPORT
+    if (vartime) {
+        sb_sw_point_mult_add_vartime(v, s);
+    } else {
+        sb_sw_point_mult_add_z(v, s);
+    }
+#else
+    (void) vartime;
+    sb_sw_point_mult_add_z(v, s);
+#endif
+
+    res &= sb_sw_verify_point(v, s);
+    return res;
+}
+
+// Given a reduced x in x1, places the point (x, y) multiplied by R into
+// (x2, y2), where y is the square root of x^3 + a * x + b whose parity is
+// odd. Returns whether there is such a point, in constant time.
+// Uses: x1, y1, x2, y2, t5, t6, t7
+static sb_word_t sb_sw_point_lift(sb_sw_context_t c[static const 1],
+                                  const sb_word_t odd,
+                                  const sb_sw_curve_t s[static const 1])
+{
+    sb_sw_curve_y2(c, s); // y1 = y^2, t7 = x
+    sb_fe_mont_mult(C_X2(c), C_T7(c), &s->p->r2_mod_p, s->p); // x2 = x * R
+    sb_fe_mont_mult(C_Y2(c), C_Y1(c), &s->p->r2_mod_p, s->p); // y2 = y^2 * R
+    const sb_word_t square =
+        sb_fe_mod_sqrt_r(C_Y2(c), C_T5(c), C_T6(c), C_T7(c), s->p);
+
+    // If y does not have the given parity, -y does
+    sb_fe_mont_reduce(C_T5(c), C_Y2(c), s->p); // t5 = y
+    sb_fe_mod_sub(C_T6(c), &s->p->p, C_Y2(c), s->p); // t6 = -y * R
+    sb_fe_ctswap(sb_fe_test_bit(C_T5(c), 0) ^ odd, C_Y2(c), C_T6(c));
+
+    return square;
+}
+
+// Given r in VERIFY_QR, places R into (x2, y2) multiplied by R, where R is
+// the point identified by the recovery id: its X coordinate is r, or r + N if
+// bit 1 of the recovery id is set, and bit 0 is the parity of its Y
+// coordinate. Returns whether there is such a point.
+// Uses: x1, y1, x2, y2, t5, t6, t7
+static _Bool sb_sw_recover_point_r(sb_sw_context_t c[static const 1],
+                                   const sb_byte_t id,
+                                   const sb_sw_curve_t s[static const 1])
+{
+    if (id > 3) {
+        return 0;
+    }
+
+    *C_X1(c) = *VERIFY_QR(c);
+    if (id & 2) {
+        if (sb_fe_add(C_X1(c), C_X1(c), &s->n->p) ||
+            !sb_fe_lt(C_X1(c), &s->p->p)) {
+            return 0;
+        }
+    }
+
+    return sb_sw_point_lift(c, (sb_word_t) (id & 1), s) != 0;
+}
+
+static sb_error_t sb_sw_curve_from_id(const sb_sw_curve_t** const s,
+                                      sb_sw_curve_id_t const curve)
+{
+    switch (curve) {
+#if SB_SW_P256_SUPPORT
+        case SB_SW_CURVE_P256: {
+            *s = &SB_CURVE_P256;
+            return 0;
+        }
+#endif
+#if SB_SW_SECP256K1_SUPPORT
+        case SB_SW_CURVE_SECP256K1: {
+            *s = &SB_CURVE_SECP256K1;
+            return 0;
+        }
+#endif
+#ifdef SB_TEST
+        case SB_SW_CURVE_INVALID:
+            break;
+#endif
+    }
+    // Huh?
+    *s = NULL;
+    return SB_ERROR_CURVE_INVALID;
+}
+
+// a Z value is invalid if it is zero, since the only point with Z = 0 is the
+// point at infinity. Note that this is not expected to ever occur!
+static sb_error_t sb_sw_z_valid(const sb_fe_t z[static const 1],
+                                const sb_sw_curve_t s[static const 1])
+{
+    sb_error_t err = SB_SUCCESS;
+    err |= SB_ERROR_IF(DRBG_FAILURE, sb_fe_equal(z, &SB_FE_ZERO));
+    err |= SB_ERROR_IF(DRBG_FAILURE, sb_fe_equal(z, &s->p->p));
+    return err;
+}
+
+// Initial Z generation for Z blinding (Coron's third countermeasure)
+static sb_error_t sb_sw_generate_z(sb_sw_context_t c[static const 1],
+                                   sb_hmac_drbg_state_t* const drbg,
+                                   const sb_sw_curve_t s[static const 1],
+                                   const sb_byte_t* const d1, const size_t l1,
+                                   const sb_byte_t* const d2, const size_t l2,
+                                   const sb_byte_t* const d3, const size_t l3)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    if (drbg) {
+        // Use the supplied data as additional input to the DRBG
+        const sb_byte_t* const add[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
+            d1, d2, d3
+        };
+
+        const size_t add_len[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
+            l1, l2, l3
+        };
+
+        err |= sb_hmac_drbg_generate_additional_vec(drbg, c->buf, SB_ELEM_BYTES,
+                                                    add, add_len);
+    } else {
+        // Seed the HMAC-DRBG with the input supplied
+        err |= sb_hmac_drbg_init(&c->drbg_state,
+                                 d1, l1,
+                                 d2, l2,
+                                 d3, l3);
+
+        // It is a bug if this ever fails; the DRBG limits should allow these
+        // inputs.
+        SB_ASSERT(!err, "DRBG initialization should never fail.");
+
+        err |= sb_hmac_drbg_generate(&c->drbg_state, c->buf, SB_ELEM_BYTES);
+    }
+
+    // It is a bug if this ever fails; the DRBG reseed count should have
+    // been checked already, and the DRBG limits should allow these inputs.
+    SB_ASSERT(!err, "Z generation should never fail.");
+
+    sb_fe_from_bytes(MULT_Z(c), c->buf, SB_DATA_ENDIAN_BIG);
+    err |= sb_sw_z_valid(MULT_Z(c), s);
+    return err;
+}
+
+//// PUBLIC API:
+
+/// FIPS 186-4-style private key generation. Note that this only tests two
+/// candidates; the probability of both candidates failing is extremely low.
+sb_error_t sb_sw_generate_private_key(sb_sw_context_t ctx[static const 1],
+                                      sb_sw_private_t private[static const 1],
+                                      sb_hmac_drbg_state_t drbg[static const 1],
+                                      sb_sw_curve_id_t const curve,
+                                      sb_data_endian_t const e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    // Avoid modifying the input drbg state if the second generate call fails.
+    // It takes two generate calls to generate a private key.
+    err |= sb_hmac_drbg_reseed_required(drbg, 2);
+
+    SB_RETURN_ERRORS(err);
+
+    // With P-256, the chance of one random scalar being invalid is <2^-32
+    // The chance of two random scalars being invalid is <2^-64
+    // With secp256k1, the chance of one random scalar being invalid is <2^-128!
+    // Assume that it's OK to fail if both scalars generated are invalid.
+
+    err |= sb_hmac_drbg_generate(drbg, &ctx->buf[0], SB_ELEM_BYTES);
+    SB_ASSERT(!err, "Private key generation should never fail.");
+
+    err |= sb_hmac_drbg_generate(drbg, &ctx->buf[SB_ELEM_BYTES], SB_ELEM_BYTES);
+    SB_ASSERT(!err, "Private key generation should never fail.");
+
+    sb_fe_from_bytes(MULT_K(ctx), &ctx->buf[0], e);
+    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[SB_ELEM_BYTES], e);
+
+    // per FIPS 186-4 B.4.2: d = c + 1
+    // if this overflows, the value was invalid to begin with
+    err |= SB_ERROR_IF(DRBG_FAILURE,
+                       sb_fe_add(MULT_K(ctx), MULT_K(ctx), &SB_FE_ONE));
+    err |= SB_ERROR_IF(DRBG_FAILURE,
+                       sb_fe_add(MULT_Z(ctx), MULT_Z(ctx), &SB_FE_ONE));
+
+    _Bool k1v = sb_sw_scalar_valid(MULT_K(ctx), s);
+    sb_fe_ctswap((sb_word_t) (k1v ^ 1), MULT_K(ctx), MULT_Z(ctx));
+
+    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_scalar_valid(MULT_K(ctx), s));
+
+    sb_fe_to_bytes(private->bytes, MULT_K(ctx), e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+sb_error_t sb_sw_compute_public_key(sb_sw_context_t ctx[static const 1],
+                                    sb_sw_public_t public[static const 1],
+                                    const sb_sw_private_t private[static const 1],
+                                    sb_hmac_drbg_state_t* const drbg,
+                                    const sb_sw_curve_id_t curve,
+                                    const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    // Bail out early if the DRBG needs to be reseeded
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 1);
+    }
+
+    // Return invalid-curve and DRBG errors immediately.
+    SB_RETURN_ERRORS(err);
+
+    // Validate the private key before performing any operations.
+
+    sb_fe_from_bytes(MULT_K(ctx), private->bytes, e);
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       !sb_sw_scalar_valid(MULT_K(ctx), s));
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    // This is cheating: the private key isn't enough entropy to seed a
+    // HMAC-DRBG with, so it's used as both entropy and nonce when no DRBG is
+    // supplied. When a DRBG is supplied, the private key is used as
+    // additional input to the DRBG twice, which shouldn't cause any problems:
+    // SP 800-90A rev 1 is fairly clear that additional input can be anything
+    // at all, private or public information, as long as it doesn't require
+    // protection at a higher security level than the underlying HMAC (which
+    // is the same security level as our inputs).
+
+    err |= sb_sw_generate_z(ctx, drbg, s, private->bytes, SB_ELEM_BYTES,
+                            private->bytes, SB_ELEM_BYTES, NULL, 0);
+
+    sb_sw_point_mult_base(ctx, s);
+
+    // The output is quasi-reduced, so the point at infinity is (p, p).
+    // This should never occur with valid scalars.
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       (sb_fe_equal(C_X1(ctx), &s->p->p) &
+                        sb_fe_equal(C_Y1(ctx), &s->p->p)));
+    SB_ASSERT(!err, "Montgomery ladder produced the point at infinity from a "
+        "valid scalar.");
+
+    sb_fe_to_bytes(public->bytes, C_X1(ctx), e);
+    sb_fe_to_bytes(public->bytes + SB_ELEM_BYTES, C_Y1(ctx), e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+sb_error_t sb_sw_valid_public_key(sb_sw_context_t ctx[static const 1],
+                                  const sb_sw_public_t public[static const 1],
+                                  const sb_sw_curve_id_t curve,
+                                  const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    SB_RETURN_ERRORS(err);
+
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+sb_error_t
+sb_sw_compress_public_key(sb_sw_context_t ctx[static const 1],
+                          sb_sw_compressed_public_t compressed[static const 1],
+                          const sb_sw_public_t public[static const 1],
+                          const sb_sw_curve_id_t curve,
+                          const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    SB_RETURN_ERRORS(err);
+
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    compressed->bytes[0] =
+        (sb_byte_t) (0x02 | sb_fe_test_bit(&MULT_POINT(ctx)[1], 0));
+    sb_fe_to_bytes(compressed->bytes + 1, &MULT_POINT(ctx)[0],
+                   SB_DATA_ENDIAN_BIG);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+sb_error_t
+sb_sw_decompress_public_key(sb_sw_context_t ctx[static const 1],
+                            sb_sw_public_t public[static const 1],
+                            const sb_sw_compressed_public_t
+                            compressed[static const 1],
+                            const sb_sw_curve_id_t curve,
+                            const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    SB_RETURN_ERRORS(err);
+
+    sb_fe_from_bytes(C_X1(ctx), compressed->bytes + 1, SB_DATA_ENDIAN_BIG);
+
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       (compressed->bytes[0] & 0xFE) != 0x02);
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID, !sb_fe_lt(C_X1(ctx), &s->p->p));
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    const sb_word_t odd = (sb_word_t) (compressed->bytes[0] & 1);
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID, !sb_sw_point_lift(ctx, odd, s));
+
+    // The lifted point is checked as any other public key would be
+    MULT_POINT(ctx)[0] = *C_X1(ctx);
+    sb_fe_mont_reduce(&MULT_POINT(ctx)[1], C_Y2(ctx), s->p);
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    sb_fe_to_bytes(public->bytes, &MULT_POINT(ctx)[0], e);
+    sb_fe_to_bytes(public->bytes + SB_ELEM_BYTES, &MULT_POINT(ctx)[1], e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+sb_error_t sb_sw_shared_secret(sb_sw_context_t ctx[static const 1],
+                               sb_sw_shared_secret_t secret[static const 1],
+                               const sb_sw_private_t private[static const 1],
+                               const sb_sw_public_t public[static const 1],
+                               sb_hmac_drbg_state_t* const drbg,
+                               const sb_sw_curve_id_t curve,
+                               const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    // Bail out early if the DRBG needs to be reseeded
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 1);
+    }
+
+    SB_RETURN_ERRORS(err);
+
+    // Only the X coordinate of the public key is used as the nonce, since
+    // the Y coordinate is not an independent input.
+    err |= sb_sw_generate_z(ctx, drbg, s, private->bytes, SB_ELEM_BYTES,
+                            public->bytes, SB_ELEM_BYTES,
+                            NULL, 0);
+
+    sb_fe_from_bytes(MULT_K(ctx), private->bytes, e);
+
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       !sb_sw_scalar_valid(MULT_K(ctx), s));
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+
+    // Return errors here to prevent not-on-curve public keys from being used
+    // in a power side-channel attack.
+    SB_RETURN_ERRORS(err, ctx);
+
+    // Pre-multiply the point's x and y by R
+    sb_fe_mont_mult(C_X1(ctx), &MULT_POINT(ctx)[0], &s->p->r2_mod_p, s->p);
+    sb_fe_mont_mult(C_Y1(ctx), &MULT_POINT(ctx)[1], &s->p->r2_mod_p, s->p);
+    MULT_POINT(ctx)[0] = *C_X1(ctx);
+    MULT_POINT(ctx)[1] = *C_Y1(ctx);
+
+    sb_sw_point_mult(ctx, MULT_POINT(ctx), s);
+
+    // This should never occur with a valid private scalar.
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       (sb_fe_equal(C_X1(ctx), &s->p->p) &
+                        sb_fe_equal(C_Y1(ctx), &s->p->p)));
+    SB_ASSERT(!err, "Montgomery ladder produced the point at infinity from a "
+        "valid scalar.");
+
+    sb_fe_to_bytes(secret->bytes, C_X1(ctx), e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    return err;
+}
+
+// Generates the per-message secret k in MULT_K and an initial Z in MULT_Z for
+// signing the reduced message in SIGN_MESSAGE with the private scalar d in
+// SIGN_PRIVATE, which the caller has validated. private and message are as
+// supplied by the caller, and are used as additional input to the DRBG.
+static sb_error_t
+sb_sw_sign_generate_k(sb_sw_context_t ctx[static const 1],
+                      const sb_sw_private_t private[static const 1],
+                      const sb_sw_message_digest_t message[static const 1],
+                      const sb_sw_private_t* const k,
+                      sb_hmac_drbg_state_t* const drbg,
+                      const sb_sw_curve_t s[static const 1])
+{
+    sb_error_t err = SB_SUCCESS;
+
+#ifndef SB_TEST
+    (void) k;
+#endif
+
+#ifdef SB_TEST
+    // Inject the provided per-message secret
+    if (k) {
+        memcpy(ctx->buf, k, SB_ELEM_BYTES);
+    } else
+#endif
+    if (drbg) {
+        // FIPS 186-4-style per-message secret generation
+        // The private key and message are used (in native endianness) as
+        // additional input to the DRBG in order to prevent catastrophic
+        // entropy failure.
+
+        const sb_byte_t* const add[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
+            private->bytes, message->bytes
+        };
+
+        const size_t add_len[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
+            SB_ELEM_BYTES, SB_ELEM_BYTES
+        };
+
+        err |= sb_hmac_drbg_generate_additional_vec(drbg, &ctx->buf[0],
+                                                    SB_ELEM_BYTES, add,
+                                                    add_len);
+
+        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[SB_ELEM_BYTES],
+                                     SB_ELEM_BYTES);
+
+    } else {
+        // RFC6979 deterministic signature generation
+
+        // Convert the private scalar and reduced message back into a
+        // big-endian byte string
+        sb_fe_to_bytes(&ctx->buf[0], SIGN_PRIVATE(ctx),
+                       SB_DATA_ENDIAN_BIG);
+        sb_fe_to_bytes(&ctx->buf[SB_ELEM_BYTES], SIGN_MESSAGE(ctx),
+                       SB_DATA_ENDIAN_BIG);
+
+        err |=
+            sb_hmac_drbg_init(&ctx->drbg_state, &ctx->buf[0], SB_ELEM_BYTES,
+                              &ctx->buf[SB_ELEM_BYTES], SB_ELEM_BYTES, NULL, 0);
+        SB_ASSERT(!err, "DRBG initialization should never fail.");
+
+        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[0],
+                                     SB_ELEM_BYTES);
+
+        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[SB_ELEM_BYTES],
+                                     SB_ELEM_BYTES);
+    }
+
+    SB_ASSERT(!err, "The DRBG should never fail to generate a "
+        "per-message secret.");
+
+    sb_fe_from_bytes(MULT_K(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
+    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[SB_ELEM_BYTES], SB_DATA_ENDIAN_BIG);
+
+    if (drbg) {
+        // per FIPS 186-4 B.5.2: k = c + 1
+        // if this overflows, the value was invalid to begin with
+        err |= SB_ERROR_IF(DRBG_FAILURE,
+                           sb_fe_add(MULT_K(ctx), MULT_K(ctx), &SB_FE_ONE));
+        err |= SB_ERROR_IF(DRBG_FAILURE,
+                           sb_fe_add(MULT_Z(ctx), MULT_Z(ctx), &SB_FE_ONE));
+    }
+
+    // Note that this step rejects the scalars -2, -1, and 1, which both FIPS
+    // 186-4 and RFC6979 would accept. The probability of this happening in
+    // practice is too remote to consider, so the deviation from standard is
+    // acceptable.
+
+    _Bool k1v = sb_sw_scalar_valid(MULT_K(ctx), s);
+    sb_fe_ctswap((sb_word_t) (k1v ^ 1), MULT_K(ctx), MULT_Z(ctx));
 
-    // k = 1
-    *MULT_K(&m) = SB_FE_ONE;
-    TEST_EX();
+    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_scalar_valid(MULT_K(ctx), s));
 
-    // k = 0
-    *MULT_K(&m) = SB_CURVE_P256.n->p;
-    TEST_EX();
+    // And now generate an initial Z
+    err |= sb_hmac_drbg_generate((drbg ? drbg : &ctx->drbg_state),
+                                 &ctx->buf[0], SB_ELEM_BYTES);
+    SB_ASSERT(!err, "The DRBG should never fail to generate a Z value.");
 
-    // k = -1
-    *MULT_K(&m) = SB_CURVE_P256.n->p;
-    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
-    TEST_EX();
+    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
+    err |= sb_sw_z_valid(MULT_Z(ctx), s);
 
-    // k = -2
-    *MULT_K(&m) = SB_CURVE_P256.n->p;
-    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
-    sb_fe_sub(MULT_K(&m), MULT_K(&m), &SB_FE_ONE);
-    TEST_EX();
-    return 1;
+    return err;
+}
+
+// Signs the message with the private scalar d in SIGN_PRIVATE, which the
+// caller has validated. private is the private key as supplied by the caller,
+// used as additional input to the DRBG. If d_r is not NULL, it is d * R mod N.
+// If recovery_id is not NULL, the recovery id of the signature is placed in
+// it; see sb_sw_recover_public_key.
+static sb_error_t
+sb_sw_sign_message_digest_shared(sb_sw_context_t ctx[static const 1],
+                                 sb_sw_signature_t signature[static const 1],
+                                 sb_byte_t* const recovery_id,
+                                 const sb_sw_private_t private[static const 1],
+                                 const sb_fe_t* const d_r,
+                                 const sb_sw_message_digest_t message[static const 1],
+                                 const sb_sw_private_t* const k,
+                                 sb_hmac_drbg_state_t* const drbg,
+                                 const sb_sw_curve_t s[static const 1],
+                                 const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    sb_fe_from_bytes(SIGN_MESSAGE(ctx), message->bytes, e);
+
+    // Reduce the message modulo N
+    sb_fe_mod_sub(SIGN_MESSAGE(ctx), SIGN_MESSAGE(ctx), &s->n->p, s->n);
+
+    err |= sb_sw_sign_generate_k(ctx, private, message, k, drbg, s);
+
+    if (d_r) {
+        *SIGN_PRIVATE(ctx) = *d_r;
+    } else {
+        sb_fe_mont_mult(C_T5(ctx), SIGN_PRIVATE(ctx), &s->n->r2_mod_p,
+                        s->n); // t5 = d_A * R
+        *SIGN_PRIVATE(ctx) = *C_T5(ctx);
+    }
+
+    // If sb_sw_sign fails, the DRBG produced an extremely low-probability k
+    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_sign(ctx, s));
+
+    sb_fe_to_bytes(signature->bytes, C_X2(ctx), e);
+    sb_fe_to_bytes(signature->bytes + SB_ELEM_BYTES, C_Y2(ctx), e);
+
+    // k * G is left in (x1, y1)
+    if (recovery_id) {
+        *recovery_id = (sb_byte_t) (sb_fe_test_bit(C_Y1(ctx), 0) |
+                                    (!sb_fe_lt(C_X1(ctx), &s->n->p) << 1));
+    }
+
+    return err;
+}
+
+#ifdef SB_TEST
+
+// This is an EXTREMELY dangerous method and is not exposed in the public
+// header. Do not under any circumstances call this function unless you are
+// running NIST CAVP tests.
+
+// Prototype to satisfy the compiler...
+
+sb_error_t sb_sw_sign_message_digest_with_k_beware_of_the_leopard
+    (sb_sw_context_t ctx[static 1],
+     sb_sw_signature_t signature[static 1],
+     const sb_sw_private_t private[static 1],
+     const sb_sw_message_digest_t message[static 1],
+     const sb_sw_private_t* k,
+     sb_hmac_drbg_state_t* drbg,
+     sb_sw_curve_id_t curve,
+     sb_data_endian_t e);
+
+#endif
+
+// Validates the private key and signs the message as
+// sb_sw_sign_message_digest does, using the supplied k if it is not NULL
+static sb_error_t
+sb_sw_sign_message_digest_checked(sb_sw_context_t ctx[static const 1],
+                                  sb_sw_signature_t signature[static const 1],
+                                  sb_byte_t* const recovery_id,
+                                  const sb_sw_private_t private[static const 1],
+                                  const sb_sw_message_digest_t message[static const 1],
+                                  const sb_sw_private_t* const k,
+                                  sb_hmac_drbg_state_t* const drbg,
+                                  const sb_sw_curve_id_t curve,
+                                  const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    // Bail out early if the DRBG needs to be reseeded
+    // It takes two calls to generate a per-message secret and one to
+    // generate an initial Z
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 3);
+    }
+
+    SB_RETURN_ERRORS(err);
+
+    sb_fe_from_bytes(SIGN_PRIVATE(ctx), private->bytes, e);
+
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       !sb_sw_scalar_valid(SIGN_PRIVATE(ctx), s));
+
+    err |= sb_sw_sign_message_digest_shared(ctx, signature, recovery_id,
+                                            private, NULL, message, k, drbg,
+                                            s, e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
+}
+
+sb_error_t sb_sw_sign_message_digest(sb_sw_context_t ctx[static const 1],
+                                     sb_sw_signature_t signature[static const 1],
+                                     const sb_sw_private_t private[static const 1],
+                                     const sb_sw_message_digest_t message[static const 1],
+                                     sb_hmac_drbg_state_t* const drbg,
+                                     const sb_sw_curve_id_t curve,
+                                     const sb_data_endian_t e)
+{
+    return sb_sw_sign_message_digest_checked(ctx, signature, NULL, private,
+                                             message, NULL, drbg, curve, e);
+}
+
+#ifdef SB_TEST
+
+sb_error_t sb_sw_sign_message_digest_with_k_beware_of_the_leopard
+    (sb_sw_context_t ctx[static const 1],
+     sb_sw_signature_t signature[static const 1],
+     const sb_sw_private_t private[static const 1],
+     const sb_sw_message_digest_t message[static const 1],
+     const sb_sw_private_t* const k,
+     sb_hmac_drbg_state_t* const drbg,
+     const sb_sw_curve_id_t curve,
+     const sb_data_endian_t e)
+{
+    return sb_sw_sign_message_digest_checked(ctx, signature, NULL, private,
+                                             message, k, drbg, curve, e);
+}
+
+#endif
+
+sb_error_t
+sb_sw_sign_message_digest_recoverable(sb_sw_context_t ctx[static const 1],
+                                      sb_sw_signature_t signature[static const 1],
+                                      sb_byte_t recovery_id[static const 1],
+                                      const sb_sw_private_t private[static const 1],
+                                      const sb_sw_message_digest_t message[static const 1],
+                                      sb_hmac_drbg_state_t* const drbg,
+                                      const sb_sw_curve_id_t curve,
+                                      const sb_data_endian_t e)
+{
+    return sb_sw_sign_message_digest_checked(ctx, signature, recovery_id,
+                                             private, message, NULL, drbg,
+                                             curve, e);
+}
+
+sb_error_t sb_sw_prepare_signer(sb_sw_context_t ctx[static const 1],
+                                sb_sw_signer_t signer[static const 1],
+                                const sb_sw_private_t private[static const 1],
+                                const sb_sw_curve_id_t curve,
+                                const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    SB_RETURN_ERRORS(err);
+
+    sb_fe_from_bytes(SIGN_PRIVATE(ctx), private->bytes, e);
+
+    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                       !sb_sw_scalar_valid(SIGN_PRIVATE(ctx), s));
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    signer->private = *private;
+    signer->d = *SIGN_PRIVATE(ctx);
+    sb_fe_mont_mult(&signer->d_r, SIGN_PRIVATE(ctx), &s->n->r2_mod_p, s->n);
+    signer->curve = curve;
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
+}
+
+sb_error_t
+sb_sw_sign_message_digest_prepared(sb_sw_context_t ctx[static const 1],
+                                   sb_sw_signature_t signature[static const 1],
+                                   const sb_sw_signer_t signer[static const 1],
+                                   const sb_sw_message_digest_t message[static const 1],
+                                   sb_hmac_drbg_state_t* const drbg,
+                                   const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, signer->curve);
+
+    // As in sb_sw_sign_message_digest
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 3);
+    }
+
+    SB_RETURN_ERRORS(err);
+
+    *SIGN_PRIVATE(ctx) = signer->d;
+
+    err |= sb_sw_sign_message_digest_shared(ctx, signature, NULL,
+                                            &signer->private, &signer->d_r,
+                                            message, NULL, drbg, s, e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
+}
+
+sb_error_t sb_sw_presignature_pool_init(sb_sw_presignature_pool_t
+                                        pool[static const 1],
+                                        sb_sw_presignature_t* const entries,
+                                        const size_t capacity,
+                                        const sb_sw_curve_id_t curve)
+{
+    sb_error_t err = SB_SUCCESS;
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    SB_RETURN_ERRORS(err);
+
+    memset(entries, 0, capacity * sizeof(sb_sw_presignature_t));
+
+    pool->entries = entries;
+    pool->capacity = capacity;
+    pool->count = 0;
+    pool->curve = curve;
+
+    return err;
+}
+
+sb_error_t sb_sw_presignature_pool_fill(sb_sw_context_t ctx[static const 1],
+                                        sb_sw_presignature_pool_t
+                                        pool[static const 1],
+                                        sb_hmac_drbg_state_t drbg[static const 1])
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, pool->curve);
+
+    SB_RETURN_ERRORS(err);
+
+    while (pool->count < pool->capacity) {
+        // It takes one call to generate two candidate per-message secrets
+        // and one to generate an initial Z
+        err |= sb_hmac_drbg_reseed_required(drbg, 2);
+
+        SB_RETURN_ERRORS(err, ctx);
+
+        // FIPS 186-4-style per-message secret generation, as in
+        // sb_sw_sign_message_digest. There is no private key or message to
+        // use as additional input.
+        err |= sb_hmac_drbg_generate(drbg, ctx->buf, 2 * SB_ELEM_BYTES);
+        SB_ASSERT(!err, "The DRBG should never fail to generate a "
+            "per-message secret.");
+
+        sb_fe_from_bytes(MULT_K(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
+        sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[SB_ELEM_BYTES],
+                         SB_DATA_ENDIAN_BIG);
+
+        // per FIPS 186-4 B.5.2: k = c + 1
+        // if this overflows, the value was invalid to begin with
+        err |= SB_ERROR_IF(DRBG_FAILURE,
+                           sb_fe_add(MULT_K(ctx), MULT_K(ctx), &SB_FE_ONE));
+        err |= SB_ERROR_IF(DRBG_FAILURE,
+                           sb_fe_add(MULT_Z(ctx), MULT_Z(ctx), &SB_FE_ONE));
+
+        _Bool k1v = sb_sw_scalar_valid(MULT_K(ctx), s);
+        sb_fe_ctswap((sb_word_t) (k1v ^ 1), MULT_K(ctx), MULT_Z(ctx));
+
+        err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_scalar_valid(MULT_K(ctx), s));
+
+        // And now generate an initial Z
+        err |= sb_hmac_drbg_generate(drbg, &ctx->buf[0], SB_ELEM_BYTES);
+        SB_ASSERT(!err, "The DRBG should never fail to generate a Z value.");
+
+        sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
+        err |= sb_sw_z_valid(MULT_Z(ctx), s);
+
+        // If this fails, the DRBG produced an extremely low-probability k
+        err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_sign_presign(ctx, s));
+
+        SB_RETURN_ERRORS(err, ctx);
+
+        sb_sw_presignature_t* const entry = &pool->entries[pool->count];
+        entry->k_inv_r = *C_T7(ctx);
+        entry->r = *C_X2(ctx);
+        pool->count++;
+    }
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
+}
+
+sb_error_t
+sb_sw_sign_message_digest_presigned(sb_sw_context_t ctx[static const 1],
+                                    sb_sw_signature_t signature[static const 1],
+                                    sb_sw_presignature_pool_t pool[static const 1],
+                                    const sb_sw_signer_t signer[static const 1],
+                                    const sb_sw_message_digest_t message[static const 1],
+                                    const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, signer->curve);
+    err |= SB_ERROR_IF(CURVE_INVALID, signer->curve != pool->curve);
+
+    SB_RETURN_ERRORS(err);
+
+    err |= SB_ERROR_IF(PRESIGNATURE_POOL_EMPTY, pool->count == 0);
+
+    SB_RETURN_ERRORS(err);
+
+    // Take the most recently generated presignature and wipe it from the
+    // pool so that it can never be used again
+    pool->count--;
+    sb_sw_presignature_t* const entry = &pool->entries[pool->count];
+    *C_T7(ctx) = entry->k_inv_r;
+    *C_X2(ctx) = entry->r;
+    memset(entry, 0, sizeof(sb_sw_presignature_t));
+
+    sb_fe_from_bytes(SIGN_MESSAGE(ctx), message->bytes, e);
+
+    // Reduce the message modulo N
+    sb_fe_mod_sub(SIGN_MESSAGE(ctx), SIGN_MESSAGE(ctx), &s->n->p, s->n);
+
+    *SIGN_PRIVATE(ctx) = signer->d_r;
+
+    // If this fails, the DRBG produced an extremely low-probability k
+    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_sign_finish(ctx, s));
+
+    sb_fe_to_bytes(signature->bytes, C_X2(ctx), e);
+    sb_fe_to_bytes(signature->bytes + SB_ELEM_BYTES, C_Y2(ctx), e);
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
 }
 
-#endif
+sb_error_t
+sb_sw_sign_message_digest_batch(sb_sw_context_t ctx[static const 1],
+                                sb_sw_signature_t signatures[static const 1],
+                                const sb_sw_private_t privates[static const 1],
+                                const sb_sw_message_digest_t messages[static const 1],
+                                const size_t count,
+                                sb_hmac_drbg_state_t* const drbg,
+                                const sb_sw_curve_id_t curve,
+                                const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
+
+    // As in sb_sw_sign_message_digest, for each signature. A batch larger
+    // than the reseed interval can never be signed without reseeding.
+    if (drbg != NULL) {
+        if (count > SB_HMAC_DRBG_RESEED_INTERVAL) {
+            err |= SB_ERROR_RESEED_REQUIRED;
+        } else {
+            err |= sb_hmac_drbg_reseed_required(drbg, 3 * count);
+        }
+    }
+
+    SB_RETURN_ERRORS(err);
 
-// Places (r, s) into (x2, y2)
-static _Bool
-sb_sw_sign(sb_sw_context_t g[static const 1],
-           const sb_sw_curve_t s[static const 1])
-{
-    _Bool res = 1;
+    for (size_t i = 0; i < count; i++) {
+        sb_fe_from_bytes(SIGN_PRIVATE(ctx), privates[i].bytes, e);
+        err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
+                           !sb_sw_scalar_valid(SIGN_PRIVATE(ctx), s));
+    }
 
-    sb_sw_point_mult(g, s->g_r, s);
+    SB_RETURN_ERRORS(err, ctx);
 
+    // Signatures are produced in chunks. For each signature in a chunk,
+    // k * G is computed in Jacobian coordinates; then r is recovered for the
+    // whole chunk with one inversion of Z^2 mod P, and k^-1 is computed for
+    // the whole chunk with one inversion mod N.
+    sb_fe_t k_r[SB_SW_BATCH_CHUNK]; // k * R mod N
+    sb_fe_t x_r[SB_SW_BATCH_CHUNK]; // X * R mod P, then r
+    sb_fe_t z2_r[SB_SW_BATCH_CHUNK]; // Z^2 * R mod P
+    sb_fe_t inv[SB_SW_BATCH_CHUNK];
 
-    // This is used to quasi-reduce x1 modulo the curve N:
-    *C_X2(g) = *C_X1(g);
-    sb_fe_qr(C_X2(g), 0, s->n);
+    for (size_t base = 0; base < count; base += SB_SW_BATCH_CHUNK) {
+        const size_t b = (count - base < SB_SW_BATCH_CHUNK ?
+                          count - base : SB_SW_BATCH_CHUNK);
 
-    res &= !sb_fe_equal(C_X2(g), &s->n->p);
+        for (size_t j = 0; j < b; j++) {
+            const size_t i = base + j;
 
-    sb_fe_mont_mult(C_T7(g), MULT_K(g), &s->n->r2_mod_p, s->n); // t7 = k * R
-    sb_fe_mod_inv_r(C_T7(g), C_T5(g), C_T6(g), s->n); // t7 = k^-1 * R
-    sb_fe_mont_mult(C_T6(g), SIGN_PRIVATE(g), &s->n->r2_mod_p,
-                    s->n); // t6 = d_A * R
-    sb_fe_mont_mult(C_T5(g), C_X2(g), C_T6(g), s->n); // t5 = r * d_A
-    sb_fe_mod_add(C_T5(g), C_T5(g), SIGN_MESSAGE(g), s->n); // t5 = z + r * d_A
-    sb_fe_mont_mult(C_Y2(g), C_T5(g), C_T7(g),
-                    s->n); // y2 = k^-1 * R * (z + r * d_A) * R^-1 mod N
+            // Each per-message secret is generated from a fresh context, as
+            // in sb_sw_sign_message_digest
+            memset(ctx, 0, sizeof(sb_sw_context_t));
 
-    // mont_mul produces quasi-reduced output
-    res &= !sb_fe_equal(C_Y2(g), &s->n->p);
+            sb_fe_from_bytes(SIGN_PRIVATE(ctx), privates[i].bytes, e);
+            sb_fe_from_bytes(SIGN_MESSAGE(ctx), messages[i].bytes, e);
 
-    return res;
-}
+            // Reduce the message modulo N
+            sb_fe_mod_sub(SIGN_MESSAGE(ctx), SIGN_MESSAGE(ctx), &s->n->p,
+                          s->n);
 
-static _Bool sb_sw_verify(sb_sw_context_t v[static const 1],
-                          const sb_sw_curve_t s[static const 1])
-{
-    _Bool res = 1;
+            err |= sb_sw_sign_generate_k(ctx, &privates[i], &messages[i], NULL,
+                                         drbg, s);
 
-    res &= sb_sw_scalar_valid(VERIFY_QR(v), s);
-    res &= sb_sw_scalar_valid(VERIFY_QS(v), s);
+            sb_sw_point_mult_base_jacobian(ctx, s);
 
-    sb_fe_mont_mult(C_T5(v), VERIFY_QS(v), &s->n->r2_mod_p, s->n); // t5 = s * R
-    sb_fe_mod_inv_r(C_T5(v), C_T6(v), C_T7(v), s->n); // t5 = s^-1 * R
+            sb_fe_mont_mult(&k_r[j], MULT_K(ctx), &s->n->r2_mod_p, s->n);
+            x_r[j] = *C_X1(ctx);
+            sb_fe_mont_square(&z2_r[j], C_Z1(ctx), s->p);
+        }
 
-    sb_fe_mont_mult(MULT_ADD_KG(v), VERIFY_MESSAGE(v), C_T5(v),
-                    s->n); // k_G = m * s^-1
-    sb_fe_mont_mult(MULT_K(v), VERIFY_QR(v), C_T5(v), s->n); // k_P = r * s^-1
+        // inv[j] = Z^-2 * R
+        sb_fe_batch_inv_r(inv, z2_r, b, C_T5(ctx), s->p);
 
-    sb_sw_point_mult_add_z(v, s);
+        for (size_t j = 0; j < b; j++) {
+            sb_fe_mont_mult(C_T5(ctx), &inv[j], &x_r[j],
+                            s->p); // t5 = X * Z^-2 * R
+            sb_fe_mont_reduce(&x_r[j], C_T5(ctx), s->p); // x_r[j] = x
 
-    // This happens when p is some multiple of g that occurs within
-    // the ladder, such that additions inadvertently produce a point
-    // doubling. When that occurs, the private scalar that generated p is
-    // also obvious, so this is bad news. Don't do this.
-    res &= !(sb_fe_equal(C_X1(v), &s->p->p) & sb_fe_equal(C_Y1(v), &s->p->p));
+            // This is used to quasi-reduce x modulo the curve N:
+            sb_fe_qr(&x_r[j], 0, s->n);
 
-    _Bool ver = 0;
+            // If r is zero, the DRBG produced an extremely low-probability k
+            err |= SB_ERROR_IF(DRBG_FAILURE, sb_fe_equal(&x_r[j], &s->n->p));
+        }
 
-    // qr ==? x mod N, but we don't have x, just x * z^2
-    // Given that qr is reduced, if it is >= P - N, then it can be used directly
-    // if it is < P - N, then we need to try to see if the original value was
-    // qr or qr + N
-    // Try directly first:
-    sb_fe_mont_square(C_T6(v), C_T5(v), s->p); // t6 = Z^2 * R
-    sb_fe_mont_mult(C_T7(v), VERIFY_QR(v), C_T6(v), s->p);
-    ver |= sb_fe_equal(C_T7(v), C_X1(v));
+        // inv[j] = k^-1 * R
+        sb_fe_batch_inv_r(inv, k_r, b, C_T5(ctx), s->n);
 
-    // If that didn't work, and qr < P - N, then we need to compare
-    // (qr + N) * z^2 against x * z^2
+        for (size_t j = 0; j < b; j++) {
+            const size_t i = base + j;
 
-    // Note that this code is probably never used because this situation occurs
-    // with very low probability (<2^-128)
+            sb_fe_from_bytes(C_T5(ctx), privates[i].bytes, e);
+            sb_fe_mont_mult(SIGN_PRIVATE(ctx), C_T5(ctx), &s->n->r2_mod_p,
+                            s->n); // d_A * R
+            sb_fe_from_bytes(SIGN_MESSAGE(ctx), messages[i].bytes, e);
+            sb_fe_mod_sub(SIGN_MESSAGE(ctx), SIGN_MESSAGE(ctx), &s->n->p,
+                          s->n);
 
-    sb_fe_mod_add(C_T5(v), VERIFY_QR(v), &s->n->p, s->p);
-    sb_fe_mont_mult(C_T7(v), VERIFY_QR(v), C_T6(v), s->p);
-    sb_fe_sub(C_T5(v), &s->p->p, &s->n->p); // t5 = P - N
-    ver |= (sb_fe_lt(VERIFY_QR(v), C_T5(v)) &
-            sb_fe_equal(C_T7(v), C_X1(v)));
+            *C_X2(ctx) = x_r[j];
+            *C_T7(ctx) = inv[j];
 
-    return res & ver;
-}
+            // If this fails, the DRBG produced an extremely low-probability k
+            err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_sign_finish(ctx, s));
 
-static sb_error_t sb_sw_curve_from_id(const sb_sw_curve_t** const s,
-                                      sb_sw_curve_id_t const curve)
-{
-    switch (curve) {
-#if SB_SW_P256_SUPPORT
-        case SB_SW_CURVE_P256: {
-            *s = &SB_CURVE_P256;
-            return 0;
-        }
-#endif
-#if SB_SW_SECP256K1_SUPPORT
-        case SB_SW_CURVE_SECP256K1: {
-            *s = &SB_CURVE_SECP256K1;
-            return 0;
+            sb_fe_to_bytes(signatures[i].bytes, C_X2(ctx), e);
+            sb_fe_to_bytes(signatures[i].bytes + SB_ELEM_BYTES, C_Y2(ctx), e);
         }
-#endif
-#ifdef SB_TEST
-        case SB_SW_CURVE_INVALID:
-            break;
-#endif
     }
-    // Huh?
-    *s = NULL;
-    return SB_ERROR_CURVE_INVALID;
-}
 
-// a Z value is invalid if it is zero, since the only point with Z = 0 is the
-// point at infinity. Note that this is not expected to ever occur!
-static sb_error_t sb_sw_z_valid(const sb_fe_t z[static const 1],
-                                const sb_sw_curve_t s[static const 1])
-{
-    sb_error_t err = SB_SUCCESS;
-    err |= SB_ERROR_IF(DRBG_FAILURE, sb_fe_equal(z, &SB_FE_ZERO));
-    err |= SB_ERROR_IF(DRBG_FAILURE, sb_fe_equal(z, &s->p->p));
+    memset(k_r, 0, sizeof(k_r));
+    memset(x_r, 0, sizeof(x_r));
+    memset(z2_r, 0, sizeof(z2_r));
+    memset(inv, 0, sizeof(inv));
+    memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
-// Initial Z generation for Z blinding (Coron's third countermeasure)
-static sb_error_t sb_sw_generate_z(sb_sw_context_t c[static const 1],
-                                   sb_hmac_drbg_state_t* const drbg,
-                                   const sb_sw_curve_t s[static const 1],
-                                   const sb_byte_t* const d1, const size_t l1,
-                                   const sb_byte_t* const d2, const size_t l2,
-                                   const sb_byte_t* const d3, const size_t l3)
+sb_error_t sb_sw_verify_signature(sb_sw_context_t ctx[static const 1],
+                                  const sb_sw_signature_t signature[static const 1],
+                                  const sb_sw_public_t public[static const 1],
+                                  const sb_sw_message_digest_t message[static const 1],
+                                  sb_hmac_drbg_state_t* const drbg,
+                                  const sb_sw_curve_id_t curve,
+                                  const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
 
-    if (drbg) {
-        // Use the supplied data as additional input to the DRBG
-        const sb_byte_t* const add[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
-            d1, d2, d3
-        };
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
 
-        const size_t add_len[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
-            l1, l2, l3
-        };
+    // Bail out early if the DRBG needs to be reseeded
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 1);
+    }
 
-        err |= sb_hmac_drbg_generate_additional_vec(drbg, c->buf, SB_ELEM_BYTES,
-                                                    add, add_len);
-    } else {
-        // Seed the HMAC-DRBG with the input supplied
-        err |= sb_hmac_drbg_init(&c->drbg_state,
-                                 d1, l1,
-                                 d2, l2,
-                                 d3, l3);
+    SB_RETURN_ERRORS(err);
 
-        // It is a bug if this ever fails; the DRBG limits should allow these
-        // inputs.
-        SB_ASSERT(!err, "DRBG initialization should never fail.");
+    // Only the X coordinate of the public key is used as input, since
+    // the Y coordinate is not an independent input. When no DRBG is
+    // supplied, the message is used as personalization string, but the
+    // division here is somewhat arbitrary since it's just concatenated as
+    // HMAC input with the entropy and nonce. When a DRBG is supplied, the
+    // public key, signature, and message are all used as additional input.
+    err |= sb_sw_generate_z(ctx, drbg, s, public->bytes, SB_ELEM_BYTES,
+                            signature->bytes, 2 * SB_ELEM_BYTES,
+                            message->bytes, SB_ELEM_BYTES);
 
-        err |= sb_hmac_drbg_generate(&c->drbg_state, c->buf, SB_ELEM_BYTES);
-    }
+    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
+    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
+    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
 
-    // It is a bug if this ever fails; the DRBG reseed count should have
-    // been checked already, and the DRBG limits should allow these inputs.
-    SB_ASSERT(!err, "Z generation should never fail.");
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
 
-    sb_fe_from_bytes(MULT_Z(c), c->buf, SB_DATA_ENDIAN_BIG);
-    err |= sb_sw_z_valid(MULT_Z(c), s);
+    // Return early if the public key is invalid. If an attacker can modify
+    // the public key so that it is invalid, they can presumably also replace
+    // the public key with a different, valid key. In the event that the
+    // public key is incorrect or corrupt, better to avoid computing anything
+    // on the signature at all.
+
+    SB_RETURN_ERRORS(err, ctx);
+
+    err |= SB_ERROR_IF(SIGNATURE_INVALID, !sb_sw_verify(ctx, s, 0));
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
-//// PUBLIC API:
-
-/// FIPS 186-4-style private key generation. Note that this only tests two
-/// candidates; the probability of both candidates failing is extremely low.
-sb_error_t sb_sw_generate_private_key(sb_sw_context_t ctx[static const 1],
-                                      sb_sw_private_t private[static const 1],
-                                      sb_hmac_drbg_state_t drbg[static const 1],
-                                      sb_sw_curve_id_t const curve,
-                                      sb_data_endian_t const e)
+sb_error_t sb_sw_recover_public_key(sb_sw_context_t ctx[static const 1],
+                                    sb_sw_public_t public[static const 1],
+                                    const sb_sw_signature_t signature[static const 1],
+                                    const sb_byte_t recovery_id,
+                                    const sb_sw_message_digest_t message[static const 1],
+                                    sb_hmac_drbg_state_t* const drbg,
+                                    const sb_sw_curve_id_t curve,
+                                    const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
     memset(ctx, 0, sizeof(sb_sw_context_t));
@@ -1066,51 +4747,102 @@ sb_error_t sb_sw_generate_private_key(sb_sw_context_t ctx[static const 1],
     const sb_sw_curve_t* s;
     err |= sb_sw_curve_from_id(&s, curve);
 
-    // Avoid modifying the input drbg state if the second generate call fails.
-    // It takes two generate calls to generate a private key.
-    err |= sb_hmac_drbg_reseed_required(drbg, 2);
+    // Bail out early if the DRBG needs to be reseeded
+    if (drbg != NULL) {
+        err |= sb_hmac_drbg_reseed_required(drbg, 1);
+    }
 
     SB_RETURN_ERRORS(err);
 
-    // With P-256, the chance of one random scalar being invalid is <2^-32
-    // The chance of two random scalars being invalid is <2^-64
-    // With secp256k1, the chance of one random scalar being invalid is <2^-128!
-    // Assume that it's OK to fail if both scalars generated are invalid.
+    // As in sb_sw_verify_signature, except that there is no public key
+    err |= sb_sw_generate_z(ctx, drbg, s, signature->bytes, 2 * SB_ELEM_BYTES,
+                            message->bytes, SB_ELEM_BYTES, &recovery_id, 1);
 
-    err |= sb_hmac_drbg_generate(drbg, &ctx->buf[0], SB_ELEM_BYTES);
-    SB_ASSERT(!err, "Private key generation should never fail.");
+    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
+    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
+    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
 
-    err |= sb_hmac_drbg_generate(drbg, &ctx->buf[SB_ELEM_BYTES], SB_ELEM_BYTES);
-    SB_ASSERT(!err, "Private key generation should never fail.");
+    err |= SB_ERROR_IF(SIGNATURE_INVALID,
+                       !sb_sw_scalar_valid(VERIFY_QR(ctx), s));
+    err |= SB_ERROR_IF(SIGNATURE_INVALID,
+                       !sb_sw_scalar_valid(VERIFY_QS(ctx), s));
 
-    sb_fe_from_bytes(MULT_K(ctx), &ctx->buf[0], e);
-    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[SB_ELEM_BYTES], e);
+    SB_RETURN_ERRORS(err, ctx);
 
-    // per FIPS 186-4 B.4.2: d = c + 1
-    // if this overflows, the value was invalid to begin with
-    err |= SB_ERROR_IF(DRBG_FAILURE,
-                       sb_fe_add(MULT_K(ctx), MULT_K(ctx), &SB_FE_ONE));
-    err |= SB_ERROR_IF(DRBG_FAILURE,
-                       sb_fe_add(MULT_Z(ctx), MULT_Z(ctx), &SB_FE_ONE));
+    err |= SB_ERROR_IF(SIGNATURE_INVALID,
+                       !sb_sw_recover_point_r(ctx, recovery_id, s));
 
-    _Bool k1v = sb_sw_scalar_valid(MULT_K(ctx), s);
-    sb_fe_ctswap((sb_word_t) (k1v ^ 1), MULT_K(ctx), MULT_Z(ctx));
+    SB_RETURN_ERRORS(err, ctx);
 
-    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_scalar_valid(MULT_K(ctx), s));
+    // Q = r^-1 * (s * R - m * G) = (s * r^-1) * R + (-m * r^-1) * G
+    sb_fe_mont_reduce(&MULT_POINT(ctx)[0], C_X2(ctx), s->p);
+    sb_fe_mont_reduce(&MULT_POINT(ctx)[1], C_Y2(ctx), s->p);
+
+    sb_fe_mont_mult(C_T5(ctx), VERIFY_QR(ctx), &s->n->r2_mod_p,
+                    s->n); // t5 = r * R
+    sb_fe_mod_inv_r(C_T5(ctx), C_T6(ctx), C_T7(ctx),
+                    s->n); // t5 = r^-1 * R
+    sb_fe_mont_mult(MULT_K(ctx), VERIFY_QS(ctx), C_T5(ctx),
+                    s->n); // k_R = s * r^-1
+    sb_fe_mont_mult(C_T6(ctx), VERIFY_MESSAGE(ctx), C_T5(ctx),
+                    s->n); // t6 = m * r^-1
+    sb_fe_mod_sub(MULT_ADD_KG(ctx), &s->n->p, C_T6(ctx),
+                  s->n); // k_G = -m * r^-1
+
+    sb_sw_point_mult_add_z(ctx, s);
+
+    // As in sb_sw_verify_point, the point at infinity is (p, p), which is
+    // also produced when the ladder encounters an exceptional case
+    err |= SB_ERROR_IF(SIGNATURE_INVALID,
+                       sb_fe_equal(C_X1(ctx), &s->p->p) &
+                       sb_fe_equal(C_Y1(ctx), &s->p->p));
 
-    sb_fe_to_bytes(private->bytes, MULT_K(ctx), e);
+    SB_RETURN_ERRORS(err, ctx);
 
-    memset(ctx, 0, sizeof(sb_sw_context_t));
+    sb_fe_mod_inv_r(C_T5(ctx), C_T6(ctx), C_T7(ctx),
+                    s->p); // t5 = Z^-1 * R
+    sb_fe_mont_square(C_T6(ctx), C_T5(ctx), s->p); // t6 = Z^-2 * R
+    sb_fe_mont_mult(C_T7(ctx), C_T6(ctx), C_T5(ctx), s->p); // t7 = Z^-3 * R
+    sb_fe_mont_mult(C_X2(ctx), C_X1(ctx), C_T6(ctx), s->p); // x2 = x
+    sb_fe_mont_mult(C_Y2(ctx), C_Y1(ctx), C_T7(ctx), s->p); // y2 = y
+
+    sb_fe_to_bytes(public->bytes, C_X2(ctx), e);
+    sb_fe_to_bytes(public->bytes + SB_ELEM_BYTES, C_Y2(ctx), e);
 
+    memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
-sb_error_t sb_sw_compute_public_key(sb_sw_context_t ctx[static const 1],
-                                    sb_sw_public_t public[static const 1],
-                                    const sb_sw_private_t private[static const 1],
-                                    sb_hmac_drbg_state_t* const drbg,
-                                    const sb_sw_curve_id_t curve,
-                                    const sb_data_endian_t e)
+// Loads a signature, public key, and message into the context as
+// sb_sw_verify_signature does. Returns PUBLIC_KEY_INVALID if the public key
+// is invalid.
+static sb_error_t
+sb_sw_verify_batch_load(sb_sw_context_t ctx[static const 1],
+                        const sb_sw_signature_t signature[static const 1],
+                        const sb_sw_public_t public[static const 1],
+                        const sb_sw_message_digest_t message[static const 1],
+                        const sb_sw_curve_t s[static const 1],
+                        const sb_data_endian_t e)
+{
+    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
+    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
+    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
+
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+    return SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+}
+
+sb_error_t sb_sw_verify_signature_batch(sb_sw_context_t ctx[static const 1],
+                                        sb_byte_t valid[static const 1],
+                                        const sb_sw_signature_t signatures[static const 1],
+                                        const sb_sw_public_t publics[static const 1],
+                                        const sb_sw_message_digest_t messages[static const 1],
+                                        const size_t count,
+                                        sb_hmac_drbg_state_t* const drbg,
+                                        const sb_sw_curve_id_t curve,
+                                        const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
     memset(ctx, 0, sizeof(sb_sw_context_t));
@@ -1118,59 +4850,139 @@ sb_error_t sb_sw_compute_public_key(sb_sw_context_t ctx[static const 1],
     const sb_sw_curve_t* s;
     err |= sb_sw_curve_from_id(&s, curve);
 
-    // Bail out early if the DRBG needs to be reseeded
+    // As in sb_sw_verify_signature, for each signature
     if (drbg != NULL) {
-        err |= sb_hmac_drbg_reseed_required(drbg, 1);
+        if (count > SB_HMAC_DRBG_RESEED_INTERVAL) {
+            err |= SB_ERROR_RESEED_REQUIRED;
+        } else {
+            err |= sb_hmac_drbg_reseed_required(drbg, count);
+        }
     }
 
-    // Return invalid-curve and DRBG errors immediately.
     SB_RETURN_ERRORS(err);
 
-    // Validate the private key before performing any operations.
+    memset(valid, 0, (count + 7) / 8);
+
+    // Signatures are verified in chunks. For each signature in a chunk, the
+    // scalar s and the Z of P + H and P + G + H (see
+    // sb_sw_point_mult_add_prepare) are computed; then each is inverted for
+    // the whole chunk at once. P + H and P + G + H are recomputed afterwards,
+    // which is much cheaper than storing them. Signatures whose public key is
+    // invalid are skipped, and invalid scalars and Z values are replaced by
+    // one so that they do not spoil the inversion of the others. A Z of zero
+    // can only arise from a public key for which P + H or P + G + H is the
+    // point at infinity; such signatures are verified on their own.
+    sb_fe_t s_r[SB_SW_BATCH_CHUNK]; // s * R mod N, then s^-1 * R
+    sb_fe_t z_r[SB_SW_BATCH_CHUNK]; // Z * R mod P
+    sb_fe_t iz[SB_SW_BATCH_CHUNK]; // initial Z
+    sb_fe_t inv[SB_SW_BATCH_CHUNK];
+    sb_error_t key_err[SB_SW_BATCH_CHUNK];
+    _Bool z_zero[SB_SW_BATCH_CHUNK];
+
+    for (size_t base = 0; base < count; base += SB_SW_BATCH_CHUNK) {
+        const size_t b = (count - base < SB_SW_BATCH_CHUNK ?
+                          count - base : SB_SW_BATCH_CHUNK);
+
+        for (size_t j = 0; j < b; j++) {
+            const size_t i = base + j;
+
+            memset(ctx, 0, sizeof(sb_sw_context_t));
+
+            // As in sb_sw_verify_signature
+            err |= sb_sw_generate_z(ctx, drbg, s, publics[i].bytes,
+                                    SB_ELEM_BYTES, signatures[i].bytes,
+                                    2 * SB_ELEM_BYTES, messages[i].bytes,
+                                    SB_ELEM_BYTES);
+            iz[j] = *MULT_Z(ctx);
+
+            key_err[j] = sb_sw_verify_batch_load(ctx, &signatures[i],
+                                                 &publics[i], &messages[i],
+                                                 s, e);
+            err |= key_err[j];
+
+            // As in sb_sw_verify_signature, nothing is computed if the
+            // public key is invalid
+            if (key_err[j]) {
+                s_r[j] = s->n->r_mod_p;
+                z_r[j] = s->p->r_mod_p;
+                z_zero[j] = 0;
+                continue;
+            }
+
+            sb_fe_mont_mult(&s_r[j], VERIFY_QS(ctx), &s->n->r2_mod_p, s->n);
+            *C_T5(ctx) = s->n->r_mod_p;
+            sb_fe_ctswap((sb_word_t) !sb_sw_scalar_valid(VERIFY_QS(ctx), s),
+                         &s_r[j], C_T5(ctx));
+
+            sb_sw_point_mult_add_prepare_jacobian(ctx, s);
+            z_r[j] = *MULT_Z(ctx);
+
+            z_zero[j] = sb_fe_equal(&z_r[j], &s->p->p);
+            if (z_zero[j]) {
+                z_r[j] = s->p->r_mod_p;
+            }
+        }
 
-    sb_fe_from_bytes(MULT_K(ctx), private->bytes, e);
-    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
-                       !sb_sw_scalar_valid(MULT_K(ctx), s));
+        // s_r[j] = s^-1 * R
+        sb_fe_batch_inv_r(inv, s_r, b, C_T5(ctx), s->n);
+        memcpy(s_r, inv, b * sizeof(sb_fe_t));
 
-    SB_RETURN_ERRORS(err, ctx);
+        // inv[j] = Z^-1 * R
+        sb_fe_batch_inv_r(inv, z_r, b, C_T5(ctx), s->p);
 
-    // This is cheating: the private key isn't enough entropy to seed a
-    // HMAC-DRBG with, so it's used as both entropy and nonce when no DRBG is
-    // supplied. When a DRBG is supplied, the private key is used as
-    // additional input to the DRBG twice, which shouldn't cause any problems:
-    // SP 800-90A rev 1 is fairly clear that additional input can be anything
-    // at all, private or public information, as long as it doesn't require
-    // protection at a higher security level than the underlying HMAC (which
-    // is the same security level as our inputs).
+        for (size_t j = 0; j < b; j++) {
+            const size_t i = base + j;
 
-    err |= sb_sw_generate_z(ctx, drbg, s, private->bytes, SB_ELEM_BYTES,
-                            private->bytes, SB_ELEM_BYTES, NULL, 0);
+            if (key_err[j]) {
+                continue;
+            }
+
+            sb_sw_verify_batch_load(ctx, &signatures[i], &publics[i],
+                                    &messages[i], s, e);
+            *MULT_Z(ctx) = iz[j];
+
+            _Bool res;
+
+            if (z_zero[j]) {
+                // P + H or P + G + H is the point at infinity; this public
+                // key is verified on its own, as sb_sw_verify_signature
+                // would
+                res = sb_sw_verify(ctx, s, 0);
+            } else {
+                res = sb_sw_scalar_valid(VERIFY_QR(ctx), s);
+                res &= sb_sw_scalar_valid(VERIFY_QS(ctx), s);
+
+                sb_fe_mont_mult(MULT_ADD_KG(ctx), VERIFY_MESSAGE(ctx),
+                                &s_r[j], s->n); // k_G = m * s^-1
+                sb_fe_mont_mult(MULT_K(ctx), VERIFY_QR(ctx), &s_r[j],
+                                s->n); // k_P = r * s^-1
+
+                sb_sw_point_mult_add_prepare_jacobian(ctx, s);
+                *C_T5(ctx) = inv[j];
+                sb_sw_point_mult_add_prepare_affine(ctx, s);
 
-    sb_sw_point_mult(ctx, s->g_r, s);
+                *MULT_Z(ctx) = iz[j];
+                sb_sw_point_mult_add_z_prepared(ctx, s);
 
-    // The output is quasi-reduced, so the point at infinity is (p, p).
-    // This should never occur with valid scalars.
-    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
-                       (sb_fe_equal(C_X1(ctx), &s->p->p) &
-                        sb_fe_equal(C_Y1(ctx), &s->p->p)));
-    SB_ASSERT(!err, "Montgomery ladder produced the point at infinity from a "
-        "valid scalar.");
+                res &= sb_sw_verify_point(ctx, s);
+            }
 
-    sb_fe_to_bytes(public->bytes, C_X1(ctx), e);
-    sb_fe_to_bytes(public->bytes + SB_ELEM_BYTES, C_Y1(ctx), e);
+            valid[i / 8] |= (sb_byte_t) (res << (i % 8));
+            err |= SB_ERROR_IF(SIGNATURE_INVALID, !res);
+        }
+    }
 
     memset(ctx, 0, sizeof(sb_sw_context_t));
-
     return err;
 }
 
-sb_error_t sb_sw_valid_public_key(sb_sw_context_t ctx[static const 1],
-                                  const sb_sw_public_t public[static const 1],
-                                  const sb_sw_curve_id_t curve,
-                                  const sb_data_endian_t e)
+sb_error_t sb_sw_prepare_public_key(sb_sw_context_t ctx[static const 1],
+                                    sb_sw_public_prepared_t prepared[static const 1],
+                                    const sb_sw_public_t public[static const 1],
+                                    const sb_sw_curve_id_t curve,
+                                    const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
-
     memset(ctx, 0, sizeof(sb_sw_context_t));
 
     const sb_sw_curve_t* s;
@@ -1180,28 +4992,43 @@ sb_error_t sb_sw_valid_public_key(sb_sw_context_t ctx[static const 1],
 
     sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
     sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
-
     err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
                        !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
 
-    memset(ctx, 0, sizeof(sb_sw_context_t));
+    SB_RETURN_ERRORS(err, ctx);
+
+    prepared->p[0] = MULT_POINT(ctx)[0];
+    prepared->p[1] = MULT_POINT(ctx)[1];
+
+#if SB_SW_FIXED_BASE_WINDOW
+    sb_sw_point_comb_table(prepared->comb, ctx, s);
+#else
+    sb_sw_point_mult_add_prepare(ctx, s);
 
+    prepared->p_h[0][0] = MULT_POINT(ctx)[0];
+    prepared->p_h[0][1] = MULT_POINT(ctx)[1];
+    prepared->p_h[1][0] = MULT_ADD_PG(ctx)[0];
+    prepared->p_h[1][1] = MULT_ADD_PG(ctx)[1];
+#endif
+
+    prepared->curve = curve;
+
+    memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
-sb_error_t sb_sw_shared_secret(sb_sw_context_t ctx[static const 1],
-                               sb_sw_shared_secret_t secret[static const 1],
-                               const sb_sw_private_t private[static const 1],
-                               const sb_sw_public_t public[static const 1],
-                               sb_hmac_drbg_state_t* const drbg,
-                               const sb_sw_curve_id_t curve,
-                               const sb_data_endian_t e)
+sb_error_t sb_sw_verify_signature_prepared(sb_sw_context_t ctx[static const 1],
+                                           const sb_sw_signature_t signature[static const 1],
+                                           const sb_sw_public_prepared_t prepared[static const 1],
+                                           const sb_sw_message_digest_t message[static const 1],
+                                           sb_hmac_drbg_state_t* const drbg,
+                                           const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
     memset(ctx, 0, sizeof(sb_sw_context_t));
 
     const sb_sw_curve_t* s;
-    err |= sb_sw_curve_from_id(&s, curve);
+    err |= sb_sw_curve_from_id(&s, prepared->curve);
 
     // Bail out early if the DRBG needs to be reseeded
     if (drbg != NULL) {
@@ -1210,91 +5037,56 @@ sb_error_t sb_sw_shared_secret(sb_sw_context_t ctx[static const 1],
 
     SB_RETURN_ERRORS(err);
 
-    // Only the X coordinate of the public key is used as the nonce, since
-    // the Y coordinate is not an independent input.
-    err |= sb_sw_generate_z(ctx, drbg, s, private->bytes, SB_ELEM_BYTES,
-                            public->bytes, SB_ELEM_BYTES,
-                            NULL, 0);
-
-    sb_fe_from_bytes(MULT_K(ctx), private->bytes, e);
-
-    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
-    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
-
-    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
-                       !sb_sw_scalar_valid(MULT_K(ctx), s));
-    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
-                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+    // As in sb_sw_verify_signature, the X coordinate of the public key is
+    // used as input to Z generation.
+    sb_single_t x;
+    sb_fe_to_bytes(x.bytes, &prepared->p[0], e);
+    err |= sb_sw_generate_z(ctx, drbg, s, x.bytes, SB_ELEM_BYTES,
+                            signature->bytes, 2 * SB_ELEM_BYTES,
+                            message->bytes, SB_ELEM_BYTES);
 
-    // Return errors here to prevent not-on-curve public keys from being used
-    // in a power side-channel attack.
-    SB_RETURN_ERRORS(err, ctx);
+    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
+    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
+    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
 
-    // Pre-multiply the point's x and y by R
-    sb_fe_mont_mult(C_X1(ctx), &MULT_POINT(ctx)[0], &s->p->r2_mod_p, s->p);
-    sb_fe_mont_mult(C_Y1(ctx), &MULT_POINT(ctx)[1], &s->p->r2_mod_p, s->p);
-    MULT_POINT(ctx)[0] = *C_X1(ctx);
-    MULT_POINT(ctx)[1] = *C_Y1(ctx);
+    _Bool res = sb_sw_verify_scalars(ctx, s);
 
-    sb_sw_point_mult(ctx, MULT_POINT(ctx), s);
+#if SB_SW_FIXED_BASE_WINDOW
+    // If the comb encounters an exceptional addition, verification falls
+    // back to the regular algorithm. Since the signature, message, and
+    // public key are public, revealing this through timing is harmless.
+    if (sb_sw_point_mult_add_comb(ctx, prepared->comb, s)) {
+        MULT_POINT(ctx)[0] = prepared->p[0];
+        MULT_POINT(ctx)[1] = prepared->p[1];
+        sb_sw_point_mult_add_z(ctx, s);
+    }
+#else
+    // VERIFY_MESSAGE and VERIFY_QS are no longer needed once the scalars
+    // have been computed, and MULT_ADD_PG overlaps them.
+    MULT_POINT(ctx)[0] = prepared->p_h[0][0];
+    MULT_POINT(ctx)[1] = prepared->p_h[0][1];
+    MULT_ADD_PG(ctx)[0] = prepared->p_h[1][0];
+    MULT_ADD_PG(ctx)[1] = prepared->p_h[1][1];
+
+    sb_sw_point_mult_add_z_prepared(ctx, s);
+#endif
 
-    // This should never occur with a valid private scalar.
-    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
-                       (sb_fe_equal(C_X1(ctx), &s->p->p) &
-                        sb_fe_equal(C_Y1(ctx), &s->p->p)));
-    SB_ASSERT(!err, "Montgomery ladder produced the point at infinity from a "
-        "valid scalar.");
+    res &= sb_sw_verify_point(ctx, s);
 
-    sb_fe_to_bytes(secret->bytes, C_X1(ctx), e);
+    err |= SB_ERROR_IF(SIGNATURE_INVALID, !res);
 
     memset(ctx, 0, sizeof(sb_sw_context_t));
-
     return err;
 }
 
-#ifdef SB_TEST
-
-// This is an EXTREMELY dangerous method and is not exposed in the public
-// header. Do not under any circumstances call this function unless you are
-// running NIST CAVP tests.
-
-// Prototype to satisfy the compiler...
-
-sb_error_t sb_sw_sign_message_digest_with_k_beware_of_the_leopard
-    (sb_sw_context_t ctx[static 1],
-     sb_sw_signature_t signature[static 1],
-     const sb_sw_private_t private[static 1],
-     const sb_sw_message_digest_t message[static 1],
-     const sb_sw_private_t* k,
-     sb_hmac_drbg_state_t* drbg,
-     sb_sw_curve_id_t curve,
-     sb_data_endian_t e);
-
-#endif
-
-sb_error_t sb_sw_sign_message_digest(sb_sw_context_t ctx[static const 1],
-                                     sb_sw_signature_t signature[static const 1],
-                                     const sb_sw_private_t private[static const 1],
-                                     const sb_sw_message_digest_t message[static const 1],
-                                     sb_hmac_drbg_state_t* const drbg,
-                                     const sb_sw_curve_id_t curve,
-                                     const sb_data_endian_t e)
-#ifdef SB_TEST
-{
-    return sb_sw_sign_message_digest_with_k_beware_of_the_leopard
-        (ctx, signature, private, message, NULL, drbg, curve, e);
-}
+#if SB_SW_VARTIME_SUPPORT
 
-sb_error_t sb_sw_sign_message_digest_with_k_beware_of_the_leopard
-    (sb_sw_context_t ctx[static const 1],
-     sb_sw_signature_t signature[static const 1],
-     const sb_sw_private_t private[static const 1],
-     const sb_sw_message_digest_t message[static const 1],
-     const sb_sw_private_t* const k,
-     sb_hmac_drbg_state_t* const drbg,
-     const sb_sw_curve_id_t curve,
-     const sb_data_endian_t e)
-#endif
+sb_error_t sb_sw_verify_signature_vartime(sb_sw_context_t ctx[static const 1],
+                                          const sb_sw_signature_t signature[static const 1],
+                                          const sb_sw_public_t public[static const 1],
+                                          const sb_sw_message_digest_t message[static const 1],
+                                          const sb_sw_curve_id_t curve,
+                                          const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
     memset(ctx, 0, sizeof(sb_sw_context_t));
@@ -1302,123 +5094,324 @@ sb_error_t sb_sw_sign_message_digest_with_k_beware_of_the_leopard
     const sb_sw_curve_t* s;
     err |= sb_sw_curve_from_id(&s, curve);
 
-    // Bail out early if the DRBG needs to be reseeded
-    // It takes two calls to generate a per-message secret and one to
-    // generate an initial Z
-    if (drbg != NULL) {
-        err |= sb_hmac_drbg_reseed_required(drbg, 3);
-    }
-
     SB_RETURN_ERRORS(err);
 
-    sb_fe_from_bytes(SIGN_PRIVATE(ctx), private->bytes, e);
-    sb_fe_from_bytes(SIGN_MESSAGE(ctx), message->bytes, e);
+    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
+    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
+    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
 
-    err |= SB_ERROR_IF(PRIVATE_KEY_INVALID,
-                       !sb_sw_scalar_valid(SIGN_PRIVATE(ctx), s));
+    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
+    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
+    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
 
-    // Reduce the message modulo N
-    sb_fe_mod_sub(SIGN_MESSAGE(ctx), SIGN_MESSAGE(ctx), &s->n->p, s->n);
+    // As in sb_sw_verify_signature, return early if the public key is invalid
+    SB_RETURN_ERRORS(err, ctx);
 
-#ifdef SB_TEST
-    // Inject the provided per-message secret
-    if (k) {
-        memcpy(ctx->buf, k, SB_ELEM_BYTES);
-    } else
-#endif
-    if (drbg) {
-        // FIPS 186-4-style per-message secret generation
-        // The private key and message are used (in native endianness) as
-        // additional input to the DRBG in order to prevent catastrophic
-        // entropy failure.
+    err |= SB_ERROR_IF(SIGNATURE_INVALID, !sb_sw_verify(ctx, s, 1));
 
-        const sb_byte_t* const add[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
-            private->bytes, message->bytes
-        };
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    return err;
+}
 
-        const size_t add_len[SB_HMAC_DRBG_ADD_VECTOR_LEN] = {
-            SB_ELEM_BYTES, SB_ELEM_BYTES
-        };
+// Returns the number of DRBG requests needed to generate the coefficients for
+// count signatures in sb_sw_verify_signature_batch_vartime.
+static size_t sb_sw_batch_vartime_requests(const size_t count)
+{
+#define SB_REQUESTS(n) \
+    (((n) + SB_SW_VARTIME_BATCH_PER_REQUEST - 1) / \
+     SB_SW_VARTIME_BATCH_PER_REQUEST)
+    return (count / SB_SW_VARTIME_BATCH_CHUNK) *
+           SB_REQUESTS(SB_SW_VARTIME_BATCH_CHUNK) +
+           SB_REQUESTS(count % SB_SW_VARTIME_BATCH_CHUNK);
+#undef SB_REQUESTS
+}
 
-        err |= sb_hmac_drbg_generate_additional_vec(drbg, &ctx->buf[0],
-                                                    SB_ELEM_BYTES, add,
-                                                    add_len);
+// Loads a random coefficient for the batch equation
+static void
+sb_sw_batch_vartime_coefficient(sb_fe_t a[static const 1],
+                                const sb_byte_t
+                                bytes[static const SB_SW_VARTIME_BATCH_BYTES])
+{
+    sb_byte_t buf[SB_ELEM_BYTES] = { 0 };
+    memcpy(buf + SB_ELEM_BYTES - SB_SW_VARTIME_BATCH_BYTES, bytes,
+           SB_SW_VARTIME_BATCH_BYTES);
+    sb_fe_from_bytes(a, buf, SB_DATA_ENDIAN_BIG);
+}
 
-        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[SB_ELEM_BYTES],
-                                     SB_ELEM_BYTES);
+// Verifies signature i on its own, as sb_sw_verify_signature_vartime would,
+// and records the result in valid. The public key must be valid.
+static void
+sb_sw_batch_vartime_verify_one(sb_sw_context_t ctx[static const 1],
+                               sb_byte_t valid[static const 1],
+                               const size_t i,
+                               const sb_sw_signature_t signatures[static const 1],
+                               const sb_sw_public_t publics[static const 1],
+                               const sb_sw_message_digest_t messages[static const 1],
+                               const sb_sw_curve_t s[static const 1],
+                               const sb_data_endian_t e)
+{
+    memset(ctx, 0, sizeof(sb_sw_context_t));
+    sb_sw_verify_batch_load(ctx, &signatures[i], &publics[i], &messages[i], s,
+                            e);
+    const _Bool res = sb_sw_verify(ctx, s, 1);
+    valid[i / 8] |= (sb_byte_t) (res << (i % 8));
+}
 
-    } else {
-        // RFC6979 deterministic signature generation
+// Checks entries [lo, hi) of the batch, recording in valid the signatures
+// found to be valid, and returns whether the batch equation held for them.
+// If it does not, the entries are split in half and each half is checked;
+// since the equation is the sum of the equations for both halves, if it holds
+// for the first half, it is known not to hold for the second (known_bad).
+// Single entries for which the equation does not hold are verified on their
+// own, as the recovery id may have been wrong.
+static _Bool
+sb_sw_batch_vartime_bisect(sb_sw_batch_vartime_t b[static const 1],
+                           const size_t lo, const size_t hi,
+                           const _Bool known_bad,
+                           sb_sw_context_t ctx[static const 1],
+                           sb_byte_t valid[static const 1],
+                           const sb_sw_signature_t signatures[static const 1],
+                           const sb_sw_public_t publics[static const 1],
+                           const sb_sw_message_digest_t messages[static const 1],
+                           const sb_sw_curve_t s[static const 1],
+                           const sb_data_endian_t e)
+{
+    if (!known_bad && sb_sw_batch_vartime_check(b, lo, hi, ctx, s)) {
+        for (size_t k = lo; k < hi; k++) {
+            valid[b->index[k] / 8] |= (sb_byte_t) (1 << (b->index[k] % 8));
+        }
+        return 1;
+    }
 
-        // Convert the private scalar and reduced message back into a
-        // big-endian byte string
-        sb_fe_to_bytes(&ctx->buf[0], SIGN_PRIVATE(ctx),
-                       SB_DATA_ENDIAN_BIG);
-        sb_fe_to_bytes(&ctx->buf[SB_ELEM_BYTES], SIGN_MESSAGE(ctx),
-                       SB_DATA_ENDIAN_BIG);
+    if (hi - lo == 1) {
+        sb_sw_batch_vartime_verify_one(ctx, valid, b->index[lo], signatures,
+                                       publics, messages, s, e);
+        return 0;
+    }
 
-        err |=
-            sb_hmac_drbg_init(&ctx->drbg_state, &ctx->buf[0], SB_ELEM_BYTES,
-                              &ctx->buf[SB_ELEM_BYTES], SB_ELEM_BYTES, NULL, 0);
-        SB_ASSERT(!err, "DRBG initialization should never fail.");
+    const size_t mid = lo + (hi - lo) / 2;
+    const _Bool first = sb_sw_batch_vartime_bisect(b, lo, mid, 0, ctx, valid,
+                                                   signatures, publics,
+                                                   messages, s, e);
+    sb_sw_batch_vartime_bisect(b, mid, hi, first, ctx, valid, signatures,
+                               publics, messages, s, e);
+    return 0;
+}
 
-        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[0],
-                                     SB_ELEM_BYTES);
+sb_error_t
+sb_sw_verify_signature_batch_vartime(sb_sw_context_t ctx[static const 1],
+                                     sb_byte_t valid[static const 1],
+                                     const sb_sw_signature_t signatures[static const 1],
+                                     const sb_byte_t* const recovery_ids,
+                                     const sb_sw_public_t publics[static const 1],
+                                     const sb_sw_message_digest_t messages[static const 1],
+                                     const size_t count,
+                                     sb_hmac_drbg_state_t drbg[static const 1],
+                                     const sb_sw_curve_id_t curve,
+                                     const sb_data_endian_t e)
+{
+    sb_error_t err = SB_SUCCESS;
+    memset(ctx, 0, sizeof(sb_sw_context_t));
 
-        err |= sb_hmac_drbg_generate(&ctx->drbg_state, &ctx->buf[SB_ELEM_BYTES],
-                                     SB_ELEM_BYTES);
-    }
+    const sb_sw_curve_t* s;
+    err |= sb_sw_curve_from_id(&s, curve);
 
-    SB_ASSERT(!err, "The DRBG should never fail to generate a "
-        "per-message secret.");
+    const size_t requests = sb_sw_batch_vartime_requests(count);
+    if (requests > SB_HMAC_DRBG_RESEED_INTERVAL) {
+        err |= SB_ERROR_RESEED_REQUIRED;
+    } else {
+        err |= sb_hmac_drbg_reseed_required(drbg, requests);
+    }
 
-    sb_fe_from_bytes(MULT_K(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
-    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[SB_ELEM_BYTES], SB_DATA_ENDIAN_BIG);
+    SB_RETURN_ERRORS(err);
 
-    if (drbg) {
-        // per FIPS 186-4 B.5.2: k = c + 1
-        // if this overflows, the value was invalid to begin with
-        err |= SB_ERROR_IF(DRBG_FAILURE,
-                           sb_fe_add(MULT_K(ctx), MULT_K(ctx), &SB_FE_ONE));
-        err |= SB_ERROR_IF(DRBG_FAILURE,
-                           sb_fe_add(MULT_Z(ctx), MULT_Z(ctx), &SB_FE_ONE));
-    }
+    memset(valid, 0, (count + 7) / 8);
+
+    // Signatures are verified in chunks. Each signature whose public key and
+    // scalars are valid and whose recovery id identifies a point R is added
+    // to the batch; the others are either invalid or are verified on their
+    // own, as is every signature if no recovery ids were supplied. The tables
+    // of odd multiples of Q and -R for the batch are converted to affine
+    // coordinates with a single inversion, as are the values of s.
+    sb_sw_batch_vartime_t b;
+    sb_fe_t q_ratio[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_P_ENTRIES];
+    sb_fe_t r_ratio[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_R_ENTRIES];
+    sb_fe_t z[2 * SB_SW_VARTIME_BATCH_CHUNK]; // Z of the tables of Q and -R
+    sb_fe_t inv[2 * SB_SW_VARTIME_BATCH_CHUNK];
+    sb_fe_t s_r[SB_SW_VARTIME_BATCH_CHUNK]; // s * R mod N, then s^-1 * R
+    sb_byte_t a[SB_SW_VARTIME_BATCH_CHUNK][SB_SW_VARTIME_BATCH_BYTES];
+    sb_error_t key_err[SB_SW_VARTIME_BATCH_CHUNK];
+
+    for (size_t base = 0; base < count; base += SB_SW_VARTIME_BATCH_CHUNK) {
+        const size_t c = (count - base < SB_SW_VARTIME_BATCH_CHUNK ?
+                          count - base : SB_SW_VARTIME_BATCH_CHUNK);
+
+        sb_error_t drbg_err = SB_SUCCESS;
+        for (size_t j = 0; j < c; j += SB_SW_VARTIME_BATCH_PER_REQUEST) {
+            const size_t n = (c - j < SB_SW_VARTIME_BATCH_PER_REQUEST ?
+                              c - j : SB_SW_VARTIME_BATCH_PER_REQUEST);
+            drbg_err |= sb_hmac_drbg_generate(drbg, a[j],
+                                              n * SB_SW_VARTIME_BATCH_BYTES);
+        }
 
-    // Note that this step rejects the scalars -2, -1, and 1, which both FIPS
-    // 186-4 and RFC6979 would accept. The probability of this happening in
-    // practice is too remote to consider, so the deviation from standard is
-    // acceptable.
+        // It is a bug if this ever fails; the DRBG reseed count has been
+        // checked already, and the requests are small enough for any DRBG
+        // configuration. Without the coefficients, nothing can be verified.
+        SB_ASSERT(!drbg_err, "Coefficient generation should never fail.");
+        if (drbg_err) {
+            memset(valid, 0, (count + 7) / 8);
+            err |= drbg_err;
+            break;
+        }
 
-    _Bool k1v = sb_sw_scalar_valid(MULT_K(ctx), s);
-    sb_fe_ctswap((sb_word_t) (k1v ^ 1), MULT_K(ctx), MULT_Z(ctx));
+        size_t m = 0; // the number of entries in the batch
+
+        for (size_t j = 0; j < c; j++) {
+            const size_t i = base + j;
+
+            memset(ctx, 0, sizeof(sb_sw_context_t));
+
+            // As in sb_sw_verify_signature_vartime, nothing is computed if
+            // the public key is invalid, and the signature is invalid if
+            // either scalar is
+            key_err[j] = sb_sw_verify_batch_load(ctx, &signatures[i],
+                                                 &publics[i], &messages[i],
+                                                 s, e);
+            err |= key_err[j];
+            if (key_err[j] || !sb_sw_scalar_valid(VERIFY_QR(ctx), s) ||
+                !sb_sw_scalar_valid(VERIFY_QS(ctx), s)) {
+                continue;
+            }
+
+            if (!recovery_ids ||
+                !sb_sw_recover_point_r(ctx, recovery_ids[i], s)) {
+                sb_sw_batch_vartime_verify_one(ctx, valid, i, signatures,
+                                               publics, messages, s, e);
+                continue;
+            }
+            sb_fe_mod_sub(C_Y2(ctx), &s->p->p, C_Y2(ctx), s->p); // -R
+
+            sb_fe_mont_mult(&s_r[m], VERIFY_QS(ctx), &s->n->r2_mod_p, s->n);
+
+            sb_sw_point_odd_multiples_z(b.r[m], r_ratio[m],
+                                        SB_SW_VARTIME_R_ENTRIES, ctx, s);
+            z[2 * m + 1] = *C_Z1(ctx);
+
+            sb_fe_mont_mult(C_X2(ctx), &MULT_POINT(ctx)[0], &s->p->r2_mod_p,
+                            s->p);
+            sb_fe_mont_mult(C_Y2(ctx), &MULT_POINT(ctx)[1], &s->p->r2_mod_p,
+                            s->p);
+            sb_sw_point_odd_multiples_z(b.q[m], q_ratio[m],
+                                        SB_SW_VARTIME_P_ENTRIES, ctx, s);
+            z[2 * m] = *C_Z1(ctx);
+
+            sb_sw_batch_vartime_coefficient(C_T5(ctx), a[j]);
+            sb_sw_wnaf(b.naf_r[m], C_T5(ctx), SB_SW_VARTIME_R_WINDOW);
+
+            b.index[m] = i;
+            m++;
+        }
 
-    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_scalar_valid(MULT_K(ctx), s));
+        if (m) {
+            // s_r[k] = s^-1 * R
+            sb_fe_batch_inv_r(inv, s_r, m, C_T5(ctx), s->n);
+            memcpy(s_r, inv, m * sizeof(sb_fe_t));
 
-    // And now generate an initial Z
-    err |= sb_hmac_drbg_generate((drbg ? drbg : &ctx->drbg_state),
-                                 &ctx->buf[0], SB_ELEM_BYTES);
-    SB_ASSERT(!err, "The DRBG should never fail to generate a Z value.");
+            // inv[2 * k] = Z^-1 * R for the table of Q, and
+            // inv[2 * k + 1] for the table of -R
+            sb_fe_batch_inv_r(inv, z, 2 * m, C_T5(ctx), s->p);
+        }
 
-    sb_fe_from_bytes(MULT_Z(ctx), &ctx->buf[0], SB_DATA_ENDIAN_BIG);
-    err |= sb_sw_z_valid(MULT_Z(ctx), s);
+        for (size_t k = 0; k < m; k++) {
+            const size_t i = b.index[k];
+
+            *C_T5(ctx) = inv[2 * k];
+            sb_sw_point_odd_multiples_affine(b.q[k], q_ratio[k],
+                                             SB_SW_VARTIME_P_ENTRIES, ctx, s);
+            *C_T5(ctx) = inv[2 * k + 1];
+            sb_sw_point_odd_multiples_affine(b.r[k], r_ratio[k],
+                                             SB_SW_VARTIME_R_ENTRIES, ctx, s);
+
+            sb_sw_batch_vartime_coefficient(C_T5(ctx), a[i - base]);
+            sb_fe_mont_mult(C_T6(ctx), C_T5(ctx), &s->n->r2_mod_p,
+                            s->n); // t6 = a * R
+            sb_fe_mont_mult(C_T7(ctx), C_T6(ctx), &s_r[k],
+                            s->n); // t7 = a * s^-1 * R
+
+            sb_fe_from_bytes(VERIFY_QR(ctx), signatures[i].bytes, e);
+            sb_fe_from_bytes(VERIFY_MESSAGE(ctx), messages[i].bytes, e);
+
+            sb_fe_mont_mult(MULT_K(ctx), VERIFY_QR(ctx), C_T7(ctx),
+                            s->n); // k_Q = a * r * s^-1
+            sb_sw_wnaf(b.naf_q[k], MULT_K(ctx), SB_SW_VARTIME_P_WINDOW);
+            sb_fe_mont_mult(&b.k_g[k], VERIFY_MESSAGE(ctx), C_T7(ctx),
+                            s->n); // k_G = a * m * s^-1
+        }
 
-    // If sb_sw_sign fails, the DRBG produced an extremely low-probability k
-    err |= SB_ERROR_IF(DRBG_FAILURE, !sb_sw_sign(ctx, s));
+        if (m) {
+            sb_sw_batch_vartime_bisect(&b, 0, m, 0, ctx, valid, signatures,
+                                       publics, messages, s, e);
+        }
 
-    sb_fe_to_bytes(signature->bytes, C_X2(ctx), e);
-    sb_fe_to_bytes(signature->bytes + SB_ELEM_BYTES, C_Y2(ctx), e);
+        for (size_t j = 0; j < c; j++) {
+            const size_t i = base + j;
+            const _Bool res = (valid[i / 8] >> (i % 8)) & 1;
+            if (!key_err[j]) {
+                err |= SB_ERROR_IF(SIGNATURE_INVALID, !res);
+            }
+        }
+    }
 
+    memset(a, 0, sizeof(a));
     memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
-sb_error_t sb_sw_verify_signature(sb_sw_context_t ctx[static const 1],
-                                  const sb_sw_signature_t signature[static const 1],
-                                  const sb_sw_public_t public[static const 1],
-                                  const sb_sw_message_digest_t message[static const 1],
-                                  sb_hmac_drbg_state_t* const drbg,
-                                  const sb_sw_curve_id_t curve,
-                                  const sb_data_endian_t e)
+// Places the sum of scalars[i] * points[i] into output, as described for
+// sb_sw_multi_mult_vartime, using Pippenger's method with the given window or
+// Straus's method if it is 0. The points must be valid.
+static void sb_sw_multi_mult(sb_sw_context_t ctx[static const 1],
+                             sb_sw_public_t output[static const 1],
+                             const sb_sw_scalar_t scalars[static const 1],
+                             const sb_sw_public_t points[static const 1],
+                             const size_t count,
+                             sb_sw_multi_mult_bucket_t* const buckets,
+                             const size_t window,
+                             const sb_sw_curve_t s[static const 1],
+                             const sb_data_endian_t e)
+{
+    sb_fe_t sum[3];
+
+    if (window) {
+        sb_sw_multi_mult_pippenger(sum, scalars, points, count, buckets,
+                                   window, ctx, s, e);
+    } else {
+        sb_sw_multi_mult_straus(sum, scalars, points, count, ctx, s, e);
+    }
+
+    if (sb_fe_equal(&sum[2], &s->p->p)) {
+        memset(output, 0, sizeof(sb_sw_public_t));
+        return;
+    }
+
+    *C_X1(ctx) = sum[0];
+    *C_Y1(ctx) = sum[1];
+    *C_Z1(ctx) = sum[2];
+    sb_sw_point_affine(ctx, s);
+    sb_fe_to_bytes(output->bytes, C_X1(ctx), e);
+    sb_fe_to_bytes(output->bytes + SB_ELEM_BYTES, C_Y1(ctx), e);
+}
+
+sb_error_t sb_sw_multi_mult_vartime(sb_sw_context_t ctx[static const 1],
+                                    sb_sw_public_t output[static const 1],
+                                    const sb_sw_scalar_t scalars[static const 1],
+                                    const sb_sw_public_t points[static const 1],
+                                    const size_t count,
+                                    sb_sw_multi_mult_bucket_t* const buckets,
+                                    const size_t bucket_count,
+                                    const sb_sw_curve_id_t curve,
+                                    const sb_data_endian_t e)
 {
     sb_error_t err = SB_SUCCESS;
     memset(ctx, 0, sizeof(sb_sw_context_t));
@@ -1426,46 +5419,29 @@ sb_error_t sb_sw_verify_signature(sb_sw_context_t ctx[static const 1],
     const sb_sw_curve_t* s;
     err |= sb_sw_curve_from_id(&s, curve);
 
-    // Bail out early if the DRBG needs to be reseeded
-    if (drbg != NULL) {
-        err |= sb_hmac_drbg_reseed_required(drbg, 1);
-    }
-
     SB_RETURN_ERRORS(err);
 
-    // Only the X coordinate of the public key is used as input, since
-    // the Y coordinate is not an independent input. When no DRBG is
-    // supplied, the message is used as personalization string, but the
-    // division here is somewhat arbitrary since it's just concatenated as
-    // HMAC input with the entropy and nonce. When a DRBG is supplied, the
-    // public key, signature, and message are all used as additional input.
-    err |= sb_sw_generate_z(ctx, drbg, s, public->bytes, SB_ELEM_BYTES,
-                            signature->bytes, 2 * SB_ELEM_BYTES,
-                            message->bytes, SB_ELEM_BYTES);
-
-    sb_fe_from_bytes(VERIFY_QR(ctx), signature->bytes, e);
-    sb_fe_from_bytes(VERIFY_QS(ctx), signature->bytes + SB_ELEM_BYTES, e);
-    sb_fe_from_bytes(VERIFY_MESSAGE(ctx), message->bytes, e);
-
-    sb_fe_from_bytes(&MULT_POINT(ctx)[0], public->bytes, e);
-    sb_fe_from_bytes(&MULT_POINT(ctx)[1], public->bytes + SB_ELEM_BYTES, e);
-    err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
-                       !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
-
-    // Return early if the public key is invalid. If an attacker can modify
-    // the public key so that it is invalid, they can presumably also replace
-    // the public key with a different, valid key. In the event that the
-    // public key is incorrect or corrupt, better to avoid computing anything
-    // on the signature at all.
+    for (size_t i = 0; i < count; i++) {
+        sb_fe_from_bytes(&MULT_POINT(ctx)[0], points[i].bytes, e);
+        sb_fe_from_bytes(&MULT_POINT(ctx)[1], points[i].bytes + SB_ELEM_BYTES,
+                         e);
+        err |= SB_ERROR_IF(PUBLIC_KEY_INVALID,
+                           !sb_sw_point_valid(MULT_POINT(ctx), ctx, s));
+    }
 
     SB_RETURN_ERRORS(err, ctx);
 
-    err |= SB_ERROR_IF(SIGNATURE_INVALID, !sb_sw_verify(ctx, s));
+    const size_t window =
+        (buckets ? sb_sw_multi_mult_window(count, bucket_count) : 0);
+    sb_sw_multi_mult(ctx, output, scalars, points, count, buckets, window, s,
+                     e);
 
     memset(ctx, 0, sizeof(sb_sw_context_t));
     return err;
 }
 
+#endif
+
 //// End of public API; tests follow.
 
 #ifdef SB_TEST
@@ -1606,80 +5582,879 @@ _Bool sb_test_compute_public(void)
     return 1;
 }
 
-_Bool sb_test_valid_public(void)
+_Bool sb_test_valid_public(void)
+{
+    sb_sw_context_t ct;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_valid_public_key(&ct, &TEST_PUB_1, SB_SW_CURVE_P256,
+                               SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_valid_public_key(&ct, &TEST_PUB_2, SB_SW_CURVE_P256,
+                               SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_valid_public_key(&ct, &TEST_PUB_2, SB_SW_CURVE_P256,
+                               SB_DATA_ENDIAN_LITTLE),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+    return 1;
+}
+
+static const sb_sw_message_digest_t TEST_MESSAGE = {
+    {
+        0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1,
+        0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+        0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15,
+        0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+    }
+};
+
+static const sb_sw_signature_t TEST_SIG = {
+    {
+        0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD,
+        0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6,
+        0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA, 0xF9, 0x91,
+        0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16,
+        0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41,
+        0xD4, 0x36, 0xC7, 0xA1, 0xB6, 0xE2, 0x9F, 0x65,
+        0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06,
+        0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8
+    }
+};
+
+// Inputs for tests of methods which operate on many keys: private key i is
+// TEST_PRIV_1 with its last byte XORed with i. If p is not NULL, the public
+// key is computed using the given endianness.
+static _Bool sb_test_batch_key(sb_sw_private_t d[static const 1],
+                               sb_sw_public_t* const p,
+                               const size_t i,
+                               const sb_sw_curve_id_t c,
+                               const sb_data_endian_t e)
+{
+    *d = TEST_PRIV_1;
+    d->bytes[SB_ELEM_BYTES - 1] ^= (sb_byte_t) i;
+    if (p) {
+        sb_sw_context_t ct;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_compute_public_key(&ct, p, d, NULL, c, e));
+    }
+    return 1;
+}
+
+// Fills d[0] through d[count - 1] with the keys of sb_test_batch_key, and, if
+// they are not NULL, p with the big-endian public keys and m with messages,
+// where message i is TEST_MESSAGE with its first byte XORed with i.
+static _Bool sb_test_batch_inputs(sb_sw_private_t d[static const 1],
+                                  sb_sw_public_t* const p,
+                                  sb_sw_message_digest_t* const m,
+                                  const size_t count,
+                                  const sb_sw_curve_id_t c)
+{
+    for (size_t i = 0; i < count; i++) {
+        SB_TEST_ASSERT(sb_test_batch_key(&d[i], p ? &p[i] : NULL, i, c,
+                                         SB_DATA_ENDIAN_BIG));
+        if (m) {
+            m[i] = TEST_MESSAGE;
+            m[i].bytes[0] ^= (sb_byte_t) i;
+        }
+    }
+    return 1;
+}
+
+_Bool sb_test_compress_public(void)
+{
+    static const sb_sw_curve_id_t curves[] = {
+        SB_SW_CURVE_P256, SB_SW_CURVE_SECP256K1
+    };
+
+    sb_sw_context_t ct;
+    sb_sw_private_t d;
+    sb_sw_public_t p, q;
+    sb_sw_compressed_public_t k, k2;
+
+    for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); c++) {
+        const sb_sw_curve_t* s;
+        SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, curves[c]));
+
+        // Keys of both parities in both endiannesses round-trip
+        sb_byte_t parities = 0;
+        for (size_t i = 0; i < 8; i++) {
+            const sb_data_endian_t e =
+                (i & 1) ? SB_DATA_ENDIAN_LITTLE : SB_DATA_ENDIAN_BIG;
+            SB_TEST_ASSERT(sb_test_batch_key(&d, &p, i, curves[c], e));
+            SB_TEST_ASSERT_SUCCESS(
+                sb_sw_compress_public_key(&ct, &k, &p, curves[c], e));
+
+            const sb_byte_t y0 = (e == SB_DATA_ENDIAN_BIG) ?
+                                 p.bytes[2 * SB_ELEM_BYTES - 1] :
+                                 p.bytes[SB_ELEM_BYTES];
+            SB_TEST_ASSERT(k.bytes[0] == (0x02 | (y0 & 1)));
+            parities |= (sb_byte_t) (1 << (y0 & 1));
+            for (size_t j = 0; j < SB_ELEM_BYTES; j++) {
+                const size_t x = (e == SB_DATA_ENDIAN_BIG) ?
+                                 j : SB_ELEM_BYTES - 1 - j;
+                SB_TEST_ASSERT(k.bytes[1 + j] == p.bytes[x]);
+            }
+
+            SB_TEST_ASSERT_SUCCESS(
+                sb_sw_decompress_public_key(&ct, &q, &k, curves[c], e));
+            SB_TEST_ASSERT_EQUAL(p, q);
+        }
+        SB_TEST_ASSERT(parities == 3);
+
+        // Invalid keys are not compressed
+        p.bytes[SB_ELEM_BYTES] ^= 1;
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_compress_public_key(&ct, &k2, &p, curves[c],
+                                      SB_DATA_ENDIAN_LITTLE),
+            SB_ERROR_PUBLIC_KEY_INVALID);
+
+        // Neither are prefixes other than 0x02 and 0x03
+        static const sb_byte_t prefixes[] = { 0x00, 0x01, 0x04, 0x06, 0x12 };
+        for (size_t i = 0; i < sizeof(prefixes); i++) {
+            k2 = k;
+            k2.bytes[0] = prefixes[i];
+            SB_TEST_ASSERT_ERROR(
+                sb_sw_decompress_public_key(&ct, &q, &k2, curves[c],
+                                            SB_DATA_ENDIAN_BIG),
+                SB_ERROR_PUBLIC_KEY_INVALID);
+        }
+
+        // Nor an X coordinate of p, or of 7, for which x^3 + a * x + b is
+        // not a square on either curve
+        k2 = k;
+        sb_fe_to_bytes(k2.bytes + 1, &s->p->p, SB_DATA_ENDIAN_BIG);
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_decompress_public_key(&ct, &q, &k2, curves[c],
+                                        SB_DATA_ENDIAN_BIG),
+            SB_ERROR_PUBLIC_KEY_INVALID);
+        memset(k2.bytes + 1, 0, SB_ELEM_BYTES);
+        k2.bytes[SB_ELEM_BYTES] = 7;
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_decompress_public_key(&ct, &q, &k2, curves[c],
+                                        SB_DATA_ENDIAN_BIG),
+            SB_ERROR_PUBLIC_KEY_INVALID);
+    }
+
+    // On P-256, b is a square, so there are points with an X coordinate of 0
+    memset(k.bytes, 0, sizeof(k));
+    for (sb_byte_t i = 2; i <= 3; i++) {
+        k.bytes[0] = i;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_decompress_public_key(&ct, &q, &k, SB_SW_CURVE_P256,
+                                        SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT((q.bytes[2 * SB_ELEM_BYTES - 1] & 1) == (i & 1));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_compress_public_key(&ct, &k2, &q, SB_SW_CURVE_P256,
+                                      SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(k, k2);
+    }
+    return 1;
+}
+
+_Bool sb_test_sign_rfc6979(void)
+{
+    sb_sw_context_t ct;
+    sb_sw_signature_t out;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest(&ct, &out, &TEST_PRIV_2, &TEST_MESSAGE,
+                                  NULL, SB_SW_CURVE_P256,
+                                  SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_EQUAL(TEST_SIG, out);
+
+    sb_sw_signer_t signer;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_prepare_signer(&ct, &signer, &TEST_PRIV_2, SB_SW_CURVE_P256,
+                             SB_DATA_ENDIAN_BIG));
+    memset(&out, 0, sizeof(out));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_prepared(&ct, &out, &signer, &TEST_MESSAGE,
+                                           NULL, SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_EQUAL(TEST_SIG, out);
+    return 1;
+}
+
+_Bool sb_test_verify(void)
+{
+    sb_sw_context_t ct;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_PUB_2, &TEST_MESSAGE,
+                               NULL, SB_SW_CURVE_P256,
+                               SB_DATA_ENDIAN_BIG));
+
+    sb_sw_public_prepared_t pp;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_prepare_public_key(&ct, &pp, &TEST_PUB_2, SB_SW_CURVE_P256,
+                                 SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_verify_signature_prepared(&ct, &TEST_SIG, &pp, &TEST_MESSAGE,
+                                        NULL, SB_DATA_ENDIAN_BIG));
+#if SB_SW_VARTIME_SUPPORT
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_verify_signature_vartime(&ct, &TEST_SIG, &TEST_PUB_2,
+                                       &TEST_MESSAGE, SB_SW_CURVE_P256,
+                                       SB_DATA_ENDIAN_BIG));
+#endif
+    return 1;
+}
+
+_Bool sb_test_verify_invalid(void)
+{
+    sb_sw_context_t ct;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_PUB_1, &TEST_MESSAGE,
+                               NULL, SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_SIGNATURE_INVALID);
+
+    // This tests that verifying a signature with an invalid public key will
+    // fail with the correct indication:
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_SIG, &TEST_MESSAGE,
+                               NULL, SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+
+    sb_sw_public_prepared_t pp;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_prepare_public_key(&ct, &pp, &TEST_PUB_1, SB_SW_CURVE_P256,
+                                 SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_prepared(&ct, &TEST_SIG, &pp, &TEST_MESSAGE,
+                                        NULL, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_SIGNATURE_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_prepare_public_key(&ct, &pp, &TEST_SIG, SB_SW_CURVE_P256,
+                                 SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+
+#if SB_SW_VARTIME_SUPPORT
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_vartime(&ct, &TEST_SIG, &TEST_PUB_1,
+                                       &TEST_MESSAGE, SB_SW_CURVE_P256,
+                                       SB_DATA_ENDIAN_BIG),
+        SB_ERROR_SIGNATURE_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_vartime(&ct, &TEST_SIG, &TEST_SIG,
+                                       &TEST_MESSAGE, SB_SW_CURVE_P256,
+                                       SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+#endif
+    return 1;
+}
+
+// Checks that the results of batch verification match those of individual
+// verification of each signature
+static _Bool
+sb_test_verify_batch_check(const sb_sw_signature_t sig[static const 1],
+                           const sb_sw_public_t pub[static const 1],
+                           const sb_sw_message_digest_t msg[static const 1],
+                           const size_t count,
+                           sb_hmac_drbg_state_t* const drbg,
+                           const sb_sw_curve_id_t c)
+{
+    sb_sw_context_t ct;
+    sb_byte_t valid[8];
+    sb_error_t expected = SB_SUCCESS;
+
+    SB_TEST_ASSERT(count <= 8 * sizeof(valid));
+    memset(valid, 0xFF, sizeof(valid));
+
+    const sb_error_t err =
+        sb_sw_verify_signature_batch(&ct, valid, sig, pub, msg, count, drbg, c,
+                                     SB_DATA_ENDIAN_BIG);
+
+    for (size_t i = 0; i < count; i++) {
+        const sb_error_t one =
+            sb_sw_verify_signature(&ct, &sig[i], &pub[i], &msg[i], NULL, c,
+                                   SB_DATA_ENDIAN_BIG);
+        const _Bool bit = (valid[i / 8] >> (i & 7)) & 1;
+        SB_TEST_ASSERT(bit == (one == SB_SUCCESS));
+        expected |= one;
+    }
+
+    // Bits beyond count are cleared
+    for (size_t i = count; i < 8 * ((count + 7) / 8); i++) {
+        const _Bool bit = (valid[i / 8] >> (i & 7)) & 1;
+        SB_TEST_ASSERT(!bit);
+    }
+
+    SB_TEST_ASSERT(err == expected);
+    return 1;
+}
+
+static _Bool sb_test_verify_batch_c(const sb_sw_curve_id_t c)
+{
+#define BATCH_COUNT (2 * SB_SW_BATCH_CHUNK + 3)
+    sb_sw_private_t d[BATCH_COUNT];
+    sb_sw_public_t p[BATCH_COUNT];
+    sb_sw_message_digest_t m[BATCH_COUNT];
+    sb_sw_signature_t sig[BATCH_COUNT];
+    sb_sw_context_t ct;
+    const sb_sw_curve_t* s;
+
+    SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, c));
+
+    SB_TEST_ASSERT(sb_test_batch_inputs(d, p, m, BATCH_COUNT, c));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_batch(&ct, sig, d, m, BATCH_COUNT, NULL, c,
+                                        SB_DATA_ENDIAN_BIG));
+
+    // Every signature is valid
+    SB_TEST_ASSERT(sb_test_verify_batch_check(sig, p, m, BATCH_COUNT, NULL, c));
+
+    // A signature of a different message
+    m[1].bytes[1] ^= 1;
+
+    // An invalid public key
+    p[SB_SW_BATCH_CHUNK].bytes[2 * SB_ELEM_BYTES - 1] ^= 1;
+
+    // Out-of-range s and r
+    memset(sig[SB_SW_BATCH_CHUNK + 1].bytes + SB_ELEM_BYTES, 0xFF,
+           SB_ELEM_BYTES);
+    memset(sig[SB_SW_BATCH_CHUNK + 2].bytes, 0xFF, SB_ELEM_BYTES);
+
+    // -H, for which P + H is the point at infinity
+    sb_fe_t h[2];
+    sb_fe_mont_reduce(&h[0], &s->h_r[0], s->p);
+    sb_fe_mont_reduce(&h[1], &s->h_r[1], s->p);
+    sb_fe_mod_sub(&h[1], &s->p->p, &h[1], s->p);
+    sb_fe_to_bytes(p[2 * SB_SW_BATCH_CHUNK].bytes, &h[0], SB_DATA_ENDIAN_BIG);
+    sb_fe_to_bytes(p[2 * SB_SW_BATCH_CHUNK].bytes + SB_ELEM_BYTES, &h[1],
+                   SB_DATA_ENDIAN_BIG);
+
+    SB_TEST_ASSERT(sb_test_verify_batch_check(sig, p, m, BATCH_COUNT, NULL, c));
+
+    // A batch of one signature, and an empty batch
+    SB_TEST_ASSERT(sb_test_verify_batch_check(sig, p, m, 1, NULL, c));
+    SB_TEST_ASSERT(sb_test_verify_batch_check(sig, p, m, 0, NULL, c));
+
+    // With a DRBG
+    sb_hmac_drbg_state_t drbg;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_init(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                          TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2), NULL, 0)
+    );
+    SB_TEST_ASSERT(sb_test_verify_batch_check(&sig[SB_SW_BATCH_CHUNK - 1],
+                                              &p[SB_SW_BATCH_CHUNK - 1],
+                                              &m[SB_SW_BATCH_CHUNK - 1],
+                                              4, &drbg, c));
+
+    // A batch which would exhaust the DRBG fails before doing any work
+    sb_byte_t valid[8];
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_batch(&ct, valid, sig, p, m, BATCH_COUNT, &drbg,
+                                     c, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_RESEED_REQUIRED);
+#undef BATCH_COUNT
+    return 1;
+}
+
+_Bool sb_test_verify_batch(void)
+{
+    return sb_test_verify_batch_c(SB_SW_CURVE_P256);
+}
+
+_Bool sb_test_verify_batch_k256(void)
+{
+    return sb_test_verify_batch_c(SB_SW_CURVE_SECP256K1);
+}
+
+#if SB_SW_VARTIME_SUPPORT
+
+// Computes the recovery id of a valid signature from
+// R = m * s^-1 * G + r * s^-1 * Q, for sb_sw_verify_signature_batch_vartime
+static sb_byte_t
+sb_test_recovery_id(const sb_sw_signature_t sig[static const 1],
+                    const sb_sw_public_t pub[static const 1],
+                    const sb_sw_message_digest_t msg[static const 1],
+                    const sb_sw_curve_t s[static const 1])
+{
+    sb_sw_context_t ct;
+    memset(&ct, 0, sizeof(ct));
+
+    sb_sw_verify_batch_load(&ct, sig, pub, msg, s, SB_DATA_ENDIAN_BIG);
+    sb_sw_verify_scalars(&ct, s);
+    sb_sw_point_mult_add_vartime(&ct, s);
+
+    sb_fe_mod_inv_r(C_T5(&ct), C_T6(&ct), C_T7(&ct), s->p); // t5 = Z^-1 * R
+    sb_fe_mont_square(C_T6(&ct), C_T5(&ct), s->p); // t6 = Z^-2 * R
+    sb_fe_mont_mult(C_T7(&ct), C_T6(&ct), C_T5(&ct), s->p); // t7 = Z^-3 * R
+    sb_fe_mont_mult(C_X2(&ct), C_X1(&ct), C_T6(&ct), s->p); // x2 = x
+    sb_fe_mont_mult(C_Y2(&ct), C_Y1(&ct), C_T7(&ct), s->p); // y2 = y
+
+    return (sb_byte_t) (sb_fe_test_bit(C_Y2(&ct), 0) |
+                        (!sb_fe_lt(C_X2(&ct), &s->n->p) << 1));
+}
+
+// Checks that the results of randomized batch verification match those of
+// individual verification of each signature
+static _Bool
+sb_test_verify_batch_vartime_check(const sb_sw_signature_t sig[static const 1],
+                                   const sb_byte_t* const ids,
+                                   const sb_sw_public_t pub[static const 1],
+                                   const sb_sw_message_digest_t msg[static const 1],
+                                   const size_t count,
+                                   sb_hmac_drbg_state_t drbg[static const 1],
+                                   const sb_sw_curve_id_t c)
+{
+    sb_sw_context_t ct;
+    sb_byte_t valid[8];
+    sb_error_t expected = SB_SUCCESS;
+
+    SB_TEST_ASSERT(count <= 8 * sizeof(valid));
+    memset(valid, 0xFF, sizeof(valid));
+
+    const sb_error_t err =
+        sb_sw_verify_signature_batch_vartime(&ct, valid, sig, ids, pub, msg,
+                                             count, drbg, c,
+                                             SB_DATA_ENDIAN_BIG);
+
+    for (size_t i = 0; i < count; i++) {
+        const sb_error_t one =
+            sb_sw_verify_signature_vartime(&ct, &sig[i], &pub[i], &msg[i], c,
+                                           SB_DATA_ENDIAN_BIG);
+        const _Bool bit = (valid[i / 8] >> (i & 7)) & 1;
+        SB_TEST_ASSERT(bit == (one == SB_SUCCESS));
+        expected |= one;
+    }
+
+    // Bits beyond count are cleared
+    for (size_t i = count; i < 8 * ((count + 7) / 8); i++) {
+        const _Bool bit = (valid[i / 8] >> (i & 7)) & 1;
+        SB_TEST_ASSERT(!bit);
+    }
+
+    SB_TEST_ASSERT(err == expected);
+    return 1;
+}
+
+static _Bool sb_test_verify_batch_vartime_c(const sb_sw_curve_id_t c)
+{
+#define BATCH_COUNT (2 * SB_SW_VARTIME_BATCH_CHUNK + 3)
+    sb_sw_private_t d[BATCH_COUNT];
+    sb_sw_public_t p[BATCH_COUNT];
+    sb_sw_message_digest_t m[BATCH_COUNT];
+    sb_sw_signature_t sig[BATCH_COUNT];
+    sb_byte_t ids[BATCH_COUNT];
+    sb_sw_context_t ct;
+    const sb_sw_curve_t* s;
+
+    SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, c));
+
+    SB_TEST_ASSERT(sb_test_batch_inputs(d, p, m, BATCH_COUNT, c));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_batch(&ct, sig, d, m, BATCH_COUNT, NULL, c,
+                                        SB_DATA_ENDIAN_BIG));
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        ids[i] = sb_test_recovery_id(&sig[i], &p[i], &m[i], s);
+    }
+
+    sb_hmac_drbg_state_t drbg;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_init(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                          TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2), NULL, 0)
+    );
+
+    // Every signature is valid
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, ids, p, m,
+                                                      BATCH_COUNT, &drbg, c));
+
+    // Valid signatures with incorrect or out-of-range recovery ids
+    ids[2] ^= 1;
+    ids[3] = 0xFF;
+    ids[4] |= 2;
+
+    // Signatures of a different message and by a different key
+    m[1].bytes[1] ^= 1;
+    p[5] = p[6];
+
+    // An invalid public key, and out-of-range s and r
+    p[SB_SW_VARTIME_BATCH_CHUNK].bytes[2 * SB_ELEM_BYTES - 1] ^= 1;
+    memset(sig[SB_SW_VARTIME_BATCH_CHUNK + 1].bytes + SB_ELEM_BYTES, 0xFF,
+           SB_ELEM_BYTES);
+    memset(sig[SB_SW_VARTIME_BATCH_CHUNK + 2].bytes, 0xFF, SB_ELEM_BYTES);
+
+    // Two invalid signatures in the same chunk
+    m[SB_SW_VARTIME_BATCH_CHUNK + 3].bytes[1] ^= 1;
+    m[SB_SW_VARTIME_BATCH_CHUNK + 7].bytes[1] ^= 1;
+
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_reseed(&drbg, TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2),
+                            NULL, 0));
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, ids, p, m,
+                                                      BATCH_COUNT, &drbg, c));
+
+    // A batch of one signature, and an empty batch
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, ids, p, m, 1,
+                                                      &drbg, c));
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, ids, p, m, 0,
+                                                      &drbg, c));
+
+    // Without recovery ids
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_reseed(&drbg, TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2),
+                            NULL, 0));
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, NULL, p, m,
+                                                      BATCH_COUNT, &drbg, c));
+
+    // A batch which would exhaust the DRBG fails before doing any work
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_reseed(&drbg, TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2),
+                            NULL, 0));
+    SB_TEST_ASSERT(sb_test_verify_batch_vartime_check(sig, ids, p, m,
+                                                      BATCH_COUNT, &drbg, c));
+    sb_byte_t valid[8];
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_batch_vartime(&ct, valid, sig, ids, p, m,
+                                             BATCH_COUNT, &drbg, c,
+                                             SB_DATA_ENDIAN_BIG),
+        SB_ERROR_RESEED_REQUIRED);
+#undef BATCH_COUNT
+    return 1;
+}
+
+#endif
+
+_Bool sb_test_verify_batch_vartime(void)
+{
+#if SB_SW_VARTIME_SUPPORT
+    return sb_test_verify_batch_vartime_c(SB_SW_CURVE_P256);
+#else
+    return 1;
+#endif
+}
+
+_Bool sb_test_verify_batch_vartime_k256(void)
+{
+#if SB_SW_VARTIME_SUPPORT
+    return sb_test_verify_batch_vartime_c(SB_SW_CURVE_SECP256K1);
+#else
+    return 1;
+#endif
+}
+
+#if SB_SW_VARTIME_SUPPORT
+
+// Checks that sb_sw_multi_mult_vartime, and Straus's method and Pippenger's
+// method with each window up to 6, compute the sum of scalars[i] * points[i]
+// where points[i] = d[i] * G, which is (sum of scalars[i] * d[i] mod N) * G
+static _Bool
+sb_test_multi_mult_check(const sb_sw_scalar_t scalars[static const 1],
+                         const sb_sw_private_t d[static const 1],
+                         const sb_sw_public_t points[static const 1],
+                         const size_t count,
+                         const sb_sw_curve_id_t c)
 {
     sb_sw_context_t ct;
+    sb_sw_public_t expected, out;
+    sb_sw_multi_mult_bucket_t buckets[1 << 5];
+    const sb_sw_curve_t* s;
+    sb_fe_t sum, k, k_r, kd;
+
+    SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, c));
+
+    sum = s->n->p;
+    for (size_t i = 0; i < count; i++) {
+        sb_fe_from_bytes(&k, scalars[i].bytes, SB_DATA_ENDIAN_BIG);
+        if (!sb_fe_lt(&k, &s->n->p)) {
+            sb_fe_sub(&k, &k, &s->n->p);
+        }
+        if (sb_fe_equal(&k, &SB_FE_ZERO)) {
+            continue;
+        }
+        sb_fe_mont_mult(&k_r, &k, &s->n->r2_mod_p, s->n); // k_r = k * R
+        sb_fe_from_bytes(&k, d[i].bytes, SB_DATA_ENDIAN_BIG);
+        sb_fe_mont_mult(&kd, &k_r, &k, s->n);
+        sb_fe_mod_add(&sum, &sum, &kd, s->n);
+    }
+
+    if (sb_fe_equal(&sum, &s->n->p) || sb_fe_equal(&sum, &SB_FE_ZERO)) {
+        memset(&expected, 0, sizeof(expected));
+    } else {
+        sb_sw_private_t e;
+        sb_fe_to_bytes(e.bytes, &sum, SB_DATA_ENDIAN_BIG);
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_compute_public_key(&ct, &expected, &e, NULL, c,
+                                     SB_DATA_ENDIAN_BIG));
+    }
+
     SB_TEST_ASSERT_SUCCESS(
-        sb_sw_valid_public_key(&ct, &TEST_PUB_1, SB_SW_CURVE_P256,
-                               SB_DATA_ENDIAN_BIG));
-    SB_TEST_ASSERT_SUCCESS(
-        sb_sw_valid_public_key(&ct, &TEST_PUB_2, SB_SW_CURVE_P256,
-                               SB_DATA_ENDIAN_BIG));
-    SB_TEST_ASSERT_ERROR(
-        sb_sw_valid_public_key(&ct, &TEST_PUB_2, SB_SW_CURVE_P256,
-                               SB_DATA_ENDIAN_LITTLE),
-        SB_ERROR_PUBLIC_KEY_INVALID);
+        sb_sw_multi_mult_vartime(&ct, &out, scalars, points, count, NULL, 0,
+                                 c, SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_EQUAL(out, expected);
+
+    for (size_t w = 2; w <= 6; w++) {
+        memset(&out, 0xFF, sizeof(out));
+        sb_sw_multi_mult(&ct, &out, scalars, points, count, buckets, w, s,
+                         SB_DATA_ENDIAN_BIG);
+        SB_TEST_ASSERT_EQUAL(out, expected);
+    }
+
     return 1;
 }
 
-static const sb_sw_message_digest_t TEST_MESSAGE = {
-    {
-        0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1,
-        0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
-        0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15,
-        0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
-    }
-};
+static _Bool sb_test_multi_mult_c(const sb_sw_curve_id_t c)
+{
+#define MULTI_COUNT (2 * SB_SW_VARTIME_BATCH_CHUNK + 3)
+    sb_sw_private_t d[MULTI_COUNT];
+    sb_sw_public_t p[MULTI_COUNT];
+    sb_sw_scalar_t k[MULTI_COUNT];
+    const sb_sw_curve_t* s;
 
-static const sb_sw_signature_t TEST_SIG = {
-    {
-        0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD,
-        0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6,
-        0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA, 0xF9, 0x91,
-        0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16,
-        0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41,
-        0xD4, 0x36, 0xC7, 0xA1, 0xB6, 0xE2, 0x9F, 0x65,
-        0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06,
-        0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8
+    SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, c));
+
+    SB_TEST_ASSERT(sb_test_batch_inputs(d, p, NULL, MULTI_COUNT, c));
+
+    // The X coordinates of the points serve as arbitrary scalars
+    for (size_t i = 0; i < MULTI_COUNT; i++) {
+        memcpy(k[i].bytes, p[(i + 1) % MULTI_COUNT].bytes, SB_ELEM_BYTES);
     }
-};
+    SB_TEST_ASSERT(sb_test_multi_mult_check(k, d, p, MULTI_COUNT, c));
+
+    // Scalars of zero, one, and 2^256 - 1, which is not reduced
+    memset(k[0].bytes, 0, SB_ELEM_BYTES);
+    memset(k[1].bytes, 0, SB_ELEM_BYTES);
+    k[1].bytes[SB_ELEM_BYTES - 1] = 1;
+    memset(k[2].bytes, 0xFF, SB_ELEM_BYTES);
+    SB_TEST_ASSERT(sb_test_multi_mult_check(k, d, p, MULTI_COUNT, c));
+
+    // One point, and no points
+    SB_TEST_ASSERT(sb_test_multi_mult_check(&k[1], &d[1], &p[1], 1, c));
+    SB_TEST_ASSERT(sb_test_multi_mult_check(k, d, p, 0, c));
+
+    // The same point with small scalars, so that equal points are added both
+    // to buckets and to sums of buckets
+    for (size_t i = 0; i < MULTI_COUNT; i++) {
+        d[i] = d[0];
+        p[i] = p[0];
+        memset(k[i].bytes, 0, SB_ELEM_BYTES);
+        k[i].bytes[SB_ELEM_BYTES - 1] = (sb_byte_t) (i + 1);
+    }
+    SB_TEST_ASSERT(sb_test_multi_mult_check(k, d, p, MULTI_COUNT, c));
+
+    // A sum which is the point at infinity: (N - 5) * P + 5 * P
+    sb_fe_t n_5;
+    sb_fe_from_bytes(&n_5, k[4].bytes, SB_DATA_ENDIAN_BIG);
+    sb_fe_sub(&n_5, &s->n->p, &n_5);
+    sb_fe_to_bytes(k[3].bytes, &n_5, SB_DATA_ENDIAN_BIG);
+    SB_TEST_ASSERT(sb_test_multi_mult_check(&k[3], &d[3], &p[3], 2, c));
+
+    // Pippenger's method is used only for many points, and only when there
+    // are buckets for it
+    SB_TEST_ASSERT(sb_sw_multi_mult_window(16, 1 << 10) == 0);
+    SB_TEST_ASSERT(sb_sw_multi_mult_window(1 << 12, 0) == 0);
+    SB_TEST_ASSERT(sb_sw_multi_mult_window(1 << 12, 1 << 10) > 6);
+#undef MULTI_COUNT
+    return 1;
+}
 
-_Bool sb_test_sign_rfc6979(void)
+#endif
+
+_Bool sb_test_multi_mult(void)
 {
-    sb_sw_context_t ct;
-    sb_sw_signature_t out;
-    SB_TEST_ASSERT_SUCCESS(
-        sb_sw_sign_message_digest(&ct, &out, &TEST_PRIV_2, &TEST_MESSAGE,
-                                  NULL, SB_SW_CURVE_P256,
-                                  SB_DATA_ENDIAN_BIG));
-    SB_TEST_ASSERT_EQUAL(TEST_SIG, out);
+#if SB_SW_VARTIME_SUPPORT
+    return sb_test_multi_mult_c(SB_SW_CURVE_P256);
+#else
     return 1;
+#endif
 }
 
-_Bool sb_test_verify(void)
+_Bool sb_test_multi_mult_k256(void)
 {
-    sb_sw_context_t ct;
-    SB_TEST_ASSERT_SUCCESS(
-        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_PUB_2, &TEST_MESSAGE,
-                               NULL, SB_SW_CURVE_P256,
-                               SB_DATA_ENDIAN_BIG));
+#if SB_SW_VARTIME_SUPPORT
+    return sb_test_multi_mult_c(SB_SW_CURVE_SECP256K1);
+#else
     return 1;
+#endif
 }
 
-_Bool sb_test_verify_invalid(void)
+static _Bool sb_test_recover_public_key_c(const sb_sw_curve_id_t c)
 {
+    sb_sw_private_t d;
+    sb_sw_public_t p, q;
+    sb_sw_message_digest_t m;
+    sb_sw_signature_t sig, sig2;
     sb_sw_context_t ct;
+    sb_byte_t id;
+    const sb_sw_curve_t* s;
+
+    SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, c));
+
+    for (size_t i = 0; i < 8; i++) {
+        SB_TEST_ASSERT(sb_test_batch_key(&d, &p, i, c, SB_DATA_ENDIAN_BIG));
+        m = TEST_MESSAGE;
+        m.bytes[0] ^= (sb_byte_t) i;
+        if (i == 0) {
+            // A message of N, for which only R is multiplied
+            sb_fe_to_bytes(m.bytes, &s->n->p, SB_DATA_ENDIAN_BIG);
+        }
+
+        // The signature is the same as sb_sw_sign_message_digest produces
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest_recoverable(&ct, &sig, &id, &d, &m,
+                                                  NULL, c,
+                                                  SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest(&ct, &sig2, &d, &m, NULL, c,
+                                      SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(sig, sig2);
+        SB_TEST_ASSERT(id <= 1);
+
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_recover_public_key(&ct, &q, &sig, id, &m, NULL, c,
+                                     SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(p, q);
+
+        // The other parity gives a different key for which the signature is
+        // also valid
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_recover_public_key(&ct, &q, &sig, id ^ 1, &m, NULL, c,
+                                     SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_NOT_EQUAL(p, q);
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature(&ct, &sig, &q, &m, NULL, c,
+                                   SB_DATA_ENDIAN_BIG));
+
+        // r + N is not a valid X coordinate, and neither is 4 a valid id
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_recover_public_key(&ct, &q, &sig, id | 2, &m, NULL, c,
+                                     SB_DATA_ENDIAN_BIG),
+            SB_ERROR_SIGNATURE_INVALID);
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_recover_public_key(&ct, &q, &sig, 4, &m, NULL, c,
+                                     SB_DATA_ENDIAN_BIG),
+            SB_ERROR_SIGNATURE_INVALID);
+    }
+
+    // A different message gives a different key
+    m.bytes[1] ^= 1;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_recover_public_key(&ct, &q, &sig, id, &m, NULL, c,
+                                 SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_NOT_EQUAL(p, q);
+
+    // With a DRBG, the same key is recovered
+    m.bytes[1] ^= 1;
+    sb_hmac_drbg_state_t drbg;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_init(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                          TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2), NULL, 0)
+    );
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_recover_public_key(&ct, &q, &sig, id, &m, &drbg, c,
+                                 SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_EQUAL(p, q);
+
+    // Out-of-range scalars
+    sig2 = sig;
+    memset(sig2.bytes, 0xFF, SB_ELEM_BYTES);
     SB_TEST_ASSERT_ERROR(
-        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_PUB_1, &TEST_MESSAGE,
-                               NULL, SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
+        sb_sw_recover_public_key(&ct, &q, &sig2, id, &m, NULL, c,
+                                 SB_DATA_ENDIAN_BIG),
+        SB_ERROR_SIGNATURE_INVALID);
+    sig2 = sig;
+    memset(sig2.bytes + SB_ELEM_BYTES, 0, SB_ELEM_BYTES);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_recover_public_key(&ct, &q, &sig2, id, &m, NULL, c,
+                                 SB_DATA_ENDIAN_BIG),
         SB_ERROR_SIGNATURE_INVALID);
 
-    // This tests that verifying a signature with an invalid public key will
-    // fail with the correct indication:
+    // An r which is not the X coordinate of any point; for both curves,
+    // x = 7 gives a non-square y^2
+    sig2 = sig;
+    memset(sig2.bytes, 0, SB_ELEM_BYTES);
+    sig2.bytes[SB_ELEM_BYTES - 1] = 7;
     SB_TEST_ASSERT_ERROR(
-        sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_SIG, &TEST_MESSAGE,
-                               NULL, SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
-        SB_ERROR_PUBLIC_KEY_INVALID);
+        sb_sw_recover_public_key(&ct, &q, &sig2, id, &m, NULL, c,
+                                 SB_DATA_ENDIAN_BIG),
+        SB_ERROR_SIGNATURE_INVALID);
+    return 1;
+}
+
+_Bool sb_test_recover_public_key(void)
+{
+    return sb_test_recover_public_key_c(SB_SW_CURVE_P256);
+}
+
+_Bool sb_test_recover_public_key_k256(void)
+{
+    return sb_test_recover_public_key_c(SB_SW_CURVE_SECP256K1);
+}
+
+// Test verification with a prepared public key when the comb multiplication
+// encounters an exceptional addition: with public key G and r = m, both
+// scalars are equal, so the first column of P doubles the first column of G.
+_Bool sb_test_verify_prepared(void)
+{
+    static const sb_sw_curve_id_t curves[] = {
+        SB_SW_CURVE_P256, SB_SW_CURVE_SECP256K1
+    };
+
+    for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); c++) {
+        const sb_sw_curve_t* s;
+        SB_TEST_ASSERT_SUCCESS(sb_sw_curve_from_id(&s, curves[c]));
+
+        sb_sw_context_t ct;
+        memset(&ct, 0, sizeof(ct));
+
+        // r = x(k * G) mod N
+        const sb_fe_t k = SB_FE_CONST(0, 0, 0, 0x1234567);
+        *MULT_K(&ct) = k;
+        *MULT_Z(&ct) = SB_FE_ONE;
+        sb_sw_point_mult(&ct, s->g_r, s);
+        sb_fe_t r = *C_X1(&ct);
+        sb_fe_qr(&r, 0, s->n);
+
+        // s = k^-1 * (m + r * d) = k^-1 * 2 * r with m = r and d = 1
+        sb_fe_t t5, t6, t7, sig_s;
+        sb_fe_mont_mult(&t5, &k, &s->n->r2_mod_p, s->n);
+        sb_fe_mod_inv_r(&t5, &t6, &t7, s->n);
+        sb_fe_mod_add(&t6, &r, &r, s->n);
+        sb_fe_mont_mult(&sig_s, &t6, &t5, s->n);
+
+        sb_sw_signature_t sig;
+        sb_sw_message_digest_t m;
+        sb_sw_public_t g;
+        sb_fe_to_bytes(sig.bytes, &r, SB_DATA_ENDIAN_BIG);
+        sb_fe_to_bytes(sig.bytes + SB_ELEM_BYTES, &sig_s, SB_DATA_ENDIAN_BIG);
+        sb_fe_to_bytes(m.bytes, &r, SB_DATA_ENDIAN_BIG);
+        sb_fe_mont_reduce(&t5, &s->g_r[0], s->p);
+        sb_fe_mont_reduce(&t6, &s->g_r[1], s->p);
+        sb_fe_to_bytes(g.bytes, &t5, SB_DATA_ENDIAN_BIG);
+        sb_fe_to_bytes(g.bytes + SB_ELEM_BYTES, &t6, SB_DATA_ENDIAN_BIG);
+
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature(&ct, &sig, &g, &m, NULL, curves[c],
+                                   SB_DATA_ENDIAN_BIG));
+
+        sb_sw_public_prepared_t pp;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_prepare_public_key(&ct, &pp, &g, curves[c],
+                                     SB_DATA_ENDIAN_BIG));
+
+#if SB_SW_FIXED_BASE_WINDOW
+        // The comb table of G computed for a public key matches the
+        // precomputed one.
+        for (size_t i = 0; i < SB_SW_FIXED_BASE_ENTRIES; i++) {
+            SB_TEST_ASSERT(sb_fe_equal(&pp.comb[i][0], &s->g_comb[i][0]) &&
+                           sb_fe_equal(&pp.comb[i][1], &s->g_comb[i][1]));
+        }
+
+        memset(&ct, 0, sizeof(ct));
+        *MULT_Z(&ct) = SB_FE_ONE;
+        *MULT_K(&ct) = r;
+        *MULT_ADD_KG(&ct) = r;
+        SB_TEST_ASSERT(sb_sw_point_mult_add_comb(
+            &ct, (const sb_fe_t (*)[2]) pp.comb, s));
+#endif
+
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature_prepared(&ct, &sig, &pp, &m, NULL,
+                                            SB_DATA_ENDIAN_BIG));
+
+        sig.bytes[SB_ELEM_BYTES] ^= 1;
+        SB_TEST_ASSERT_ERROR(
+            sb_sw_verify_signature_prepared(&ct, &sig, &pp, &m, NULL,
+                                            SB_DATA_ENDIAN_BIG),
+            SB_ERROR_SIGNATURE_INVALID);
+    }
     return 1;
 }
 
@@ -1738,7 +6513,9 @@ static _Bool sb_test_sign_iter_c(const sb_sw_curve_id_t c)
 {
     sb_sw_private_t d;
     sb_sw_public_t p;
-    sb_sw_signature_t s;
+    sb_sw_public_prepared_t pp;
+    sb_sw_signer_t signer;
+    sb_sw_signature_t s, s2;
     sb_sw_context_t ct;
     size_t i = 0;
 
@@ -1752,12 +6529,34 @@ static _Bool sb_test_sign_iter_c(const sb_sw_curve_id_t c)
                                                           SB_DATA_ENDIAN_BIG));
         SB_TEST_ASSERT_SUCCESS(sb_sw_compute_public_key(&ct, &p, &d, &drbg, c,
                                                         SB_DATA_ENDIAN_BIG));
+
+        // A prepared signer produces the same signature given the same DRBG
+        // state
+        sb_hmac_drbg_state_t drbg2 = drbg;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_prepare_signer(&ct, &signer, &d, c, SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest_prepared(&ct, &s2, &signer,
+                                               &TEST_MESSAGE, &drbg2,
+                                               SB_DATA_ENDIAN_BIG));
+
         SB_TEST_ASSERT_SUCCESS(
             sb_sw_sign_message_digest(&ct, &s, &d, &TEST_MESSAGE, &drbg,
                                       c, SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(s, s2);
         SB_TEST_ASSERT_SUCCESS(
             sb_sw_verify_signature(&ct, &s, &p, &TEST_MESSAGE, &drbg, c,
                                    SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_prepare_public_key(&ct, &pp, &p, c, SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature_prepared(&ct, &s, &pp, &TEST_MESSAGE,
+                                            &drbg, SB_DATA_ENDIAN_BIG));
+#if SB_SW_VARTIME_SUPPORT
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature_vartime(&ct, &s, &p, &TEST_MESSAGE, c,
+                                           SB_DATA_ENDIAN_BIG));
+#endif
         SB_TEST_ASSERT_SUCCESS(
             sb_hmac_drbg_reseed(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
                                 TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2))
@@ -1777,6 +6576,182 @@ _Bool sb_test_sign_iter_k256(void)
     return sb_test_sign_iter_c(SB_SW_CURVE_SECP256K1);
 }
 
+static _Bool sb_test_sign_presigned_c(const sb_sw_curve_id_t c)
+{
+    static const sb_sw_presignature_t zero_presignature;
+    sb_sw_presignature_t entries[4];
+    sb_sw_presignature_pool_t pool;
+    sb_sw_private_t d;
+    sb_sw_public_t p;
+    sb_sw_signer_t signer;
+    sb_sw_signature_t s[4];
+    sb_sw_message_digest_t m = TEST_MESSAGE;
+    sb_sw_context_t ct;
+
+    sb_hmac_drbg_state_t drbg;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_init(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                          TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2), NULL, 0)
+    );
+
+    SB_TEST_ASSERT_SUCCESS(sb_sw_generate_private_key(&ct, &d, &drbg, c,
+                                                      SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_SUCCESS(sb_sw_compute_public_key(&ct, &p, &d, &drbg, c,
+                                                    SB_DATA_ENDIAN_BIG));
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_prepare_signer(&ct, &signer, &d, c, SB_DATA_ENDIAN_BIG));
+
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_presignature_pool_init(&pool, entries, 4, c));
+    SB_TEST_ASSERT(pool.count == 0);
+
+    // With room for only two more DRBG generate calls, a single
+    // presignature is generated before the pool asks to be reseeded
+    drbg.reseed_counter = SB_HMAC_DRBG_RESEED_INTERVAL - 2;
+    SB_TEST_ASSERT_ERROR(sb_sw_presignature_pool_fill(&ct, &pool, &drbg),
+                         SB_ERROR_RESEED_REQUIRED);
+    SB_TEST_ASSERT(pool.count == 1);
+
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_reseed(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                            TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2))
+    );
+    SB_TEST_ASSERT_SUCCESS(sb_sw_presignature_pool_fill(&ct, &pool, &drbg));
+    SB_TEST_ASSERT(pool.count == 4);
+
+    // Filling a full pool does nothing
+    SB_TEST_ASSERT_SUCCESS(sb_sw_presignature_pool_fill(&ct, &pool, &drbg));
+    SB_TEST_ASSERT(pool.count == 4);
+
+    for (size_t i = 0; i < 4; i++) {
+        m.bytes[0] = (sb_byte_t) i;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest_presigned(&ct, &s[i], &pool, &signer,
+                                                &m, SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT(pool.count == 3 - i);
+
+        // The presignature is wiped once it has been consumed
+        SB_TEST_ASSERT_EQUAL(entries[3 - i], zero_presignature);
+
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature(&ct, &s[i], &p, &m, NULL, c,
+                                   SB_DATA_ENDIAN_BIG));
+
+        // Every presignature uses a different per-message secret
+        for (size_t j = 0; j < i; j++) {
+            SB_TEST_ASSERT_NOT_EQUAL(s[i], s[j], SB_ELEM_BYTES);
+        }
+    }
+
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_presigned(&ct, &s[0], &pool, &signer, &m,
+                                            SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PRESIGNATURE_POOL_EMPTY);
+
+    // The signer and pool must agree on the curve
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_reseed(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                            TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2))
+    );
+    SB_TEST_ASSERT_SUCCESS(sb_sw_presignature_pool_fill(&ct, &pool, &drbg));
+    signer.curve = (c == SB_SW_CURVE_P256 ? SB_SW_CURVE_SECP256K1 :
+                    SB_SW_CURVE_P256);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_presigned(&ct, &s[0], &pool, &signer, &m,
+                                            SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+    SB_TEST_ASSERT(pool.count == 4);
+    return 1;
+}
+
+_Bool sb_test_sign_presigned(void)
+{
+    return sb_test_sign_presigned_c(SB_SW_CURVE_P256);
+}
+
+_Bool sb_test_sign_presigned_k256(void)
+{
+    return sb_test_sign_presigned_c(SB_SW_CURVE_SECP256K1);
+}
+
+static _Bool sb_test_sign_batch_c(const sb_sw_curve_id_t c)
+{
+#define BATCH_COUNT (2 * SB_SW_BATCH_CHUNK + 3)
+    sb_sw_private_t d[BATCH_COUNT];
+    sb_sw_message_digest_t m[BATCH_COUNT];
+    sb_sw_signature_t s[BATCH_COUNT], s2;
+    sb_sw_public_t p;
+    sb_sw_context_t ct;
+
+    SB_TEST_ASSERT(sb_test_batch_inputs(d, NULL, m, BATCH_COUNT, c));
+
+    // RFC6979 signatures in a batch spanning several chunks are the same as
+    // those produced one at a time
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_batch(&ct, s, d, m, BATCH_COUNT, NULL, c,
+                                        SB_DATA_ENDIAN_BIG));
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest(&ct, &s2, &d[i], &m[i], NULL, c,
+                                      SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(s[i], s2);
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_compute_public_key(&ct, &p, &d[i], NULL, c,
+                                     SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature(&ct, &s[i], &p, &m[i], NULL, c,
+                                   SB_DATA_ENDIAN_BIG));
+    }
+
+    // An empty batch does nothing
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_batch(&ct, s, d, m, 0, NULL, c,
+                                        SB_DATA_ENDIAN_BIG));
+
+    // With a DRBG, signatures are the same as those produced one at a time
+    // given the same DRBG state
+    sb_hmac_drbg_state_t drbg, drbg2;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_hmac_drbg_init(&drbg, TEST_PRIV_1.bytes, sizeof(TEST_PRIV_1),
+                          TEST_PRIV_2.bytes, sizeof(TEST_PRIV_2), NULL, 0)
+    );
+    drbg2 = drbg;
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_sign_message_digest_batch(&ct, s, d, m, 2, &drbg, c,
+                                        SB_DATA_ENDIAN_BIG));
+    for (size_t i = 0; i < 2; i++) {
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_sign_message_digest(&ct, &s2, &d[i], &m[i], &drbg2, c,
+                                      SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_EQUAL(s[i], s2);
+    }
+
+    // A batch which would exhaust the DRBG fails before doing any work
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_batch(&ct, s, d, m, BATCH_COUNT, &drbg, c,
+                                        SB_DATA_ENDIAN_BIG),
+        SB_ERROR_RESEED_REQUIRED);
+
+    // Any invalid private key fails the whole batch
+    memset(&d[SB_SW_BATCH_CHUNK], 0, sizeof(d[0]));
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_batch(&ct, s, d, m, BATCH_COUNT, NULL, c,
+                                        SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PRIVATE_KEY_INVALID);
+#undef BATCH_COUNT
+    return 1;
+}
+
+_Bool sb_test_sign_batch(void)
+{
+    return sb_test_sign_batch_c(SB_SW_CURVE_P256);
+}
+
+_Bool sb_test_sign_batch_k256(void)
+{
+    return sb_test_sign_batch_c(SB_SW_CURVE_SECP256K1);
+}
+
 static _Bool sb_test_shared_iter_c(const sb_sw_curve_id_t c)
 {
     sb_sw_private_t d, d2;
@@ -1943,11 +6918,86 @@ _Bool sb_test_sw_early_errors(void)
                                   &drbg, SB_SW_CURVE_INVALID,
                                   SB_DATA_ENDIAN_BIG),
         (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+    sb_sw_signer_t signer;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_prepare_signer(&ct, &signer, &TEST_PRIV_1, SB_SW_CURVE_INVALID,
+                             SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+    memset(&signer, 0, sizeof(signer));
+    signer.curve = SB_SW_CURVE_INVALID;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_prepared(&ct, &d, &signer, &TEST_MESSAGE,
+                                           &drbg, SB_DATA_ENDIAN_BIG),
+        (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_batch(&ct, &d, &TEST_PRIV_1, &TEST_MESSAGE,
+                                        1, &drbg, SB_SW_CURVE_INVALID,
+                                        SB_DATA_ENDIAN_BIG),
+        (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+    sb_byte_t valid;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_batch(&ct, &valid, &TEST_SIG, &TEST_PUB_1,
+                                     &TEST_MESSAGE, 1, &drbg,
+                                     SB_SW_CURVE_INVALID, SB_DATA_ENDIAN_BIG),
+        (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+    sb_sw_presignature_t entry;
+    sb_sw_presignature_pool_t pool;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_presignature_pool_init(&pool, &entry, 1, SB_SW_CURVE_INVALID),
+        SB_ERROR_CURVE_INVALID);
+    pool.entries = &entry;
+    pool.capacity = 1;
+    pool.count = 0;
+    pool.curve = SB_SW_CURVE_INVALID;
+    SB_TEST_ASSERT_ERROR(sb_sw_presignature_pool_fill(&ct, &pool, &drbg),
+                         SB_ERROR_CURVE_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_sign_message_digest_presigned(&ct, &d, &pool, &signer,
+                                            &TEST_MESSAGE, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+
+    // A valid pool that must be reseeded fails before doing any work
+    SB_TEST_ASSERT_SUCCESS(
+        sb_sw_presignature_pool_init(&pool, &entry, 1, SB_SW_CURVE_P256));
+    SB_TEST_ASSERT_ERROR(sb_sw_presignature_pool_fill(&ct, &pool, &drbg),
+                         SB_ERROR_RESEED_REQUIRED);
+    SB_TEST_ASSERT(pool.count == 0);
+
+    // A private key of zero is invalid
+    memset(&s, 0, sizeof(s));
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_prepare_signer(&ct, &signer, &s, SB_SW_CURVE_P256,
+                             SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PRIVATE_KEY_INVALID);
     SB_TEST_ASSERT_ERROR(
         sb_sw_verify_signature(&ct, &TEST_SIG, &TEST_PUB_1, &TEST_MESSAGE,
                                &drbg, SB_SW_CURVE_INVALID,
                                SB_DATA_ENDIAN_BIG),
         (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+    sb_sw_public_prepared_t pp;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_prepare_public_key(&ct, &pp, &TEST_PUB_1, SB_SW_CURVE_INVALID,
+                                 SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+    memset(&pp, 0, sizeof(pp));
+    pp.curve = SB_SW_CURVE_INVALID;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_prepared(&ct, &TEST_SIG, &pp, &TEST_MESSAGE,
+                                        &drbg, SB_DATA_ENDIAN_BIG),
+        (SB_ERROR_CURVE_INVALID | SB_ERROR_RESEED_REQUIRED));
+#if SB_SW_VARTIME_SUPPORT
+    sb_double_t o;
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_vartime(&ct, &TEST_SIG, &TEST_PUB_1,
+                                       &TEST_MESSAGE, SB_SW_CURVE_INVALID,
+                                       SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_multi_mult_vartime(&ct, &o, &TEST_PRIV_1, &TEST_PUB_1, 1, NULL,
+                                 0, SB_SW_CURVE_INVALID, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_CURVE_INVALID);
+#endif
 
     d = TEST_PUB_1;
     d.bytes[0] ^= 1;
@@ -1964,6 +7014,20 @@ _Bool sb_test_sw_early_errors(void)
         sb_sw_verify_signature(&ct, &TEST_SIG, &d, &TEST_MESSAGE, NULL,
                                SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
         SB_ERROR_PUBLIC_KEY_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_prepare_public_key(&ct, &pp, &d, SB_SW_CURVE_P256,
+                                 SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+#if SB_SW_VARTIME_SUPPORT
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_verify_signature_vartime(&ct, &TEST_SIG, &d, &TEST_MESSAGE,
+                                       SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+    SB_TEST_ASSERT_ERROR(
+        sb_sw_multi_mult_vartime(&ct, &o, &TEST_PRIV_1, &d, 1, NULL, 0,
+                                 SB_SW_CURVE_P256, SB_DATA_ENDIAN_BIG),
+        SB_ERROR_PUBLIC_KEY_INVALID);
+#endif
 
     return 1;
 }
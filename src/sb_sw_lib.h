@@ -28,6 +28,14 @@ typedef sb_single_t sb_sw_shared_secret_t;
 typedef sb_single_t sb_sw_message_digest_t;
 typedef sb_double_t sb_sw_public_t;
 typedef sb_double_t sb_sw_signature_t;
+typedef sb_single_t sb_sw_scalar_t;
+
+// A public key in the compressed form of SEC 1 section 2.3.3: a byte of 0x02
+// if the Y coordinate is even or 0x03 if it is odd, followed by the X
+// coordinate in big-endian order
+typedef struct sb_sw_compressed_public_t {
+    sb_byte_t bytes[SB_ELEM_BYTES + 1];
+} sb_sw_compressed_public_t;
 
 #ifndef SB_SW_P256_SUPPORT
 #define SB_SW_P256_SUPPORT 1
@@ -41,6 +49,93 @@ typedef sb_double_t sb_sw_signature_t;
 #error "One of SB_SW_P256_SUPPORT or SB_SW_SECP256K1_SUPPORT must be enabled!"
 #endif
 
+// Multiplication of the curve generator in key generation and signing uses a
+// fixed-base comb with this many teeth, which must be 4, 5, or 6. The comb
+// table holds 2^(SB_SW_FIXED_BASE_WINDOW - 1) points (512 bytes to 2 KiB) per
+// curve. If set to 0, the generator is multiplied with the same Montgomery
+// ladder used for other points, and no table is included.
+#ifndef SB_SW_FIXED_BASE_WINDOW
+#define SB_SW_FIXED_BASE_WINDOW 5
+#endif
+
+#if SB_SW_FIXED_BASE_WINDOW
+#define SB_SW_FIXED_BASE_ENTRIES (1 << (SB_SW_FIXED_BASE_WINDOW - 1))
+#endif
+
+// On secp256k1, multiplication of other points (and of the generator if
+// SB_SW_FIXED_BASE_WINDOW is 0) uses the curve's endomorphism to split the
+// scalar into two halves of about 129 bits, which are multiplied together
+// using signed windows of SB_SW_GLV_WINDOW bits. This must be 0 or 3 through
+// 6; the window's 2^(SB_SW_GLV_WINDOW - 1) odd multiples of the point take
+// 384 bytes to 3 KiB of stack. If set to 0, every point is multiplied with
+// the Montgomery ladder.
+#ifndef SB_SW_GLV_WINDOW
+#define SB_SW_GLV_WINDOW 4
+#endif
+
+#if SB_SW_GLV_WINDOW && (SB_SW_GLV_WINDOW < 3 || SB_SW_GLV_WINDOW > 6)
+#error "SB_SW_GLV_WINDOW must be 0, 3, 4, 5, or 6"
+#endif
+
+#if SB_SW_GLV_WINDOW
+#define SB_SW_GLV_ENTRIES (1 << (SB_SW_GLV_WINDOW - 1))
+#endif
+
+// On P-256 (and on secp256k1 if SB_SW_GLV_WINDOW is 0), multiplication of
+// other points uses signed windows of SB_SW_VARIABLE_BASE_WINDOW bits over
+// the whole scalar. This must be 0 or 3 through 6; as above, the window's
+// odd multiples of the point take 384 bytes to 3 KiB of stack. If set to 0,
+// these points are multiplied with the Montgomery ladder.
+#ifndef SB_SW_VARIABLE_BASE_WINDOW
+#define SB_SW_VARIABLE_BASE_WINDOW 5
+#endif
+
+#if SB_SW_VARIABLE_BASE_WINDOW && \
+    (SB_SW_VARIABLE_BASE_WINDOW < 3 || SB_SW_VARIABLE_BASE_WINDOW > 6)
+#error "SB_SW_VARIABLE_BASE_WINDOW must be 0, 3, 4, 5, or 6"
+#endif
+
+#if SB_SW_VARIABLE_BASE_WINDOW
+#define SB_SW_VARIABLE_BASE_ENTRIES (1 << (SB_SW_VARIABLE_BASE_WINDOW - 1))
+#endif
+
+// sb_sw_verify_signature_vartime uses a table of 16 precomputed multiples of
+// the curve generator (1 KiB per curve), and on secp256k1 another such table
+// of multiples of lambda * G, where lambda is the eigenvalue of the curve's
+// endomorphism. Set SB_SW_VARTIME_SUPPORT to 0 to omit the tables and the
+// function.
+#ifndef SB_SW_VARTIME_SUPPORT
+#define SB_SW_VARTIME_SUPPORT 1
+#endif
+
+// sb_sw_sign_message_digest_batch and sb_sw_verify_signature_batch share the
+// inversions needed for each signature among chunks of up to
+// SB_SW_BATCH_CHUNK signatures. Each signature in a chunk uses 128 bytes of
+// stack when signing (four field elements) and 133 bytes when verifying (four
+// field elements, an error code, and a flag). Larger chunks save more
+// inversions, but most of the benefit is already had with 8.
+#ifndef SB_SW_BATCH_CHUNK
+#define SB_SW_BATCH_CHUNK 8
+#endif
+
+#if SB_SW_BATCH_CHUNK < 1
+#error "SB_SW_BATCH_CHUNK must be at least 1"
+#endif
+
+// sb_sw_verify_signature_batch_vartime checks chunks of up to
+// SB_SW_VARTIME_BATCH_CHUNK signatures at once, using about 2 KiB of stack per
+// signature in a chunk. The point doublings in each check are shared among
+// the signatures in the chunk; beyond 16, they are a small part of the cost.
+// Without buckets, sb_sw_multi_mult_vartime likewise multiplies chunks of up
+// to this many points at once, using about 1.1 KiB of stack per point.
+#ifndef SB_SW_VARTIME_BATCH_CHUNK
+#define SB_SW_VARTIME_BATCH_CHUNK 16
+#endif
+
+#if SB_SW_VARTIME_BATCH_CHUNK < 1
+#error "SB_SW_VARTIME_BATCH_CHUNK must be at least 1"
+#endif
+
 typedef enum sb_sw_curve_id_value_t {
 #if SB_SW_P256_SUPPORT
     SB_SW_CURVE_P256 = 0,
@@ -55,6 +150,65 @@ typedef enum sb_sw_curve_id_value_t {
 
 typedef uint32_t sb_sw_curve_id_t;
 
+// A public key prepared for repeated signature verification by
+// sb_sw_prepare_public_key. Its contents are private to Sweet B. It contains
+// no secret information and may be stored and reused indefinitely. If
+// SB_SW_FIXED_BASE_WINDOW is nonzero, it holds a comb table for the key and
+// takes about 0.6, 1.1, or 2.1 KiB for 4, 5, or 6 teeth; otherwise, it takes
+// about 200 bytes.
+typedef struct sb_sw_public_prepared_t {
+    sb_fe_t p[2];
+#if SB_SW_FIXED_BASE_WINDOW
+    sb_fe_t comb[SB_SW_FIXED_BASE_ENTRIES][2];
+#else
+    sb_fe_t p_h[2][2];
+#endif
+    sb_sw_curve_id_t curve;
+} sb_sw_public_prepared_t;
+
+// A private key prepared for repeated signing by sb_sw_prepare_signer. Its
+// contents are private to Sweet B. It contains the private key, so you are
+// responsible for protecting it and for clearing it (for instance, with
+// memset) when it is no longer needed.
+typedef struct sb_sw_signer_t {
+    sb_sw_private_t private;
+    sb_fe_t d;
+    sb_fe_t d_r;
+    sb_sw_curve_id_t curve;
+} sb_sw_signer_t;
+
+// A presignature generated by sb_sw_presignature_pool_fill. Its contents are
+// private to Sweet B. It holds the inverse of a per-message secret, from
+// which the private key used to sign with it can be recovered; it must be
+// kept secret and must never be used for more than one signature.
+typedef struct sb_sw_presignature_t {
+    sb_fe_t k_inv_r;
+    sb_fe_t r;
+} sb_sw_presignature_t;
+
+// A bounded pool of presignatures over storage that you provide. Its
+// contents are private to Sweet B; initialize it with
+// sb_sw_presignature_pool_init. count is the number of presignatures
+// currently available. Presignatures are wiped from the storage as they are
+// consumed, but you are responsible for protecting the storage and for
+// clearing it when the pool is no longer needed.
+typedef struct sb_sw_presignature_pool_t {
+    sb_sw_presignature_t* entries;
+    size_t capacity;
+    size_t count;
+    sb_sw_curve_id_t curve;
+} sb_sw_presignature_pool_t;
+
+#if SB_SW_VARTIME_SUPPORT
+
+// A bucket used by sb_sw_multi_mult_vartime, which holds a point in Jacobian
+// coordinates (96 bytes). Its contents are private to Sweet B.
+typedef struct sb_sw_multi_mult_bucket_t {
+    sb_fe_t p[3];
+} sb_sw_multi_mult_bucket_t;
+
+#endif
+
 // see sb_types.h for the definition of sb_data_endian_t
 
 // All of the following methods take an initial parameter of type
@@ -86,7 +240,9 @@ typedef uint32_t sb_sw_curve_id_t;
 // ensuring that the HMAC-DRBG instance supplied has been seeded with
 // sufficient entropy at initialization time.
 
-// This is the only method which requires a HMAC-DRBG instance to be passed.
+// This method, sb_sw_presignature_pool_fill, and
+// sb_sw_verify_signature_batch_vartime are the only methods which require a
+// HMAC-DRBG instance to be passed.
 // You do not need to use this method to generate private keys. Alternatively,
 // you could repeatedly call sb_sw_compute_public_key with random bytes until
 // it succeeds.
@@ -125,6 +281,36 @@ extern sb_error_t sb_sw_valid_public_key(sb_sw_context_t context[static 1],
                                          sb_sw_curve_id_t curve,
                                          sb_data_endian_t e);
 
+// sb_sw_compress_public_key:
+
+// Compresses the supplied public key, which is validated as by
+// sb_sw_valid_public_key. The endianness applies to the uncompressed key;
+// the compressed key is always in SEC 1 form. Returns
+// SB_ERROR_PUBLIC_KEY_INVALID exclusively if the key supplied is invalid.
+// Fails if the curve supplied is invalid.
+
+extern sb_error_t sb_sw_compress_public_key(sb_sw_context_t context[static 1],
+                                            sb_sw_compressed_public_t
+                                            compressed[static 1],
+                                            const sb_sw_public_t public[static 1],
+                                            sb_sw_curve_id_t curve,
+                                            sb_data_endian_t e);
+
+// sb_sw_decompress_public_key:
+
+// Recovers the Y coordinate of the supplied compressed public key with a
+// constant-time square root, and places the key in public in the given
+// endianness. Returns SB_ERROR_PUBLIC_KEY_INVALID exclusively if the
+// compressed key does not begin with 0x02 or 0x03 or its X coordinate is not
+// that of a point on the curve. Fails if the curve supplied is invalid.
+
+extern sb_error_t sb_sw_decompress_public_key(sb_sw_context_t context[static 1],
+                                              sb_sw_public_t public[static 1],
+                                              const sb_sw_compressed_public_t
+                                              compressed[static 1],
+                                              sb_sw_curve_id_t curve,
+                                              sb_data_endian_t e);
+
 // sb_sw_shared_secret:
 
 // Generate an ECDH shared secret using the given private key and public key.
@@ -165,6 +351,125 @@ extern sb_error_t sb_sw_sign_message_digest(sb_sw_context_t context[static 1],
                                             sb_sw_curve_id_t curve,
                                             sb_data_endian_t e);
 
+// sb_sw_sign_message_digest_recoverable
+
+// Signs the message digest as sb_sw_sign_message_digest does, producing the
+// same signature, and places the signature's recovery id into recovery_id
+// for use with sb_sw_recover_public_key. Bit 0 of the recovery id is the
+// parity of the Y coordinate of the point R = k * G whose X coordinate gives
+// r, and bit 1 is set if that X coordinate is r + N rather than r (which
+// occurs with negligible probability).
+
+extern sb_error_t sb_sw_sign_message_digest_recoverable(sb_sw_context_t context[static 1],
+                                                        sb_sw_signature_t signature[static 1],
+                                                        sb_byte_t recovery_id[static 1],
+                                                        const sb_sw_private_t private[static 1],
+                                                        const sb_sw_message_digest_t
+                                                        message[static 1],
+                                                        sb_hmac_drbg_state_t* drbg,
+                                                        sb_sw_curve_id_t curve,
+                                                        sb_data_endian_t e);
+
+// sb_sw_sign_message_digest_batch
+
+// Signs count message digests, each with the corresponding private key, as
+// if by calling sb_sw_sign_message_digest for each in order with the same
+// drbg, curve, and endianness. Signing in batches shares the modular
+// inversions needed by each signature (see SB_SW_BATCH_CHUNK), which
+// saves about a fifth of the work of signing if SB_FE_SAFEGCD_INVERSION is 0
+// and somewhat less otherwise. Fails if the supplied curve or any private
+// key is invalid, or if the optionally supplied drbg requires reseeding
+// before all count signatures could be generated.
+
+extern sb_error_t sb_sw_sign_message_digest_batch(sb_sw_context_t context[static 1],
+                                                  sb_sw_signature_t signatures[static 1],
+                                                  const sb_sw_private_t
+                                                  privates[static 1],
+                                                  const sb_sw_message_digest_t
+                                                  messages[static 1],
+                                                  size_t count,
+                                                  sb_hmac_drbg_state_t* drbg,
+                                                  sb_sw_curve_id_t curve,
+                                                  sb_data_endian_t e);
+
+// sb_sw_prepare_signer
+
+// Validates the supplied private key and stores it in the forms used for
+// signing, so that repeated calls to sb_sw_sign_message_digest_prepared do
+// not repeat this work. Fails if the supplied curve or private key is invalid.
+
+extern sb_error_t sb_sw_prepare_signer(sb_sw_context_t context[static 1],
+                                       sb_sw_signer_t signer[static 1],
+                                       const sb_sw_private_t private[static 1],
+                                       sb_sw_curve_id_t curve,
+                                       sb_data_endian_t e);
+
+// sb_sw_sign_message_digest_prepared
+
+// Signs the 32-byte message digest using a private key prepared with
+// sb_sw_prepare_signer, producing the same signature as
+// sb_sw_sign_message_digest would given the same private key, DRBG state,
+// and endianness. The curve is the one supplied when the signer was prepared.
+// Fails if the signer's curve is invalid or if the optionally supplied drbg
+// requires reseeding.
+
+extern sb_error_t sb_sw_sign_message_digest_prepared(sb_sw_context_t context[static 1],
+                                                     sb_sw_signature_t signature[static 1],
+                                                     const sb_sw_signer_t signer[static 1],
+                                                     const sb_sw_message_digest_t
+                                                     message[static 1],
+                                                     sb_hmac_drbg_state_t* drbg,
+                                                     sb_data_endian_t e);
+
+// sb_sw_presignature_pool_init
+
+// Initializes an empty pool of presignatures for the given curve, stored in
+// the capacity entries supplied. Fails if the supplied curve is invalid.
+
+extern sb_error_t sb_sw_presignature_pool_init(sb_sw_presignature_pool_t
+                                               pool[static 1],
+                                               sb_sw_presignature_t* entries,
+                                               size_t capacity,
+                                               sb_sw_curve_id_t curve);
+
+// sb_sw_presignature_pool_fill
+
+// Using the given HMAC-DRBG instance, generates presignatures until the pool
+// is full. Each presignature costs about as much as a signature, and none of
+// this work depends on the private key or message, so this is intended to be
+// called when the device is otherwise idle. Fails if the pool's curve is
+// invalid, if the DRBG must be reseeded (presignatures generated before that
+// point are kept), or in the infinitesimal chance that the DRBG produces
+// invalid per-message secrets (probability no greater than 2^-64). You are
+// responsible for ensuring that the HMAC-DRBG instance supplied has been
+// seeded with sufficient entropy at initialization time.
+
+extern sb_error_t sb_sw_presignature_pool_fill(sb_sw_context_t context[static 1],
+                                               sb_sw_presignature_pool_t
+                                               pool[static 1],
+                                               sb_hmac_drbg_state_t drbg[static 1]);
+
+// sb_sw_sign_message_digest_presigned
+
+// Signs the 32-byte message digest using a private key prepared with
+// sb_sw_prepare_signer and a presignature taken from the pool, which is
+// removed from the pool and wiped. This performs no point multiplication or
+// inversion and is much faster than sb_sw_sign_message_digest_prepared.
+// The per-message secret does not depend on the private key or message, so
+// signatures are not deterministic in the sense of RFC6979, and the
+// protection against DRBG failure that additional input would provide when
+// signing with sb_sw_sign_message_digest is absent. Fails if the signer's
+// curve is invalid or differs from the pool's curve, or if the pool is empty.
+
+extern sb_error_t sb_sw_sign_message_digest_presigned(sb_sw_context_t context[static 1],
+                                                      sb_sw_signature_t signature[static 1],
+                                                      sb_sw_presignature_pool_t
+                                                      pool[static 1],
+                                                      const sb_sw_signer_t signer[static 1],
+                                                      const sb_sw_message_digest_t
+                                                      message[static 1],
+                                                      sb_data_endian_t e);
+
 // sb_sw_verify_signature
 
 // Verifies the supplied message digest signature. Returns SB_SUCCESS if the
@@ -181,4 +486,178 @@ extern sb_error_t sb_sw_verify_signature(sb_sw_context_t context[static 1],
                                          sb_sw_curve_id_t curve,
                                          sb_data_endian_t e);
 
+// sb_sw_recover_public_key
+
+// Recovers the public key which produced the supplied signature of the
+// message digest, given the recovery id produced by
+// sb_sw_sign_message_digest_recoverable. This computes
+// Q = r^-1 * (s * R - m * G), where R is the point identified by the recovery
+// id, using the same constant-time multiplication as sb_sw_verify_signature;
+// the signature is valid for the recovered key by construction, so the caller
+// must instead check that the key is one it trusts. Returns
+// SB_ERROR_SIGNATURE_INVALID exclusively if either scalar of the signature is
+// invalid or the recovery id does not identify a point, in which case public
+// is not modified. Fails if the supplied curve is invalid or if the
+// optionally supplied drbg requires reseeding.
+
+extern sb_error_t sb_sw_recover_public_key(sb_sw_context_t context[static 1],
+                                           sb_sw_public_t public[static 1],
+                                           const sb_sw_signature_t signature[static 1],
+                                           sb_byte_t recovery_id,
+                                           const sb_sw_message_digest_t
+                                           message[static 1],
+                                           sb_hmac_drbg_state_t* drbg,
+                                           sb_sw_curve_id_t curve,
+                                           sb_data_endian_t e);
+
+// sb_sw_verify_signature_batch
+
+// Verifies count signatures, each of the corresponding message digest with
+// the corresponding public key. Bit (i % 8) of valid[i / 8] is set if
+// signature i is valid and cleared otherwise, exactly as if
+// sb_sw_verify_signature had returned SB_SUCCESS for it; valid must hold at
+// least (count + 7) / 8 bytes. The return value is the bitwise or of the
+// values that sb_sw_verify_signature would return for each signature. As
+// in sb_sw_sign_message_digest_batch, the modular inversions needed to
+// verify each signature are shared. Fails if the supplied curve is invalid,
+// or if the optionally supplied drbg requires reseeding before all count
+// signatures could be verified.
+
+extern sb_error_t sb_sw_verify_signature_batch(sb_sw_context_t context[static 1],
+                                               sb_byte_t valid[static 1],
+                                               const sb_sw_signature_t
+                                               signatures[static 1],
+                                               const sb_sw_public_t
+                                               publics[static 1],
+                                               const sb_sw_message_digest_t
+                                               messages[static 1],
+                                               size_t count,
+                                               sb_hmac_drbg_state_t* drbg,
+                                               sb_sw_curve_id_t curve,
+                                               sb_data_endian_t e);
+
+// sb_sw_prepare_public_key
+
+// Validates the supplied public key and precomputes the values used by
+// sb_sw_verify_signature_prepared, so that repeated verification of
+// signatures made by the same key does not repeat this work. Fails if the
+// supplied curve or public key is invalid.
+
+extern sb_error_t sb_sw_prepare_public_key(sb_sw_context_t context[static 1],
+                                           sb_sw_public_prepared_t prepared[static 1],
+                                           const sb_sw_public_t public[static 1],
+                                           sb_sw_curve_id_t curve,
+                                           sb_data_endian_t e);
+
+// sb_sw_verify_signature_prepared
+
+// Verifies the supplied message digest signature against a public key
+// prepared with sb_sw_prepare_public_key, with the same results as
+// sb_sw_verify_signature. The curve is the one supplied when the key was
+// prepared. Fails if the prepared key's curve is invalid or if the optionally
+// supplied drbg requires reseeding.
+
+extern sb_error_t sb_sw_verify_signature_prepared(sb_sw_context_t context[static 1],
+                                                  const sb_sw_signature_t signature[static 1],
+                                                  const sb_sw_public_prepared_t prepared[static 1],
+                                                  const sb_sw_message_digest_t
+                                                  message[static 1],
+                                                  sb_hmac_drbg_state_t* drbg,
+                                                  sb_data_endian_t e);
+
+#if SB_SW_VARTIME_SUPPORT
+
+// sb_sw_verify_signature_vartime
+
+// Verifies the supplied message digest signature with the same results as
+// sb_sw_verify_signature, using a faster algorithm whose running time and
+// memory access pattern depend on the signature, public key, and message.
+// Use this ONLY when all of these are public, and when it is acceptable to
+// reveal something about them through timing; for instance, an embedded
+// system verifying its firmware on boot may reveal which version it is
+// running. On secp256k1, both scalars are split using the curve's
+// endomorphism, which halves the number of doublings. In addition to the
+// context, this function uses about 1.3 KiB of stack, or 2.4 KiB on
+// secp256k1.
+
+extern sb_error_t sb_sw_verify_signature_vartime(sb_sw_context_t context[static 1],
+                                                 const sb_sw_signature_t signature[static 1],
+                                                 const sb_sw_public_t public[static 1],
+                                                 const sb_sw_message_digest_t
+                                                 message[static 1],
+                                                 sb_sw_curve_id_t curve,
+                                                 sb_data_endian_t e);
+
+// sb_sw_verify_signature_batch_vartime
+
+// Verifies count signatures, each of the corresponding message digest with the
+// corresponding public key, reporting the results in valid and in the return
+// value as sb_sw_verify_signature_batch does. Like
+// sb_sw_verify_signature_vartime, this may reveal the signatures, public keys,
+// and messages through timing. Rather than verifying each signature, this
+// checks that a random linear combination of the verification equations of a
+// chunk of signatures holds, which is several times faster; if it does not, the
+// chunk is halved until the invalid signatures are found. This requires the
+// point R whose X coordinate gives r, which is identified by recovery_ids[i]
+// for signature i as produced by sb_sw_sign_message_digest_recoverable: bit 0
+// is the parity of the Y coordinate of R, and bit 1 is set if its X coordinate
+// is r + N rather than r (which occurs with negligible probability). A
+// signature with an incorrect or out-of-range recovery id is still verified
+// correctly, but no faster than by sb_sw_verify_signature_vartime. If
+// recovery_ids is NULL, R is not known and every signature is verified on its
+// own in this way: plain (r, s) signatures are accepted, but batching them is
+// no faster than calling sb_sw_verify_signature_vartime for each. The random
+// coefficients are generated using the supplied drbg, which must not be
+// predictable to whoever produced the signatures; with them, an invalid
+// signature is reported as valid with probability no greater than about
+// 2^-127. Fails if the supplied curve is invalid, or if drbg requires
+// reseeding before all count signatures could be verified (one request is made
+// for each 8 signatures in a chunk).
+
+extern sb_error_t sb_sw_verify_signature_batch_vartime(sb_sw_context_t context[static 1],
+                                                       sb_byte_t valid[static 1],
+                                                       const sb_sw_signature_t
+                                                       signatures[static 1],
+                                                       const sb_byte_t*
+                                                       recovery_ids,
+                                                       const sb_sw_public_t
+                                                       publics[static 1],
+                                                       const sb_sw_message_digest_t
+                                                       messages[static 1],
+                                                       size_t count,
+                                                       sb_hmac_drbg_state_t drbg[static 1],
+                                                       sb_sw_curve_id_t curve,
+                                                       sb_data_endian_t e);
+
+// sb_sw_multi_mult_vartime
+
+// Computes the sum of scalars[i] * points[i] for the count given points and
+// returns it in output, or sets output to zero if the sum is the point at
+// infinity (which, having zero coordinates, is not a valid public key). Each
+// scalar may be any integer less than 2^256. Like
+// sb_sw_verify_signature_vartime, this may reveal the scalars and points
+// through timing, so use it ONLY with public inputs. With few points, or if
+// buckets is NULL, each chunk of SB_SW_VARTIME_BATCH_CHUNK points is
+// multiplied with interleaved width-5 NAFs (Straus's method). With many
+// points, Pippenger's method is used instead if it is expected to be faster,
+// with a window chosen from count such that it needs no more than
+// bucket_count buckets; nothing is allocated. Pippenger's method starts to
+// win at about 150 points with 32 buckets, and a few hundred buckets suffice
+// for thousands of points. Fails if the supplied curve or any point is
+// invalid.
+
+extern sb_error_t sb_sw_multi_mult_vartime(sb_sw_context_t context[static 1],
+                                           sb_sw_public_t output[static 1],
+                                           const sb_sw_scalar_t
+                                           scalars[static 1],
+                                           const sb_sw_public_t
+                                           points[static 1],
+                                           size_t count,
+                                           sb_sw_multi_mult_bucket_t* buckets,
+                                           size_t bucket_count,
+                                           sb_sw_curve_id_t curve,
+                                           sb_data_endian_t e);
+
+#endif
+
 #endif
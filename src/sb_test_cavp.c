@@ -397,6 +397,22 @@ static _Bool sb_test_nist_signatures(sb_sw_curve_id_t curve, const char* name)
                                                       NULL,
                                                       curve,
                                                       SB_DATA_ENDIAN_BIG));
+        sb_sw_public_prepared_t prepared;
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_prepare_public_key(&ct, &prepared, &pub_key_a, curve,
+                                     SB_DATA_ENDIAN_BIG));
+        SB_TEST_ASSERT_SUCCESS(
+            sb_sw_verify_signature_prepared(&ct, &signature, &prepared,
+                                            &digest, NULL,
+                                            SB_DATA_ENDIAN_BIG));
+#if SB_SW_VARTIME_SUPPORT
+        SB_TEST_ASSERT_SUCCESS(sb_sw_verify_signature_vartime(&ct,
+                                                              &signature,
+                                                              &pub_key_a,
+                                                              &digest,
+                                                              curve,
+                                                              SB_DATA_ENDIAN_BIG));
+#endif
 
     }
 
@@ -22,8 +22,17 @@ SB_DEFINE_TEST(hmac_drbg);
 SB_DEFINE_TEST(fe);
 SB_DEFINE_TEST(mont_mult);
 SB_DEFINE_TEST(mod_expt_p);
+SB_DEFINE_TEST(mod_inv);
+SB_DEFINE_TEST(mod_inv_expt);
+SB_DEFINE_TEST(mod_inv_safegcd);
+SB_DEFINE_TEST(batch_inv);
+SB_DEFINE_TEST(mult_shift_round);
+SB_DEFINE_TEST(mod_sqrt);
+SB_DEFINE_TEST(fast_reduction);
+SB_DEFINE_TEST(fe_specialize);
 
 SB_DEFINE_TEST(mont_point_mult);
+SB_DEFINE_TEST(mont_radix_51);
 SB_DEFINE_TEST(mont_public_key);
 SB_DEFINE_TEST(mont_shared_secret);
 SB_DEFINE_TEST(mont_not_on_curve);
@@ -31,10 +40,17 @@ SB_DEFINE_TEST(mont_invalid_points);
 SB_DEFINE_TEST(mont_early_errors);
 
 SB_DEFINE_TEST(sw_h);
+SB_DEFINE_TEST(sw_point_complete);
 SB_DEFINE_TEST(exceptions);
 SB_DEFINE_TEST(sw_point_mult_add);
+SB_DEFINE_TEST(sw_point_mult_add_vartime);
+SB_DEFINE_TEST(sw_point_mult_add_glv_vartime);
+SB_DEFINE_TEST(sw_point_mult_base);
+SB_DEFINE_TEST(sw_point_mult_glv);
+SB_DEFINE_TEST(sw_point_mult_window);
 SB_DEFINE_TEST(sw_early_errors);
 SB_DEFINE_TEST(valid_public);
+SB_DEFINE_TEST(compress_public);
 SB_DEFINE_TEST(compute_public);
 SB_DEFINE_TEST(shared_secret);
 SB_DEFINE_TEST(shared_secret_cavp_1);
@@ -42,6 +58,15 @@ SB_DEFINE_TEST(sign_rfc6979);
 SB_DEFINE_TEST(sign_catastrophe);
 SB_DEFINE_TEST(verify);
 SB_DEFINE_TEST(verify_invalid);
+SB_DEFINE_TEST(verify_prepared);
+SB_DEFINE_TEST(verify_batch);
+SB_DEFINE_TEST(verify_batch_k256);
+SB_DEFINE_TEST(verify_batch_vartime);
+SB_DEFINE_TEST(verify_batch_vartime_k256);
+SB_DEFINE_TEST(multi_mult);
+SB_DEFINE_TEST(multi_mult_k256);
+SB_DEFINE_TEST(recover_public_key);
+SB_DEFINE_TEST(recover_public_key_k256);
 SB_DEFINE_TEST(sign_k256);
 SB_DEFINE_TEST(shared_secret_k256);
 
@@ -51,6 +76,10 @@ SB_DEFINE_TEST(mont_iter);
 SB_DEFINE_TEST(sw_point_mult_add_rand);
 SB_DEFINE_TEST(sign_iter);
 SB_DEFINE_TEST(sign_iter_k256);
+SB_DEFINE_TEST(sign_presigned);
+SB_DEFINE_TEST(sign_presigned_k256);
+SB_DEFINE_TEST(sign_batch);
+SB_DEFINE_TEST(sign_batch_k256);
 SB_DEFINE_TEST(shared_iter);
 SB_DEFINE_TEST(shared_iter_k256);
 